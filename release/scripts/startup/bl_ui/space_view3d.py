@@ -2566,6 +2566,10 @@ class VIEW3D_MT_edit_mesh_clean(Menu):
         layout.operator("mesh.vert_connect_concave")
         layout.operator("mesh.fill_holes")
 
+        layout.separator()
+
+        layout.operator("mesh.compact")
+
 
 class VIEW3D_MT_edit_mesh_delete(Menu):
     bl_label = "Delete"
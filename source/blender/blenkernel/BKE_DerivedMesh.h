@@ -735,6 +735,9 @@ void makeDerivedMesh(
         struct Scene *scene, struct Object *ob, struct BMEditMesh *em,
         CustomDataMask dataMask, const bool build_shapekey_layers);
 
+void mesh_modifier_stack_cache_free(struct Object *ob);
+void mesh_modifier_stack_cache_tag(struct Object *ob, struct ModifierData *md);
+
 void weight_to_rgb(float r_rgb[3], const float weight);
 /** Update the weight MCOL preview layer.
  * If weights are NULL, use object's active vgroup(s).
@@ -220,6 +220,9 @@ void CustomData_copy_data(const struct CustomData *source,
 void CustomData_copy_data_named(const struct CustomData *source,
                           struct CustomData *dest, int source_index,
                           int dest_index, int count);
+void CustomData_copy_data_indices(const struct CustomData *source,
+                                  struct CustomData *dest, const int *src_indices,
+                                  int dest_index, int count);
 void CustomData_copy_elements(int type, void *src_data_ofs, void *dst_data_ofs, int count);
 void CustomData_bmesh_copy_data(const struct CustomData *source, 
                                 struct CustomData *dest, void *src_block, 
@@ -246,6 +249,10 @@ void CustomData_interp(
         const struct CustomData *source, struct CustomData *dest,
         int *src_indices, float *weights, float *sub_weights,
         int count, int dest_index);
+void CustomData_interp_range(
+        const struct CustomData *source, struct CustomData *dest,
+        const int *src_indices, const float *weights,
+        int count, int dest_index, int dest_count);
 void CustomData_bmesh_interp_n(
         struct CustomData *data, const void **src_blocks, const float *weights,
         const float *sub_weights, int count, void *dst_block_ofs, int n);
@@ -342,6 +349,7 @@ void CustomData_set_layer_stencil_index(struct CustomData *data, int type, int n
 /* adds flag to the layer flags */
 void CustomData_set_layer_flag(struct CustomData *data, int type, int flag);
 
+void CustomData_bmesh_alloc_block(struct CustomData *data, void **block);
 void CustomData_bmesh_set_default(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block(struct CustomData *data, void **block);
 void CustomData_bmesh_free_block_data(struct CustomData *data, void *block);
@@ -352,6 +360,11 @@ void CustomData_to_bmesh_block(const struct CustomData *source,
                                struct CustomData *dest, int src_index, void **dest_block, bool use_default_init);
 void CustomData_from_bmesh_block(const struct CustomData *source, 
                                  struct CustomData *dest, void *src_block, int dest_index);
+void CustomData_to_bmesh_block_range(const struct CustomData *source,
+                                     struct CustomData *dest, int src_index, void **dest_blocks, int count,
+                                     bool use_default_init);
+void CustomData_from_bmesh_block_range(const struct CustomData *source,
+                                       struct CustomData *dest, void **src_blocks, int dest_index, int count);
 
 void CustomData_file_write_prepare(
         struct CustomData *data,
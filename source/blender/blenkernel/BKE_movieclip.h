@@ -34,6 +34,7 @@
 
 struct ImBuf;
 struct Main;
+struct MovieCacheStats;
 struct MovieClip;
 struct MovieClipScopes;
 struct MovieClipUser;
@@ -77,7 +78,9 @@ void BKE_movieclip_filename_for_frame(struct MovieClip *clip, struct MovieClipUs
 struct ImBuf *BKE_movieclip_anim_ibuf_for_frame(struct MovieClip *clip, struct MovieClipUser *user);
 
 bool BKE_movieclip_has_cached_frame(struct MovieClip *clip, struct MovieClipUser *user);
-bool BKE_movieclip_put_frame_if_possible(struct MovieClip *clip, struct MovieClipUser *user, struct ImBuf *ibuf);
+bool BKE_movieclip_put_frame_if_possible(struct MovieClip *clip, struct MovieClipUser *user, struct ImBuf *ibuf,
+                                         float cost);
+void BKE_movieclip_cache_get_stats(struct MovieClip *clip, struct MovieCacheStats *r_stats);
 
 /* cacheing flags */
 #define MOVIECLIP_CACHE_SKIP        (1 << 0)
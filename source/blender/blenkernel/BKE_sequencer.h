@@ -40,6 +40,7 @@ struct GPUFX;
 struct ImBuf;
 struct Main;
 struct Mask;
+struct MovieCacheStats;
 struct Scene;
 struct Sequence;
 struct SequenceModifierData;
@@ -102,6 +103,7 @@ typedef struct SeqRenderData {
 	float motion_blur_shutter;
 	bool skip_cache;
 	bool is_proxy_render;
+	bool is_prefetch_render;
 	int view_id;
 
 	/* special case for OpenGL render */
@@ -190,7 +192,17 @@ struct ImBuf *BKE_sequencer_give_ibuf(const SeqRenderData *context, float cfra,
 struct ImBuf *BKE_sequencer_give_ibuf_threaded(const SeqRenderData *context, float cfra, int chanshown);
 struct ImBuf *BKE_sequencer_give_ibuf_direct(const SeqRenderData *context, float cfra, struct Sequence *seq);
 struct ImBuf *BKE_sequencer_give_ibuf_seqbase(const SeqRenderData *context, float cfra, int chan_shown, struct ListBase *seqbasep);
-void BKE_sequencer_give_ibuf_prefetch_request(const SeqRenderData *context, float cfra, int chan_shown);
+
+/* **********************************************************************
+ * sequencer.c
+ *
+ * prefetching of frames ahead of the playhead
+ * ********************************************************************** */
+
+bool BKE_sequencer_prefetch_supported(struct Scene *scene);
+int  BKE_sequencer_prefetch_begin(void);
+bool BKE_sequencer_prefetch_frame(const SeqRenderData *context, float cfra, int chanshown, int generation);
+void BKE_sequencer_prefetch_stop(void);
 
 /* **********************************************************************
  * sequencer.c
@@ -276,9 +288,14 @@ struct ImBuf *BKE_sequencer_cache_get(const SeqRenderData *context, struct Seque
 /* passed ImBuf is properly refed, so ownership is *not* 
  * transferred to the cache.
  * you can pass the same ImBuf multiple times to the cache without problems.
+ * cost is the time in seconds it took to render the ImBuf, 0 when unknown,
+ * expensive ImBufs stay in the cache longer.
  */
 
-void BKE_sequencer_cache_put(const SeqRenderData *context, struct Sequence *seq, float cfra, eSeqStripElemIBuf type, struct ImBuf *nval);
+void BKE_sequencer_cache_put(const SeqRenderData *context, struct Sequence *seq, float cfra, eSeqStripElemIBuf type,
+                             struct ImBuf *nval, float cost);
+
+void BKE_sequencer_cache_get_stats(struct MovieCacheStats *r_stats);
 
 void BKE_sequencer_cache_cleanup_sequence(struct Sequence *seq);
 
@@ -144,6 +144,7 @@ typedef struct CCGDerivedMesh {
 /* TODO(sergey): Not really ideal place, but we don't currently have better one. */
 void BKE_subsurf_osd_init(void);
 void BKE_subsurf_free_unused_buffers(void);
+void BKE_subsurf_osd_free_cached_evaluators(void);
 void BKE_subsurf_osd_cleanup(void);
 #endif
 
@@ -306,6 +306,7 @@ CCGSubSurf *ccgSubSurf_new(CCGMeshIFC *ifc, int subdivLevels, CCGAllocatorIFC *a
 
 #ifdef WITH_OPENSUBDIV
 		ss->osd_evaluator = NULL;
+		ss->osd_evaluator_hash = 0;
 		ss->osd_mesh = NULL;
 		ss->osd_topology_refiner = NULL;
 		ss->osd_mesh_invalid = false;
@@ -331,7 +332,7 @@ void ccgSubSurf_free(CCGSubSurf *ss)
 	CCGAllocatorHDL allocator = ss->allocator;
 #ifdef WITH_OPENSUBDIV
 	if (ss->osd_evaluator != NULL) {
-		openSubdiv_deleteEvaluatorDescr(ss->osd_evaluator);
+		ccgSubSurf__release_evaluator(ss);
 	}
 	if (ss->osd_mesh != NULL) {
 		ccgSubSurf__delete_osdGLMesh(ss->osd_mesh);
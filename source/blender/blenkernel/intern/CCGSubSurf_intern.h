@@ -250,6 +250,10 @@ struct CCGSubSurf {
 
 	/* Limit evaluator, used to evaluate CCG. */
 	struct OpenSubdiv_EvaluatorDescr *osd_evaluator;
+	/* Hash of the topology the evaluator was created for, used to put the
+	 * evaluator to the evaluator cache when subsurf is freed.
+	 */
+	uint64_t osd_evaluator_hash;
 	/* Next PTex face index, used while CCG synchronization
 	 * to fill in PTex index of CCGFace.
 	 */
@@ -311,6 +315,11 @@ void ccgSubSurf__sync_opensubdiv(CCGSubSurf *ss);
 void ccgSubSurf__delete_osdGLMesh(struct OpenSubdiv_GLMesh *osd_mesh);
 void ccgSubSurf__delete_vertex_array(unsigned int vao);
 void ccgSubSurf__delete_pending(void);
+
+/* Hands the limit evaluator over to the evaluator cache, so subsurf with the
+ * same topology can re-use it instead of creating stencils and patches again.
+ */
+void ccgSubSurf__release_evaluator(CCGSubSurf *ss);
 #endif
 
 /* * CCGSubSurf_opensubdiv_converter.c * */
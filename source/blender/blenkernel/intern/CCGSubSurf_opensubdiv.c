@@ -24,13 +24,17 @@
 
 #ifdef WITH_OPENSUBDIV
 
+#include <float.h>
+
 #include "MEM_guardedalloc.h"
 #include "BLI_sys_types.h" // for intptr_t support
 
 #include "BLI_utildefines.h" /* for BLI_assert */
+#include "BLI_hash_mm2a.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_threads.h"
+#include "PIL_time.h"
 
 #include "CCGSubSurf.h"
 #include "CCGSubSurf_intern.h"
@@ -201,8 +205,7 @@ void ccgSubSurf_checkTopologyChanged(CCGSubSurf *ss, DerivedMesh *dm)
 
 		/* Reste CPU side. */
 		if (ss->osd_evaluator != NULL) {
-			openSubdiv_deleteEvaluatorDescr(ss->osd_evaluator);
-			ss->osd_evaluator = NULL;
+			ccgSubSurf__release_evaluator(ss);
 		}
 	}
 }
@@ -445,6 +448,173 @@ void ccgSubSurf_evaluatorFVarUV(CCGSubSurf *ss,
 	zero_v2(uv);
 }
 
+/* ** Evaluator cache ** */
+
+/* Subsurf modifier frees its subsurf structure after every evaluation, so
+ * without this cache stencils and patch tables would be created again for
+ * every deformation of the same mesh.
+ */
+#define OSD_EVALUATOR_CACHE_SIZE 8
+/* Seconds after which unused evaluators are freed, they can take hundreds of megabytes. */
+#define OSD_EVALUATOR_CACHE_TIMEOUT 10.0
+
+/* seed of the second half of the topology hash */
+#define OSD_TOPOLOGY_HASH_SEED_HIGH 0x9e3779b9
+
+typedef struct OsdEvaluatorCacheItem {
+	struct OsdEvaluatorCacheItem *next, *prev;
+	OpenSubdiv_EvaluatorDescr *evaluator;
+	uint64_t hash;
+	double time_released;
+} OsdEvaluatorCacheItem;
+
+/* A mutex rather than a spin lock, the cache is used and freed in background mode too,
+ * where BKE_subsurf_osd_init() isn't called. */
+static ThreadMutex evaluator_cache_lock = BLI_MUTEX_INITIALIZER;
+static ListBase evaluator_cache = {NULL, NULL};
+static int evaluator_cache_len = 0;
+
+typedef struct OsdTopologyHash {
+	BLI_HashMurmur2A low, high;
+} OsdTopologyHash;
+
+static void topology_hash_add(OsdTopologyHash *hash, const void *data, size_t len)
+{
+	BLI_hash_mm2a_add(&hash->low, data, len);
+	BLI_hash_mm2a_add(&hash->high, data, len);
+}
+
+static void topology_hash_add_int(OsdTopologyHash *hash, int value)
+{
+	BLI_hash_mm2a_add_int(&hash->low, value);
+	BLI_hash_mm2a_add_int(&hash->high, value);
+}
+
+/* Hash of everything the topology refiner is created from, 0 is never returned. */
+static uint64_t opensubdiv_topology_hash(CCGSubSurf *ss)
+{
+	OpenSubdiv_Converter converter;
+	OsdTopologyHash hash;
+	int *indices = NULL, indices_len = 0;
+	int num_faces, num_edges, face, edge;
+	uint64_t result;
+
+	BLI_hash_mm2a_init(&hash.low, 0);
+	BLI_hash_mm2a_init(&hash.high, OSD_TOPOLOGY_HASH_SEED_HIGH);
+
+	ccgSubSurf_converter_setup_from_ccg(ss, &converter);
+
+	num_faces = converter.get_num_faces(&converter);
+	num_edges = converter.get_num_edges(&converter);
+
+	topology_hash_add_int(&hash, ss->subdivLevels);
+	topology_hash_add_int(&hash, converter.get_type(&converter));
+	topology_hash_add_int(&hash, converter.get_num_verts(&converter));
+	topology_hash_add_int(&hash, num_edges);
+	topology_hash_add_int(&hash, num_faces);
+
+	for (face = 0; face < num_faces; face++) {
+		const int num_face_verts = converter.get_num_face_verts(&converter, face);
+		if (num_face_verts > indices_len) {
+			indices_len = num_face_verts;
+			indices = MEM_reallocN(indices, sizeof(int) * indices_len);
+		}
+		topology_hash_add_int(&hash, num_face_verts);
+		converter.get_face_verts(&converter, face, indices);
+		topology_hash_add(&hash, indices, sizeof(int) * num_face_verts);
+		converter.get_face_edges(&converter, face, indices);
+		topology_hash_add(&hash, indices, sizeof(int) * num_face_verts);
+	}
+
+	for (edge = 0; edge < num_edges; edge++) {
+		int edge_verts[2];
+		const float sharpness = converter.get_edge_sharpness(&converter, edge);
+		converter.get_edge_verts(&converter, edge, edge_verts);
+		topology_hash_add(&hash, edge_verts, sizeof(edge_verts));
+		topology_hash_add(&hash, &sharpness, sizeof(sharpness));
+	}
+
+	ccgSubSurf_converter_free(&converter);
+	MEM_SAFE_FREE(indices);
+
+	result = ((uint64_t)BLI_hash_mm2a_end(&hash.high) << 32) | BLI_hash_mm2a_end(&hash.low);
+	return result ? result : 1;
+}
+
+/* Takes the evaluator created for the given topology out of the cache. */
+static OpenSubdiv_EvaluatorDescr *evaluator_cache_pop(uint64_t hash)
+{
+	OpenSubdiv_EvaluatorDescr *evaluator = NULL;
+	OsdEvaluatorCacheItem *item;
+
+	BLI_mutex_lock(&evaluator_cache_lock);
+	for (item = evaluator_cache.first; item != NULL; item = item->next) {
+		if (item->hash == hash) {
+			evaluator = item->evaluator;
+			BLI_remlink(&evaluator_cache, item);
+			evaluator_cache_len--;
+			break;
+		}
+	}
+	BLI_mutex_unlock(&evaluator_cache_lock);
+
+	if (item != NULL) {
+		MEM_freeN(item);
+	}
+	return evaluator;
+}
+
+void ccgSubSurf__release_evaluator(CCGSubSurf *ss)
+{
+	OsdEvaluatorCacheItem *item, *oldest = NULL;
+
+	if (ss->osd_evaluator_hash == 0) {
+		openSubdiv_deleteEvaluatorDescr(ss->osd_evaluator);
+		ss->osd_evaluator = NULL;
+		return;
+	}
+
+	item = MEM_mallocN(sizeof(OsdEvaluatorCacheItem), "opensubdiv evaluator cache item");
+	item->evaluator = ss->osd_evaluator;
+	item->hash = ss->osd_evaluator_hash;
+	item->time_released = PIL_check_seconds_timer();
+
+	/* Most recently released evaluators are at the head of the list. */
+	BLI_mutex_lock(&evaluator_cache_lock);
+	BLI_addhead(&evaluator_cache, item);
+	if (evaluator_cache_len == OSD_EVALUATOR_CACHE_SIZE) {
+		oldest = evaluator_cache.last;
+		BLI_remlink(&evaluator_cache, oldest);
+	}
+	else {
+		evaluator_cache_len++;
+	}
+	BLI_mutex_unlock(&evaluator_cache_lock);
+
+	if (oldest != NULL) {
+		openSubdiv_deleteEvaluatorDescr(oldest->evaluator);
+		MEM_freeN(oldest);
+	}
+
+	ss->osd_evaluator = NULL;
+	ss->osd_evaluator_hash = 0;
+}
+
+/* Frees the evaluators released before the given time, all of them for DBL_MAX. */
+static void evaluator_cache_trim(double time)
+{
+	OsdEvaluatorCacheItem *item, *prev;
+	BLI_mutex_lock(&evaluator_cache_lock);
+	for (item = evaluator_cache.last; item != NULL && item->time_released < time; item = prev) {
+		prev = item->prev;
+		BLI_remlink(&evaluator_cache, item);
+		evaluator_cache_len--;
+		openSubdiv_deleteEvaluatorDescr(item->evaluator);
+		MEM_freeN(item);
+	}
+	BLI_mutex_unlock(&evaluator_cache_lock);
+}
+
 static bool opensubdiv_createEvaluator(CCGSubSurf *ss)
 {
 	OpenSubdiv_Converter converter;
@@ -453,6 +623,15 @@ static bool opensubdiv_createEvaluator(CCGSubSurf *ss)
 		/* OpenSubdiv doesn't support meshes without faces. */
 		return false;
 	}
+	/* Deformation only changes coarse positions, which are always updated
+	 * after the evaluator is ensured.
+	 */
+	ss->osd_evaluator_hash = opensubdiv_topology_hash(ss);
+	ss->osd_evaluator = evaluator_cache_pop(ss->osd_evaluator_hash);
+	if (ss->osd_evaluator != NULL) {
+		OSD_LOG("Re-using cached evaluator, %d verts\n", ss->vMap->numEntries);
+		return true;
+	}
 	ccgSubSurf_converter_setup_from_ccg(ss, &converter);
 	topology_refiner = openSubdiv_createTopologyRefinerDescr(&converter);
 	ccgSubSurf_converter_free(&converter);
@@ -461,6 +640,7 @@ static bool opensubdiv_createEvaluator(CCGSubSurf *ss)
 	                                        ss->subdivLevels);
 	if (ss->osd_evaluator == NULL) {
 		BLI_assert(!"OpenSubdiv initialization failed, should not happen.");
+		ss->osd_evaluator_hash = 0;
 		return false;
 	}
 	return true;
@@ -995,10 +1175,17 @@ void BKE_subsurf_osd_init(void)
 void BKE_subsurf_free_unused_buffers(void)
 {
 	ccgSubSurf__delete_pending();
+	evaluator_cache_trim(PIL_check_seconds_timer() - OSD_EVALUATOR_CACHE_TIMEOUT);
+}
+
+void BKE_subsurf_osd_free_cached_evaluators(void)
+{
+	evaluator_cache_trim(DBL_MAX);
 }
 
 void BKE_subsurf_osd_cleanup(void)
 {
+	evaluator_cache_trim(DBL_MAX);
 	openSubdiv_cleanup();
 	ccgSubSurf__delete_pending();
 	BLI_spin_end(&delete_spin);
@@ -49,6 +49,7 @@
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
 #include "BLI_linklist.h"
+#include "BLI_hash_mm2a.h"
 
 #include "BKE_cdderivedmesh.h"
 #include "BKE_editmesh.h"
@@ -1692,6 +1693,433 @@ static void dm_ensure_display_normals(DerivedMesh *dm)
 	}
 }
 
+/* -------------------------------------------------------------------- */
+
+/** \name Modifier Stack Cache
+ *
+ * Keeps a copy of the DerivedMesh at one position of the modifier stack, so after a
+ * change to the settings of a modifier the evaluation continues from the input of that
+ * modifier instead of running the whole stack again.
+ *
+ * Every position in the stack is identified by a key hashed from the original mesh, the
+ * evaluation arguments and the settings of all modifiers before it. The input of the
+ * modifier whose settings changed last is stored, that's where the next change is most
+ * likely to happen while a modifier is being tweaked.
+ *
+ * Modifiers depending on time, other data-blocks or with side effects can't be identified
+ * by their settings, the stack positions after them are never cached.
+ * \{ */
+
+/* seed of the second half of the keys, any value different from the first seed */
+#define STACK_CACHE_SEED_HIGH 0x9e3779b9
+
+typedef struct ModifierStackCache {
+	/* hash of the settings of every modifier at the last evaluation */
+	uint64_t *settings;
+	int settings_len;
+
+	/* copy of the input of the modifier at stack position 'index' */
+	DerivedMesh *dm;
+	ModifierData *md;
+	uint64_t key;
+	int index;
+} ModifierStackCache;
+
+typedef struct StackCacheState {
+	ModifierStackCache *cache;
+	/* key of the input of every stack position, 0 for positions that can't be cached */
+	uint64_t *keys;
+	/* position to continue from the cached DerivedMesh, -1 when the stack runs from the start */
+	int resume_index;
+	/* position to store the input of, -1 when nothing has to be stored */
+	int store_index;
+} StackCacheState;
+
+typedef struct StackCacheHash {
+	BLI_HashMurmur2A low;
+	BLI_HashMurmur2A high;
+} StackCacheHash;
+
+static void stack_cache_hash_init(StackCacheHash *hash)
+{
+	BLI_hash_mm2a_init(&hash->low, 0);
+	BLI_hash_mm2a_init(&hash->high, STACK_CACHE_SEED_HIGH);
+}
+
+static void stack_cache_hash_add(StackCacheHash *hash, const void *data, size_t len)
+{
+	BLI_hash_mm2a_add(&hash->low, data, len);
+	BLI_hash_mm2a_add(&hash->high, data, len);
+}
+
+static void stack_cache_hash_add_int(StackCacheHash *hash, int value)
+{
+	BLI_hash_mm2a_add_int(&hash->low, value);
+	BLI_hash_mm2a_add_int(&hash->high, value);
+}
+
+static uint64_t stack_cache_hash_end(StackCacheHash *hash)
+{
+	const uint64_t low = BLI_hash_mm2a_end(&hash->low);
+	const uint64_t high = BLI_hash_mm2a_end(&hash->high);
+	const uint64_t key = (high << 32) | low;
+
+	/* 0 is reserved for positions that can't be cached */
+	return key ? key : 1;
+}
+
+/* returns false for layers referencing data that can't be hashed */
+static bool stack_cache_hash_customdata(StackCacheHash *hash, const CustomData *data, int totelem)
+{
+	int i;
+
+	stack_cache_hash_add_int(hash, totelem);
+
+	for (i = 0; i < data->totlayer; i++) {
+		const CustomDataLayer *layer = &data->layers[i];
+
+		stack_cache_hash_add_int(hash, layer->type);
+		stack_cache_hash_add_int(hash, layer->flag);
+		stack_cache_hash_add_int(hash, layer->active);
+		stack_cache_hash_add_int(hash, layer->active_rnd);
+		stack_cache_hash_add_int(hash, layer->active_clone);
+		stack_cache_hash_add_int(hash, layer->active_mask);
+		stack_cache_hash_add(hash, layer->name, strlen(layer->name));
+
+		if (layer->data == NULL) {
+			continue;
+		}
+
+		if (layer->type == CD_MDEFORMVERT) {
+			const MDeformVert *dvert = layer->data;
+			int j;
+
+			for (j = 0; j < totelem; j++) {
+				stack_cache_hash_add_int(hash, dvert[j].totweight);
+				if (dvert[j].totweight) {
+					stack_cache_hash_add(hash, dvert[j].dw, sizeof(*dvert[j].dw) * (size_t)dvert[j].totweight);
+				}
+			}
+		}
+		else if (ELEM(layer->type, CD_MDISPS, CD_GRID_PAINT_MASK, CD_BM_ELEM_PYPTR)) {
+			return false;
+		}
+		else {
+			stack_cache_hash_add(hash, layer->data, (size_t)CustomData_sizeof(layer->type) * (size_t)totelem);
+		}
+	}
+
+	return true;
+}
+
+static void stack_cache_hash_key(StackCacheHash *hash, const Key *key)
+{
+	const KeyBlock *kb;
+
+	stack_cache_hash_add_int(hash, key->type);
+	stack_cache_hash_add_int(hash, key->flag);
+	stack_cache_hash_add(hash, &key->ctime, sizeof(key->ctime));
+
+	for (kb = key->block.first; kb; kb = kb->next) {
+		stack_cache_hash_add(hash, &kb->pos, sizeof(kb->pos));
+		stack_cache_hash_add(hash, &kb->curval, sizeof(kb->curval));
+		stack_cache_hash_add_int(hash, kb->type);
+		stack_cache_hash_add_int(hash, kb->relative);
+		stack_cache_hash_add_int(hash, kb->flag);
+		stack_cache_hash_add_int(hash, kb->totelem);
+		stack_cache_hash_add(hash, kb->vgroup, strlen(kb->vgroup));
+		if (kb->data) {
+			stack_cache_hash_add(hash, kb->data, (size_t)key->elemsize * (size_t)kb->totelem);
+		}
+	}
+}
+
+/* key of the original data the stack starts from, 0 when it can't be identified */
+static uint64_t stack_cache_base_key(
+        Scene *scene, Object *ob, CustomDataMask dataMask, const bool need_mapping,
+        const bool build_shapekey_layers, ModifierApplyFlag app_flags)
+{
+	Mesh *me = ob->data;
+	StackCacheHash hash;
+	bDeformGroup *dg;
+
+	stack_cache_hash_init(&hash);
+
+	stack_cache_hash_add(&hash, &me, sizeof(me));
+	stack_cache_hash_add(&hash, &dataMask, sizeof(dataMask));
+	stack_cache_hash_add_int(&hash, need_mapping);
+	stack_cache_hash_add_int(&hash, build_shapekey_layers);
+	stack_cache_hash_add_int(&hash, app_flags);
+
+	/* object settings read by modifiers */
+	stack_cache_hash_add_int(&hash, ob->mode);
+	stack_cache_hash_add_int(&hash, ob->totcol);
+	stack_cache_hash_add_int(&hash, ob->shapenr);
+	stack_cache_hash_add_int(&hash, ob->shapeflag);
+	stack_cache_hash_add(&hash, ob->obmat, sizeof(ob->obmat));
+	for (dg = ob->defbase.first; dg; dg = dg->next) {
+		stack_cache_hash_add(&hash, dg->name, strlen(dg->name));
+	}
+
+	/* simplify changes the subdivision levels */
+	stack_cache_hash_add_int(&hash, scene->r.mode & R_SIMPLIFY);
+	stack_cache_hash_add_int(&hash, scene->r.simplify_subsurf);
+#ifdef WITH_OPENSUBDIV
+	stack_cache_hash_add_int(&hash, U.opensubdiv_compute_type);
+#endif
+
+	stack_cache_hash_add_int(&hash, me->flag);
+	stack_cache_hash_add(&hash, &me->smoothresh, sizeof(me->smoothresh));
+	stack_cache_hash_add(&hash, me->loc, sizeof(me->loc));
+	stack_cache_hash_add(&hash, me->size, sizeof(me->size));
+
+	if (!stack_cache_hash_customdata(&hash, &me->vdata, me->totvert) ||
+	    !stack_cache_hash_customdata(&hash, &me->edata, me->totedge) ||
+	    !stack_cache_hash_customdata(&hash, &me->fdata, me->totface) ||
+	    !stack_cache_hash_customdata(&hash, &me->ldata, me->totloop) ||
+	    !stack_cache_hash_customdata(&hash, &me->pdata, me->totpoly))
+	{
+		return 0;
+	}
+
+	if (me->key) {
+		stack_cache_hash_key(&hash, me->key);
+	}
+
+	return stack_cache_hash_end(&hash);
+}
+
+static uint64_t stack_cache_modifier_settings(ModifierData *md)
+{
+	const ModifierTypeInfo *mti = modifierType_getInfo(md->type);
+	StackCacheHash hash;
+
+	stack_cache_hash_init(&hash);
+	stack_cache_hash_add_int(&hash, md->type);
+	stack_cache_hash_add_int(&hash, md->mode);
+
+	/* Runtime data stored after the ModifierData header is hashed as well,
+	 * this can cause a cache miss after it changes but never a wrong result. */
+	stack_cache_hash_add(&hash, (const char *)md + sizeof(ModifierData), (size_t)mti->structSize - sizeof(ModifierData));
+
+	return stack_cache_hash_end(&hash);
+}
+
+static void stack_cache_id_walk(void *userData, Object *UNUSED(ob), ID **idpoin, int UNUSED(cd_flag))
+{
+	if (*idpoin) {
+		*((bool *)userData) = true;
+	}
+}
+
+/* can the result of the modifier be identified by its settings and input only */
+static bool stack_cache_modifier_is_supported(Object *ob, ModifierData *md)
+{
+	const ModifierTypeInfo *mti = modifierType_getInfo(md->type);
+	bool uses_id = false;
+
+	/* simulations, and modifiers storing their result for other parts of blender */
+	if ((mti->flags & eModifierTypeFlag_UsesPointCache) ||
+	    ELEM(md->type, eModifierType_ParticleSystem, eModifierType_Multires))
+	{
+		return false;
+	}
+
+#ifdef WITH_OPENSUBDIV
+	/* the result may only exist on the GPU */
+	if (md->type == eModifierType_Subsurf && ((SubsurfModifierData *)md)->use_opensubdiv) {
+		return false;
+	}
+#endif
+
+	if (modifier_dependsOnTime(md)) {
+		return false;
+	}
+
+	if (mti->foreachIDLink) {
+		mti->foreachIDLink(md, ob, stack_cache_id_walk, &uses_id);
+	}
+	else if (mti->foreachObjectLink) {
+		mti->foreachObjectLink(md, ob, (ObjectWalkFunc)stack_cache_id_walk, &uses_id);
+	}
+
+	return !uses_id;
+}
+
+static void stack_cache_free_dm(ModifierStackCache *cache)
+{
+	if (cache->dm) {
+		cache->dm->needsFree = 1;
+		cache->dm->release(cache->dm);
+		cache->dm = NULL;
+	}
+	cache->md = NULL;
+	cache->index = -1;
+	cache->key = 0;
+}
+
+void mesh_modifier_stack_cache_free(Object *ob)
+{
+	ModifierStackCache *cache = ob->modifier_stack_cache;
+
+	if (cache) {
+		stack_cache_free_dm(cache);
+		MEM_SAFE_FREE(cache->settings);
+		MEM_freeN(cache);
+		ob->modifier_stack_cache = NULL;
+	}
+}
+
+/**
+ * Called when settings of \a md changed that aren't stored in the modifier itself,
+ * like curve mappings. The cached result is freed if it depends on the modifier.
+ */
+void mesh_modifier_stack_cache_tag(Object *ob, ModifierData *md)
+{
+	ModifierStackCache *cache = ob->modifier_stack_cache;
+	ModifierData *md_iter;
+
+	if (cache == NULL || cache->dm == NULL) {
+		return;
+	}
+
+	/* the input of the modifier itself is still valid */
+	if (md == cache->md) {
+		return;
+	}
+
+	for (md_iter = md; md_iter; md_iter = md_iter->next) {
+		if (md_iter == cache->md) {
+			break;
+		}
+	}
+
+	/* stored after the modifier, or at the end of the stack */
+	if (md_iter || cache->md == NULL) {
+		stack_cache_free_dm(cache);
+	}
+}
+
+/**
+ * Finds the position to continue the evaluation from and the position to store,
+ * state->keys has to be freed with #stack_cache_end.
+ */
+static void stack_cache_begin(
+        Scene *scene, Object *ob, ModifierData *firstmd, CDMaskLink *datamasks, const int required_mode,
+        CustomDataMask dataMask, const bool need_mapping, const bool build_shapekey_layers,
+        ModifierApplyFlag app_flags,
+        StackCacheState *state)
+{
+	ModifierStackCache *cache = ob->modifier_stack_cache;
+	ModifierData *md;
+	CDMaskLink *curr;
+	uint64_t *settings;
+	int len = 0, changed = -1, i;
+
+	state->cache = NULL;
+	state->keys = NULL;
+	state->resume_index = -1;
+	state->store_index = -1;
+
+	for (md = firstmd; md; md = md->next) {
+		len++;
+	}
+
+	if (len == 0) {
+		mesh_modifier_stack_cache_free(ob);
+		return;
+	}
+
+	if (cache == NULL) {
+		cache = ob->modifier_stack_cache = MEM_callocN(sizeof(*cache), __func__);
+		cache->index = -1;
+	}
+
+	/* the first modifier with different settings than in the last evaluation */
+	settings = MEM_mallocN(sizeof(*settings) * (size_t)len, __func__);
+	for (md = firstmd, i = 0; md; md = md->next, i++) {
+		settings[i] = stack_cache_modifier_settings(md);
+
+		if (changed == -1 && (i >= cache->settings_len || settings[i] != cache->settings[i])) {
+			changed = i;
+		}
+	}
+	if (changed == -1 && len < cache->settings_len) {
+		changed = len;
+	}
+
+	MEM_SAFE_FREE(cache->settings);
+	cache->settings = settings;
+	cache->settings_len = len;
+
+	/* avoid hashing the mesh when there is nothing to restore or store */
+	if (cache->dm == NULL && changed == -1) {
+		return;
+	}
+
+	state->cache = cache;
+	state->keys = MEM_mallocN(sizeof(*state->keys) * (size_t)(len + 1), __func__);
+	state->keys[0] = stack_cache_base_key(scene, ob, dataMask, need_mapping, build_shapekey_layers, app_flags);
+
+	for (md = firstmd, curr = datamasks, i = 0; md; md = md->next, curr = curr->next, i++) {
+		uint64_t key = 0;
+
+		if (state->keys[i] != 0 &&
+		    (!modifier_isEnabled(scene, md, required_mode) || stack_cache_modifier_is_supported(ob, md)))
+		{
+			StackCacheHash hash;
+
+			stack_cache_hash_init(&hash);
+			stack_cache_hash_add(&hash, &state->keys[i], sizeof(state->keys[i]));
+			stack_cache_hash_add(&hash, &settings[i], sizeof(settings[i]));
+			stack_cache_hash_add(&hash, &curr->mask, sizeof(curr->mask));
+			key = stack_cache_hash_end(&hash);
+		}
+
+		state->keys[i + 1] = key;
+	}
+
+	if (cache->dm) {
+		if (cache->index <= len && cache->key != 0 && state->keys[cache->index] == cache->key) {
+			state->resume_index = cache->index;
+		}
+		else {
+			stack_cache_free_dm(cache);
+		}
+	}
+
+	if (changed != -1 && changed != state->resume_index && state->keys[changed] != 0) {
+		state->store_index = changed;
+	}
+}
+
+/**
+ * Store a copy of the input of the modifier at stack position \a index,
+ * \a md is NULL for the end of the stack.
+ */
+static void stack_cache_store(StackCacheState *state, int index, ModifierData *md, DerivedMesh *dm)
+{
+	ModifierStackCache *cache = state->cache;
+
+	BLI_assert(index == state->store_index);
+
+	stack_cache_free_dm(cache);
+
+	cache->dm = CDDM_copy(dm);
+	cache->md = md;
+	cache->key = state->keys[index];
+	cache->index = index;
+
+	state->store_index = -1;
+}
+
+static void stack_cache_end(StackCacheState *state)
+{
+	MEM_SAFE_FREE(state->keys);
+}
+
+/** \} */
+
 /**
  * new value for useDeform -1  (hack for the gameengine):
  *
@@ -1709,7 +2137,7 @@ static void mesh_calc_modifiers(
         DerivedMesh **r_deform, DerivedMesh **r_final)
 {
 	Mesh *me = ob->data;
-	ModifierData *firstmd, *md, *previewmd = NULL;
+	ModifierData *firstmd, *md, *tmd, *previewmd = NULL;
 	CDMaskLink *datamasks, *curr;
 	/* XXX Always copying POLYINDEX, else tessellated data are no more valid! */
 	CustomDataMask mask, nextmask, previewmask = 0, append_mask = CD_MASK_ORIGINDEX;
@@ -1744,6 +2172,11 @@ static void mesh_calc_modifiers(
 	ModifierApplyFlag app_flags = useRenderParams ? MOD_APPLY_RENDER : 0;
 	ModifierApplyFlag deform_app_flags = app_flags;
 
+	/* only the viewport evaluation in object mode uses the stack cache */
+	const bool use_stack_cache = (useCache && !useRenderParams && useDeform == 1 && index == -1 &&
+	                              inputVertexCos == NULL && !sculpt_mode && !do_init_wmcol);
+	StackCacheState stack_cache = {NULL};
+	int md_index;
 
 	if (useCache)
 		app_flags |= MOD_APPLY_USECACHE;
@@ -1764,8 +2197,6 @@ static void mesh_calc_modifiers(
 
 	md = firstmd;
 
-	modifiers_clearErrors(ob);
-
 	if (do_mod_wmcol || do_mod_mcol) {
 		/* Find the last active modifier generating a preview, or NULL if none. */
 		/* XXX Currently, DPaint modifier just ignores this.
@@ -1784,6 +2215,26 @@ static void mesh_calc_modifiers(
 	datamasks = modifiers_calcDataMasks(scene, ob, md, dataMask, required_mode, previewmd, previewmask);
 	curr = datamasks;
 
+	if (use_stack_cache) {
+		stack_cache_begin(
+		        scene, ob, firstmd, datamasks, required_mode, dataMask, need_mapping, build_shapekey_layers,
+		        app_flags, &stack_cache);
+	}
+
+	if (stack_cache.resume_index == -1) {
+		modifiers_clearErrors(ob);
+	}
+	else {
+		/* keep the errors of the modifiers that are not evaluated again */
+		for (md = firstmd, md_index = 0; md; md = md->next, md_index++) {
+			if (md_index >= stack_cache.resume_index && md->error) {
+				MEM_freeN(md->error);
+				md->error = NULL;
+			}
+		}
+		md = firstmd;
+	}
+
 	if (r_deform) {
 		*r_deform = NULL;
 	}
@@ -1853,9 +2304,34 @@ static void mesh_calc_modifiers(
 	orcodm = NULL;
 	clothorcodm = NULL;
 
-	for (; md; md = md->next, curr = curr->next) {
+	md_index = 0;
+	for (tmd = firstmd; tmd != md; tmd = tmd->next) {
+		md_index++;
+	}
+
+	if (stack_cache.resume_index > md_index) {
+		/* continue from the cached input of the first modifier that needs to be evaluated again */
+		if (deformedVerts) {
+			MEM_freeN(deformedVerts);
+			deformedVerts = NULL;
+		}
+
+		dm = CDDM_copy(stack_cache.cache->dm);
+
+		for (; md_index < stack_cache.resume_index; md = md->next, curr = curr->next, md_index++) {
+			md->scene = scene;
+		}
+	}
+
+	for (; md; md = md->next, curr = curr->next, md_index++) {
 		const ModifierTypeInfo *mti = modifierType_getInfo(md->type);
 
+		if (md_index == stack_cache.store_index && dm && !deformedVerts && !orcodm && !clothorcodm &&
+		    append_mask == CD_MASK_ORIGINDEX)
+		{
+			stack_cache_store(&stack_cache, md_index, md, dm);
+		}
+
 		md->scene = scene;
 
 		if (!modifier_isEnabled(scene, md, required_mode)) {
@@ -2111,6 +2587,13 @@ static void mesh_calc_modifiers(
 		}
 	}
 
+	if (md == NULL && md_index == stack_cache.store_index && dm && !deformedVerts && !orcodm && !clothorcodm &&
+	    append_mask == CD_MASK_ORIGINDEX)
+	{
+		stack_cache_store(&stack_cache, md_index, NULL, dm);
+	}
+	stack_cache_end(&stack_cache);
+
 	for (md = firstmd; md; md = md->next)
 		modifier_freeTemporaryData(md);
 
@@ -2260,6 +2260,84 @@ void CustomData_copy_data(const CustomData *source, CustomData *dest,
 	}
 }
 
+/* Gather \a count elements of a layer without copy callback, the size being a constant
+ * lets the compiler turn memcpy into plain (vectorized) loads and stores. */
+#define CUSTOMDATA_GATHER(_size) \
+	for (i = 0; i < count; i++) { \
+		memcpy(POINTER_OFFSET(dst_data, (size_t)i * (_size)), \
+		       POINTER_OFFSET(src_data, (size_t)src_indices[i] * (_size)), (_size)); \
+	} (void)0
+
+static void CustomData_copy_data_indices_layer(
+        const CustomData *source, CustomData *dest,
+        int src_i, int dst_i,
+        const int *src_indices, int dst_index, int count)
+{
+	const LayerTypeInfo *typeInfo = layerType_getInfo(source->layers[src_i].type);
+	const size_t size = (size_t)typeInfo->size;
+	const void *src_data = source->layers[src_i].data;
+	void *dst_data = dest->layers[dst_i].data;
+	int i;
+
+	if (!count || !src_data || !dst_data) {
+		return;
+	}
+
+	dst_data = POINTER_OFFSET(dst_data, (size_t)dst_index * size);
+
+	if (typeInfo->copy) {
+		for (i = 0; i < count; i++) {
+			typeInfo->copy(POINTER_OFFSET(src_data, (size_t)src_indices[i] * size),
+			               POINTER_OFFSET(dst_data, (size_t)i * size), 1);
+		}
+		return;
+	}
+
+	switch (size) {
+		case 2:  CUSTOMDATA_GATHER(2); break;
+		case 4:  CUSTOMDATA_GATHER(4); break;
+		case 8:  CUSTOMDATA_GATHER(8); break;
+		case 12: CUSTOMDATA_GATHER(12); break;
+		case 16: CUSTOMDATA_GATHER(16); break;
+		default: CUSTOMDATA_GATHER(size); break;
+	}
+}
+
+#undef CUSTOMDATA_GATHER
+
+/**
+ * Copy \a count elements of \a source to consecutive elements of \a dest, starting at \a dest_index:
+ * dest[dest_index + i] = source[src_indices[i]].
+ *
+ * Same as calling #CustomData_copy_data for each element, but the layers are only looked up once.
+ */
+void CustomData_copy_data_indices(const CustomData *source, CustomData *dest,
+                                  const int *src_indices, int dest_index, int count)
+{
+	int src_i, dest_i;
+
+	/* copies a layer at a time */
+	dest_i = 0;
+	for (src_i = 0; src_i < source->totlayer; ++src_i) {
+
+		/* find the first dest layer with type >= the source type
+		 * (this should work because layers are ordered by type)
+		 */
+		while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+			dest_i++;
+		}
+
+		/* if there are no more dest layers, we're done */
+		if (dest_i >= dest->totlayer) return;
+
+		/* if we found a matching layer, copy the data */
+		if (dest->layers[dest_i].type == source->layers[src_i].type) {
+			CustomData_copy_data_indices_layer(source, dest, src_i, dest_i, src_indices, dest_index, count);
+			dest_i++;
+		}
+	}
+}
+
 void CustomData_free_elem(CustomData *data, int index, int count)
 {
 	int i;
@@ -2333,6 +2411,137 @@ void CustomData_interp(const CustomData *source, CustomData *dest,
 	if (count > SOURCE_BUF_SIZE) MEM_freeN((void *)sources);
 }
 
+/* Weighted sum of float layers (e.g. bevel weights or shape keys), for each destination element. */
+static void customdata_interp_range_float(
+        const void **sources, const float *weights, int count,
+        float *dest, int dest_count, const int size)
+{
+	int i, j, k;
+
+	for (i = 0; i < dest_count; i++, dest += size) {
+		const float *weight = weights ? &weights[i * count] : NULL;
+		float value[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+
+		for (j = 0; j < count; j++) {
+			const float *src = sources[j];
+			const float w = weight ? weight[j] : 1.0f;
+			for (k = 0; k < size; k++) {
+				value[k] += src[k] * w;
+			}
+		}
+
+		/* delay writing to the destination incase dest is in sources */
+		for (k = 0; k < size; k++) {
+			dest[k] = value[k];
+		}
+	}
+}
+
+/* Same as layerInterp_mloopuv, for each destination element. */
+static void customdata_interp_range_mloopuv(
+        const void **sources, const float *weights, int count,
+        MLoopUV *dest, int dest_count)
+{
+	int i, j;
+
+	for (i = 0; i < dest_count; i++, dest++) {
+		const float *weight = weights ? &weights[i * count] : NULL;
+		float uv[2] = {0.0f, 0.0f};
+		int flag = 0;
+
+		for (j = 0; j < count; j++) {
+			const MLoopUV *src = sources[j];
+			const float w = weight ? weight[j] : 1.0f;
+			madd_v2_v2fl(uv, src->uv, w);
+			if (w > 0.0f) {
+				flag |= src->flag;
+			}
+		}
+
+		copy_v2_v2(dest->uv, uv);
+		dest->flag = flag;
+	}
+}
+
+/**
+ * Interpolate \a dest_count consecutive elements of \a dest, starting at \a dest_index,
+ * all of them from the same \a count elements of \a source.
+ * \a weights holds \a count weights for each destination element (all 1's when NULL).
+ *
+ * Same as calling #CustomData_interp for each element (without sub-weights),
+ * but the layers are only looked up once and common float layers don't go through their interp callback.
+ */
+void CustomData_interp_range(const CustomData *source, CustomData *dest,
+                             const int *src_indices, const float *weights,
+                             int count, int dest_index, int dest_count)
+{
+	int src_i, dest_i;
+	int i, j;
+	const void *source_buf[SOURCE_BUF_SIZE];
+	const void **sources = source_buf;
+
+	if (dest_count <= 0) {
+		return;
+	}
+
+	/* slow fallback in case we're interpolating a ridiculous number of
+	 * elements
+	 */
+	if (count > SOURCE_BUF_SIZE)
+		sources = MEM_mallocN(sizeof(*sources) * count, __func__);
+
+	/* interpolates a layer at a time */
+	dest_i = 0;
+	for (src_i = 0; src_i < source->totlayer; ++src_i) {
+		const LayerTypeInfo *typeInfo = layerType_getInfo(source->layers[src_i].type);
+		if (!typeInfo->interp) continue;
+
+		/* find the first dest layer with type >= the source type
+		 * (this should work because layers are ordered by type)
+		 */
+		while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+			dest_i++;
+		}
+
+		/* if there are no more dest layers, we're done */
+		if (dest_i >= dest->totlayer) break;
+
+		/* if we found a matching layer, copy the data */
+		if (dest->layers[dest_i].type == source->layers[src_i].type) {
+			void *src_data = source->layers[src_i].data;
+			void *dst_data = POINTER_OFFSET(dest->layers[dest_i].data, dest_index * typeInfo->size);
+
+			for (j = 0; j < count; ++j) {
+				sources[j] = POINTER_OFFSET(src_data, src_indices[j] * typeInfo->size);
+			}
+
+			if (typeInfo->interp == layerInterp_bweight) {
+				customdata_interp_range_float(sources, weights, count, dst_data, dest_count, 1);
+			}
+			else if (typeInfo->interp == layerInterp_shapekey) {
+				customdata_interp_range_float(sources, weights, count, dst_data, dest_count, 3);
+			}
+			else if (typeInfo->interp == layerInterp_mloopuv) {
+				customdata_interp_range_mloopuv(sources, weights, count, dst_data, dest_count);
+			}
+			else {
+				for (i = 0; i < dest_count; i++) {
+					typeInfo->interp(sources, weights ? &weights[i * count] : NULL, NULL, count,
+					                 POINTER_OFFSET(dst_data, i * typeInfo->size));
+				}
+			}
+
+			/* if there are multiple source & dest layers of the same type,
+			 * we don't want to copy all source layers to the same dest, so
+			 * increment dest_i
+			 */
+			dest_i++;
+		}
+	}
+
+	if (count > SOURCE_BUF_SIZE) MEM_freeN((void *)sources);
+}
+
 /**
  * Swap data inside each item, for all layers.
  * This only applies to item types that may store several sub-item data (e.g. corner data [UVs, VCol, ...] of
@@ -2848,7 +3057,7 @@ void CustomData_bmesh_free_block_data(CustomData *data, void *block)
 		memset(block, 0, data->totsize);
 }
 
-static void CustomData_bmesh_alloc_block(CustomData *data, void **block)
+void CustomData_bmesh_alloc_block(CustomData *data, void **block)
 {
 
 	if (*block)
@@ -3311,6 +3520,127 @@ void CustomData_from_bmesh_block(const CustomData *source, CustomData *dest,
 
 }
 
+/**
+ * Same as #CustomData_to_bmesh_block for \a count consecutive source elements, starting at \a src_index,
+ * but the layers are only looked up once.
+ *
+ * \param dest_blocks: The blocks of the destination elements, which must already be allocated.
+ */
+void CustomData_to_bmesh_block_range(const CustomData *source, CustomData *dest,
+                                     int src_index, void **dest_blocks, int count, bool use_default_init)
+{
+	const LayerTypeInfo *typeInfo;
+	int dest_i, src_i, i;
+
+	/* copies a layer at a time */
+	dest_i = 0;
+	for (src_i = 0; src_i < source->totlayer; ++src_i) {
+
+		/* find the first dest layer with type >= the source type
+		 * (this should work because layers are ordered by type)
+		 */
+		while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+			if (use_default_init) {
+				for (i = 0; i < count; i++) {
+					CustomData_bmesh_set_default_n(dest, &dest_blocks[i], dest_i);
+				}
+			}
+			dest_i++;
+		}
+
+		/* if there are no more dest layers, we're done */
+		if (dest_i >= dest->totlayer) break;
+
+		/* if we found a matching layer, copy the data */
+		if (dest->layers[dest_i].type == source->layers[src_i].type) {
+			const int offset = dest->layers[dest_i].offset;
+			const void *src_data;
+			size_t size;
+
+			typeInfo = layerType_getInfo(dest->layers[dest_i].type);
+			size = (size_t)typeInfo->size;
+			src_data = POINTER_OFFSET(source->layers[src_i].data, (size_t)src_index * size);
+
+			if (typeInfo->copy) {
+				for (i = 0; i < count; i++) {
+					typeInfo->copy(POINTER_OFFSET(src_data, (size_t)i * size),
+					               POINTER_OFFSET(dest_blocks[i], offset), 1);
+				}
+			}
+			else {
+				for (i = 0; i < count; i++) {
+					memcpy(POINTER_OFFSET(dest_blocks[i], offset), POINTER_OFFSET(src_data, (size_t)i * size), size);
+				}
+			}
+
+			/* if there are multiple source & dest layers of the same type,
+			 * we don't want to copy all source layers to the same dest, so
+			 * increment dest_i
+			 */
+			dest_i++;
+		}
+	}
+
+	if (use_default_init) {
+		while (dest_i < dest->totlayer) {
+			for (i = 0; i < count; i++) {
+				CustomData_bmesh_set_default_n(dest, &dest_blocks[i], dest_i);
+			}
+			dest_i++;
+		}
+	}
+}
+
+/**
+ * Same as #CustomData_from_bmesh_block for \a count consecutive destination elements,
+ * starting at \a dest_index, but the layers are only looked up once.
+ */
+void CustomData_from_bmesh_block_range(const CustomData *source, CustomData *dest,
+                                       void **src_blocks, int dest_index, int count)
+{
+	int dest_i, src_i, i;
+
+	/* copies a layer at a time */
+	dest_i = 0;
+	for (src_i = 0; src_i < source->totlayer; ++src_i) {
+
+		/* find the first dest layer with type >= the source type
+		 * (this should work because layers are ordered by type)
+		 */
+		while (dest_i < dest->totlayer && dest->layers[dest_i].type < source->layers[src_i].type) {
+			dest_i++;
+		}
+
+		/* if there are no more dest layers, we're done */
+		if (dest_i >= dest->totlayer) return;
+
+		/* if we found a matching layer, copy the data */
+		if (dest->layers[dest_i].type == source->layers[src_i].type) {
+			const LayerTypeInfo *typeInfo = layerType_getInfo(dest->layers[dest_i].type);
+			const int offset = source->layers[src_i].offset;
+			const size_t size = (size_t)typeInfo->size;
+			void *dst_data = POINTER_OFFSET(dest->layers[dest_i].data, (size_t)dest_index * size);
+
+			if (typeInfo->copy) {
+				for (i = 0; i < count; i++) {
+					typeInfo->copy(POINTER_OFFSET(src_blocks[i], offset), POINTER_OFFSET(dst_data, (size_t)i * size), 1);
+				}
+			}
+			else {
+				for (i = 0; i < count; i++) {
+					memcpy(POINTER_OFFSET(dst_data, (size_t)i * size), POINTER_OFFSET(src_blocks[i], offset), size);
+				}
+			}
+
+			/* if there are multiple source & dest layers of the same type,
+			 * we don't want to copy all source layers to the same dest, so
+			 * increment dest_i
+			 */
+			dest_i++;
+		}
+	}
+}
+
 void CustomData_file_write_info(int type, const char **structname, int *structnum)
 {
 	const LayerTypeInfo *typeInfo = layerType_getInfo(type);
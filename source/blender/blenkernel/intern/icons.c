@@ -389,7 +389,7 @@ void BKE_previewimg_ensure(PreviewImage *prv, const int size)
 						icon_w = icon_h = ICON_RENDER_DEFAULT_HEIGHT;
 					}
 
-					IMB_scaleImBuf(thumb, icon_w, icon_h);
+					IMB_scaleImBuf_filter(thumb, icon_w, icon_h, IMB_SCALE_FILTER_MITCHELL);
 					prv->w[ICON_SIZE_ICON] = icon_w;
 					prv->h[ICON_SIZE_ICON] = icon_h;
 					prv->rect[ICON_SIZE_ICON] = MEM_dupallocN(thumb->rect);
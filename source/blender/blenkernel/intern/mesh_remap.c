@@ -105,6 +105,66 @@ static bool mesh_remap_bvhtree_query_raycast(
 	}
 }
 
+/**
+ * Same as #mesh_remap_bvhtree_query_raycast for all the vertices of \a verts_dst, done in parallel by the tree.
+ * \a r_rayhits must have room for twice \a numverts, the hits along the normals are followed by the hits
+ * in the other direction, use #mesh_remap_bvhtree_raycast_batch_result to read them.
+ */
+static void mesh_remap_bvhtree_query_raycast_batch(
+        BVHTreeFromMesh *treedata, BVHTreeRayHit *r_rayhits,
+        const MVert *verts_dst, const int numverts, const SpaceTransform *space_transform,
+        const float radius, const float max_dist)
+{
+	float (*cos)[3] = MEM_mallocN(sizeof(*cos) * (size_t)numverts, __func__);
+	float (*nos)[3] = MEM_mallocN(sizeof(*nos) * (size_t)numverts * 2, __func__);
+	float (*inv_nos)[3] = &nos[numverts];
+	int i;
+
+	for (i = 0; i < numverts; i++) {
+		copy_v3_v3(cos[i], verts_dst[i].co);
+		normal_short_to_float_v3(nos[i], verts_dst[i].no);
+
+		/* Convert the vertex to tree coordinates, if needed. */
+		if (space_transform) {
+			BLI_space_transform_apply(space_transform, cos[i]);
+			BLI_space_transform_apply_normal(space_transform, nos[i]);
+		}
+		negate_v3_v3(inv_nos[i], nos[i]);
+
+		r_rayhits[i].index = r_rayhits[i + numverts].index = -1;
+		r_rayhits[i].dist = r_rayhits[i + numverts].dist = max_dist;
+	}
+
+	BLI_bvhtree_ray_cast_batch(
+	        treedata->tree, (const float (*)[3])cos, (const float (*)[3])nos, numverts, radius,
+	        r_rayhits, treedata->raycast_callback, treedata, BVH_RAYCAST_DEFAULT);
+	/* Also cast in the other direction! */
+	BLI_bvhtree_ray_cast_batch(
+	        treedata->tree, (const float (*)[3])cos, (const float (*)[3])inv_nos, numverts, radius,
+	        &r_rayhits[numverts], treedata->raycast_callback, treedata, BVH_RAYCAST_DEFAULT);
+
+	MEM_freeN(cos);
+	MEM_freeN(nos);
+}
+
+static bool mesh_remap_bvhtree_raycast_batch_result(
+        const BVHTreeRayHit *rayhits, const int numverts, const int index, const float max_dist,
+        BVHTreeRayHit *r_rayhit, float *r_hit_dist)
+{
+	const BVHTreeRayHit *rayhit = &rayhits[index];
+	const BVHTreeRayHit *rayhit_inv = &rayhits[index + numverts];
+
+	*r_rayhit = (rayhit_inv->dist < rayhit->dist) ? *rayhit_inv : *rayhit;
+
+	if ((r_rayhit->index != -1) && (r_rayhit->dist <= max_dist)) {
+		*r_hit_dist = r_rayhit->dist;
+		return true;
+	}
+	else {
+		return false;
+	}
+}
+
 /** \} */
 
 /**
@@ -457,7 +517,7 @@ void BKE_mesh_remap_calc_verts_from_dm(
 		BVHTreeNearest nearest = {0};
 		BVHTreeRayHit rayhit = {0};
 		float hit_dist;
-		float tmp_co[3], tmp_no[3];
+		float tmp_co[3];
 
 		if (mode == MREMAP_MODE_VERT_NEAREST) {
 			bvhtree_from_mesh_verts(&treedata, dm_src, 0.0f, 2, 6);
@@ -546,19 +606,13 @@ void BKE_mesh_remap_calc_verts_from_dm(
 			bvhtree_from_mesh_looptri(&treedata, dm_src, (mode & MREMAP_USE_NORPROJ) ? ray_radius : 0.0f, 2, 6);
 
 			if (mode == MREMAP_MODE_VERT_POLYINTERP_VNORPROJ) {
-				for (i = 0; i < numverts_dst; i++) {
-					copy_v3_v3(tmp_co, verts_dst[i].co);
-					normal_short_to_float_v3(tmp_no, verts_dst[i].no);
+				BVHTreeRayHit *rayhits = MEM_mallocN(sizeof(*rayhits) * (size_t)numverts_dst * 2, __func__);
 
-					/* Convert the vertex to tree coordinates, if needed. */
-					if (space_transform) {
-						BLI_space_transform_apply(space_transform, tmp_co);
-						BLI_space_transform_apply_normal(space_transform, tmp_no);
-					}
+				mesh_remap_bvhtree_query_raycast_batch(
+				        &treedata, rayhits, verts_dst, numverts_dst, space_transform, ray_radius, max_dist);
 
-					if (mesh_remap_bvhtree_query_raycast(
-					        &treedata, &rayhit, tmp_co, tmp_no, ray_radius, max_dist, &hit_dist))
-					{
+				for (i = 0; i < numverts_dst; i++) {
+					if (mesh_remap_bvhtree_raycast_batch_result(rayhits, numverts_dst, i, max_dist, &rayhit, &hit_dist)) {
 						const MLoopTri *lt = &treedata.looptri[rayhit.index];
 						MPoly *mp_src = &polys_src[lt->poly];
 						const int sources_num = mesh_remap_interp_poly_data_get(
@@ -572,6 +626,8 @@ void BKE_mesh_remap_calc_verts_from_dm(
 						BKE_mesh_remap_item_define_invalid(r_map, i);
 					}
 				}
+
+				MEM_freeN(rayhits);
 			}
 			else {
 				nearest.index = -1;
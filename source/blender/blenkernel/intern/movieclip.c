@@ -59,6 +59,8 @@
 #include "BLI_math.h"
 #include "BLI_threads.h"
 
+#include "PIL_time.h"
+
 #include "BKE_animsys.h"
 #include "BKE_colortools.h"
 #include "BKE_library.h"
@@ -262,7 +264,7 @@ static void movieclip_open_anim_file(MovieClip *clip)
 		BLI_path_abs(str, ID_BLEND_PATH(G.main, &clip->id));
 
 		/* FIXME: make several stream accessible in image editor, too */
-		clip->anim = openanim(str, IB_rect, 0, clip->colorspace_settings.name);
+		clip->anim = openanim(str, IB_rect | IB_animdecoderpool, 0, clip->colorspace_settings.name);
 
 		if (clip->anim) {
 			if (clip->flag & MCLIP_USE_PROXY_CUSTOM_DIR) {
@@ -511,11 +513,13 @@ static bool has_imbuf_cache(MovieClip *clip, MovieClipUser *user, int flag)
 	return false;
 }
 
+/* cost is the time in seconds it took to read the frame */
 static bool put_imbuf_cache(MovieClip *clip,
                             const MovieClipUser *user,
                             ImBuf *ibuf,
                             int flag,
-                            bool destructive)
+                            bool destructive,
+                            float cost)
 {
 	MovieClipImBufCacheKey key;
 
@@ -564,11 +568,11 @@ static bool put_imbuf_cache(MovieClip *clip,
 	}
 
 	if (destructive) {
-		IMB_moviecache_put(clip->cache->moviecache, &key, ibuf);
+		IMB_moviecache_put_ex(clip->cache->moviecache, &key, ibuf, cost);
 		return true;
 	}
 	else {
-		return IMB_moviecache_put_if_possible(clip->cache->moviecache, &key, ibuf);
+		return IMB_moviecache_put_if_possible(clip->cache->moviecache, &key, ibuf, cost);
 	}
 }
 
@@ -939,6 +943,7 @@ static ImBuf *movieclip_get_postprocessed_ibuf(MovieClip *clip,
 
 	if (!ibuf) {
 		bool use_sequence = false;
+		const double start_time = PIL_check_seconds_timer();
 
 		/* undistorted proxies for movies should be read as image sequence */
 		use_sequence = (user->render_flag & MCLIP_PROXY_RENDER_UNDISTORT) &&
@@ -955,7 +960,7 @@ static ImBuf *movieclip_get_postprocessed_ibuf(MovieClip *clip,
 		}
 
 		if (ibuf && (cache_flag & MOVIECLIP_CACHE_SKIP) == 0) {
-			put_imbuf_cache(clip, user, ibuf, flag, true);
+			put_imbuf_cache(clip, user, ibuf, flag, true, (float)(PIL_check_seconds_timer() - start_time));
 		}
 	}
 
@@ -1613,13 +1618,26 @@ bool BKE_movieclip_has_cached_frame(MovieClip *clip, MovieClipUser *user)
 
 bool BKE_movieclip_put_frame_if_possible(MovieClip *clip,
                                          MovieClipUser *user,
-                                         ImBuf *ibuf)
+                                         ImBuf *ibuf,
+                                         float cost)
 {
 	bool result;
 
 	BLI_lock_thread(LOCK_MOVIECLIP);
-	result = put_imbuf_cache(clip, user, ibuf, clip->flag, false);
+	result = put_imbuf_cache(clip, user, ibuf, clip->flag, false, cost);
 	BLI_unlock_thread(LOCK_MOVIECLIP);
 
 	return result;
 }
+
+void BKE_movieclip_cache_get_stats(MovieClip *clip, MovieCacheStats *r_stats)
+{
+	BLI_lock_thread(LOCK_MOVIECLIP);
+	if (clip->cache) {
+		IMB_moviecache_get_stats(clip->cache->moviecache, r_stats);
+	}
+	else {
+		memset(r_stats, 0, sizeof(*r_stats));
+	}
+	BLI_unlock_thread(LOCK_MOVIECLIP);
+}
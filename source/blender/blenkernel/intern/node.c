@@ -3156,6 +3156,7 @@ void nodeUpdate(bNodeTree *ntree, bNode *node)
 	
 	/* clear update flag */
 	node->update = 0;
+	node->update_stamp++;
 	
 	ntree->is_updating = false;
 }
@@ -3181,6 +3182,7 @@ bool nodeUpdateID(bNodeTree *ntree, ID *id)
 				node->typeinfo->updatefunc(ntree, node);
 			/* clear update flag */
 			node->update = 0;
+			node->update_stamp++;
 		}
 	}
 	
@@ -214,6 +214,7 @@ void BKE_object_free_modifiers(Object *ob)
 
 	/* modifiers may have stored data in the DM cache */
 	BKE_object_free_derived_caches(ob);
+	mesh_modifier_stack_cache_free(ob);
 }
 
 void BKE_object_modifier_hook_reset(Object *ob, HookModifierData *hmd)
@@ -379,6 +380,9 @@ void BKE_object_free_caches(Object *object)
 		}
 	}
 
+	/* Intermediate result of the modifier stack, only used to speed up re-evaluation. */
+	mesh_modifier_stack_cache_free(object);
+
 	/* Tag object for update, so once memory critical operation is over and
 	 * scene update routines are back to it's business the object will be
 	 * guaranteed to be in a known state.
@@ -1563,6 +1567,7 @@ Object *BKE_object_copy_ex(Main *bmain, Object *ob, bool copy_caches)
 	
 	obn->derivedDeform = NULL;
 	obn->derivedFinal = NULL;
+	obn->modifier_stack_cache = NULL;
 
 	BLI_listbase_clear(&obn->gpulamp);
 	BLI_listbase_clear(&obn->pc_ids);
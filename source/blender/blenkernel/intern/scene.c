@@ -1926,6 +1926,11 @@ void BKE_scene_update_for_newframe_ex(EvaluationContext *eval_ctx, Main *bmain,
 #endif
 	
 	BKE_sound_set_cfra(sce->r.cfra);
+
+	/* the sequencer prefetch job reads the strips animation is about to write */
+	if (!BKE_sequencer_prefetch_supported(sce)) {
+		BKE_sequencer_prefetch_stop();
+	}
 	
 	/* clear animation overrides */
 	/* XXX TODO... */
@@ -27,6 +27,7 @@
  */
 
 #include <stddef.h>
+#include <string.h>
 
 #include "BLI_sys_types.h"  /* for intptr_t */
 
@@ -40,6 +41,7 @@
 #include "IMB_imbuf_types.h"
 
 #include "BLI_listbase.h"
+#include "BLI_threads.h"
 
 #include "BKE_sequencer.h"
 #include "BKE_scene.h"
@@ -69,7 +71,11 @@ typedef struct SeqPreprocessCache {
 static struct MovieCache *moviecache = NULL;
 static struct SeqPreprocessCache *preprocess_cache = NULL;
 
+/* strips of a stack are rendered in parallel, see seq_render_strip_stack */
+static ThreadMutex cache_lock = BLI_MUTEX_INITIALIZER;
+
 static void preprocessed_cache_destruct(void);
+static void preprocessed_cache_cleanup(void);
 
 static bool seq_cmp_render_data(const SeqRenderData *a, const SeqRenderData *b)
 {
@@ -131,12 +137,18 @@ void BKE_sequencer_cache_destruct(void)
 
 void BKE_sequencer_cache_cleanup(void)
 {
+	BKE_sequencer_prefetch_stop();
+
+	BLI_mutex_lock(&cache_lock);
+
 	if (moviecache) {
 		IMB_moviecache_free(moviecache);
 		moviecache = IMB_moviecache_create("seqcache", sizeof(SeqCacheKey), seqcache_hashhash, seqcache_hashcmp);
 	}
 
-	BKE_sequencer_preprocessed_cache_cleanup();
+	preprocessed_cache_cleanup();
+
+	BLI_mutex_unlock(&cache_lock);
 }
 
 static bool seqcache_key_check_seq(ImBuf *UNUSED(ibuf), void *userkey, void *userdata)
@@ -149,12 +161,19 @@ static bool seqcache_key_check_seq(ImBuf *UNUSED(ibuf), void *userkey, void *use
 
 void BKE_sequencer_cache_cleanup_sequence(Sequence *seq)
 {
+	BKE_sequencer_prefetch_stop();
+
+	BLI_mutex_lock(&cache_lock);
 	if (moviecache)
 		IMB_moviecache_cleanup(moviecache, seqcache_key_check_seq, seq);
+	BLI_mutex_unlock(&cache_lock);
 }
 
 struct ImBuf *BKE_sequencer_cache_get(const SeqRenderData *context, Sequence *seq, float cfra, eSeqStripElemIBuf type)
 {
+	ImBuf *ibuf = NULL;
+
+	BLI_mutex_lock(&cache_lock);
 	if (moviecache && seq) {
 		SeqCacheKey key;
 
@@ -163,13 +182,15 @@ struct ImBuf *BKE_sequencer_cache_get(const SeqRenderData *context, Sequence *se
 		key.cfra = cfra - seq->start;
 		key.type = type;
 
-		return IMB_moviecache_get(moviecache, &key);
+		ibuf = IMB_moviecache_get(moviecache, &key);
 	}
+	BLI_mutex_unlock(&cache_lock);
 
-	return NULL;
+	return ibuf;
 }
 
-void BKE_sequencer_cache_put(const SeqRenderData *context, Sequence *seq, float cfra, eSeqStripElemIBuf type, ImBuf *i)
+void BKE_sequencer_cache_put(const SeqRenderData *context, Sequence *seq, float cfra, eSeqStripElemIBuf type, ImBuf *i,
+                             float cost)
 {
 	SeqCacheKey key;
 
@@ -177,19 +198,41 @@ void BKE_sequencer_cache_put(const SeqRenderData *context, Sequence *seq, float
 		return;
 	}
 
-	if (!moviecache) {
-		moviecache = IMB_moviecache_create("seqcache", sizeof(SeqCacheKey), seqcache_hashhash, seqcache_hashcmp);
-	}
-
 	key.seq = seq;
 	key.context = *context;
 	key.cfra = cfra - seq->start;
 	key.type = type;
 
-	IMB_moviecache_put(moviecache, &key, i);
+	BLI_mutex_lock(&cache_lock);
+
+	if (!moviecache) {
+		moviecache = IMB_moviecache_create("seqcache", sizeof(SeqCacheKey), seqcache_hashhash, seqcache_hashcmp);
+	}
+
+	if (context->is_prefetch_render) {
+		/* prefetched frames never free frames which are cached already */
+		IMB_moviecache_put_if_possible(moviecache, &key, i, cost);
+	}
+	else {
+		IMB_moviecache_put_ex(moviecache, &key, i, cost);
+	}
+
+	BLI_mutex_unlock(&cache_lock);
 }
 
-void BKE_sequencer_preprocessed_cache_cleanup(void)
+void BKE_sequencer_cache_get_stats(MovieCacheStats *r_stats)
+{
+	BLI_mutex_lock(&cache_lock);
+	if (moviecache) {
+		IMB_moviecache_get_stats(moviecache, r_stats);
+	}
+	else {
+		memset(r_stats, 0, sizeof(*r_stats));
+	}
+	BLI_mutex_unlock(&cache_lock);
+}
+
+static void preprocessed_cache_cleanup(void)
 {
 	SeqPreprocessCacheElem *elem;
 
@@ -204,12 +247,19 @@ void BKE_sequencer_preprocessed_cache_cleanup(void)
 	BLI_listbase_clear(&preprocess_cache->elems);
 }
 
+void BKE_sequencer_preprocessed_cache_cleanup(void)
+{
+	BLI_mutex_lock(&cache_lock);
+	preprocessed_cache_cleanup();
+	BLI_mutex_unlock(&cache_lock);
+}
+
 static void preprocessed_cache_destruct(void)
 {
 	if (!preprocess_cache)
 		return;
 
-	BKE_sequencer_preprocessed_cache_cleanup();
+	preprocessed_cache_cleanup();
 
 	MEM_freeN(preprocess_cache);
 	preprocess_cache = NULL;
@@ -218,42 +268,36 @@ static void preprocessed_cache_destruct(void)
 ImBuf *BKE_sequencer_preprocessed_cache_get(const SeqRenderData *context, Sequence *seq, float cfra, eSeqStripElemIBuf type)
 {
 	SeqPreprocessCacheElem *elem;
+	ImBuf *ibuf = NULL;
 
-	if (!preprocess_cache)
-		return NULL;
-
-	if (preprocess_cache->cfra != cfra)
-		return NULL;
+	BLI_mutex_lock(&cache_lock);
 
-	for (elem = preprocess_cache->elems.first; elem; elem = elem->next) {
-		if (elem->seq != seq)
-			continue;
+	if (preprocess_cache && preprocess_cache->cfra == cfra) {
+		for (elem = preprocess_cache->elems.first; elem; elem = elem->next) {
+			if (elem->seq != seq)
+				continue;
 
-		if (elem->type != type)
-			continue;
+			if (elem->type != type)
+				continue;
 
-		if (seq_cmp_render_data(&elem->context, context) != 0)
-			continue;
+			if (seq_cmp_render_data(&elem->context, context) != 0)
+				continue;
 
-		IMB_refImBuf(elem->ibuf);
-		return elem->ibuf;
+			IMB_refImBuf(elem->ibuf);
+			ibuf = elem->ibuf;
+			break;
+		}
 	}
 
-	return NULL;
+	BLI_mutex_unlock(&cache_lock);
+
+	return ibuf;
 }
 
 void BKE_sequencer_preprocessed_cache_put(const SeqRenderData *context, Sequence *seq, float cfra, eSeqStripElemIBuf type, ImBuf *ibuf)
 {
 	SeqPreprocessCacheElem *elem;
 
-	if (!preprocess_cache) {
-		preprocess_cache = MEM_callocN(sizeof(SeqPreprocessCache), "sequencer preprocessed cache");
-	}
-	else {
-		if (preprocess_cache->cfra != cfra)
-			BKE_sequencer_preprocessed_cache_cleanup();
-	}
-
 	elem = MEM_callocN(sizeof(SeqPreprocessCacheElem), "sequencer preprocessed cache element");
 
 	elem->seq = seq;
@@ -261,11 +305,23 @@ void BKE_sequencer_preprocessed_cache_put(const SeqRenderData *context, Sequence
 	elem->context = *context;
 	elem->ibuf = ibuf;
 
-	preprocess_cache->cfra = cfra;
-
 	IMB_refImBuf(ibuf);
 
+	BLI_mutex_lock(&cache_lock);
+
+	if (!preprocess_cache) {
+		preprocess_cache = MEM_callocN(sizeof(SeqPreprocessCache), "sequencer preprocessed cache");
+	}
+	else {
+		if (preprocess_cache->cfra != cfra)
+			preprocessed_cache_cleanup();
+	}
+
+	preprocess_cache->cfra = cfra;
+
 	BLI_addtail(&preprocess_cache->elems, elem);
+
+	BLI_mutex_unlock(&cache_lock);
 }
 
 void BKE_sequencer_preprocessed_cache_cleanup_sequence(Sequence *seq)
@@ -275,6 +331,8 @@ void BKE_sequencer_preprocessed_cache_cleanup_sequence(Sequence *seq)
 	if (!preprocess_cache)
 		return;
 
+	BLI_mutex_lock(&cache_lock);
+
 	for (elem = preprocess_cache->elems.first; elem; elem = elem_next) {
 		elem_next = elem->next;
 
@@ -284,4 +342,6 @@ void BKE_sequencer_preprocessed_cache_cleanup_sequence(Sequence *seq)
 			BLI_freelinkN(&preprocess_cache->elems, elem);
 		}
 	}
+
+	BLI_mutex_unlock(&cache_lock);
 }
@@ -50,9 +50,12 @@
 #include "BLI_path_util.h"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
+#include "PIL_time.h"
+
 #ifdef WIN32
 #  include "BLI_winstuff.h"
 #else
@@ -78,8 +81,6 @@
 
 #include "RE_pipeline.h"
 
-#include <pthread.h>
-
 #include "IMB_imbuf.h"
 #include "IMB_imbuf_types.h"
 #include "IMB_colormanagement.h"
@@ -188,6 +189,8 @@ static void seq_free_strip(Strip *strip)
 /* only give option to skip cache locally (static func) */
 static void BKE_sequence_free_ex(Scene *scene, Sequence *seq, const bool do_cache)
 {
+	BKE_sequencer_prefetch_stop();
+
 	if (seq->strip)
 		seq_free_strip(seq->strip);
 
@@ -254,6 +257,8 @@ void BKE_sequence_free(Scene *scene, Sequence *seq)
 /* Function to free imbuf and anim data on changes */
 void BKE_sequence_free_anim(Sequence *seq)
 {
+	BKE_sequencer_prefetch_stop();
+
 	while (seq->anims.last) {
 		StripAnim *sanim = seq->anims.last;
 
@@ -564,6 +569,7 @@ void BKE_sequencer_new_render_data(
 	r_context->motion_blur_shutter = 0;
 	r_context->skip_cache = false;
 	r_context->is_proxy_render = false;
+	r_context->is_prefetch_render = false;
 	r_context->view_id = 0;
 	r_context->gpu_offscreen = NULL;
 	r_context->gpu_samples = (scene->r.mode & R_OSA) ? scene->r.osa : 0;
@@ -824,6 +830,8 @@ void BKE_sequence_reload_new_file(Scene *scene, Sequence *seq, const bool lock_r
 		return;
 	}
 
+	BKE_sequencer_prefetch_stop();
+
 	if (lock_range) {
 		/* keep so we don't have to move the actual start and end points (only the data) */
 		BKE_sequence_calc_disp(scene, seq);
@@ -1489,6 +1497,8 @@ static void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 	bool is_multiview_loaded = false;
 	Editing *ed = scene->ed;
 	const bool is_multiview = (seq->flag & SEQ_USE_VIEWS) != 0 && (scene->r.scemode & R_MULTIVIEW) != 0;
+	/* strips are scrubbed a lot, keep several decoders around for long GOP movies */
+	const int ib_flags = IB_rect | IB_animdecoderpool | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0);
 
 	if ((seq->anims.first != NULL) && (((StripAnim *)seq->anims.first)->anim != NULL)) {
 		return;
@@ -1539,12 +1549,12 @@ static void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
 				if (openfile) {
 					sanim->anim = openanim(
-					        str, IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+					        str, ib_flags,
 					        seq->streamindex, seq->strip->colorspace_settings.name);
 				}
 				else {
 					sanim->anim = openanim_noload(
-					        str, IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+					        str, ib_flags,
 					        seq->streamindex, seq->strip->colorspace_settings.name);
 				}
 
@@ -1559,12 +1569,12 @@ static void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 				else {
 					if (openfile) {
 						sanim->anim = openanim(
-						        name, IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+						        name, ib_flags,
 						        seq->streamindex, seq->strip->colorspace_settings.name);
 					}
 					else {
 						sanim->anim = openanim_noload(
-						        name, IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+						        name, ib_flags,
 						        seq->streamindex, seq->strip->colorspace_settings.name);
 					}
 
@@ -1588,12 +1598,12 @@ static void seq_open_anim_file(Scene *scene, Sequence *seq, bool openfile)
 
 		if (openfile) {
 			sanim->anim = openanim(
-			        name, IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+			        name, ib_flags,
 			        seq->streamindex, seq->strip->colorspace_settings.name);
 		}
 		else {
 			sanim->anim = openanim_noload(
-			        name, IB_rect | ((seq->flag & SEQ_FILTERY) ? IB_animdeinterlace : 0),
+			        name, ib_flags,
 			        seq->streamindex, seq->strip->colorspace_settings.name);
 		}
 
@@ -2553,7 +2563,8 @@ static ImBuf *copy_from_ibuf_still(const SeqRenderData *context, Sequence *seq,
 	return rval;
 }
 
-static void copy_to_ibuf_still(const SeqRenderData *context, Sequence *seq, float nr, ImBuf *ibuf)
+/* cost is the time it took to produce ibuf, see BKE_sequencer_cache_put */
+static void copy_to_ibuf_still(const SeqRenderData *context, Sequence *seq, float nr, ImBuf *ibuf, float cost)
 {
 	/* warning: ibuf may be NULL if the video fails to load */
 	if (nr == 0 || nr == seq->len - 1) {
@@ -2569,11 +2580,11 @@ static void copy_to_ibuf_still(const SeqRenderData *context, Sequence *seq, floa
 		}
 
 		if (nr == 0) {
-			BKE_sequencer_cache_put(context, seq, seq->start, SEQ_STRIPELEM_IBUF_STARTSTILL, ibuf);
+			BKE_sequencer_cache_put(context, seq, seq->start, SEQ_STRIPELEM_IBUF_STARTSTILL, ibuf, cost);
 		}
 
 		if (nr == seq->len - 1) {
-			BKE_sequencer_cache_put(context, seq, seq->start, SEQ_STRIPELEM_IBUF_ENDSTILL, ibuf);
+			BKE_sequencer_cache_put(context, seq, seq->start, SEQ_STRIPELEM_IBUF_ENDSTILL, ibuf, cost);
 		}
 
 		IMB_freeImBuf(ibuf);
@@ -2787,6 +2798,8 @@ static ImBuf *seq_render_image_strip(const SeqRenderData *context, Sequence *seq
 		struct ImBuf **ibufs_arr;
 		char prefix[FILE_MAX];
 		const char *ext = NULL;
+		double start_time;
+		float view_cost;
 		int i;
 
 		if (totfiles > 1) {
@@ -2802,6 +2815,8 @@ static ImBuf *seq_render_image_strip(const SeqRenderData *context, Sequence *seq
 		totviews = BKE_scene_multiview_num_views_get(&context->scene->r);
 		ibufs_arr = MEM_callocN(sizeof(ImBuf *) * totviews, "Sequence Image Views Imbufs");
 
+		start_time = PIL_check_seconds_timer();
+
 		for (i = 0; i < totfiles; i++) {
 
 			if (prefix[0] == '\0') {
@@ -2823,6 +2838,9 @@ static ImBuf *seq_render_image_strip(const SeqRenderData *context, Sequence *seq
 		if (seq->views_format == R_IMF_VIEWS_STEREO_3D && ibufs_arr[0])
 			IMB_ImBufFromStereo3d(seq->stereo3d_format, ibufs_arr[0], &ibufs_arr[0], &ibufs_arr[1]);
 
+		/* the views are loaded together, each one costs its share */
+		view_cost = (float)(PIL_check_seconds_timer() - start_time) / totviews;
+
 		for (i = 0; i < totviews; i++) {
 			if (ibufs_arr[i]) {
 				SeqRenderData localcontext = *context;
@@ -2832,8 +2850,8 @@ static ImBuf *seq_render_image_strip(const SeqRenderData *context, Sequence *seq
 				BKE_sequencer_imbuf_to_sequencer_space(context->scene, ibufs_arr[i], false);
 
 				if (i != context->view_id) {
-					copy_to_ibuf_still(&localcontext, seq, nr, ibufs_arr[i]);
-					BKE_sequencer_cache_put(&localcontext, seq, cfra, SEQ_STRIPELEM_IBUF, ibufs_arr[i]);
+					copy_to_ibuf_still(&localcontext, seq, nr, ibufs_arr[i], view_cost);
+					BKE_sequencer_cache_put(&localcontext, seq, cfra, SEQ_STRIPELEM_IBUF, ibufs_arr[i], view_cost);
 				}
 			}
 		}
@@ -2885,6 +2903,8 @@ static ImBuf *seq_render_movie_strip(const SeqRenderData *context, Sequence *seq
 	if (is_multiview) {
 		ImBuf **ibuf_arr;
 		const int totfiles = seq_num_files(context->scene, seq->views_format, true);
+		const double start_time = PIL_check_seconds_timer();
+		float view_cost;
 		int totviews;
 		int i;
 
@@ -2928,6 +2948,9 @@ static ImBuf *seq_render_movie_strip(const SeqRenderData *context, Sequence *seq
 			}
 		}
 
+		/* the views are decoded together, each one costs its share */
+		view_cost = (float)(PIL_check_seconds_timer() - start_time) / totviews;
+
 		for (i = 0; i < totviews; i++) {
 			SeqRenderData localcontext = *context;
 			localcontext.view_id = i;
@@ -2937,8 +2960,8 @@ static ImBuf *seq_render_movie_strip(const SeqRenderData *context, Sequence *seq
 				BKE_sequencer_imbuf_to_sequencer_space(context->scene, ibuf_arr[i], false);
 			}
 			if (i != context->view_id) {
-				copy_to_ibuf_still(&localcontext, seq, nr, ibuf_arr[i]);
-				BKE_sequencer_cache_put(&localcontext, seq, cfra, SEQ_STRIPELEM_IBUF, ibuf_arr[i]);
+				copy_to_ibuf_still(&localcontext, seq, nr, ibuf_arr[i], view_cost);
+				BKE_sequencer_cache_put(&localcontext, seq, cfra, SEQ_STRIPELEM_IBUF, ibuf_arr[i], view_cost);
 			}
 		}
 
@@ -3261,6 +3284,8 @@ static ImBuf *seq_render_scene_strip(const SeqRenderData *context, Sequence *seq
 	else {
 		Render *re = RE_GetRender(scene->id.name);
 		const int totviews = BKE_scene_multiview_num_views_get(&scene->r);
+		const double start_time = PIL_check_seconds_timer();
+		float view_cost;
 		int i;
 		ImBuf **ibufs_arr;
 
@@ -3285,6 +3310,9 @@ static ImBuf *seq_render_scene_strip(const SeqRenderData *context, Sequence *seq
 			G.is_rendering = is_rendering;
 		}
 
+		/* the views are rendered together, each one costs its share */
+		view_cost = (float)(PIL_check_seconds_timer() - start_time) / totviews;
+
 		for (i = 0; i < totviews; i++) {
 			SeqRenderData localcontext = *context;
 			RenderResult rres;
@@ -3311,8 +3339,8 @@ static ImBuf *seq_render_scene_strip(const SeqRenderData *context, Sequence *seq
 			}
 
 			if (i != context->view_id) {
-				copy_to_ibuf_still(&localcontext, seq, nr, ibufs_arr[i]);
-				BKE_sequencer_cache_put(&localcontext, seq, cfra, SEQ_STRIPELEM_IBUF, ibufs_arr[i]);
+				copy_to_ibuf_still(&localcontext, seq, nr, ibufs_arr[i], view_cost);
+				BKE_sequencer_cache_put(&localcontext, seq, cfra, SEQ_STRIPELEM_IBUF, ibufs_arr[i], view_cost);
 			}
 
 			RE_ReleaseResultImage(re);
@@ -3386,6 +3414,7 @@ static ImBuf *do_render_strip_seqbase(
 static ImBuf *do_render_strip_uncached(const SeqRenderData *context, Sequence *seq, float cfra)
 {
 	ImBuf *ibuf = NULL;
+	const double start_time = PIL_check_seconds_timer();
 	float nr = give_stripelem_index(seq, cfra);
 	int type = (seq->type & SEQ_TYPE_EFFECT && seq->type != SEQ_TYPE_SPEED) ? SEQ_TYPE_EFFECT : seq->type;
 	bool use_preprocess = BKE_sequencer_input_have_to_preprocess(context, seq, cfra);
@@ -3423,7 +3452,7 @@ static ImBuf *do_render_strip_uncached(const SeqRenderData *context, Sequence *s
 				/* Scene strips update all animation, so we need to restore original state.*/
 				BKE_animsys_evaluate_all_animation(context->bmain, context->scene, cfra);
 
-				copy_to_ibuf_still(context, seq, nr, ibuf);
+				copy_to_ibuf_still(context, seq, nr, ibuf, (float)(PIL_check_seconds_timer() - start_time));
 			}
 			break;
 		}
@@ -3464,14 +3493,14 @@ static ImBuf *do_render_strip_uncached(const SeqRenderData *context, Sequence *s
 		case SEQ_TYPE_IMAGE:
 		{
 			ibuf = seq_render_image_strip(context, seq, nr, cfra);
-			copy_to_ibuf_still(context, seq, nr, ibuf);
+			copy_to_ibuf_still(context, seq, nr, ibuf, (float)(PIL_check_seconds_timer() - start_time));
 			break;
 		}
 
 		case SEQ_TYPE_MOVIE:
 		{
 			ibuf = seq_render_movie_strip(context, seq, nr, cfra);
-			copy_to_ibuf_still(context, seq, nr, ibuf);
+			copy_to_ibuf_still(context, seq, nr, ibuf, (float)(PIL_check_seconds_timer() - start_time));
 			break;
 		}
 
@@ -3488,7 +3517,7 @@ static ImBuf *do_render_strip_uncached(const SeqRenderData *context, Sequence *s
 				if (ibuf->rect_float)
 					BKE_sequencer_imbuf_to_sequencer_space(context->scene, ibuf, false);
 
-				copy_to_ibuf_still(context, seq, nr, ibuf);
+				copy_to_ibuf_still(context, seq, nr, ibuf, (float)(PIL_check_seconds_timer() - start_time));
 			}
 
 			break;
@@ -3499,7 +3528,7 @@ static ImBuf *do_render_strip_uncached(const SeqRenderData *context, Sequence *s
 			/* ibuf is always new */
 			ibuf = seq_render_mask_strip(context, seq, nr);
 
-			copy_to_ibuf_still(context, seq, nr, ibuf);
+			copy_to_ibuf_still(context, seq, nr, ibuf, (float)(PIL_check_seconds_timer() - start_time));
 			break;
 		}
 	}
@@ -3519,6 +3548,7 @@ static ImBuf *seq_render_strip(const SeqRenderData *context, Sequence *seq, floa
 	/* all effects are handled similarly with the exception of speed effect */
 	int type = (seq->type & SEQ_TYPE_EFFECT && seq->type != SEQ_TYPE_SPEED) ? SEQ_TYPE_EFFECT : seq->type;
 	bool is_preprocessed = !ELEM(type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE, SEQ_TYPE_SCENE, SEQ_TYPE_MOVIECLIP);
+	const double start_time = PIL_check_seconds_timer();
 
 	ibuf = BKE_sequencer_cache_get(context, seq, cfra, SEQ_STRIPELEM_IBUF);
 
@@ -3571,7 +3601,7 @@ static ImBuf *seq_render_strip(const SeqRenderData *context, Sequence *seq, floa
 	if (use_preprocess)
 		ibuf = input_preprocess(context, seq, cfra, ibuf, is_proxy_image, is_preprocessed);
 
-	BKE_sequencer_cache_put(context, seq, cfra, SEQ_STRIPELEM_IBUF, ibuf);
+	BKE_sequencer_cache_put(context, seq, cfra, SEQ_STRIPELEM_IBUF, ibuf, (float)(PIL_check_seconds_timer() - start_time));
 
 	return ibuf;
 }
@@ -3637,12 +3667,119 @@ static ImBuf *seq_render_strip_stack_apply_effect(const SeqRenderData *context,
 	return out;
 }
 
+/* Strips which can be rendered in parallel to other ones, they only use their own data.
+ * Effects, metas and modifier masks render other strips, scenes render in the main thread. */
+static bool seq_render_strip_is_threadsafe(Sequence *seq)
+{
+	SequenceModifierData *smd;
+
+	if (!ELEM(seq->type, SEQ_TYPE_IMAGE, SEQ_TYPE_MOVIE)) {
+		return false;
+	}
+
+	for (smd = seq->modifiers.first; smd; smd = smd->next) {
+		if (smd->mask_sequence) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+typedef struct RenderStripTask {
+	const SeqRenderData *context;
+	Sequence *seq;
+	float cfra;
+	ImBuf **r_ibuf;
+} RenderStripTask;
+
+static void seq_render_strip_task(TaskPool * __restrict UNUSED(pool), void *taskdata, int UNUSED(threadid))
+{
+	RenderStripTask *task = taskdata;
+
+	*task->r_ibuf = seq_render_strip(task->context, task->seq, task->cfra);
+}
+
+/* Render the strips of the stack which are needed for the frame in parallel, into ibuf_arr.
+ * This finds the strips the same way as seq_render_strip_stack, which blends them in order
+ * afterwards and renders the strips depending on other ones itself. */
+static void seq_render_strip_stack_parallel(const SeqRenderData *context, Sequence **seq_arr, int count,
+                                            float cfra, ImBuf **ibuf_arr)
+{
+	RenderStripTask tasks[MAXSEQ + 1];
+	int num_tasks = 0;
+	int i;
+
+	for (i = count - 1; i >= 0; i--) {
+		Sequence *seq = seq_arr[i];
+		ImBuf *ibuf = BKE_sequencer_cache_get(context, seq, cfra, SEQ_STRIPELEM_IBUF_COMP);
+		int early_out;
+		bool is_bottom = false, use_strip = false;
+
+		if (ibuf) {
+			IMB_freeImBuf(ibuf);
+			break;
+		}
+
+		early_out = seq_get_early_out_for_blend_mode(seq);
+
+		if (seq->blend_mode == SEQ_BLEND_REPLACE || ELEM(early_out, EARLY_NO_INPUT, EARLY_USE_INPUT_2)) {
+			is_bottom = true;
+			use_strip = true;
+		}
+		else if (early_out == EARLY_DO_EFFECT) {
+			use_strip = true;
+		}
+
+		if (use_strip && seq_render_strip_is_threadsafe(seq)) {
+			RenderStripTask *task = &tasks[num_tasks++];
+
+			task->context = context;
+			task->seq = seq;
+			task->cfra = cfra;
+			task->r_ibuf = &ibuf_arr[i];
+		}
+
+		if (is_bottom) {
+			break;
+		}
+	}
+
+	if (num_tasks > 1) {
+		TaskScheduler *task_scheduler = BLI_task_scheduler_get();
+		TaskPool *task_pool = BLI_task_pool_create(task_scheduler, NULL);
+
+		for (i = 0; i < num_tasks; i++) {
+			BLI_task_pool_push(task_pool, seq_render_strip_task, &tasks[i], false, TASK_PRIORITY_HIGH);
+		}
+
+		BLI_task_pool_work_and_wait(task_pool);
+		BLI_task_pool_free(task_pool);
+	}
+}
+
+/* strip of the stack, rendered in parallel already or now */
+static ImBuf *seq_render_strip_stack_input(const SeqRenderData *context, Sequence **seq_arr, ImBuf **ibuf_arr,
+                                           int i, float cfra)
+{
+	ImBuf *ibuf = ibuf_arr[i];
+
+	if (ibuf) {
+		ibuf_arr[i] = NULL;
+		return ibuf;
+	}
+
+	return seq_render_strip(context, seq_arr[i], cfra);
+}
+
 static ImBuf *seq_render_strip_stack(const SeqRenderData *context, ListBase *seqbasep, float cfra, int chanshown)
 {
 	Sequence *seq_arr[MAXSEQ + 1];
+	ImBuf *ibuf_arr[MAXSEQ + 1] = {NULL};
 	int count;
 	int i;
 	ImBuf *out = NULL;
+	const double start_time = PIL_check_seconds_timer();
 
 	count = get_shown_sequences(seqbasep, cfra, chanshown, (Sequence **)&seq_arr);
 
@@ -3707,11 +3844,14 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context, ListBase *seq
 			out = seq_render_strip(context, seq, cfra);
 		}
 
-		BKE_sequencer_cache_put(context, seq, cfra, SEQ_STRIPELEM_IBUF_COMP, out);
+		BKE_sequencer_cache_put(context, seq, cfra, SEQ_STRIPELEM_IBUF_COMP, out,
+		                        (float)(PIL_check_seconds_timer() - start_time));
 
 		return out;
 	}
 
+	seq_render_strip_stack_parallel(context, seq_arr, count, cfra, ibuf_arr);
+
 	for (i = count - 1; i >= 0; i--) {
 		int early_out;
 		Sequence *seq = seq_arr[i];
@@ -3722,7 +3862,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context, ListBase *seq
 			break;
 		}
 		if (seq->blend_mode == SEQ_BLEND_REPLACE) {
-			out = seq_render_strip(context, seq, cfra);
+			out = seq_render_strip_stack_input(context, seq_arr, ibuf_arr, i, cfra);
 			break;
 		}
 
@@ -3731,7 +3871,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context, ListBase *seq
 		switch (early_out) {
 			case EARLY_NO_INPUT:
 			case EARLY_USE_INPUT_2:
-				out = seq_render_strip(context, seq, cfra);
+				out = seq_render_strip_stack_input(context, seq_arr, ibuf_arr, i, cfra);
 				break;
 			case EARLY_USE_INPUT_1:
 				if (i == 0) {
@@ -3741,7 +3881,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context, ListBase *seq
 			case EARLY_DO_EFFECT:
 				if (i == 0) {
 					ImBuf *ibuf1 = IMB_allocImBuf(context->rectx, context->recty, 32, IB_rect);
-					ImBuf *ibuf2 = seq_render_strip(context, seq, cfra);
+					ImBuf *ibuf2 = seq_render_strip_stack_input(context, seq_arr, ibuf_arr, i, cfra);
 
 					out = seq_render_strip_stack_apply_effect(context, seq, cfra, ibuf1, ibuf2);
 
@@ -3756,7 +3896,8 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context, ListBase *seq
 		}
 	}
 
-	BKE_sequencer_cache_put(context, seq_arr[i], cfra, SEQ_STRIPELEM_IBUF_COMP, out);
+	BKE_sequencer_cache_put(context, seq_arr[i], cfra, SEQ_STRIPELEM_IBUF_COMP, out,
+	                        (float)(PIL_check_seconds_timer() - start_time));
 
 	i++;
 
@@ -3765,7 +3906,7 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context, ListBase *seq
 
 		if (seq_get_early_out_for_blend_mode(seq) == EARLY_DO_EFFECT) {
 			ImBuf *ibuf1 = out;
-			ImBuf *ibuf2 = seq_render_strip(context, seq, cfra);
+			ImBuf *ibuf2 = seq_render_strip_stack_input(context, seq_arr, ibuf_arr, i, cfra);
 
 			out = seq_render_strip_stack_apply_effect(context, seq, cfra, ibuf1, ibuf2);
 
@@ -3773,12 +3914,31 @@ static ImBuf *seq_render_strip_stack(const SeqRenderData *context, ListBase *seq
 			IMB_freeImBuf(ibuf2);
 		}
 
-		BKE_sequencer_cache_put(context, seq_arr[i], cfra, SEQ_STRIPELEM_IBUF_COMP, out);
+		BKE_sequencer_cache_put(context, seq_arr[i], cfra, SEQ_STRIPELEM_IBUF_COMP, out,
+		                        (float)(PIL_check_seconds_timer() - start_time));
+	}
+
+	/* strips which turned out to be unused */
+	for (i = 0; i < count; i++) {
+		if (ibuf_arr[i]) {
+			IMB_freeImBuf(ibuf_arr[i]);
+		}
 	}
 
 	return out;
 }
 
+static ListBase *seq_shown_seqbase_get(Editing *ed, int chanshown)
+{
+	if ((chanshown < 0) && !BLI_listbase_is_empty(&ed->metastack)) {
+		int count = BLI_listbase_count(&ed->metastack);
+		count = max_ii(count + chanshown, 0);
+		return ((MetaStack *)BLI_findlink(&ed->metastack, count))->oldbasep;
+	}
+
+	return ed->seqbasep;
+}
+
 /*
  * returned ImBuf is refed!
  * you have to free after usage!
@@ -3791,14 +3951,7 @@ ImBuf *BKE_sequencer_give_ibuf(const SeqRenderData *context, float cfra, int cha
 	
 	if (ed == NULL) return NULL;
 
-	if ((chanshown < 0) && !BLI_listbase_is_empty(&ed->metastack)) {
-		int count = BLI_listbase_count(&ed->metastack);
-		count = max_ii(count + chanshown, 0);
-		seqbasep = ((MetaStack *)BLI_findlink(&ed->metastack, count))->oldbasep;
-	}
-	else {
-		seqbasep = ed->seqbasep;
-	}
+	seqbasep = seq_shown_seqbase_get(ed, chanshown);
 
 #ifdef USE_SCENE_RECURSIVE_HACK
 	BKE_main_id_tag_idcode(context->bmain, ID_SCE, LIB_TAG_DOIT, false);
@@ -3818,156 +3971,181 @@ ImBuf *BKE_sequencer_give_ibuf_direct(const SeqRenderData *context, float cfra,
 	return seq_render_strip(context, seq, cfra);
 }
 
-/* *********************** threading api ******************* */
+/* *********************** prefetching ******************* */
 
-static ListBase running_threads;
-static ListBase prefetch_wait;
-static ListBase prefetch_done;
+/* Frames ahead of the playhead are rendered into the cache by the prefetch job of the
+ * sequencer editor. Rendering strips isn't thread safe, so the job and the preview never
+ * render at the same time, both hold prefetch_render_lock while rendering.
+ *
+ * The render pipeline doesn't take the lock, scene strips would render recursively with it.
+ * Final and OpenGL renders stop and wait for the job before they start instead, and the job
+ * isn't started again while G.is_rendering is set.
+ *
+ * Changes to strips stop the job with BKE_sequencer_prefetch_stop(), it is called when
+ * strips are freed and the cache is invalidated. Scenes with animated strips aren't
+ * prefetched, a frame change stops the job before animation writes the strips.
+ */
 
-static pthread_mutex_t queue_lock          = PTHREAD_MUTEX_INITIALIZER;
-static pthread_mutex_t wakeup_lock         = PTHREAD_MUTEX_INITIALIZER;
-static pthread_cond_t wakeup_cond          = PTHREAD_COND_INITIALIZER;
+static ThreadMutex prefetch_render_lock = BLI_MUTEX_INITIALIZER;
+/* incremented when prefetching has to stop, only changed by the main thread while holding the lock */
+static int prefetch_generation = 0;
+/* the main thread is rendering while holding the lock */
+static bool prefetch_render_lock_main = false;
 
-//static pthread_mutex_t prefetch_ready_lock = PTHREAD_MUTEX_INITIALIZER;
-//static pthread_cond_t  prefetch_ready_cond = PTHREAD_COND_INITIALIZER;
+ImBuf *BKE_sequencer_give_ibuf_threaded(const SeqRenderData *context, float cfra, int chanshown)
+{
+	const bool is_main = BLI_thread_is_main();
+	ImBuf *ibuf;
 
-static pthread_mutex_t frame_done_lock     = PTHREAD_MUTEX_INITIALIZER;
-static pthread_cond_t frame_done_cond      = PTHREAD_COND_INITIALIZER;
+	BLI_mutex_lock(&prefetch_render_lock);
+	if (is_main) {
+		prefetch_render_lock_main = true;
+	}
 
-static volatile bool seq_thread_shutdown = true; 
-static volatile int seq_last_given_monoton_cfra = 0;
-static int monoton_cfra = 0;
+	ibuf = BKE_sequencer_give_ibuf(context, cfra, chanshown);
 
-typedef struct PrefetchThread {
-	struct PrefetchThread *next, *prev;
-	
-	Scene *scene;
-	struct PrefetchQueueElem *current;
-	pthread_t pthread;
-	int running;
-	
-} PrefetchThread;
+	if (is_main) {
+		prefetch_render_lock_main = false;
+	}
+	BLI_mutex_unlock(&prefetch_render_lock);
 
-typedef struct PrefetchQueueElem {
-	struct PrefetchQueueElem *next, *prev;
-	
-	int rectx;
-	int recty;
-	float cfra;
-	int chanshown;
-	int preview_render_size;
+	return ibuf;
+}
 
-	int monoton_cfra;
+int BKE_sequencer_prefetch_begin(void)
+{
+	BLI_assert(BLI_thread_is_main());
 
-	ImBuf *ibuf;
-} PrefetchQueueElem;
+	return prefetch_generation;
+}
 
-void BKE_sequencer_give_ibuf_prefetch_request(const SeqRenderData *context, float cfra, int chanshown)
+void BKE_sequencer_prefetch_stop(void)
 {
-	PrefetchQueueElem *e;
-	if (seq_thread_shutdown) {
+	/* the job itself and the main thread rendering the preview hold the lock already */
+	if (!BLI_thread_is_main() || prefetch_render_lock_main) {
 		return;
 	}
 
-	e = MEM_callocN(sizeof(PrefetchQueueElem), "prefetch_queue_elem");
-	e->rectx = context->rectx;
-	e->recty = context->recty;
-	e->cfra = cfra;
-	e->chanshown = chanshown;
-	e->preview_render_size = context->preview_render_size;
-	e->monoton_cfra = monoton_cfra++;
+	/* waits for the frame which is being prefetched */
+	BLI_mutex_lock(&prefetch_render_lock);
+	prefetch_generation++;
+	BLI_mutex_unlock(&prefetch_render_lock);
+}
 
-	pthread_mutex_lock(&queue_lock);
-	BLI_addtail(&prefetch_wait, e);
-	pthread_mutex_unlock(&queue_lock);
-	
-	pthread_mutex_lock(&wakeup_lock);
-	pthread_cond_signal(&wakeup_cond);
-	pthread_mutex_unlock(&wakeup_lock);
+static bool seq_fcurves_animate_strips(ListBase *fcurves)
+{
+	FCurve *fcu;
+
+	for (fcu = fcurves->first; fcu; fcu = fcu->next) {
+		if (fcu->rna_path && STRPREFIX(fcu->rna_path, "sequence_editor.")) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
-ImBuf *BKE_sequencer_give_ibuf_threaded(const SeqRenderData *context, float cfra, int chanshown)
+/* Strip animation is only evaluated at the current frame, frames ahead of it would be rendered
+ * with its values. Checked before the job starts, the job can't read F-Curves while they're edited. */
+bool BKE_sequencer_prefetch_supported(Scene *scene)
 {
-	PrefetchQueueElem *e = NULL;
-	bool found_something = false;
+	AnimData *adt = scene->adt;
+	NlaTrack *nlt;
+	NlaStrip *strip;
 
-	if (seq_thread_shutdown) {
-		return BKE_sequencer_give_ibuf(context, cfra, chanshown);
+	if (adt == NULL) {
+		return true;
 	}
 
-	while (!e) {
-		bool success = false;
-		pthread_mutex_lock(&queue_lock);
+	if (seq_fcurves_animate_strips(&adt->drivers)) {
+		return false;
+	}
 
-		for (e = prefetch_done.first; e; e = e->next) {
-			if (cfra == e->cfra &&
-			    chanshown == e->chanshown &&
-			    context->rectx == e->rectx &&
-			    context->recty == e->recty &&
-			    context->preview_render_size == e->preview_render_size)
-			{
-				success = true;
-				found_something = true;
-				break;
-			}
-		}
+	if (adt->action && seq_fcurves_animate_strips(&adt->action->curves)) {
+		return false;
+	}
 
-		if (!e) {
-			for (e = prefetch_wait.first; e; e = e->next) {
-				if (cfra == e->cfra &&
-				    chanshown == e->chanshown &&
-				    context->rectx == e->rectx &&
-				    context->recty == e->recty &&
-				    context->preview_render_size == e->preview_render_size)
-				{
-					found_something = true;
-					break;
-				}
+	for (nlt = adt->nla_tracks.first; nlt; nlt = nlt->next) {
+		for (strip = nlt->strips.first; strip; strip = strip->next) {
+			if (strip->act && seq_fcurves_animate_strips(&strip->act->curves)) {
+				return false;
 			}
 		}
+	}
 
-		if (!e) {
-			PrefetchThread *tslot;
+	return true;
+}
 
-			for (tslot = running_threads.first;
-			     tslot;
-			     tslot = tslot->next)
-			{
-				if (tslot->current &&
-				    cfra == tslot->current->cfra &&
-				    chanshown == tslot->current->chanshown &&
-				    context->rectx == tslot->current->rectx &&
-				    context->recty == tslot->current->recty &&
-				    context->preview_render_size == tslot->current->preview_render_size)
-				{
-					found_something = true;
-					break;
-				}
-			}
+/* scene strips are rendered with the render pipeline or OpenGL, which only works in the main thread */
+static bool seq_prefetch_frame_supported(ListBase *seqbase, int cfra)
+{
+	Sequence *seq;
+
+	for (seq = seqbase->first; seq; seq = seq->next) {
+		if (seq->startdisp > cfra || seq->enddisp <= cfra) {
+			continue;
 		}
 
-		/* e->ibuf is unrefed by render thread on next round. */
+		if (seq->type == SEQ_TYPE_SCENE) {
+			return false;
+		}
 
-		if (e) {
-			seq_last_given_monoton_cfra = e->monoton_cfra;
+		if (seq->type == SEQ_TYPE_META && !seq_prefetch_frame_supported(&seq->seqbase, cfra)) {
+			return false;
 		}
+	}
+
+	return true;
+}
+
+bool BKE_sequencer_prefetch_frame(const SeqRenderData *context, float cfra, int chanshown, int generation)
+{
+	Editing *ed;
+	SeqRenderData prefetch_context = *context;
+	Sequence *seq_arr[MAXSEQ + 1];
+	ListBase *seqbasep;
+	ImBuf *ibuf;
+	int count;
+	bool result = true;
 
-		pthread_mutex_unlock(&queue_lock);
+	prefetch_context.is_prefetch_render = true;
 
-		if (!success) {
-			e = NULL;
+	BLI_mutex_lock(&prefetch_render_lock);
 
-			if (!found_something) {
-				fprintf(stderr, "SEQ-THREAD: Requested frame not in queue ???\n");
-				break;
+	ed = BKE_sequencer_editing_get(context->scene, false);
+
+	if (generation != prefetch_generation || ed == NULL) {
+		BLI_mutex_unlock(&prefetch_render_lock);
+		return false;
+	}
+
+	seqbasep = seq_shown_seqbase_get(ed, chanshown);
+	count = get_shown_sequences(seqbasep, (int)cfra, chanshown, seq_arr);
+
+	if (count && seq_prefetch_frame_supported(seqbasep, (int)cfra)) {
+		/* the composite of the top strip is the final frame */
+		ibuf = BKE_sequencer_cache_get(&prefetch_context, seq_arr[count - 1], cfra, SEQ_STRIPELEM_IBUF_COMP);
+
+		if (ibuf == NULL) {
+			ibuf = seq_render_strip_stack(&prefetch_context, seqbasep, cfra, chanshown);
+
+			if (ibuf) {
+				IMB_freeImBuf(ibuf);
+
+				/* the frame isn't stored when the cache is full */
+				ibuf = BKE_sequencer_cache_get(&prefetch_context, seq_arr[count - 1], cfra, SEQ_STRIPELEM_IBUF_COMP);
+				result = (ibuf != NULL);
 			}
-			pthread_mutex_lock(&frame_done_lock);
-			pthread_cond_wait(&frame_done_cond, &frame_done_lock);
-			pthread_mutex_unlock(&frame_done_lock);
+		}
+
+		if (ibuf) {
+			IMB_freeImBuf(ibuf);
 		}
 	}
-	
-	return e ? e->ibuf : NULL;
+
+	BLI_mutex_unlock(&prefetch_render_lock);
+
+	return result;
 }
 
 /* check whether sequence cur depends on seq */
@@ -4019,6 +4197,8 @@ static void sequence_invalidate_cache(Scene *scene, Sequence *seq, bool invalida
 {
 	Editing *ed = scene->ed;
 
+	BKE_sequencer_prefetch_stop();
+
 	/* invalidate cache for current sequence */
 	if (invalidate_self) {
 		/* Animation structure holds some buffers inside,
@@ -37,6 +37,8 @@
 #include <time.h>
 #include <assert.h>
 
+#include "MEM_guardedalloc.h"
+
 #include "DNA_object_types.h"
 #include "DNA_modifier_types.h"
 #include "DNA_meshdata_types.h"
@@ -67,34 +69,15 @@
 #define OUT_OF_MEMORY() ((void)printf("Shrinkwrap: Out of memory\n"))
 
 /*
- * Shrinkwrap to the nearest vertex
- *
- * it builds a kdtree of vertexs we can attach to and then
- * for each vertex performs a nearest vertex search on the tree
+ * Gather the vertices affected by the modifier, in target space.
+ * Returns the number of vertices, their index and weight are stored in the other arrays.
  */
-static void shrinkwrap_calc_nearest_vertex(ShrinkwrapCalcData *calc)
+static int shrinkwrap_calc_target_coords(
+        ShrinkwrapCalcData *calc, int *r_index, float *r_weight, float (*r_co)[3])
 {
-	int i;
-
-	BVHTreeFromMesh treeData = NULL_BVHTreeFromMesh;
-	BVHTreeNearest nearest  = NULL_BVHTreeNearest;
-
+	int i, num = 0;
 
-	TIMEIT_BENCH(bvhtree_from_mesh_verts(&treeData, calc->target, 0.0, 2, 6), bvhtree_verts);
-	if (treeData.tree == NULL) {
-		OUT_OF_MEMORY();
-		return;
-	}
-	
-	/* Setup nearest */
-	nearest.index = -1;
-	nearest.dist_sq = FLT_MAX;
-#ifndef __APPLE__
-#pragma omp parallel for default(none) private(i) firstprivate(nearest) shared(treeData, calc) schedule(static) if (calc->numVerts > BKE_MESH_OMP_LIMIT)
-#endif
 	for (i = 0; i < calc->numVerts; ++i) {
-		float *co = calc->vertexCos[i];
-		float tmp_co[3];
 		float weight = defvert_array_find_weight_safe(calc->dvert, i, calc->vgroup);
 
 		if (calc->invert_vgroup) {
@@ -105,46 +88,110 @@ static void shrinkwrap_calc_nearest_vertex(ShrinkwrapCalcData *calc)
 			continue;
 		}
 
-
 		/* Convert the vertex to tree coordinates */
 		if (calc->vert) {
-			copy_v3_v3(tmp_co, calc->vert[i].co);
+			copy_v3_v3(r_co[num], calc->vert[i].co);
 		}
 		else {
-			copy_v3_v3(tmp_co, co);
+			copy_v3_v3(r_co[num], calc->vertexCos[i]);
 		}
-		BLI_space_transform_apply(&calc->local2target, tmp_co);
+		BLI_space_transform_apply(&calc->local2target, r_co[num]);
 
-		/* Use local proximity heuristics (to reduce the nearest search)
-		 *
-		 * If we already had an hit before.. we assume this vertex is going to have a close hit to that other vertex
-		 * so we can initiate the "nearest.dist" with the expected value to that last hit.
-		 * This will lead in pruning of the search tree. */
-		if (nearest.index != -1)
-			nearest.dist_sq = len_squared_v3v3(tmp_co, nearest.co);
-		else
-			nearest.dist_sq = FLT_MAX;
+		r_index[num] = i;
+		r_weight[num] = weight;
+		num++;
+	}
+
+	return num;
+}
+
+/*
+ * Nearest point search for all the affected vertices, done in parallel by the BVH tree.
+ * The tree keeps the previous hit of each thread to reduce the search (local proximity heuristics),
+ * the arrays must be freed by the caller.
+ */
+static int shrinkwrap_calc_nearest_batch(
+        ShrinkwrapCalcData *calc, BVHTreeFromMesh *treeData,
+        int **r_index, float **r_weight, float (**r_co)[3], BVHTreeNearest **r_nearest)
+{
+	const size_t verts_num = (size_t)calc->numVerts;
+	int *index = MEM_mallocN(sizeof(*index) * verts_num, __func__);
+	float *weight = MEM_mallocN(sizeof(*weight) * verts_num, __func__);
+	float (*co)[3] = MEM_mallocN(sizeof(*co) * verts_num, __func__);
+	BVHTreeNearest *nearest;
+	int i, num;
+
+	num = shrinkwrap_calc_target_coords(calc, index, weight, co);
+
+	nearest = MEM_mallocN(sizeof(*nearest) * (size_t)num, __func__);
+	for (i = 0; i < num; i++) {
+		nearest[i].index = -1;
+		nearest[i].dist_sq = FLT_MAX;
+	}
+
+	BLI_bvhtree_find_nearest_batch(treeData->tree, (const float (*)[3])co, num, nearest,
+	                               treeData->nearest_callback, treeData);
 
-		BLI_bvhtree_find_nearest(treeData.tree, tmp_co, &nearest, treeData.nearest_callback, &treeData);
+	*r_index = index;
+	*r_weight = weight;
+	*r_co = co;
+	*r_nearest = nearest;
 
+	return num;
+}
+
+/*
+ * Shrinkwrap to the nearest vertex
+ *
+ * it builds a kdtree of vertexs we can attach to and then
+ * for each vertex performs a nearest vertex search on the tree
+ */
+static void shrinkwrap_calc_nearest_vertex(ShrinkwrapCalcData *calc)
+{
+	int i, num;
+	int *index;
+	float *weights;
+	float (*target_co)[3];
+	BVHTreeNearest *nearest;
+
+	BVHTreeFromMesh treeData = NULL_BVHTreeFromMesh;
+
+
+	TIMEIT_BENCH(bvhtree_from_mesh_verts(&treeData, calc->target, 0.0, 2, 6), bvhtree_verts);
+	if (treeData.tree == NULL) {
+		OUT_OF_MEMORY();
+		return;
+	}
+
+	num = shrinkwrap_calc_nearest_batch(calc, &treeData, &index, &weights, &target_co, &nearest);
+
+	for (i = 0; i < num; ++i) {
+		float *co = calc->vertexCos[index[i]];
+		float tmp_co[3];
+		float weight = weights[i];
 
 		/* Found the nearest vertex */
-		if (nearest.index != -1) {
+		if (nearest[i].index != -1) {
 			/* Adjusting the vertex weight,
 			 * so that after interpolating it keeps a certain distance from the nearest position */
-			if (nearest.dist_sq > FLT_EPSILON) {
-				const float dist = sqrtf(nearest.dist_sq);
+			if (nearest[i].dist_sq > FLT_EPSILON) {
+				const float dist = sqrtf(nearest[i].dist_sq);
 				weight *= (dist - calc->keepDist) / dist;
 			}
 
 			/* Convert the coordinates back to mesh coordinates */
-			copy_v3_v3(tmp_co, nearest.co);
+			copy_v3_v3(tmp_co, nearest[i].co);
 			BLI_space_transform_invert(&calc->local2target, tmp_co);
 
 			interp_v3_v3v3(co, co, tmp_co, weight);  /* linear interpolation */
 		}
 	}
 
+	MEM_freeN(index);
+	MEM_freeN(weights);
+	MEM_freeN(target_co);
+	MEM_freeN(nearest);
+
 	free_bvhtree_from_mesh(&treeData);
 }
 
@@ -395,10 +442,13 @@ static void shrinkwrap_calc_normal_projection(ShrinkwrapCalcData *calc, bool for
  */
 static void shrinkwrap_calc_nearest_surface_point(ShrinkwrapCalcData *calc)
 {
-	int i;
+	int i, num;
+	int *index;
+	float *weights;
+	float (*target_co)[3];
+	BVHTreeNearest *nearest;
 
 	BVHTreeFromMesh treeData = NULL_BVHTreeFromMesh;
-	BVHTreeNearest nearest  = NULL_BVHTreeNearest;
 
 	/* Create a bvh-tree of the given target */
 	bvhtree_from_mesh_looptri(&treeData, calc->target, 0.0, 2, 6);
@@ -407,72 +457,43 @@ static void shrinkwrap_calc_nearest_surface_point(ShrinkwrapCalcData *calc)
 		return;
 	}
 
-	/* Setup nearest */
-	nearest.index = -1;
-	nearest.dist_sq = FLT_MAX;
-
-
 	/* Find the nearest vertex */
-#ifndef __APPLE__
-#pragma omp parallel for default(none) private(i) firstprivate(nearest) shared(calc, treeData) schedule(static) if (calc->numVerts > BKE_MESH_OMP_LIMIT)
-#endif
-	for (i = 0; i < calc->numVerts; ++i) {
-		float *co = calc->vertexCos[i];
-		float tmp_co[3];
-		float weight = defvert_array_find_weight_safe(calc->dvert, i, calc->vgroup);
-
-		if (calc->invert_vgroup) {
-			weight = 1.0f - weight;
-		}
-
-		if (weight == 0.0f) continue;
+	num = shrinkwrap_calc_nearest_batch(calc, &treeData, &index, &weights, &target_co, &nearest);
 
-		/* Convert the vertex to tree coordinates */
-		if (calc->vert) {
-			copy_v3_v3(tmp_co, calc->vert[i].co);
-		}
-		else {
-			copy_v3_v3(tmp_co, co);
-		}
-		BLI_space_transform_apply(&calc->local2target, tmp_co);
-
-		/* Use local proximity heuristics (to reduce the nearest search)
-		 *
-		 * If we already had an hit before.. we assume this vertex is going to have a close hit to that other vertex
-		 * so we can initiate the "nearest.dist" with the expected value to that last hit.
-		 * This will lead in pruning of the search tree. */
-		if (nearest.index != -1)
-			nearest.dist_sq = len_squared_v3v3(tmp_co, nearest.co);
-		else
-			nearest.dist_sq = FLT_MAX;
-
-		BLI_bvhtree_find_nearest(treeData.tree, tmp_co, &nearest, treeData.nearest_callback, &treeData);
+	for (i = 0; i < num; ++i) {
+		float *co = calc->vertexCos[index[i]];
+		float *tmp_co = target_co[i];
 
 		/* Found the nearest vertex */
-		if (nearest.index != -1) {
+		if (nearest[i].index != -1) {
 			if (calc->smd->shrinkOpts & MOD_SHRINKWRAP_KEEP_ABOVE_SURFACE) {
 				/* Make the vertex stay on the front side of the face */
-				madd_v3_v3v3fl(tmp_co, nearest.co, nearest.no, calc->keepDist);
+				madd_v3_v3v3fl(tmp_co, nearest[i].co, nearest[i].no, calc->keepDist);
 			}
 			else {
 				/* Adjusting the vertex weight,
 				 * so that after interpolating it keeps a certain distance from the nearest position */
-				const float dist = sasqrt(nearest.dist_sq);
+				const float dist = sasqrt(nearest[i].dist_sq);
 				if (dist > FLT_EPSILON) {
 					/* linear interpolation */
-					interp_v3_v3v3(tmp_co, tmp_co, nearest.co, (dist - calc->keepDist) / dist);
+					interp_v3_v3v3(tmp_co, tmp_co, nearest[i].co, (dist - calc->keepDist) / dist);
 				}
 				else {
-					copy_v3_v3(tmp_co, nearest.co);
+					copy_v3_v3(tmp_co, nearest[i].co);
 				}
 			}
 
 			/* Convert the coordinates back to mesh coordinates */
 			BLI_space_transform_invert(&calc->local2target, tmp_co);
-			interp_v3_v3v3(co, co, tmp_co, weight);  /* linear interpolation */
+			interp_v3_v3v3(co, co, tmp_co, weights[i]);  /* linear interpolation */
 		}
 	}
 
+	MEM_freeN(index);
+	MEM_freeN(weights);
+	MEM_freeN(target_co);
+	MEM_freeN(nearest);
+
 	free_bvhtree_from_mesh(&treeData);
 }
 
@@ -140,6 +140,10 @@ int BLI_bvhtree_find_nearest(
         BVHTree *tree, const float co[3], BVHTreeNearest *nearest,
         BVHTree_NearestPointCallback callback, void *userdata);
 
+void BLI_bvhtree_find_nearest_batch(
+        BVHTree *tree, const float (*co)[3], const int co_num, BVHTreeNearest *r_nearest,
+        BVHTree_NearestPointCallback callback, void *userdata);
+
 int BLI_bvhtree_find_nearest_to_ray(
         BVHTree *tree, const float co[3], const float dir[3], BVHTreeNearest *nearest,
         BVHTree_NearestToRayCallback callback, void *userdata);
@@ -152,6 +156,11 @@ int BLI_bvhtree_ray_cast(
         BVHTree *tree, const float co[3], const float dir[3], float radius, BVHTreeRayHit *hit,
         BVHTree_RayCastCallback callback, void *userdata);
 
+void BLI_bvhtree_ray_cast_batch(
+        BVHTree *tree, const float (*co)[3], const float (*dir)[3], const int ray_num, float radius,
+        BVHTreeRayHit *r_hit, BVHTree_RayCastCallback callback, void *userdata,
+        int flag);
+
 int BLI_bvhtree_ray_cast_all_ex(
         BVHTree *tree, const float co[3], const float dir[3], float radius,
         BVHTree_RayCastCallback callback, void *userdata,
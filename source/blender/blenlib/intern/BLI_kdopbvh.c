@@ -1552,6 +1552,74 @@ int BLI_bvhtree_find_nearest(
 	return data.nearest.index;
 }
 
+typedef struct BVHNearestBatchData {
+	BVHTree *tree;
+	const float (*co)[3];
+	BVHTreeNearest *nearest;
+	BVHTree_NearestPointCallback callback;
+	void *userdata;
+} BVHNearestBatchData;
+
+/* result of the previous point of the chunk */
+typedef struct BVHNearestBatchChunk {
+	BVHTreeNearest nearest;
+} BVHNearestBatchChunk;
+
+static void bvhtree_find_nearest_batch_cb(
+        void *userdata, void *userdata_chunk, const int i, const int UNUSED(thread_id))
+{
+	BVHNearestBatchData *data = userdata;
+	BVHNearestBatchChunk *prev = userdata_chunk;
+	BVHTreeNearest *nearest = &data->nearest[i];
+	const float *co = data->co[i];
+
+	/* The previous result lies on the tree, so its distance to this point is an upper bound
+	 * of the search distance, which prunes most of the tree when the points are close together. */
+	if (prev->nearest.index != -1) {
+		const float dist_sq = len_squared_v3v3(co, prev->nearest.co);
+		if (dist_sq < nearest->dist_sq) {
+			*nearest = prev->nearest;
+			nearest->dist_sq = dist_sq;
+		}
+	}
+
+	BLI_bvhtree_find_nearest(data->tree, co, nearest, data->callback, data->userdata);
+
+	if (nearest->index != -1) {
+		prev->nearest = *nearest;
+	}
+}
+
+/**
+ * Find the nearest node for each point of \a co, using threads.
+ *
+ * \param r_nearest: Array of \a co_num items, which must be initialized like for #BLI_bvhtree_find_nearest,
+ * \a dist_sq being the maximum search distance of each point.
+ *
+ * \note Consecutive points are processed by the same thread, they are expected to be close to each other
+ * (as mesh vertices usually are), which is used to limit the search.
+ * \a callback must be thread safe.
+ */
+void BLI_bvhtree_find_nearest_batch(
+        BVHTree *tree, const float (*co)[3], const int co_num, BVHTreeNearest *r_nearest,
+        BVHTree_NearestPointCallback callback, void *userdata)
+{
+	BVHNearestBatchData data = {
+		.tree = tree,
+		.co = co,
+		.nearest = r_nearest,
+		.callback = callback,
+		.userdata = userdata,
+	};
+	BVHNearestBatchChunk chunk;
+
+	chunk.nearest.index = -1;
+
+	BLI_task_parallel_range_ex(
+	        0, co_num, &data, &chunk, sizeof(chunk), bvhtree_find_nearest_batch_cb,
+	        co_num > KDOPBVH_THREAD_LEAF_THRESHOLD, false);
+}
+
 /** \} */
 
 
@@ -1805,6 +1873,55 @@ int BLI_bvhtree_ray_cast(
 	return BLI_bvhtree_ray_cast_ex(tree, co, dir, radius, hit, callback, userdata, BVH_RAYCAST_DEFAULT);
 }
 
+typedef struct BVHRayCastBatchData {
+	BVHTree *tree;
+	const float (*co)[3];
+	const float (*dir)[3];
+	float radius;
+	BVHTreeRayHit *hit;
+	BVHTree_RayCastCallback callback;
+	void *userdata;
+	int flag;
+} BVHRayCastBatchData;
+
+static void bvhtree_ray_cast_batch_cb(void *userdata, const int i)
+{
+	BVHRayCastBatchData *data = userdata;
+
+	BLI_bvhtree_ray_cast_ex(
+	        data->tree, data->co[i], data->dir[i], data->radius, &data->hit[i],
+	        data->callback, data->userdata, data->flag);
+}
+
+/**
+ * Cast a ray for each item of \a co and \a dir, using threads.
+ *
+ * \param r_hit: Array of \a ray_num items, which must be initialized like for #BLI_bvhtree_ray_cast_ex.
+ *
+ * \note Consecutive rays are processed by the same thread, so rays which are close to each other
+ * traverse the same nodes. \a callback must be thread safe.
+ */
+void BLI_bvhtree_ray_cast_batch(
+        BVHTree *tree, const float (*co)[3], const float (*dir)[3], const int ray_num, float radius,
+        BVHTreeRayHit *r_hit, BVHTree_RayCastCallback callback, void *userdata,
+        int flag)
+{
+	BVHRayCastBatchData data = {
+		.tree = tree,
+		.co = co,
+		.dir = dir,
+		.radius = radius,
+		.hit = r_hit,
+		.callback = callback,
+		.userdata = userdata,
+		.flag = flag,
+	};
+
+	BLI_task_parallel_range(
+	        0, ray_num, &data, bvhtree_ray_cast_batch_cb,
+	        ray_num > KDOPBVH_THREAD_LEAF_THRESHOLD);
+}
+
 float BLI_bvhtree_bb_raycast(const float bv[6], const float light_start[3], const float light_end[3], float pos[3])
 {
 	BVHRayCastData data;
@@ -460,6 +460,22 @@ int BLI_mempool_count(BLI_mempool *pool)
 	return (int)pool->totused;
 }
 
+/**
+ * \return the number of bytes allocated by the pool,
+ * this includes free elements in its chunks, so it may be much larger than the used elements.
+ */
+size_t BLI_mempool_memory_usage(BLI_mempool *pool)
+{
+	BLI_mempool_chunk *mpchunk;
+	size_t mem = sizeof(*pool);
+
+	for (mpchunk = pool->chunks; mpchunk; mpchunk = mpchunk->next) {
+		mem += sizeof(BLI_mempool_chunk) + (size_t)pool->csize;
+	}
+
+	return mem;
+}
+
 void *BLI_mempool_findelem(BLI_mempool *pool, unsigned int index)
 {
 	BLI_assert(pool->flag & BLI_MEMPOOL_ALLOW_ITER);
@@ -31,10 +31,12 @@
 #include "DNA_listBase.h"
 #include "DNA_object_types.h"
 
+#include "BLI_bitmap.h"
 #include "BLI_linklist_stack.h"
 #include "BLI_listbase.h"
 #include "BLI_math.h"
 #include "BLI_stack.h"
+#include "BLI_task.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_cdderivedmesh.h"
@@ -1706,3 +1708,380 @@ void BM_mesh_remap(
 	if (fptr_map)
 		BLI_ghash_free(fptr_map, NULL, NULL);
 }
+
+
+/* -------------------------------------------------------------------- */
+/* BMesh Compaction */
+
+/**
+ * Order the elements for #BM_mesh_compact, vertices are visited breadth first over their edges,
+ * edges and faces are added as they're first reached from a vertex.
+ * This keeps neighboring elements close in memory, unlike the creation order
+ * which becomes scattered after many edits.
+ */
+static void bm_mesh_compact_order(BMesh *bm, BMVert **verts, BMEdge **edges, BMFace **faces)
+{
+	BLI_bitmap *verts_visit = BLI_BITMAP_NEW(bm->totvert, __func__);
+	BLI_bitmap *edges_visit = BLI_BITMAP_NEW(bm->totedge, __func__);
+	BLI_bitmap *faces_visit = BLI_BITMAP_NEW(bm->totface, __func__);
+	int vert_tot = 0, edge_tot = 0, face_tot = 0;
+	int vert_step = 0;
+	BMIter iter;
+	BMVert *v_seed;
+
+	BM_ITER_MESH (v_seed, &iter, bm, BM_VERTS_OF_MESH) {
+		if (BLI_BITMAP_TEST(verts_visit, BM_elem_index_get(v_seed))) {
+			continue;
+		}
+		BLI_BITMAP_ENABLE(verts_visit, BM_elem_index_get(v_seed));
+		verts[vert_tot++] = v_seed;
+
+		for (; vert_step < vert_tot; vert_step++) {
+			BMVert *v = verts[vert_step];
+			BMEdge *e_iter, *e_first;
+
+			if (v->e == NULL) {
+				continue;
+			}
+
+			e_iter = e_first = v->e;
+			do {
+				BMVert *v_other;
+				BMLoop *l_iter, *l_first;
+
+				if (BLI_BITMAP_TEST(edges_visit, BM_elem_index_get(e_iter))) {
+					continue;
+				}
+				BLI_BITMAP_ENABLE(edges_visit, BM_elem_index_get(e_iter));
+				edges[edge_tot++] = e_iter;
+
+				v_other = BM_edge_other_vert(e_iter, v);
+				if (!BLI_BITMAP_TEST(verts_visit, BM_elem_index_get(v_other))) {
+					BLI_BITMAP_ENABLE(verts_visit, BM_elem_index_get(v_other));
+					verts[vert_tot++] = v_other;
+				}
+
+				if ((l_iter = l_first = e_iter->l)) {
+					do {
+						if (!BLI_BITMAP_TEST(faces_visit, BM_elem_index_get(l_iter->f))) {
+							BLI_BITMAP_ENABLE(faces_visit, BM_elem_index_get(l_iter->f));
+							faces[face_tot++] = l_iter->f;
+						}
+					} while ((l_iter = l_iter->radial_next) != l_first);
+				}
+			} while ((e_iter = BM_DISK_EDGE_NEXT(e_iter, v)) != e_first);
+		}
+	}
+
+	BLI_assert(vert_tot == bm->totvert);
+	BLI_assert(edge_tot == bm->totedge);
+	BLI_assert(face_tot == bm->totface);
+	UNUSED_VARS_NDEBUG(edge_tot, face_tot);
+
+	MEM_freeN(verts_visit);
+	MEM_freeN(edges_visit);
+	MEM_freeN(faces_visit);
+}
+
+/**
+ * Replace the custom-data pool with a new one sized for \a totelem,
+ * the old pool is returned so blocks can be copied out of it.
+ */
+static BLI_mempool *bm_mesh_compact_cd_pool_swap(CustomData *data, const int totelem, const char htype)
+{
+	BLI_mempool *pool_old = data->pool;
+
+	if (pool_old) {
+		data->pool = NULL;
+		CustomData_bmesh_init_pool(data, totelem, htype);
+	}
+
+	return pool_old;
+}
+
+BLI_INLINE void bm_mesh_compact_cd_copy(CustomData *data, void **block)
+{
+	if (*block && data->pool) {
+		void *block_new = BLI_mempool_alloc(data->pool);
+		memcpy(block_new, *block, (size_t)data->totsize);
+		*block = block_new;
+	}
+}
+
+typedef struct BMCompactData {
+	/* old element index -> new element */
+	BMVert **vmap;
+	BMEdge **emap;
+	BMLoop **lmap;
+	BMFace **fmap;
+} BMCompactData;
+
+/* the new elements still point to the old ones, which keep their original index */
+#define BM_COMPACT_MAP(map, ele) (map)[BM_elem_index_get(ele)]
+
+static void bm_mesh_compact_verts_cb(void *userdata, const int i)
+{
+	BMCompactData *data = userdata;
+	BMVert *v = data->vmap[i];
+
+	if (v->e) {
+		v->e = BM_COMPACT_MAP(data->emap, v->e);
+	}
+}
+
+static void bm_mesh_compact_edges_cb(void *userdata, const int i)
+{
+	BMCompactData *data = userdata;
+	BMEdge *e = data->emap[i];
+
+	e->v1 = BM_COMPACT_MAP(data->vmap, e->v1);
+	e->v2 = BM_COMPACT_MAP(data->vmap, e->v2);
+	e->v1_disk_link.next = BM_COMPACT_MAP(data->emap, e->v1_disk_link.next);
+	e->v1_disk_link.prev = BM_COMPACT_MAP(data->emap, e->v1_disk_link.prev);
+	e->v2_disk_link.next = BM_COMPACT_MAP(data->emap, e->v2_disk_link.next);
+	e->v2_disk_link.prev = BM_COMPACT_MAP(data->emap, e->v2_disk_link.prev);
+	if (e->l) {
+		e->l = BM_COMPACT_MAP(data->lmap, e->l);
+	}
+}
+
+static void bm_mesh_compact_faces_cb(void *userdata, const int i)
+{
+	BMCompactData *data = userdata;
+	BMFace *f = data->fmap[i];
+	BMLoop *l_iter, *l_first;
+
+	/* loops are only reached from their face, fix them here too */
+	l_iter = l_first = BM_COMPACT_MAP(data->lmap, f->l_first);
+	do {
+		l_iter->v = BM_COMPACT_MAP(data->vmap, l_iter->v);
+		l_iter->e = BM_COMPACT_MAP(data->emap, l_iter->e);
+		l_iter->f = f;
+		l_iter->radial_next = BM_COMPACT_MAP(data->lmap, l_iter->radial_next);
+		l_iter->radial_prev = BM_COMPACT_MAP(data->lmap, l_iter->radial_prev);
+		l_iter->prev = BM_COMPACT_MAP(data->lmap, l_iter->prev);
+		l_iter->next = BM_COMPACT_MAP(data->lmap, l_iter->next);
+	} while ((l_iter = l_iter->next) != l_first);
+
+	f->l_first = l_first;
+}
+
+/**
+ * Reallocate all elements and their custom-data into new pools,
+ * ordered so that topologically connected elements are close in memory.
+ *
+ * This removes the holes left by freed elements and restores locality after heavy editing,
+ * useful after large operations or before running iteration heavy tools on dense meshes.
+ * Indices are valid afterwards, following the new order.
+ *
+ * \note All element pointers are invalidated, this includes lookup tables,
+ * walkers and the edit-mesh tessellation (#BKE_editmesh_tessface_calc needs to run again).
+ * Tool-flags are kept in their own pools and aren't moved.
+ *
+ * \return false when the mesh can't be compacted,
+ * this is the case when Python holds references to the elements.
+ */
+bool BM_mesh_compact(BMesh *bm)
+{
+#ifdef USE_BMESH_HOLES
+	UNUSED_VARS(bm);
+	return false;
+#else
+	BMCompactData data;
+	BLI_mempool *vpool_old, *epool_old, *lpool_old, *fpool_old;
+	BLI_mempool *vdata_pool_old, *edata_pool_old, *ldata_pool_old, *pdata_pool_old;
+	BMVert **verts;
+	BMEdge **edges;
+	BMFace **faces;
+	int i, index_loop;
+
+	if ((CustomData_get_offset(&bm->vdata, CD_BM_ELEM_PYPTR) != -1) ||
+	    (CustomData_get_offset(&bm->edata, CD_BM_ELEM_PYPTR) != -1) ||
+	    (CustomData_get_offset(&bm->ldata, CD_BM_ELEM_PYPTR) != -1) ||
+	    (CustomData_get_offset(&bm->pdata, CD_BM_ELEM_PYPTR) != -1))
+	{
+		return false;
+	}
+
+	/* the indices are used to map old elements to new ones */
+	BM_mesh_elem_index_ensure(bm, BM_ALL);
+
+	verts = MEM_mallocN(sizeof(*verts) * (size_t)bm->totvert, __func__);
+	edges = MEM_mallocN(sizeof(*edges) * (size_t)bm->totedge, __func__);
+	faces = MEM_mallocN(sizeof(*faces) * (size_t)bm->totface, __func__);
+
+	bm_mesh_compact_order(bm, verts, edges, faces);
+
+	data.vmap = MEM_mallocN(sizeof(*data.vmap) * (size_t)bm->totvert, __func__);
+	data.emap = MEM_mallocN(sizeof(*data.emap) * (size_t)bm->totedge, __func__);
+	data.lmap = MEM_mallocN(sizeof(*data.lmap) * (size_t)bm->totloop, __func__);
+	data.fmap = MEM_mallocN(sizeof(*data.fmap) * (size_t)bm->totface, __func__);
+
+	/* new pools, the old elements stay valid until all pointers are remapped */
+	vpool_old = bm->vpool;
+	epool_old = bm->epool;
+	lpool_old = bm->lpool;
+	fpool_old = bm->fpool;
+	{
+		const BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_BM(bm);
+		bm_mempool_init(bm, &allocsize);
+	}
+
+	vdata_pool_old = bm_mesh_compact_cd_pool_swap(&bm->vdata, bm->totvert, BM_VERT);
+	edata_pool_old = bm_mesh_compact_cd_pool_swap(&bm->edata, bm->totedge, BM_EDGE);
+	ldata_pool_old = bm_mesh_compact_cd_pool_swap(&bm->ldata, bm->totloop, BM_LOOP);
+	pdata_pool_old = bm_mesh_compact_cd_pool_swap(&bm->pdata, bm->totface, BM_FACE);
+
+	/* copy elements in their new order, mempools aren't thread-safe so this is done serially */
+	for (i = 0; i < bm->totvert; i++) {
+		BMVert *v_new = BLI_mempool_alloc(bm->vpool);
+		*v_new = *verts[i];
+		bm_mesh_compact_cd_copy(&bm->vdata, &v_new->head.data);
+		BM_elem_index_set(v_new, i); /* set_ok */
+		BM_COMPACT_MAP(data.vmap, verts[i]) = v_new;
+	}
+
+	for (i = 0; i < bm->totedge; i++) {
+		BMEdge *e_new = BLI_mempool_alloc(bm->epool);
+		*e_new = *edges[i];
+		bm_mesh_compact_cd_copy(&bm->edata, &e_new->head.data);
+		BM_elem_index_set(e_new, i); /* set_ok */
+		BM_COMPACT_MAP(data.emap, edges[i]) = e_new;
+	}
+
+	index_loop = 0;
+	for (i = 0; i < bm->totface; i++) {
+		BMFace *f_new = BLI_mempool_alloc(bm->fpool);
+		BMLoop *l_iter, *l_first;
+
+		*f_new = *faces[i];
+		bm_mesh_compact_cd_copy(&bm->pdata, &f_new->head.data);
+		BM_elem_index_set(f_new, i); /* set_ok */
+		BM_COMPACT_MAP(data.fmap, faces[i]) = f_new;
+
+		/* loops of a face are stored next to each other */
+		l_iter = l_first = BM_FACE_FIRST_LOOP(faces[i]);
+		do {
+			BMLoop *l_new = BLI_mempool_alloc(bm->lpool);
+			*l_new = *l_iter;
+			bm_mesh_compact_cd_copy(&bm->ldata, &l_new->head.data);
+			BM_elem_index_set(l_new, index_loop++); /* set_ok */
+			BM_COMPACT_MAP(data.lmap, l_iter) = l_new;
+		} while ((l_iter = l_iter->next) != l_first);
+	}
+
+	BLI_assert(index_loop == bm->totloop);
+
+	/* remap pointers from the old elements to the new ones,
+	 * every element only writes to itself so this can be threaded */
+	BLI_task_parallel_range(0, bm->totvert, &data, bm_mesh_compact_verts_cb, bm->totvert >= BM_OMP_LIMIT);
+	BLI_task_parallel_range(0, bm->totedge, &data, bm_mesh_compact_edges_cb, bm->totedge >= BM_OMP_LIMIT);
+	BLI_task_parallel_range(0, bm->totface, &data, bm_mesh_compact_faces_cb, bm->totface >= BM_OMP_LIMIT);
+
+	/* Selection history */
+	{
+		BMEditSelection *ese;
+		for (ese = bm->selected.first; ese; ese = ese->next) {
+			switch (ese->htype) {
+				case BM_VERT:
+					ese->ele = (BMElem *)BM_COMPACT_MAP(data.vmap, ese->ele);
+					break;
+				case BM_EDGE:
+					ese->ele = (BMElem *)BM_COMPACT_MAP(data.emap, ese->ele);
+					break;
+				case BM_FACE:
+					ese->ele = (BMElem *)BM_COMPACT_MAP(data.fmap, ese->ele);
+					break;
+			}
+		}
+	}
+
+	if (bm->act_face) {
+		bm->act_face = BM_COMPACT_MAP(data.fmap, bm->act_face);
+	}
+
+	BLI_mempool_destroy(vpool_old);
+	BLI_mempool_destroy(epool_old);
+	BLI_mempool_destroy(lpool_old);
+	BLI_mempool_destroy(fpool_old);
+
+	if (vdata_pool_old) BLI_mempool_destroy(vdata_pool_old);
+	if (edata_pool_old) BLI_mempool_destroy(edata_pool_old);
+	if (ldata_pool_old) BLI_mempool_destroy(ldata_pool_old);
+	if (pdata_pool_old) BLI_mempool_destroy(pdata_pool_old);
+
+	bm->elem_index_dirty &= ~BM_ALL;
+	bm->elem_table_dirty |= BM_ALL_NOLOOP;
+
+	MEM_freeN(data.vmap);
+	MEM_freeN(data.emap);
+	MEM_freeN(data.lmap);
+	MEM_freeN(data.fmap);
+
+	MEM_freeN(verts);
+	MEM_freeN(edges);
+	MEM_freeN(faces);
+
+	return true;
+#endif  /* USE_BMESH_HOLES */
+}
+
+#undef BM_COMPACT_MAP
+
+static size_t bm_mesh_cd_memory_usage(CustomData *data)
+{
+	return data->pool ? BLI_mempool_memory_usage(data->pool) : 0;
+}
+
+/**
+ * Memory used by the mesh, split by element pools, custom-data and other storage.
+ * \a used is the memory taken by the elements themselves,
+ * the difference with \a total is taken by free elements in the pools.
+ */
+void BM_mesh_memory_stats(BMesh *bm, BMeshMemStats *r_stats)
+{
+	BMeshMemStats *stats = r_stats;
+
+	memset(stats, 0, sizeof(*stats));
+
+	stats->verts = BLI_mempool_memory_usage(bm->vpool);
+	stats->edges = BLI_mempool_memory_usage(bm->epool);
+	stats->loops = BLI_mempool_memory_usage(bm->lpool);
+	stats->faces = BLI_mempool_memory_usage(bm->fpool);
+
+	stats->customdata = (
+	        bm_mesh_cd_memory_usage(&bm->vdata) +
+	        bm_mesh_cd_memory_usage(&bm->edata) +
+	        bm_mesh_cd_memory_usage(&bm->ldata) +
+	        bm_mesh_cd_memory_usage(&bm->pdata));
+
+	if (bm->vtoolflagpool) {
+		stats->toolflags += BLI_mempool_memory_usage(bm->vtoolflagpool);
+	}
+	if (bm->etoolflagpool) {
+		stats->toolflags += BLI_mempool_memory_usage(bm->etoolflagpool);
+	}
+	if (bm->ftoolflagpool) {
+		stats->toolflags += BLI_mempool_memory_usage(bm->ftoolflagpool);
+	}
+
+	stats->tables = (
+	        sizeof(*bm->vtable) * (size_t)bm->vtable_tot +
+	        sizeof(*bm->etable) * (size_t)bm->etable_tot +
+	        sizeof(*bm->ftable) * (size_t)bm->ftable_tot);
+
+	stats->used = (
+	        sizeof(BMVert) * (size_t)bm->totvert +
+	        sizeof(BMEdge) * (size_t)bm->totedge +
+	        sizeof(BMLoop) * (size_t)bm->totloop +
+	        sizeof(BMFace) * (size_t)bm->totface +
+	        (size_t)bm->vdata.totsize * (size_t)bm->totvert +
+	        (size_t)bm->edata.totsize * (size_t)bm->totedge +
+	        (size_t)bm->ldata.totsize * (size_t)bm->totloop +
+	        (size_t)bm->pdata.totsize * (size_t)bm->totface);
+
+	stats->total = (
+	        sizeof(*bm) +
+	        stats->verts + stats->edges + stats->loops + stats->faces +
+	        stats->customdata + stats->toolflags + stats->tables);
+}
@@ -83,6 +83,22 @@ void BM_mesh_remap(
         const unsigned int *edge_idx,
         const unsigned int *face_idx);
 
+bool BM_mesh_compact(BMesh *bm);
+
+typedef struct BMeshMemStats {
+	/* allocated memory in bytes */
+	size_t verts, edges, loops, faces;
+	size_t customdata;
+	size_t toolflags;
+	size_t tables;
+	size_t total;
+
+	/* memory in bytes taken by elements and their custom-data (excluding free space in the pools) */
+	size_t used;
+} BMeshMemStats;
+
+void BM_mesh_memory_stats(BMesh *bm, BMeshMemStats *r_stats);
+
 typedef struct BMAllocTemplate {
 	int totvert, totedge, totloop, totface;
 } BMAllocTemplate;
@@ -86,6 +86,7 @@
 #include "BLI_listbase.h"
 #include "BLI_alloca.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.h"
 
 #include "BKE_mesh.h"
 #include "BKE_customdata.h"
@@ -98,6 +99,13 @@
 #include "bmesh.h"
 #include "intern/bmesh_private.h" /* for element checking */
 
+// #define DEBUG_TIME
+
+#ifdef DEBUG_TIME
+#  include "PIL_time.h"
+#  include "PIL_time_utildefines.h"
+#endif
+
 /**
  * Currently this is only used for Python scripts
  * which may fail to keep matching UV/TexFace layers.
@@ -217,6 +225,108 @@ static BMFace *bm_face_create_from_mpoly(
 }
 
 
+/* Elements are created on a single thread (they are allocated from the BMesh memory pools
+ * and linked to each other), their custom-data is then copied in parallel. */
+typedef struct BMFromMeshData {
+	BMesh *bm;
+	Mesh *me;
+	BMVert **vtable;
+	BMEdge **etable;
+	BMFace **ftable;
+	int cd_vert_bweight_offset;
+	int cd_edge_bweight_offset;
+	int cd_edge_crease_offset;
+	int cd_shape_keyindex_offset;
+	bool calc_face_normal;
+} BMFromMeshData;
+
+static void bm_from_me_verts_cb(void *userdata, const int i)
+{
+	BMFromMeshData *data = userdata;
+	BMesh *bm = data->bm;
+	Mesh *me = data->me;
+	const MVert *mvert = &me->mvert[i];
+	BMVert *v = data->vtable[i];
+
+	normal_short_to_float_v3(v->no, mvert->no);
+
+	/* Copy Custom Data */
+	CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
+
+	if (data->cd_vert_bweight_offset != -1) {
+		BM_ELEM_CD_SET_FLOAT(v, data->cd_vert_bweight_offset, (float)mvert->bweight / 255.0f);
+	}
+
+	/* set shapekey data */
+	if (me->key) {
+		KeyBlock *block;
+		int j;
+
+		/* set shape key original index */
+		if (data->cd_shape_keyindex_offset != -1) BM_ELEM_CD_SET_INT(v, data->cd_shape_keyindex_offset, i);
+
+		for (block = me->key->block.first, j = 0; block; block = block->next, j++) {
+			float *co = CustomData_bmesh_get_n(&bm->vdata, v->head.data, CD_SHAPEKEY, j);
+
+			if (co) {
+				copy_v3_v3(co, ((float *)block->data) + 3 * i);
+			}
+		}
+	}
+}
+
+static void bm_from_me_edges_cb(void *userdata, const int i)
+{
+	BMFromMeshData *data = userdata;
+	BMesh *bm = data->bm;
+	Mesh *me = data->me;
+	const MEdge *medge = &me->medge[i];
+	BMEdge *e = data->etable[i];
+
+	/* Copy Custom Data */
+	CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
+
+	if (data->cd_edge_bweight_offset != -1) {
+		BM_ELEM_CD_SET_FLOAT(e, data->cd_edge_bweight_offset, (float)medge->bweight / 255.0f);
+	}
+	if (data->cd_edge_crease_offset != -1) {
+		BM_ELEM_CD_SET_FLOAT(e, data->cd_edge_crease_offset, (float)medge->crease / 255.0f);
+	}
+}
+
+static void bm_from_me_faces_cb(void *userdata, const int i)
+{
+	BMFromMeshData *data = userdata;
+	BMesh *bm = data->bm;
+	Mesh *me = data->me;
+	BMFace *f = data->ftable[i];
+	BMLoop *l_iter, *l_first;
+	void **blocks;
+	int j;
+
+	/* skipped bad face */
+	if (f == NULL) {
+		return;
+	}
+
+	/* the loops of the face are consecutive in the mesh, copy them at once */
+	blocks = BLI_array_alloca(blocks, f->len);
+	j = 0;
+	l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+	do {
+		blocks[j++] = l_iter->head.data;
+	} while ((l_iter = l_iter->next) != l_first);
+
+	CustomData_to_bmesh_block_range(&me->ldata, &bm->ldata, me->mpoly[i].loopstart, blocks, f->len, true);
+
+	/* Copy Custom Data */
+	CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
+
+	if (data->calc_face_normal) {
+		BM_face_normal_update(f);
+	}
+}
+
 /**
  * \brief Mesh -> BMesh
  *
@@ -233,14 +343,10 @@ void BM_mesh_bm_from_me(
 	KeyBlock *actkey, *block;
 	BMVert *v, **vtable = NULL;
 	BMEdge *e, **etable = NULL;
-	BMFace *f;
+	BMFace *f, **ftable = NULL;
 	float (*keyco)[3] = NULL;
 	int totuv, totloops, i, j;
-
-	int cd_vert_bweight_offset;
-	int cd_edge_bweight_offset;
-	int cd_edge_crease_offset;
-	int cd_shape_keyindex_offset;
+	BMFromMeshData data;
 
 	/* free custom data */
 	/* this isnt needed in most cases but do just incase */
@@ -264,6 +370,10 @@ void BM_mesh_bm_from_me(
 		return; /* sanity check */
 	}
 
+#ifdef DEBUG_TIME
+	TIMEIT_START(bm_mesh_bm_from_me);
+#endif
+
 	vtable = MEM_mallocN(sizeof(void **) * me->totvert, "mesh to bmesh vtable");
 
 	CustomData_copy(&me->vdata, &bm->vdata, CD_MASK_BMESH, CD_CALLOC, 0);
@@ -324,10 +434,16 @@ void BM_mesh_bm_from_me(
 
 	BM_mesh_cd_flag_apply(bm, me->cd_flag);
 
-	cd_vert_bweight_offset = CustomData_get_offset(&bm->vdata, CD_BWEIGHT);
-	cd_edge_bweight_offset = CustomData_get_offset(&bm->edata, CD_BWEIGHT);
-	cd_edge_crease_offset  = CustomData_get_offset(&bm->edata, CD_CREASE);
-	cd_shape_keyindex_offset = me->key ? CustomData_get_offset(&bm->vdata, CD_SHAPE_KEYINDEX) : -1;
+	data.bm = bm;
+	data.me = me;
+	data.vtable = vtable;
+	data.etable = NULL;
+	data.ftable = NULL;
+	data.cd_vert_bweight_offset = CustomData_get_offset(&bm->vdata, CD_BWEIGHT);
+	data.cd_edge_bweight_offset = CustomData_get_offset(&bm->edata, CD_BWEIGHT);
+	data.cd_edge_crease_offset  = CustomData_get_offset(&bm->edata, CD_CREASE);
+	data.cd_shape_keyindex_offset = me->key ? CustomData_get_offset(&bm->vdata, CD_SHAPE_KEYINDEX) : -1;
+	data.calc_face_normal = calc_face_normal;
 
 	for (i = 0, mvert = me->mvert; i < me->totvert; i++, mvert++) {
 		v = vtable[i] = BM_vert_create(bm, keyco && set_key ? keyco[i] : mvert->co, NULL, BM_CREATE_SKIP_CD);
@@ -341,36 +457,24 @@ void BM_mesh_bm_from_me(
 			BM_vert_select_set(bm, v, true);
 		}
 
-		normal_short_to_float_v3(v->no, mvert->no);
-
-		/* Copy Custom Data */
-		CustomData_to_bmesh_block(&me->vdata, &bm->vdata, i, &v->head.data, true);
-
-		if (cd_vert_bweight_offset != -1) BM_ELEM_CD_SET_FLOAT(v, cd_vert_bweight_offset, (float)mvert->bweight / 255.0f);
-
-		/* set shapekey data */
-		if (me->key) {
-			/* set shape key original index */
-			if (cd_shape_keyindex_offset != -1) BM_ELEM_CD_SET_INT(v, cd_shape_keyindex_offset, i);
-
-			for (block = me->key->block.first, j = 0; block; block = block->next, j++) {
-				float *co = CustomData_bmesh_get_n(&bm->vdata, v->head.data, CD_SHAPEKEY, j);
-
-				if (co) {
-					copy_v3_v3(co, ((float *)block->data) + 3 * i);
-				}
-			}
-		}
+		/* the pool isn't thread safe, custom-data is copied later */
+		CustomData_bmesh_alloc_block(&bm->vdata, &v->head.data);
 	}
 
+	BLI_task_parallel_range(0, me->totvert, &data, bm_from_me_verts_cb, me->totvert >= BM_OMP_LIMIT);
+
 	bm->elem_index_dirty &= ~BM_VERT; /* added in order, clear dirty flag */
 
 	if (!me->totedge) {
 		MEM_freeN(vtable);
+#ifdef DEBUG_TIME
+		TIMEIT_END(bm_mesh_bm_from_me);
+#endif
 		return;
 	}
 
 	etable = MEM_mallocN(sizeof(void **) * me->totedge, "mesh to bmesh etable");
+	data.etable = etable;
 
 	medge = me->medge;
 	for (i = 0; i < me->totedge; i++, medge++) {
@@ -385,24 +489,24 @@ void BM_mesh_bm_from_me(
 			BM_edge_select_set(bm, e, true);
 		}
 
-		/* Copy Custom Data */
-		CustomData_to_bmesh_block(&me->edata, &bm->edata, i, &e->head.data, true);
-
-		if (cd_edge_bweight_offset != -1) BM_ELEM_CD_SET_FLOAT(e, cd_edge_bweight_offset, (float)medge->bweight / 255.0f);
-		if (cd_edge_crease_offset  != -1) BM_ELEM_CD_SET_FLOAT(e, cd_edge_crease_offset,  (float)medge->crease  / 255.0f);
-
+		CustomData_bmesh_alloc_block(&bm->edata, &e->head.data);
 	}
 
+	BLI_task_parallel_range(0, me->totedge, &data, bm_from_me_edges_cb, me->totedge >= BM_OMP_LIMIT);
+
 	bm->elem_index_dirty &= ~BM_EDGE; /* added in order, clear dirty flag */
 
+	ftable = MEM_mallocN(sizeof(void **) * me->totpoly, "mesh to bmesh ftable");
+	data.ftable = ftable;
+
 	mloop = me->mloop;
 	mp = me->mpoly;
 	for (i = 0, totloops = 0; i < me->totpoly; i++, mp++) {
 		BMLoop *l_iter;
 		BMLoop *l_first;
 
-		f = bm_face_create_from_mpoly(mp, mloop + mp->loopstart,
-		                              bm, vtable, etable);
+		f = ftable[i] = bm_face_create_from_mpoly(mp, mloop + mp->loopstart,
+		                                          bm, vtable, etable);
 
 		if (UNLIKELY(f == NULL)) {
 			printf("%s: Warning! Bad face in mesh"
@@ -425,24 +529,19 @@ void BM_mesh_bm_from_me(
 		f->mat_nr = mp->mat_nr;
 		if (i == me->act_face) bm->act_face = f;
 
-		j = mp->loopstart;
 		l_iter = l_first = BM_FACE_FIRST_LOOP(f);
 		do {
 			/* don't use 'j' since we may have skipped some faces, hence some loops. */
 			BM_elem_index_set(l_iter, totloops++); /* set_ok */
 
-			/* Save index of correspsonding MLoop */
-			CustomData_to_bmesh_block(&me->ldata, &bm->ldata, j++, &l_iter->head.data, true);
+			CustomData_bmesh_alloc_block(&bm->ldata, &l_iter->head.data);
 		} while ((l_iter = l_iter->next) != l_first);
 
-		/* Copy Custom Data */
-		CustomData_to_bmesh_block(&me->pdata, &bm->pdata, i, &f->head.data, true);
-
-		if (calc_face_normal) {
-			BM_face_normal_update(f);
-		}
+		CustomData_bmesh_alloc_block(&bm->pdata, &f->head.data);
 	}
 
+	BLI_task_parallel_range(0, me->totpoly, &data, bm_from_me_faces_cb, me->totpoly >= BM_OMP_LIMIT);
+
 	bm->elem_index_dirty &= ~(BM_FACE | BM_LOOP); /* added in order, clear dirty flag */
 
 	if (me->mselect && me->totselect != 0) {
@@ -490,6 +589,11 @@ void BM_mesh_bm_from_me(
 
 	MEM_freeN(vtable);
 	MEM_freeN(etable);
+	MEM_freeN(ftable);
+
+#ifdef DEBUG_TIME
+	TIMEIT_END(bm_mesh_bm_from_me);
+#endif
 }
 
 
@@ -568,22 +672,124 @@ BLI_INLINE void bmesh_quick_edgedraw_flag(MEdge *med, BMEdge *e)
 	}
 }
 
+/* Elements are written to the mesh arrays in parallel, using the element tables of the BMesh. */
+typedef struct BMToMeshData {
+	BMesh *bm;
+	Mesh *me;
+	int cd_vert_bweight_offset;
+	int cd_edge_bweight_offset;
+	int cd_edge_crease_offset;
+} BMToMeshData;
+
+static void bm_to_me_verts_cb(void *userdata, const int i)
+{
+	BMToMeshData *data = userdata;
+	BMesh *bm = data->bm;
+	Mesh *me = data->me;
+	BMVert *v = bm->vtable[i];
+	MVert *mvert = &me->mvert[i];
+
+	copy_v3_v3(mvert->co, v->co);
+	normal_float_to_short_v3(mvert->no, v->no);
+
+	mvert->flag = BM_vert_flag_to_mflag(v);
+
+	BM_elem_index_set(v, i); /* set_inline */
+
+	/* copy over customdat */
+	CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
+
+	if (data->cd_vert_bweight_offset != -1) {
+		mvert->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, data->cd_vert_bweight_offset);
+	}
+
+	BM_CHECK_ELEMENT(v);
+}
+
+static void bm_to_me_edges_cb(void *userdata, const int i)
+{
+	BMToMeshData *data = userdata;
+	BMesh *bm = data->bm;
+	Mesh *me = data->me;
+	BMEdge *e = bm->etable[i];
+	MEdge *med = &me->medge[i];
+
+	med->v1 = BM_elem_index_get(e->v1);
+	med->v2 = BM_elem_index_get(e->v2);
+
+	med->flag = BM_edge_flag_to_mflag(e);
+
+	BM_elem_index_set(e, i); /* set_inline */
+
+	/* copy over customdata */
+	CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
+
+	bmesh_quick_edgedraw_flag(med, e);
+
+	if (data->cd_edge_crease_offset  != -1) med->crease  = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, data->cd_edge_crease_offset);
+	if (data->cd_edge_bweight_offset != -1) med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, data->cd_edge_bweight_offset);
+
+	BM_CHECK_ELEMENT(e);
+}
+
+/* Expects the loop start of the polygons to be set. */
+static void bm_to_me_faces_cb(void *userdata, const int i)
+{
+	BMToMeshData *data = userdata;
+	BMesh *bm = data->bm;
+	Mesh *me = data->me;
+	BMFace *f = bm->ftable[i];
+	MPoly *mpoly = &me->mpoly[i];
+	BMLoop *l_iter, *l_first;
+	MLoop *mloop = &me->mloop[mpoly->loopstart];
+	void **blocks = BLI_array_alloca(blocks, f->len);
+	int j = 0;
+
+	mpoly->mat_nr = f->mat_nr;
+	mpoly->flag = BM_face_flag_to_mflag(f);
+
+	l_iter = l_first = BM_FACE_FIRST_LOOP(f);
+	do {
+		mloop->e = BM_elem_index_get(l_iter->e);
+		mloop->v = BM_elem_index_get(l_iter->v);
+
+		blocks[j++] = l_iter->head.data;
+
+		mloop++;
+		BM_CHECK_ELEMENT(l_iter);
+		BM_CHECK_ELEMENT(l_iter->e);
+		BM_CHECK_ELEMENT(l_iter->v);
+	} while ((l_iter = l_iter->next) != l_first);
+
+	/* copy over customdata, the loops of the face are consecutive in the mesh */
+	CustomData_from_bmesh_block_range(&bm->ldata, &me->ldata, blocks, mpoly->loopstart, f->len);
+
+	/* copy over customdata */
+	CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
+
+	BM_CHECK_ELEMENT(f);
+}
+
 void BM_mesh_bm_to_me(BMesh *bm, Mesh *me, bool do_tessface)
 {
 	MLoop *mloop;
 	MPoly *mpoly;
 	MVert *mvert, *oldverts;
-	MEdge *med, *medge;
-	BMVert *v, *eve;
-	BMEdge *e;
+	MEdge *medge;
+	BMVert *eve;
 	BMFace *f;
 	BMIter iter;
 	int i, j, ototvert;
+	BMToMeshData data;
 
 	const int cd_vert_bweight_offset = CustomData_get_offset(&bm->vdata, CD_BWEIGHT);
 	const int cd_edge_bweight_offset = CustomData_get_offset(&bm->edata, CD_BWEIGHT);
 	const int cd_edge_crease_offset  = CustomData_get_offset(&bm->edata, CD_CREASE);
 
+#ifdef DEBUG_TIME
+	TIMEIT_START(bm_mesh_bm_to_me);
+#endif
+
 	ototvert = me->totvert;
 
 	/* new vertex block */
@@ -644,85 +850,34 @@ void BM_mesh_bm_to_me(BMesh *bm, Mesh *me, bool do_tessface)
 	/* this is called again, 'dotess' arg is used there */
 	BKE_mesh_update_customdata_pointers(me, 0);
 
-	i = 0;
-	BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
-		copy_v3_v3(mvert->co, v->co);
-		normal_float_to_short_v3(mvert->no, v->no);
+	BM_mesh_elem_table_ensure(bm, BM_VERT | BM_EDGE | BM_FACE);
 
-		mvert->flag = BM_vert_flag_to_mflag(v);
+	data.bm = bm;
+	data.me = me;
+	data.cd_vert_bweight_offset = cd_vert_bweight_offset;
+	data.cd_edge_bweight_offset = cd_edge_bweight_offset;
+	data.cd_edge_crease_offset = cd_edge_crease_offset;
 
-		BM_elem_index_set(v, i); /* set_inline */
-
-		/* copy over customdat */
-		CustomData_from_bmesh_block(&bm->vdata, &me->vdata, v->head.data, i);
-
-		if (cd_vert_bweight_offset != -1) mvert->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(v, cd_vert_bweight_offset);
-
-		i++;
-		mvert++;
-
-		BM_CHECK_ELEMENT(v);
-	}
+	BLI_task_parallel_range(0, bm->totvert, &data, bm_to_me_verts_cb, bm->totvert >= BM_OMP_LIMIT);
 	bm->elem_index_dirty &= ~BM_VERT;
 
-	med = medge;
-	i = 0;
-	BM_ITER_MESH (e, &iter, bm, BM_EDGES_OF_MESH) {
-		med->v1 = BM_elem_index_get(e->v1);
-		med->v2 = BM_elem_index_get(e->v2);
-
-		med->flag = BM_edge_flag_to_mflag(e);
-
-		BM_elem_index_set(e, i); /* set_inline */
-
-		/* copy over customdata */
-		CustomData_from_bmesh_block(&bm->edata, &me->edata, e->head.data, i);
-
-		bmesh_quick_edgedraw_flag(med, e);
-
-		if (cd_edge_crease_offset  != -1) med->crease  = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_crease_offset);
-		if (cd_edge_bweight_offset != -1) med->bweight = BM_ELEM_CD_GET_FLOAT_AS_UCHAR(e, cd_edge_bweight_offset);
-
-		i++;
-		med++;
-		BM_CHECK_ELEMENT(e);
-	}
+	/* edges use the vertex indices */
+	BLI_task_parallel_range(0, bm->totedge, &data, bm_to_me_edges_cb, bm->totedge >= BM_OMP_LIMIT);
 	bm->elem_index_dirty &= ~BM_EDGE;
 
-	i = 0;
-	j = 0;
-	BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
-		BMLoop *l_iter, *l_first;
-		mpoly->loopstart = j;
-		mpoly->totloop = f->len;
-		mpoly->mat_nr = f->mat_nr;
-		mpoly->flag = BM_face_flag_to_mflag(f);
-
-		l_iter = l_first = BM_FACE_FIRST_LOOP(f);
-		do {
-			mloop->e = BM_elem_index_get(l_iter->e);
-			mloop->v = BM_elem_index_get(l_iter->v);
-
-			/* copy over customdata */
-			CustomData_from_bmesh_block(&bm->ldata, &me->ldata, l_iter->head.data, j);
-
-			j++;
-			mloop++;
-			BM_CHECK_ELEMENT(l_iter);
-			BM_CHECK_ELEMENT(l_iter->e);
-			BM_CHECK_ELEMENT(l_iter->v);
-		} while ((l_iter = l_iter->next) != l_first);
+	/* the loops of each face are stored after the loops of the previous face */
+	for (i = 0, j = 0; i < bm->totface; i++) {
+		f = bm->ftable[i];
+		mpoly[i].loopstart = j;
+		mpoly[i].totloop = f->len;
+		j += f->len;
 
 		if (f == bm->act_face) me->act_face = i;
-
-		/* copy over customdata */
-		CustomData_from_bmesh_block(&bm->pdata, &me->pdata, f->head.data, i);
-
-		i++;
-		mpoly++;
-		BM_CHECK_ELEMENT(f);
 	}
 
+	/* faces use the edge and vertex indices */
+	BLI_task_parallel_range(0, bm->totface, &data, bm_to_me_faces_cb, bm->totface >= BM_OMP_LIMIT);
+
 	/* patch hook indices and vertex parents */
 	if (ototvert > 0) {
 		Object *ob;
@@ -952,4 +1107,8 @@ void BM_mesh_bm_to_me(BMesh *bm, Mesh *me, bool do_tessface)
 
 	/* topology could be changed, ensure mdisps are ok */
 	multires_topology_changed(me);
+
+#ifdef DEBUG_TIME
+	TIMEIT_END(bm_mesh_bm_to_me);
+#endif
 }
@@ -51,6 +51,7 @@
 
 #include "BLI_kdopbvh.h"
 #include "BLI_buffer.h"
+#include "BLI_task.h"
 
 #include "bmesh.h"
 #include "bmesh_intersect.h"  /* own include */
@@ -832,6 +833,98 @@ static void bm_isect_tri_tri(
 
 #ifdef USE_BVH
 
+/* -------------------------------------------------------------------- */
+/* Threaded BVH Setup & Overlap Filtering */
+
+/* minimum number of triangles or overlapping pairs to use threads for */
+#define ISECT_THREADED_MIN 1024
+
+struct IsectTreeData {
+	BMLoop *(*looptris)[3];
+	int looptris_tot;
+	int (*test_fn)(BMFace *f, void *user_data);
+	void *user_data;
+	float eps_margin;
+
+	/* trees for side 0 and 1 */
+	BVHTree *trees[2];
+};
+
+static void bm_isect_tree_build_cb(void *userdata, const int side)
+{
+	struct IsectTreeData *data = userdata;
+	BMLoop *(*looptris)[3] = data->looptris;
+	BVHTree *tree = BLI_bvhtree_new(data->looptris_tot, data->eps_margin, 8, 8);
+	int i;
+
+	for (i = 0; i < data->looptris_tot; i++) {
+		if (data->test_fn(looptris[i][0]->f, data->user_data) == side) {
+			const float t_cos[3][3] = {
+				{UNPACK3(looptris[i][0]->v->co)},
+				{UNPACK3(looptris[i][1]->v->co)},
+				{UNPACK3(looptris[i][2]->v->co)},
+			};
+
+			BLI_bvhtree_insert(tree, i, (const float *)t_cos, 3);
+		}
+	}
+	BLI_bvhtree_balance(tree);
+
+	data->trees[side] = tree;
+}
+
+/**
+ * Check if all points of \a a_cos are on the same side of the plane of \a b_cos,
+ * further away from it than \a eps, in this case the triangles can't touch.
+ */
+static bool isect_tri_tri_plane_separated(
+        const float *a_cos[3], const float *b_cos[3], const float eps)
+{
+	float plane[4], no[3];
+	float d0, d1, d2;
+
+	if (normal_tri_v3(no, UNPACK3(b_cos)) == 0.0f) {
+		/* degenerate, can't tell */
+		return false;
+	}
+	plane_from_point_normal_v3(plane, b_cos[0], no);
+
+	d0 = dist_signed_to_plane_v3(a_cos[0], plane);
+	d1 = dist_signed_to_plane_v3(a_cos[1], plane);
+	d2 = dist_signed_to_plane_v3(a_cos[2], plane);
+
+	return (((d0 > eps) && (d1 > eps) && (d2 > eps)) ||
+	        ((d0 < -eps) && (d1 < -eps) && (d2 < -eps)));
+}
+
+struct IsectOverlapFilterData {
+	BMLoop *(*looptris)[3];
+	const BVHTreeOverlap *overlap;
+	float eps_margin;
+
+	/* output, false for pairs which can't intersect */
+	bool *overlap_test;
+};
+
+/**
+ * The BVH overlap only compares bounds, reject the pairs which can't intersect before cutting.
+ * This only reads the mesh so it can run threaded, unlike #bm_isect_tri_tri which edits it.
+ *
+ * \note The margin is well above the epsilon used by #bm_isect_tri_tri,
+ * so any pair it would find an intersection for is kept.
+ */
+static void bm_isect_overlap_filter_cb(void *userdata, const int index)
+{
+	struct IsectOverlapFilterData *data = userdata;
+	BMLoop **a = data->looptris[data->overlap[index].indexA];
+	BMLoop **b = data->looptris[data->overlap[index].indexB];
+	const float *f_a_cos[3] = {UNPACK3_EX(, a, ->v->co)};
+	const float *f_b_cos[3] = {UNPACK3_EX(, b, ->v->co)};
+
+	data->overlap_test[index] = !(isect_tri_tri_plane_separated(f_a_cos, f_b_cos, data->eps_margin) ||
+	                              isect_tri_tri_plane_separated(f_b_cos, f_a_cos, data->eps_margin));
+}
+
 struct RaycastData {
 	const float **looptris;
 	BLI_Buffer *z_buffer;
@@ -1052,48 +1145,43 @@ bool BM_mesh_intersect(
 
 #ifdef USE_BVH
 	{
-		int i;
-		tree_a = BLI_bvhtree_new(looptris_tot, s.epsilon.eps_margin, 8, 8);
-		for (i = 0; i < looptris_tot; i++) {
-			if (test_fn(looptris[i][0]->f, user_data) == 0) {
-				const float t_cos[3][3] = {
-					{UNPACK3(looptris[i][0]->v->co)},
-					{UNPACK3(looptris[i][1]->v->co)},
-					{UNPACK3(looptris[i][2]->v->co)},
-				};
-
-				BLI_bvhtree_insert(tree_a, i, (const float *)t_cos, 3);
-			}
-		}
-		BLI_bvhtree_balance(tree_a);
-	}
+		/* both sides are built at once, 'test_fn' must be thread safe */
+		struct IsectTreeData data = {
+			.looptris = looptris,
+			.looptris_tot = looptris_tot,
+			.test_fn = test_fn,
+			.user_data = user_data,
+			.eps_margin = s.epsilon.eps_margin,
+		};
 
-	if (use_self == false) {
-		int i;
-		tree_b = BLI_bvhtree_new(looptris_tot, s.epsilon.eps_margin, 8, 8);
-		for (i = 0; i < looptris_tot; i++) {
-			if (test_fn(looptris[i][0]->f, user_data) == 1) {
-				const float t_cos[3][3] = {
-					{UNPACK3(looptris[i][0]->v->co)},
-					{UNPACK3(looptris[i][1]->v->co)},
-					{UNPACK3(looptris[i][2]->v->co)},
-				};
-
-				BLI_bvhtree_insert(tree_b, i, (const float *)t_cos, 3);
-			}
-		}
-		BLI_bvhtree_balance(tree_b);
-	}
-	else {
-		tree_b = tree_a;
+		BLI_task_parallel_range(
+		        0, use_self ? 1 : 2, &data, bm_isect_tree_build_cb,
+		        looptris_tot >= ISECT_THREADED_MIN);
+
+		tree_a = data.trees[0];
+		tree_b = use_self ? tree_a : data.trees[1];
 	}
 
 	overlap = BLI_bvhtree_overlap(tree_b, tree_a, &tree_overlap_tot, NULL, NULL);
 
 	if (overlap) {
 		unsigned int i;
+		struct IsectOverlapFilterData data = {
+			.looptris = looptris,
+			.overlap = overlap,
+			.eps_margin = s.epsilon.eps_margin,
+		};
+
+		data.overlap_test = MEM_mallocN(sizeof(*data.overlap_test) * tree_overlap_tot, __func__);
+
+		BLI_task_parallel_range(
+		        0, (int)tree_overlap_tot, &data, bm_isect_overlap_filter_cb,
+		        tree_overlap_tot >= ISECT_THREADED_MIN);
 
 		for (i = 0; i < tree_overlap_tot; i++) {
+			if (data.overlap_test[i] == false) {
+				continue;
+			}
 #ifdef USE_DUMP
 			printf("  ((%d, %d), (\n",
 			       overlap[i].indexA,
@@ -1109,6 +1197,7 @@ bool BM_mesh_intersect(
 			printf(")),\n");
 #endif
 		}
+		MEM_freeN(data.overlap_test);
 		MEM_freeN(overlap);
 	}
 
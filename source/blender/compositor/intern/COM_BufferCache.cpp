@@ -0,0 +1,268 @@
+/*
+ * Copyright 2016, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include <map>
+#include <string.h>
+
+#include "COM_BufferCache.h"
+#include "COM_MemoryBuffer.h"
+
+extern "C" {
+#  include "BLI_utildefines.h"
+#  include "BLI_threads.h"
+#  include "DNA_color_types.h"
+#  include "DNA_ID.h"
+#  include "DNA_node_types.h"
+#  include "BKE_node.h"
+}
+
+#include "MEM_guardedalloc.h"
+
+/* seed of the second half of the hash, any value different from the first seed */
+#define COM_BUFFER_HASH_SEED_HIGH 0x9e3779b9
+
+typedef struct BufferCacheEntry {
+	float *buffer;
+	int width;
+	int height;
+	unsigned int num_channels;
+	size_t size;
+	/* value of g_useCounter when the entry was last stored or restored */
+	unsigned int lastUsed;
+} BufferCacheEntry;
+
+typedef std::map<BufferHash, BufferCacheEntry> BufferCacheEntries;
+
+static BufferCacheEntries g_entries;
+static ThreadMutex g_mutex = BLI_MUTEX_INITIALIZER;
+static size_t g_limit = 0;
+static size_t g_memoryInUse = 0;
+static unsigned int g_useCounter = 0;
+
+/* ******** BufferHasher ******** */
+
+BufferHasher::BufferHasher()
+{
+	BLI_hash_mm2a_init(&this->m_low, 0);
+	BLI_hash_mm2a_init(&this->m_high, COM_BUFFER_HASH_SEED_HIGH);
+	this->m_cacheable = true;
+}
+
+void BufferHasher::add(const void *data, size_t len)
+{
+	BLI_hash_mm2a_add(&this->m_low, (const unsigned char *)data, len);
+	BLI_hash_mm2a_add(&this->m_high, (const unsigned char *)data, len);
+}
+
+void BufferHasher::addInt(int value)
+{
+	BLI_hash_mm2a_add_int(&this->m_low, value);
+	BLI_hash_mm2a_add_int(&this->m_high, value);
+}
+
+void BufferHasher::addString(const char *str)
+{
+	add(str, strlen(str));
+}
+
+void BufferHasher::addHash(BufferHash hash)
+{
+	if (hash == 0) {
+		this->m_cacheable = false;
+	}
+	add(&hash, sizeof(hash));
+}
+
+static void buffer_hasher_add_curvemapping(BufferHasher &hasher, const CurveMapping *cumap)
+{
+	/* only the settings used for evaluation, the tables are reallocated on every change */
+	hasher.addInt(cumap->flag);
+	hasher.addInt(cumap->preset);
+	hasher.add(&cumap->clipr, sizeof(cumap->clipr));
+	hasher.add(cumap->black, sizeof(cumap->black));
+	hasher.add(cumap->white, sizeof(cumap->white));
+
+	for (int a = 0; a < CM_TOT; a++) {
+		const CurveMap *cuma = &cumap->cm[a];
+		hasher.addInt(cuma->totpoint);
+		hasher.addInt(cuma->flag);
+		for (int i = 0; i < cuma->totpoint; i++) {
+			hasher.add(&cuma->curve[i].x, sizeof(float));
+			hasher.add(&cuma->curve[i].y, sizeof(float));
+			hasher.addInt(cuma->curve[i].flag & CUMA_VECTOR);
+		}
+	}
+}
+
+void BufferHasher::addNode(const bNode *node)
+{
+	addInt(node->type);
+	addInt(node->custom1);
+	addInt(node->custom2);
+	add(&node->custom3, sizeof(node->custom3));
+	add(&node->custom4, sizeof(node->custom4));
+
+	if (node->id) {
+		/* images, movie clips and scenes tag the nodes using them when their content changes */
+		if (ELEM(GS(node->id->name), ID_IM, ID_MC, ID_SCE)) {
+			add(&node->id, sizeof(node->id));
+			addInt(node->update_stamp);
+		}
+		else {
+			this->m_cacheable = false;
+		}
+	}
+
+	if (node->storage) {
+		if (node->typeinfo && STREQ(node->typeinfo->storagename, "CurveMapping")) {
+			buffer_hasher_add_curvemapping(*this, (const CurveMapping *)node->storage);
+		}
+		else {
+			add(node->storage, MEM_allocN_len(node->storage));
+		}
+	}
+
+	for (bNodeSocket *sock = (bNodeSocket *)node->inputs.first; sock; sock = sock->next) {
+		if (sock->default_value) {
+			add(sock->default_value, MEM_allocN_len(sock->default_value));
+		}
+	}
+}
+
+BufferHash BufferHasher::end()
+{
+	const BufferHash low = BLI_hash_mm2a_end(&this->m_low);
+	const BufferHash high = BLI_hash_mm2a_end(&this->m_high);
+	const BufferHash hash = (high << 32) | low;
+
+	/* 0 is reserved for uncacheable buffers */
+	if (!this->m_cacheable) {
+		return 0;
+	}
+	return hash ? hash : 1;
+}
+
+/* ******** BufferCache ******** */
+
+static void buffer_cache_entry_free(BufferCacheEntries::iterator it)
+{
+	g_memoryInUse -= it->second.size;
+	MEM_freeN(it->second.buffer);
+	g_entries.erase(it);
+}
+
+/* free the least recently used entries until size bytes fit in the limit */
+static void buffer_cache_make_room(size_t size)
+{
+	while (!g_entries.empty() && g_memoryInUse + size > g_limit) {
+		BufferCacheEntries::iterator oldest = g_entries.begin();
+		for (BufferCacheEntries::iterator it = g_entries.begin(); it != g_entries.end(); ++it) {
+			if (it->second.lastUsed < oldest->second.lastUsed) {
+				oldest = it;
+			}
+		}
+		buffer_cache_entry_free(oldest);
+	}
+}
+
+static bool buffer_cache_entry_matches(const BufferCacheEntry &entry, MemoryBuffer *buffer)
+{
+	return (entry.width == buffer->getWidth() &&
+	        entry.height == buffer->getHeight() &&
+	        entry.num_channels == buffer->get_num_channels());
+}
+
+void BufferCache::setLimit(size_t limit)
+{
+	BLI_mutex_lock(&g_mutex);
+	g_limit = limit;
+	buffer_cache_make_room(0);
+	BLI_mutex_unlock(&g_mutex);
+}
+
+bool BufferCache::isEnabled()
+{
+	return g_limit != 0;
+}
+
+bool BufferCache::contains(BufferHash hash)
+{
+	BLI_mutex_lock(&g_mutex);
+	const bool found = (hash != 0 && g_entries.find(hash) != g_entries.end());
+	BLI_mutex_unlock(&g_mutex);
+
+	return found;
+}
+
+bool BufferCache::restore(BufferHash hash, MemoryBuffer *buffer)
+{
+	bool found = false;
+
+	BLI_mutex_lock(&g_mutex);
+	BufferCacheEntries::iterator it = g_entries.find(hash);
+	if (hash != 0 && it != g_entries.end() && buffer_cache_entry_matches(it->second, buffer)) {
+		memcpy(buffer->getBuffer(), it->second.buffer, it->second.size);
+		it->second.lastUsed = ++g_useCounter;
+		buffer->setCreatedState();
+		found = true;
+	}
+	BLI_mutex_unlock(&g_mutex);
+
+	return found;
+}
+
+void BufferCache::store(BufferHash hash, MemoryBuffer *buffer)
+{
+	const size_t size = sizeof(float) * buffer->getWidth() * buffer->getHeight() * buffer->get_num_channels();
+
+	if (hash == 0) {
+		return;
+	}
+
+	BLI_mutex_lock(&g_mutex);
+	if (size <= g_limit && g_entries.find(hash) == g_entries.end()) {
+		buffer_cache_make_room(size);
+
+		BufferCacheEntry entry;
+		entry.buffer = (float *)MEM_mallocN_aligned(size, 16, "COM_BufferCache");
+		entry.width = buffer->getWidth();
+		entry.height = buffer->getHeight();
+		entry.num_channels = buffer->get_num_channels();
+		entry.size = size;
+		entry.lastUsed = ++g_useCounter;
+		memcpy(entry.buffer, buffer->getBuffer(), size);
+
+		g_entries[hash] = entry;
+		g_memoryInUse += size;
+	}
+	BLI_mutex_unlock(&g_mutex);
+}
+
+void BufferCache::clear()
+{
+	BLI_mutex_lock(&g_mutex);
+	while (!g_entries.empty()) {
+		buffer_cache_entry_free(g_entries.begin());
+	}
+	BLI_mutex_unlock(&g_mutex);
+}
+
+size_t BufferCache::getMemoryInUse()
+{
+	return g_memoryInUse;
+}
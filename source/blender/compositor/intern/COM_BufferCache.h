@@ -0,0 +1,128 @@
+/*
+ * Copyright 2016, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _COM_BufferCache_h_
+#define _COM_BufferCache_h_
+
+#include <stddef.h>
+
+extern "C" {
+#  include "BLI_sys_types.h"
+#  include "BLI_hash_mm2a.h"
+}
+
+class MemoryBuffer;
+struct bNode;
+
+/**
+ * @brief hash identifying the content of a buffer
+ * 0 is used for buffers that can not be identified and are never cached.
+ * @ingroup Memory
+ */
+typedef uint64_t BufferHash;
+
+/**
+ * @brief Helper to construct a BufferHash from the settings of the operations
+ * calculating a buffer.
+ * @ingroup Memory
+ */
+class BufferHasher {
+private:
+	BLI_HashMurmur2A m_low;
+	BLI_HashMurmur2A m_high;
+
+	/**
+	 * @brief false when the data can change without the hashed settings changing
+	 */
+	bool m_cacheable;
+
+public:
+	BufferHasher();
+
+	void add(const void *data, size_t len);
+	void addInt(int value);
+	void addString(const char *str);
+
+	/**
+	 * @brief add the hash of an input, an input that can't be cached makes the result uncacheable too
+	 */
+	void addHash(BufferHash hash);
+
+	/**
+	 * @brief add the settings of an editor node
+	 * the storage, the socket values and the ID used by the node are hashed. Nodes using
+	 * data that isn't tagged when it is changed (see bNode.update_stamp) make the result uncacheable.
+	 */
+	void addNode(const bNode *node);
+
+	/**
+	 * @brief get the resulting hash, 0 when the result can't be cached
+	 */
+	BufferHash end();
+};
+
+/**
+ * @brief Cache of the results of ExecutionGroup's between compositor executions.
+ *
+ * The buffers are identified by a BufferHash of all operations calculating them,
+ * when a node changes only the buffers depending on it get a different hash
+ * and have to be recalculated. The least recently used buffers are freed when the
+ * memory limit is reached.
+ * @ingroup Memory
+ */
+class BufferCache {
+public:
+	/**
+	 * @brief set the maximum memory used by the cache in bytes, 0 disables the cache
+	 */
+	static void setLimit(size_t limit);
+
+	/**
+	 * @brief is the cache enabled
+	 */
+	static bool isEnabled();
+
+	/**
+	 * @brief is there a buffer for the hash
+	 */
+	static bool contains(BufferHash hash);
+
+	/**
+	 * @brief copy the cached data for the hash to buffer
+	 * @return false when there is no cached buffer for the hash
+	 */
+	static bool restore(BufferHash hash, MemoryBuffer *buffer);
+
+	/**
+	 * @brief copy the content of buffer to the cache
+	 * @note least recently used buffers are freed to stay below the memory limit
+	 */
+	static void store(BufferHash hash, MemoryBuffer *buffer);
+
+	/**
+	 * @brief free all cached buffers
+	 */
+	static void clear();
+
+	/**
+	 * @brief get the memory used by the cached buffers in bytes
+	 */
+	static size_t getMemoryInUse();
+};
+
+#endif /* _COM_BufferCache_h_ */
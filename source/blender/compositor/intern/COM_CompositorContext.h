@@ -82,6 +82,11 @@ private:
 	 */
 	bool m_fastCalculation;
 
+	/**
+	 * @brief Execute every operation on its whole buffer instead of per chunk
+	 */
+	bool m_fullFrame;
+
 	/* @brief color management settings */
 	const ColorManagedViewSettings *m_viewSettings;
 	const ColorManagedDisplaySettings *m_displaySettings;
@@ -199,6 +204,8 @@ public:
 	
 	void setFastCalculation(bool fastCalculation) {this->m_fastCalculation = fastCalculation;}
 	bool isFastCalculation() const { return this->m_fastCalculation; }
+	void setFullFrame(bool fullFrame) { this->m_fullFrame = fullFrame; }
+	bool isFullFrame() const { return this->m_fullFrame; }
 	bool isGroupnodeBufferEnabled() const { return (this->getbNodeTree()->flag & NTREE_COM_GROUPNODE_BUFFER) != 0; }
 };
 
@@ -57,6 +57,8 @@ ExecutionGroup::ExecutionGroup()
 	this->m_numberOfXChunks = 0;
 	this->m_numberOfYChunks = 0;
 	this->m_numberOfChunks = 0;
+	this->m_fullFrame = false;
+	this->m_chunkRows = 0;
 	this->m_initialized = false;
 	this->m_openCL = false;
 	this->m_singleThreaded = false;
@@ -168,6 +170,15 @@ void ExecutionGroup::determineNumberOfChunks()
 		this->m_numberOfYChunks = 1;
 		this->m_numberOfChunks = 1;
 	}
+	else if (this->m_fullFrame) {
+		/* bands of complete rows, with about as many pixels as a tile */
+		const int border_width = BLI_rcti_size_x(&this->m_viewerBorder);
+		const int border_height = BLI_rcti_size_y(&this->m_viewerBorder);
+		this->m_chunkRows = max_ii(1, (this->m_chunkSize * this->m_chunkSize) / max_ii(border_width, 1));
+		this->m_numberOfXChunks = 1;
+		this->m_numberOfYChunks = (border_height + this->m_chunkRows - 1) / this->m_chunkRows;
+		this->m_numberOfChunks = this->m_numberOfYChunks;
+	}
 	else {
 		const float chunkSizef = this->m_chunkSize;
 		const int border_width = BLI_rcti_size_x(&this->m_viewerBorder);
@@ -350,6 +361,57 @@ void ExecutionGroup::execute(ExecutionSystem *graph)
 	MEM_freeN(chunkOrder);
 }
 
+void ExecutionGroup::executeFullFrame(ExecutionSystem *graph)
+{
+	const CompositorContext &context = graph->getContext();
+	const bNodeTree *bTree = context.getbNodeTree();
+	if (this->m_width == 0 || this->m_height == 0) {return; } /// @note: break out... no pixels to calculate.
+	if (bTree->test_break && bTree->test_break(bTree->tbh)) {return; }
+	if (this->m_numberOfChunks == 0) {return; } /// @note: early break out
+	unsigned int chunkNumber;
+	unsigned int index;
+
+	this->m_executionStartTime = PIL_check_seconds_timer();
+
+	this->m_chunksFinished = 0;
+	this->m_bTree = bTree;
+
+	/* the input buffers are allocated just before their ExecutionGroup is executed */
+	for (index = 0; index < this->m_cachedReadOperations.size(); index++) {
+		ReadBufferOperation *readOperation = (ReadBufferOperation *)this->m_cachedReadOperations[index];
+		readOperation->updateMemoryBuffer();
+	}
+
+	DebugInfo::execution_group_started(this);
+
+	for (chunkNumber = 0; chunkNumber < this->m_numberOfChunks; chunkNumber++) {
+		scheduleChunk(chunkNumber);
+	}
+	WorkScheduler::finish();
+
+	DebugInfo::execution_group_finished(this);
+}
+
+void ExecutionGroup::setExecuted()
+{
+	for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+		this->m_chunkExecutionStates[index] = COM_ES_EXECUTED;
+	}
+}
+
+bool ExecutionGroup::isExecuted() const
+{
+	if (this->m_numberOfChunks == 0) {
+		return false;
+	}
+	for (unsigned int index = 0; index < this->m_numberOfChunks; index++) {
+		if (this->m_chunkExecutionStates[index] != COM_ES_EXECUTED) {
+			return false;
+		}
+	}
+	return true;
+}
+
 MemoryBuffer **ExecutionGroup::getInputBuffersOpenCL(int chunkNumber)
 {
 	rcti rect;
@@ -418,6 +480,13 @@ inline void ExecutionGroup::determineChunkRect(rcti *rect, const unsigned int xC
 	if (this->m_singleThreaded) {
 		BLI_rcti_init(rect, this->m_viewerBorder.xmin, border_width, this->m_viewerBorder.ymin, border_height);
 	}
+	else if (this->m_fullFrame) {
+		const unsigned int miny = yChunk * this->m_chunkRows + this->m_viewerBorder.ymin;
+		const unsigned int width = min((unsigned int) this->m_viewerBorder.xmax, this->m_width);
+		const unsigned int height = min((unsigned int) this->m_viewerBorder.ymax, this->m_height);
+		BLI_rcti_init(rect, min((unsigned int) this->m_viewerBorder.xmin, width), width,
+		              min(miny, height), min(miny + this->m_chunkRows, height));
+	}
 	else {
 		const unsigned int minx = xChunk * this->m_chunkSize + this->m_viewerBorder.xmin;
 		const unsigned int miny = yChunk * this->m_chunkSize + this->m_viewerBorder.ymin;
@@ -110,6 +110,17 @@ private:
 	 * @brief total number of chunks
 	 */
 	unsigned int m_numberOfChunks;
+
+	/**
+	 * @brief execute the whole buffer at once in chunks of complete rows
+	 * @see executeFullFrame
+	 */
+	bool m_fullFrame;
+
+	/**
+	 * @brief number of rows in a chunk when executing full frames
+	 */
+	unsigned int m_chunkRows;
 	
 	/**
 	 * @brief contains this ExecutionGroup a complex NodeOperation.
@@ -375,6 +386,27 @@ public:
 	 * @param system
 	 */
 	void execute(ExecutionSystem *system);
+
+	/**
+	 * @brief mark all chunks as executed
+	 * @note used when the output buffer is restored from the BufferCache
+	 */
+	void setExecuted();
+
+	/**
+	 * @brief are all chunks of this ExecutionGroup executed
+	 */
+	bool isExecuted() const;
+
+	/**
+	 * @brief execute the whole ExecutionGroup at once
+	 * @note all ExecutionGroup's this group depends on must be executed and their
+	 * @note MemoryProxy's allocated, no area of interest is determined.
+	 * The chunks are bands of complete rows that are all scheduled on the WorkScheduler,
+	 * this method returns when they are calculated.
+	 * @param system
+	 */
+	void executeFullFrame(ExecutionSystem *system);
 	
 	/**
 	 * @brief this method determines the MemoryProxy's where this execution group depends on.
@@ -399,6 +431,12 @@ public:
 
 	void setChunksize(int chunksize) { this->m_chunkSize = chunksize; }
 
+	/**
+	 * @brief set whether this ExecutionGroup will be executed as a full frame
+	 * @note must be set before initExecution
+	 */
+	void setFullFrame(bool fullFrame) { this->m_fullFrame = fullFrame; }
+
 	/**
 	 * @brief get the Render priority of this ExecutionGroup
 	 * @see ExecutionSystem.execute
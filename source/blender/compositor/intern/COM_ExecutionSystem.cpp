@@ -22,6 +22,10 @@
 
 #include "COM_ExecutionSystem.h"
 
+#include <map>
+#include <set>
+#include <typeinfo>
+
 #include "PIL_time.h"
 #include "BLI_utildefines.h"
 extern "C" {
@@ -36,6 +40,7 @@ extern "C" {
 #include "COM_ExecutionGroup.h"
 #include "COM_WorkScheduler.h"
 #include "COM_ReadBufferOperation.h"
+#include "COM_WriteBufferOperation.h"
 #include "COM_Debug.h"
 
 #ifdef WITH_CXX_GUARDEDALLOC
@@ -51,6 +56,11 @@ ExecutionSystem::ExecutionSystem(RenderData *rd, Scene *scene, bNodeTree *editin
 	this->m_context.setbNodeTree(editingtree);
 	this->m_context.setPreviewHash(editingtree->previews);
 	this->m_context.setFastCalculation(fastcalculation);
+	this->m_context.setFullFrame(editingtree->flag & NTREE_COM_FULL_FRAME);
+
+	/* final renders always get new render results, only cache while editing */
+	this->m_useBufferCache = BufferCache::isEnabled() && !rendering;
+	this->m_contextHash = 0;
 	/* initialize the CompositorContext */
 	if (rendering) {
 		this->m_context.setQuality((CompositorQuality)editingtree->render_quality);
@@ -143,11 +153,13 @@ void ExecutionSystem::execute()
 		}
 	}
 	unsigned int index;
+	const bool fullFrame = this->m_context.isFullFrame();
 
-	// First allocale all write buffer
+	// First allocale all write buffer, unless they are allocated during full frame execution
 	for (index = 0; index < this->m_operations.size(); index++) {
 		NodeOperation *operation = this->m_operations[index];
 		if (operation->isWriteBufferOperation()) {
+			((WriteBufferOperation *)operation)->setDeferAllocation(fullFrame);
 			operation->setbNodeTree(this->m_context.getbNodeTree());
 			operation->initExecution();
 		}
@@ -171,15 +183,31 @@ void ExecutionSystem::execute()
 	for (index = 0; index < this->m_groups.size(); index++) {
 		ExecutionGroup *executionGroup = this->m_groups[index];
 		executionGroup->setChunksize(this->m_context.getChunksize());
+		executionGroup->setFullFrame(fullFrame);
 		executionGroup->initExecution();
 	}
 
+	if (this->m_useBufferCache) {
+		restoreCachedBuffers();
+	}
+
 	WorkScheduler::start(this->m_context);
 
-	executeGroups(COM_PRIORITY_HIGH);
-	if (!this->getContext().isFastCalculation()) {
-		executeGroups(COM_PRIORITY_MEDIUM);
-		executeGroups(COM_PRIORITY_LOW);
+	if (fullFrame) {
+		executeFullFrame();
+	}
+	else {
+		executeGroups(COM_PRIORITY_HIGH);
+		if (!this->getContext().isFastCalculation()) {
+			executeGroups(COM_PRIORITY_MEDIUM);
+			executeGroups(COM_PRIORITY_LOW);
+		}
+
+		if (this->m_useBufferCache) {
+			for (index = 0; index < this->m_groups.size(); index++) {
+				storeCachedBuffer(this->m_groups[index]);
+			}
+		}
 	}
 
 	WorkScheduler::finish();
@@ -208,6 +236,201 @@ void ExecutionSystem::executeGroups(CompositorPriority priority)
 	}
 }
 
+/* add the group after all groups it depends on */
+static void full_frame_order_add(ExecutionGroup *group, std::set<ExecutionGroup *> &added, ExecutionSystem::Groups &order)
+{
+	/* already added, or restored from the buffer cache */
+	if (added.find(group) != added.end() || group->isExecuted()) {
+		return;
+	}
+	added.insert(group);
+
+	vector<MemoryProxy *> memoryProxies;
+	group->determineDependingMemoryProxies(&memoryProxies);
+	for (unsigned int index = 0; index < memoryProxies.size(); index++) {
+		ExecutionGroup *inputGroup = memoryProxies[index]->getExecutor();
+		if (inputGroup) {
+			full_frame_order_add(inputGroup, added, order);
+		}
+	}
+
+	order.push_back(group);
+}
+
+void ExecutionSystem::executeFullFrame()
+{
+	const CompositorPriority priorities[] = {COM_PRIORITY_HIGH, COM_PRIORITY_MEDIUM, COM_PRIORITY_LOW};
+	const int numPriorities = this->m_context.isFastCalculation() ? 1 : 3;
+	std::set<ExecutionGroup *> added;
+	Groups order;
+	unsigned int index;
+
+	for (int priority = 0; priority < numPriorities; priority++) {
+		vector<ExecutionGroup *> outputGroups;
+		this->findOutputExecutionGroup(&outputGroups, priorities[priority]);
+		for (index = 0; index < outputGroups.size(); index++) {
+			full_frame_order_add(outputGroups[index], added, order);
+		}
+	}
+
+	/* number of groups still to read each buffer */
+	typedef std::map<MemoryProxy *, int> ReaderMap;
+	ReaderMap readers;
+	vector<std::set<MemoryProxy *> > groupInputs(order.size());
+	for (index = 0; index < order.size(); index++) {
+		vector<MemoryProxy *> memoryProxies;
+		order[index]->determineDependingMemoryProxies(&memoryProxies);
+		groupInputs[index].insert(memoryProxies.begin(), memoryProxies.end());
+		for (std::set<MemoryProxy *>::iterator it = groupInputs[index].begin(); it != groupInputs[index].end(); ++it) {
+			readers[*it]++;
+		}
+	}
+
+	const bNodeTree *editingtree = this->m_context.getbNodeTree();
+	for (index = 0; index < order.size(); index++) {
+		if (editingtree->test_break && editingtree->test_break(editingtree->tbh)) {
+			break;
+		}
+
+		ExecutionGroup *group = order[index];
+		NodeOperation *operation = group->getOutputOperation();
+		if (operation->isWriteBufferOperation()) {
+			WriteBufferOperation *writeOperation = (WriteBufferOperation *)operation;
+			writeOperation->getMemoryProxy()->allocate(writeOperation->getWidth(), writeOperation->getHeight());
+		}
+
+		group->executeFullFrame(this);
+		if (this->m_useBufferCache) {
+			storeCachedBuffer(group);
+		}
+
+		for (std::set<MemoryProxy *>::iterator it = groupInputs[index].begin(); it != groupInputs[index].end(); ++it) {
+			if (--readers[*it] == 0) {
+				(*it)->free();
+			}
+		}
+	}
+}
+
+BufferHash ExecutionSystem::hashOperation(NodeOperation *operation)
+{
+	OperationHashes::iterator it = this->m_operationHashes.find(operation);
+	if (it != this->m_operationHashes.end()) {
+		return it->second;
+	}
+
+	BufferHasher hasher;
+	unsigned int index;
+
+	hasher.addHash(this->m_contextHash);
+	hasher.addString(typeid(*operation).name());
+	hasher.addInt(operation->getWidth());
+	hasher.addInt(operation->getHeight());
+	for (index = 0; index < operation->getNumberOfOutputSockets(); index++) {
+		hasher.addInt(operation->getOutputSocket(index)->getDataType());
+	}
+
+	if (operation->isReadBufferOperation()) {
+		ReadBufferOperation *readOperation = (ReadBufferOperation *)operation;
+		hasher.addHash(hashOperation(readOperation->getMemoryProxy()->getWriteBufferOperation()));
+	}
+	else {
+		if (operation->isSetOperation()) {
+			float value[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+			operation->readSampled(value, 0.0f, 0.0f, COM_PS_NEAREST);
+			hasher.add(value, sizeof(value));
+		}
+
+		const bNode *bnode = operation->getbNode();
+		if (bnode) {
+			hasher.addNode(bnode);
+			hasher.addInt(operation->getbNodeIndex());
+		}
+
+		for (index = 0; index < operation->getNumberOfInputSockets(); index++) {
+			NodeOperationInput *input = operation->getInputSocket(index);
+			hasher.addInt(input->getDataType());
+			hasher.addInt(input->getResizeMode());
+			if (input->isConnected()) {
+				hasher.addHash(hashOperation(&input->getLink()->getOperation()));
+			}
+		}
+	}
+
+	BufferHash hash = hasher.end();
+	this->m_operationHashes[operation] = hash;
+	return hash;
+}
+
+WriteBufferOperation *ExecutionSystem::getCachedWriteBufferOperation(ExecutionGroup *group)
+{
+	/* only the results of expensive operations are worth the memory */
+	NodeOperation *operation = group->getOutputOperation();
+	if (!operation->isWriteBufferOperation() || !group->isComplex()) {
+		return NULL;
+	}
+	return (WriteBufferOperation *)operation;
+}
+
+void ExecutionSystem::restoreCachedBuffers()
+{
+	const CompositorContext &context = this->m_context;
+	const RenderData *rd = context.getRenderData();
+	const Scene *scene = context.getScene();
+	const char *viewName = context.getViewName();
+	unsigned int index;
+
+	BufferHasher hasher;
+	hasher.add(&scene, sizeof(scene));
+	hasher.addInt(context.getFramenumber());
+	hasher.addInt(context.getQuality());
+	hasher.addInt(context.isFastCalculation());
+	hasher.addInt(rd->size);
+	hasher.addInt(rd->xsch);
+	hasher.addInt(rd->ysch);
+	hasher.addString(viewName ? viewName : "");
+	this->m_contextHash = hasher.end();
+	this->m_operationHashes.clear();
+
+	for (index = 0; index < this->m_groups.size(); index++) {
+		ExecutionGroup *group = this->m_groups[index];
+		WriteBufferOperation *writeOperation = getCachedWriteBufferOperation(group);
+		if (!writeOperation) {
+			continue;
+		}
+
+		BufferHash hash = hashOperation(writeOperation);
+		if (!BufferCache::contains(hash)) {
+			continue;
+		}
+
+		/* in full frame mode buffers are only allocated when needed */
+		MemoryProxy *memoryProxy = writeOperation->getMemoryProxy();
+		if (!memoryProxy->getBuffer()) {
+			memoryProxy->allocate(writeOperation->getWidth(), writeOperation->getHeight());
+		}
+
+		if (BufferCache::restore(hash, memoryProxy->getBuffer())) {
+			group->setExecuted();
+		}
+	}
+}
+
+void ExecutionSystem::storeCachedBuffer(ExecutionGroup *group)
+{
+	const bNodeTree *editingtree = this->m_context.getbNodeTree();
+	WriteBufferOperation *writeOperation = getCachedWriteBufferOperation(group);
+
+	/* a break leaves chunks partially calculated */
+	if (!writeOperation || !group->isExecuted() ||
+	    (editingtree->test_break && editingtree->test_break(editingtree->tbh)))
+	{
+		return;
+	}
+
+	BufferCache::store(hashOperation(writeOperation), writeOperation->getMemoryProxy()->getBuffer());
+}
+
 void ExecutionSystem::findOutputExecutionGroup(vector<ExecutionGroup *> *result, CompositorPriority priority) const
 {
 	unsigned int index;
@@ -31,6 +31,11 @@ class ExecutionGroup;
 #include "BKE_text.h"
 #include "COM_ExecutionGroup.h"
 #include "COM_NodeOperation.h"
+#include "COM_BufferCache.h"
+
+#include <map>
+
+class WriteBufferOperation;
 
 /**
  * @page execution Execution model
@@ -114,6 +119,7 @@ class ExecutionSystem {
 public:
 	typedef std::vector<NodeOperation*> Operations;
 	typedef std::vector<ExecutionGroup*> Groups;
+	typedef std::map<NodeOperation*, BufferHash> OperationHashes;
 	
 private:
 	/**
@@ -131,6 +137,21 @@ private:
 	 */
 	Groups m_groups;
 
+	/**
+	 * @brief are results of ExecutionGroup's restored from and stored in the BufferCache
+	 */
+	bool m_useBufferCache;
+
+	/**
+	 * @brief hash of the context settings used by operations
+	 */
+	BufferHash m_contextHash;
+
+	/**
+	 * @brief hashes of the results of the operations, see hashOperation
+	 */
+	OperationHashes m_operationHashes;
+
 private: //methods
 	/**
 	 * find all execution group with output nodes
@@ -177,6 +198,38 @@ public:
 private:
 	void executeGroups(CompositorPriority priority);
 
+	/**
+	 * @brief execute every needed ExecutionGroup once on its whole buffer
+	 *  - order the groups so every group comes after the groups it reads from
+	 *  - allocate the MemoryProxy of a group just before it is executed
+	 *  - free the MemoryProxy as soon as its last reading group is executed
+	 */
+	void executeFullFrame();
+
+	/**
+	 * @brief hash identifying the result of an operation
+	 * the settings of the operation and its editor node and the hashes of its inputs are combined.
+	 * @return the hash, 0 when the result can't be cached
+	 */
+	BufferHash hashOperation(NodeOperation *operation);
+
+	/**
+	 * @brief get the WriteBufferOperation of a group that is worth to cache
+	 * @return NULL when the result of the group isn't cached
+	 */
+	WriteBufferOperation *getCachedWriteBufferOperation(ExecutionGroup *group);
+
+	/**
+	 * @brief restore the results of the ExecutionGroup's found in the BufferCache
+	 * restored groups are marked executed, so the groups they depend on are not scheduled.
+	 */
+	void restoreCachedBuffers();
+
+	/**
+	 * @brief store the result of an executed ExecutionGroup in the BufferCache
+	 */
+	void storeCachedBuffer(ExecutionGroup *group);
+
 	/* allow the DebugInfo class to look at internals */
 	friend class DebugInfo;
 
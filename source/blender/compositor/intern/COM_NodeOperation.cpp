@@ -41,6 +41,8 @@ NodeOperation::NodeOperation()
 	this->m_isResolutionSet = false;
 	this->m_openCL = false;
 	this->m_btree = NULL;
+	this->m_bnode = NULL;
+	this->m_bnodeIndex = 0;
 }
 
 NodeOperation::~NodeOperation()
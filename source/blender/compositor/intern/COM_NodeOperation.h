@@ -125,6 +125,17 @@ private:
 	 * @brief set to truth when resolution for this operation is set
 	 */
 	bool m_isResolutionSet;
+
+	/**
+	 * @brief the editor node this operation is created for, NULL when added during conversion
+	 * @see BufferCache
+	 */
+	const bNode *m_bnode;
+
+	/**
+	 * @brief number of operations created for the editor node before this one
+	 */
+	unsigned int m_bnodeIndex;
 	
 public:
 	virtual ~NodeOperation();
@@ -235,6 +246,15 @@ public:
 
 	void getConnectedInputSockets(Inputs *sockets);
 
+	/**
+	 * @brief set the editor node this operation is created for
+	 * @param bnode the editor node
+	 * @param index number of operations created for the node before this one
+	 */
+	void setbNode(const bNode *bnode, unsigned int index) { this->m_bnode = bnode; this->m_bnodeIndex = index; }
+	const bNode *getbNode() const { return this->m_bnode; }
+	unsigned int getbNodeIndex() const { return this->m_bnodeIndex; }
+
 	/**
 	 * @brief is this operation complex
 	 *
@@ -0,0 +1,384 @@
+/*
+ * Copyright 2016, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _COM_RowKernels_h_
+#define _COM_RowKernels_h_
+
+#include <math.h>
+
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
+/**
+ * @brief number of pixels operations calculate at once in SocketReader::executeRow
+ * the inputs of a span are read into buffers on the stack.
+ */
+#define COM_ROW_SPAN 256
+
+/**
+ * @brief Kernels calculating a span of contiguous RGBA pixels.
+ *
+ * Used by the executeRow implementations of pixel-wise operations. Every kernel has
+ * an SSE2 version processing a whole pixel per instruction, the scalar loop is used
+ * when SSE2 isn't available. The kernels give the same result as the executePixelSampled
+ * methods of the operations using them.
+ * @ingroup Operation
+ */
+class RowKernels {
+public:
+	/**
+	 * @brief signature of the mix kernels
+	 * @param output the result, 4 channels per pixel
+	 * @param value the factor of every pixel, 1 channel per pixel
+	 * @param color1 the first color, 4 channels per pixel
+	 * @param color2 the second color, 4 channels per pixel
+	 * @param width the number of pixels
+	 */
+	typedef void (*MixFunc)(float *output, const float *value, const float *color1, const float *color2, int width);
+
+#ifdef __SSE2__
+	/* output with the rgb of rgb and the alpha of alpha */
+	static inline __m128 keepAlpha(__m128 rgb, __m128 alpha)
+	{
+		const __m128 mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+		return _mm_or_ps(_mm_and_ps(mask, rgb), _mm_andnot_ps(mask, alpha));
+	}
+#endif
+
+	/**
+	 * @brief multiply the factors with the alpha of color, see MixBaseOperation::useValueAlphaMultiply
+	 */
+	static inline void mulAlpha(float *value, const float *color, int width)
+	{
+		for (int i = 0; i < width; i++) {
+			value[i] *= color[i * 4 + 3];
+		}
+	}
+
+	/**
+	 * @brief clamp all channels to the [0, 1] range
+	 */
+	static inline void clamp(float *output, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		const __m128 zero = _mm_setzero_ps();
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i < width; i++) {
+			const __m128 c = _mm_loadu_ps(&output[i * 4]);
+			_mm_storeu_ps(&output[i * 4], _mm_min_ps(_mm_max_ps(c, zero), one));
+		}
+#endif
+		for (; i < width; i++) {
+			for (int c = 0; c < 4; c++) {
+				float *f = &output[i * 4 + c];
+				*f = (*f < 0.0f) ? 0.0f : (*f > 1.0f) ? 1.0f : *f;
+			}
+		}
+	}
+
+	static void mixBlend(float *output, const float *value, const float *color1, const float *color2, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i < width; i++) {
+			const __m128 c1 = _mm_loadu_ps(&color1[i * 4]);
+			const __m128 c2 = _mm_loadu_ps(&color2[i * 4]);
+			const __m128 fac = _mm_set1_ps(value[i]);
+			const __m128 facm = _mm_sub_ps(one, fac);
+			const __m128 r = _mm_add_ps(_mm_mul_ps(facm, c1), _mm_mul_ps(fac, c2));
+			_mm_storeu_ps(&output[i * 4], keepAlpha(r, c1));
+		}
+#endif
+		for (; i < width; i++) {
+			const float *c1 = &color1[i * 4], *c2 = &color2[i * 4];
+			const float fac = value[i], facm = 1.0f - fac;
+			float *out = &output[i * 4];
+			out[0] = facm * c1[0] + fac * c2[0];
+			out[1] = facm * c1[1] + fac * c2[1];
+			out[2] = facm * c1[2] + fac * c2[2];
+			out[3] = c1[3];
+		}
+	}
+
+	static void mixAdd(float *output, const float *value, const float *color1, const float *color2, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		for (; i < width; i++) {
+			const __m128 c1 = _mm_loadu_ps(&color1[i * 4]);
+			const __m128 c2 = _mm_loadu_ps(&color2[i * 4]);
+			const __m128 fac = _mm_set1_ps(value[i]);
+			const __m128 r = _mm_add_ps(c1, _mm_mul_ps(fac, c2));
+			_mm_storeu_ps(&output[i * 4], keepAlpha(r, c1));
+		}
+#endif
+		for (; i < width; i++) {
+			const float *c1 = &color1[i * 4], *c2 = &color2[i * 4];
+			const float fac = value[i];
+			float *out = &output[i * 4];
+			out[0] = c1[0] + fac * c2[0];
+			out[1] = c1[1] + fac * c2[1];
+			out[2] = c1[2] + fac * c2[2];
+			out[3] = c1[3];
+		}
+	}
+
+	static void mixSubtract(float *output, const float *value, const float *color1, const float *color2, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		for (; i < width; i++) {
+			const __m128 c1 = _mm_loadu_ps(&color1[i * 4]);
+			const __m128 c2 = _mm_loadu_ps(&color2[i * 4]);
+			const __m128 fac = _mm_set1_ps(value[i]);
+			const __m128 r = _mm_sub_ps(c1, _mm_mul_ps(fac, c2));
+			_mm_storeu_ps(&output[i * 4], keepAlpha(r, c1));
+		}
+#endif
+		for (; i < width; i++) {
+			const float *c1 = &color1[i * 4], *c2 = &color2[i * 4];
+			const float fac = value[i];
+			float *out = &output[i * 4];
+			out[0] = c1[0] - fac * c2[0];
+			out[1] = c1[1] - fac * c2[1];
+			out[2] = c1[2] - fac * c2[2];
+			out[3] = c1[3];
+		}
+	}
+
+	static void mixMultiply(float *output, const float *value, const float *color1, const float *color2, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i < width; i++) {
+			const __m128 c1 = _mm_loadu_ps(&color1[i * 4]);
+			const __m128 c2 = _mm_loadu_ps(&color2[i * 4]);
+			const __m128 fac = _mm_set1_ps(value[i]);
+			const __m128 facm = _mm_sub_ps(one, fac);
+			const __m128 r = _mm_mul_ps(c1, _mm_add_ps(facm, _mm_mul_ps(fac, c2)));
+			_mm_storeu_ps(&output[i * 4], keepAlpha(r, c1));
+		}
+#endif
+		for (; i < width; i++) {
+			const float *c1 = &color1[i * 4], *c2 = &color2[i * 4];
+			const float fac = value[i], facm = 1.0f - fac;
+			float *out = &output[i * 4];
+			out[0] = c1[0] * (facm + fac * c2[0]);
+			out[1] = c1[1] * (facm + fac * c2[1]);
+			out[2] = c1[2] * (facm + fac * c2[2]);
+			out[3] = c1[3];
+		}
+	}
+
+	static void mixScreen(float *output, const float *value, const float *color1, const float *color2, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i < width; i++) {
+			const __m128 c1 = _mm_loadu_ps(&color1[i * 4]);
+			const __m128 c2 = _mm_loadu_ps(&color2[i * 4]);
+			const __m128 fac = _mm_set1_ps(value[i]);
+			const __m128 facm = _mm_sub_ps(one, fac);
+			const __m128 t = _mm_add_ps(facm, _mm_mul_ps(fac, _mm_sub_ps(one, c2)));
+			const __m128 r = _mm_sub_ps(one, _mm_mul_ps(t, _mm_sub_ps(one, c1)));
+			_mm_storeu_ps(&output[i * 4], keepAlpha(r, c1));
+		}
+#endif
+		for (; i < width; i++) {
+			const float *c1 = &color1[i * 4], *c2 = &color2[i * 4];
+			const float fac = value[i], facm = 1.0f - fac;
+			float *out = &output[i * 4];
+			out[0] = 1.0f - (facm + fac * (1.0f - c2[0])) * (1.0f - c1[0]);
+			out[1] = 1.0f - (facm + fac * (1.0f - c2[1])) * (1.0f - c1[1]);
+			out[2] = 1.0f - (facm + fac * (1.0f - c2[2])) * (1.0f - c1[2]);
+			out[3] = c1[3];
+		}
+	}
+
+	static void mixDifference(float *output, const float *value, const float *color1, const float *color2, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		const __m128 one = _mm_set1_ps(1.0f);
+		const __m128 abs_mask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+		for (; i < width; i++) {
+			const __m128 c1 = _mm_loadu_ps(&color1[i * 4]);
+			const __m128 c2 = _mm_loadu_ps(&color2[i * 4]);
+			const __m128 fac = _mm_set1_ps(value[i]);
+			const __m128 facm = _mm_sub_ps(one, fac);
+			const __m128 diff = _mm_and_ps(_mm_sub_ps(c1, c2), abs_mask);
+			const __m128 r = _mm_add_ps(_mm_mul_ps(facm, c1), _mm_mul_ps(fac, diff));
+			_mm_storeu_ps(&output[i * 4], keepAlpha(r, c1));
+		}
+#endif
+		for (; i < width; i++) {
+			const float *c1 = &color1[i * 4], *c2 = &color2[i * 4];
+			const float fac = value[i], facm = 1.0f - fac;
+			float *out = &output[i * 4];
+			out[0] = facm * c1[0] + fac * fabsf(c1[0] - c2[0]);
+			out[1] = facm * c1[1] + fac * fabsf(c1[1] - c2[1]);
+			out[2] = facm * c1[2] + fac * fabsf(c1[2] - c2[2]);
+			out[3] = c1[3];
+		}
+	}
+
+	static void mixDarken(float *output, const float *value, const float *color1, const float *color2, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i < width; i++) {
+			const __m128 c1 = _mm_loadu_ps(&color1[i * 4]);
+			const __m128 c2 = _mm_loadu_ps(&color2[i * 4]);
+			const __m128 fac = _mm_set1_ps(value[i]);
+			const __m128 facm = _mm_sub_ps(one, fac);
+			const __m128 r = _mm_add_ps(_mm_mul_ps(_mm_min_ps(c1, c2), fac), _mm_mul_ps(c1, facm));
+			_mm_storeu_ps(&output[i * 4], keepAlpha(r, c1));
+		}
+#endif
+		for (; i < width; i++) {
+			const float *c1 = &color1[i * 4], *c2 = &color2[i * 4];
+			const float fac = value[i], facm = 1.0f - fac;
+			float *out = &output[i * 4];
+			out[0] = ((c1[0] < c2[0]) ? c1[0] : c2[0]) * fac + c1[0] * facm;
+			out[1] = ((c1[1] < c2[1]) ? c1[1] : c2[1]) * fac + c1[1] * facm;
+			out[2] = ((c1[2] < c2[2]) ? c1[2] : c2[2]) * fac + c1[2] * facm;
+			out[3] = c1[3];
+		}
+	}
+
+	static void mixLighten(float *output, const float *value, const float *color1, const float *color2, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		for (; i < width; i++) {
+			const __m128 c1 = _mm_loadu_ps(&color1[i * 4]);
+			const __m128 c2 = _mm_loadu_ps(&color2[i * 4]);
+			const __m128 fac = _mm_set1_ps(value[i]);
+			const __m128 r = _mm_max_ps(c1, _mm_mul_ps(fac, c2));
+			_mm_storeu_ps(&output[i * 4], keepAlpha(r, c1));
+		}
+#endif
+		for (; i < width; i++) {
+			const float *c1 = &color1[i * 4], *c2 = &color2[i * 4];
+			const float fac = value[i];
+			float *out = &output[i * 4];
+			for (int c = 0; c < 3; c++) {
+				const float tmp = fac * c2[c];
+				out[c] = (tmp > c1[c]) ? tmp : c1[c];
+			}
+			out[3] = c1[3];
+		}
+	}
+
+	/**
+	 * @brief replace the alpha of color by alpha, see SetAlphaOperation
+	 */
+	static void setAlpha(float *output, const float *color, const float *alpha, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		for (; i < width; i++) {
+			const __m128 c = _mm_loadu_ps(&color[i * 4]);
+			_mm_storeu_ps(&output[i * 4], keepAlpha(c, _mm_set1_ps(alpha[i])));
+		}
+#endif
+		for (; i < width; i++) {
+			output[i * 4 + 0] = color[i * 4 + 0];
+			output[i * 4 + 1] = color[i * 4 + 1];
+			output[i * 4 + 2] = color[i * 4 + 2];
+			output[i * 4 + 3] = alpha[i];
+		}
+	}
+
+	/**
+	 * @brief grayscale color with an opaque alpha, see ConvertValueToColorOperation
+	 */
+	static void valueToColor(float *output, const float *value, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		const __m128 one = _mm_set1_ps(1.0f);
+		for (; i < width; i++) {
+			_mm_storeu_ps(&output[i * 4], keepAlpha(_mm_set1_ps(value[i]), one));
+		}
+#endif
+		for (; i < width; i++) {
+			output[i * 4 + 0] = output[i * 4 + 1] = output[i * 4 + 2] = value[i];
+			output[i * 4 + 3] = 1.0f;
+		}
+	}
+
+	/**
+	 * @brief see ConvertStraightToPremulOperation
+	 */
+	static void straightToPremul(float *output, const float *color, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		for (; i < width; i++) {
+			const __m128 c = _mm_loadu_ps(&color[i * 4]);
+			const __m128 alpha = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 3, 3));
+			_mm_storeu_ps(&output[i * 4], keepAlpha(_mm_mul_ps(c, alpha), c));
+		}
+#endif
+		for (; i < width; i++) {
+			const float alpha = color[i * 4 + 3];
+			output[i * 4 + 0] = color[i * 4 + 0] * alpha;
+			output[i * 4 + 1] = color[i * 4 + 1] * alpha;
+			output[i * 4 + 2] = color[i * 4 + 2] * alpha;
+			output[i * 4 + 3] = alpha;
+		}
+	}
+
+	/**
+	 * @brief see ConvertPremulToStraightOperation, colors with a zero alpha become black
+	 */
+	static void premulToStraight(float *output, const float *color, int width)
+	{
+		int i = 0;
+#ifdef __SSE2__
+		for (; i < width; i++) {
+			const __m128 c = _mm_loadu_ps(&color[i * 4]);
+			const float alpha = color[i * 4 + 3];
+			const __m128 r = (fabsf(alpha) < 1e-5f) ? _mm_setzero_ps() : _mm_mul_ps(c, _mm_set1_ps(1.0f / alpha));
+			_mm_storeu_ps(&output[i * 4], keepAlpha(r, c));
+		}
+#endif
+		for (; i < width; i++) {
+			const float alpha = color[i * 4 + 3];
+			if (fabsf(alpha) < 1e-5f) {
+				output[i * 4 + 0] = output[i * 4 + 1] = output[i * 4 + 2] = 0.0f;
+			}
+			else {
+				const float fac = 1.0f / alpha;
+				output[i * 4 + 0] = color[i * 4 + 0] * fac;
+				output[i * 4 + 1] = color[i * 4 + 1] * fac;
+				output[i * 4 + 2] = color[i * 4 + 2] * fac;
+			}
+			output[i * 4 + 3] = alpha;
+		}
+	}
+};
+
+#endif /* _COM_RowKernels_h_ */
@@ -22,4 +22,10 @@
 
 #include "COM_SocketReader.h"
 
-
+void SocketReader::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	for (int x = xmin; x < xmax; x++) {
+		executePixelSampled(output, x, y, COM_PS_NEAREST);
+		output += num_channels;
+	}
+}
@@ -95,6 +95,19 @@ protected:
 	                                  float /*x*/, float /*y*/,
 	                                  float /*dx*/[2], float /*dy*/[2]) {}
 
+	/**
+	 * @brief calculate a row of pixels
+	 * @note this method is called for non-complex, the default implementation calls
+	 * executePixelSampled for every pixel. Operations can override it with a loop that
+	 * the compiler can vectorize.
+	 * @param output the result of the first pixel, pixels are num_channels floats apart
+	 * @param xmin the x-coordinate of the first pixel to calculate in image space
+	 * @param xmax the x-coordinate after the last pixel to calculate
+	 * @param y the y-coordinate of the row in image space
+	 * @param num_channels the number of channels of a pixel in output
+	 */
+	virtual void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
+
 public:
 	inline void readSampled(float result[4], float x, float y, PixelSampler sampler) {
 		executePixelSampled(result, x, y, sampler);
@@ -105,6 +118,9 @@ public:
 	inline void readFiltered(float result[4], float x, float y, float dx[2], float dy[2]) {
 		executePixelFiltered(result, x, y, dx, dy);
 	}
+	inline void readRow(float *result, int xmin, int xmax, int y, unsigned int num_channels) {
+		executeRow(result, xmin, xmax, y, num_channels);
+	}
 
 	virtual void *initializeTileData(rcti * /*rect*/) { return 0; }
 	virtual void deinitializeTileData(rcti * /*rect*/, void * /*data*/) {}
@@ -24,6 +24,7 @@
 extern "C" {
 #include "BKE_node.h"
 #include "BLI_threads.h"
+#include "DNA_userdef_types.h"
 }
 
 #include "BLT_translation.h"
@@ -31,6 +32,7 @@ extern "C" {
 #include "BKE_scene.h"
 
 #include "COM_compositor.h"
+#include "COM_BufferCache.h"
 #include "COM_ExecutionSystem.h"
 #include "COM_WorkScheduler.h"
 #include "clew.h"
@@ -72,6 +74,8 @@ void COM_execute(RenderData *rd, Scene *scene, bNodeTree *editingtree, int rende
 	bool use_opencl = (editingtree->flag & NTREE_COM_OPENCL) != 0;
 	WorkScheduler::initialize(use_opencl, BKE_render_num_threads(rd));
 
+	BufferCache::setLimit(((size_t)U.compositorcachelimit) * 1024 * 1024);
+
 	/* set progress bar to 0% and status to init compositing */
 	editingtree->progress(editingtree->prh, 0.0);
 	editingtree->stats_draw(editingtree->sdh, IFACE_("Compositing"));
@@ -99,8 +103,15 @@ void COM_execute(RenderData *rd, Scene *scene, bNodeTree *editingtree, int rende
 	BLI_mutex_unlock(&s_compositorMutex);
 }
 
+void COM_clearCaches()
+{
+	BufferCache::clear();
+}
+
 void COM_deinitialize()
 {
+	BufferCache::clear();
+
 	if (is_compositorMutex_init) {
 		BLI_mutex_lock(&s_compositorMutex);
 		WorkScheduler::deinitialize();
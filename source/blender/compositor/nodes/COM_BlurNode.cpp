@@ -29,6 +29,7 @@
 #include "COM_ExecutionSystem.h"
 #include "COM_GaussianBokehBlurOperation.h"
 #include "COM_FastGaussianBlurOperation.h"
+#include "COM_RecursiveBlurOperation.h"
 #include "COM_MathBaseOperation.h"
 #include "COM_SetValueOperation.h"
 #include "COM_GammaCorrectOperation.h"
@@ -51,6 +52,12 @@ void BlurNode::convertToOperations(NodeConverter &converter, const CompositorCon
 	CompositorQuality quality = context.getQuality();
 	NodeOperation *input_operation = NULL, *output_operation = NULL;
 
+	/* the radius is only known here for absolute sizes, relative sizes depend on the input resolution */
+	float radius = 0.0f;
+	if (!connectedSizeSocket && !data->relative) {
+		radius = size * max_ii(data->sizex, data->sizey);
+	}
+
 	if (data->filtertype == R_FILTER_FAST_GAUSS) {
 		FastGaussianBlurOperation *operationfgb = new FastGaussianBlurOperation();
 		operationfgb->setData(data);
@@ -106,6 +113,19 @@ void BlurNode::convertToOperations(NodeConverter &converter, const CompositorCon
 		output_operation = operation;
 		input_operation = operation;
 	}
+	else if (!data->bokeh && radius >= BLUR_RECURSIVE_MIN_RADIUS && RecursiveBlurOperation::isFilterSupported(data->filtertype)) {
+		/* large radius, cost of the recursive filters doesn't depend on it */
+		RecursiveBlurOperation *operation = new RecursiveBlurOperation();
+		operation->setData(data);
+		operation->setSize(size);
+		operation->setExtendBounds(extend_bounds);
+		converter.addOperation(operation);
+
+		converter.mapInputSocket(getInputSocket(1), operation->getInputSocket(1));
+
+		input_operation = operation;
+		output_operation = operation;
+	}
 	else if (!data->bokeh) {
 		GaussianXBlurOperation *operationx = new GaussianXBlurOperation();
 		operationx->setData(data);
@@ -135,7 +155,14 @@ void BlurNode::convertToOperations(NodeConverter &converter, const CompositorCon
 		output_operation = operationy;
 	}
 	else {
-		GaussianBokehBlurOperation *operation = new GaussianBokehBlurOperation();
+		GaussianBokehBlurOperation *operation;
+		if (radius >= BLUR_FFT_MIN_RADIUS) {
+			/* large radius, convolve in the frequency domain */
+			operation = new GaussianBokehBlurFFTOperation();
+		}
+		else {
+			operation = new GaussianBokehBlurOperation();
+		}
 		operation->setData(data);
 		operation->setQuality(quality);
 		operation->setExtendBounds(extend_bounds);
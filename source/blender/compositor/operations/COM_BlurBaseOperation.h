@@ -27,6 +27,11 @@
 
 #define MAX_GAUSSTAB_RADIUS 30000
 
+/* radius from which the blur node uses RecursiveBlurOperation instead of the separable gaussian */
+#define BLUR_RECURSIVE_MIN_RADIUS 64
+/* radius from which the blur node uses GaussianBokehBlurFFTOperation for bokeh blurs */
+#define BLUR_FFT_MIN_RADIUS 24
+
 #ifdef __SSE2__
 #  include <emmintrin.h>
 #endif
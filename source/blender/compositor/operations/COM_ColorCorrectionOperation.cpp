@@ -21,6 +21,7 @@
  */
 
 #include "COM_ColorCorrectionOperation.h"
+#include "COM_RowKernels.h"
 #include "BLI_math.h"
 
 extern "C" {
@@ -44,13 +45,8 @@ void ColorCorrectionOperation::initExecution()
 	this->m_inputMask = this->getInputSocketReader(1);
 }
 
-void ColorCorrectionOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
+inline void ColorCorrectionOperation::correctPixel(float output[4], const float inputImageColor[4], float maskValue)
 {
-	float inputImageColor[4];
-	float inputMask[4];
-	this->m_inputImage->readSampled(inputImageColor, x, y, sampler);
-	this->m_inputMask->readSampled(inputMask, x, y, sampler);
-	
 	float level = (inputImageColor[0] + inputImageColor[1] + inputImageColor[2]) / 3.0f;
 	float contrast = this->m_data->master.contrast;
 	float saturation = this->m_data->master.saturation;
@@ -59,7 +55,7 @@ void ColorCorrectionOperation::executePixelSampled(float output[4], float x, flo
 	float lift = this->m_data->master.lift;
 	float r, g, b;
 	
-	float value = inputMask[0];
+	float value = maskValue;
 	value = min(1.0f, value);
 	const float mvalue = 1.0f - value;
 	
@@ -139,6 +135,41 @@ void ColorCorrectionOperation::executePixelSampled(float output[4], float x, flo
 	output[3] = inputImageColor[3];
 }
 
+void ColorCorrectionOperation::executePixelSampled(float output[4], float x, float y, PixelSampler sampler)
+{
+	float inputImageColor[4];
+	float inputMask[4];
+	this->m_inputImage->readSampled(inputImageColor, x, y, sampler);
+	this->m_inputMask->readSampled(inputMask, x, y, sampler);
+
+	correctPixel(output, inputImageColor, inputMask[0]);
+}
+
+void ColorCorrectionOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	float inputImageColor[COM_ROW_SPAN * 4];
+	/* value operations may write up to 4 floats for their last pixel */
+	float inputMask[COM_ROW_SPAN + 3];
+
+	if (num_channels != COM_NUM_CHANNELS_COLOR) {
+		NodeOperation::executeRow(output, xmin, xmax, y, num_channels);
+		return;
+	}
+
+	for (int x = xmin; x < xmax; x += COM_ROW_SPAN) {
+		const int width = min_ii(COM_ROW_SPAN, xmax - x);
+
+		this->m_inputImage->readRow(inputImageColor, x, x + width, y, COM_NUM_CHANNELS_COLOR);
+		this->m_inputMask->readRow(inputMask, x, x + width, y, COM_NUM_CHANNELS_VALUE);
+
+		/* the settings depend on the level of every pixel, use the scalar code of executePixelSampled */
+		for (int i = 0; i < width; i++) {
+			correctPixel(output, &inputImageColor[i * 4], inputMask[i]);
+			output += COM_NUM_CHANNELS_COLOR;
+		}
+	}
+}
+
 void ColorCorrectionOperation::deinitExecution()
 {
 	this->m_inputImage = NULL;
@@ -38,6 +38,11 @@ private:
 	bool m_greenChannelEnabled;
 	bool m_blueChannelEnabled;
 
+	/**
+	 * @brief correct a single pixel, shared by executePixelSampled and executeRow
+	 */
+	inline void correctPixel(float output[4], const float inputImageColor[4], float maskValue);
+
 public:
 	ColorCorrectionOperation();
 	
@@ -45,6 +50,7 @@ public:
 	 * the inner loop of this program
 	 */
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 	
 	/**
 	 * Initialize the execution
@@ -41,6 +41,27 @@ void ConvertBaseOperation::deinitExecution()
 	this->m_inputOperation = NULL;
 }
 
+void ConvertBaseOperation::executeRowKernel(float *output, int xmin, int xmax, int y, unsigned int num_channels,
+                                            unsigned int input_channels, unsigned int output_channels, RowFunc kernel)
+{
+	/* room for 4 channels, operations may write up to 4 floats for their last pixel */
+	float input[COM_ROW_SPAN * 4];
+
+	if (num_channels != output_channels) {
+		NodeOperation::executeRow(output, xmin, xmax, y, num_channels);
+		return;
+	}
+
+	for (int x = xmin; x < xmax; x += COM_ROW_SPAN) {
+		const int width = min_ii(COM_ROW_SPAN, xmax - x);
+
+		this->m_inputOperation->readRow(input, x, x + width, y, input_channels);
+		kernel(output, input, width);
+
+		output += width * output_channels;
+	}
+}
+
 
 /* ******** Value to Color ******** */
 
@@ -58,6 +79,12 @@ void ConvertValueToColorOperation::executePixelSampled(float output[4], float x,
 	output[3] = 1.0f;
 }
 
+void ConvertValueToColorOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels,
+	                 COM_NUM_CHANNELS_VALUE, COM_NUM_CHANNELS_COLOR, RowKernels::valueToColor);
+}
+
 
 /* ******** Color to Value ******** */
 
@@ -74,6 +101,19 @@ void ConvertColorToValueOperation::executePixelSampled(float output[4], float x,
 	output[0] = (inputColor[0] + inputColor[1] + inputColor[2]) / 3.0f;
 }
 
+static void convert_color_to_value_row(float *output, const float *input, int width)
+{
+	for (int i = 0; i < width; i++, input += 4) {
+		output[i] = (input[0] + input[1] + input[2]) / 3.0f;
+	}
+}
+
+void ConvertColorToValueOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels,
+	                 COM_NUM_CHANNELS_COLOR, COM_NUM_CHANNELS_VALUE, convert_color_to_value_row);
+}
+
 
 /* ******** Color to BW ******** */
 
@@ -90,6 +130,19 @@ void ConvertColorToBWOperation::executePixelSampled(float output[4], float x, fl
 	output[0] = IMB_colormanagement_get_luminance(inputColor);
 }
 
+static void convert_color_to_bw_row(float *output, const float *input, int width)
+{
+	for (int i = 0; i < width; i++, input += 4) {
+		output[i] = IMB_colormanagement_get_luminance(input);
+	}
+}
+
+void ConvertColorToBWOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels,
+	                 COM_NUM_CHANNELS_COLOR, COM_NUM_CHANNELS_VALUE, convert_color_to_bw_row);
+}
+
 
 /* ******** Color to Vector ******** */
 
@@ -105,6 +158,19 @@ void ConvertColorToVectorOperation::executePixelSampled(float output[4], float x
 	this->m_inputOperation->readSampled(color, x, y, sampler);
 	copy_v3_v3(output, color);}
 
+static void convert_color_to_vector_row(float *output, const float *input, int width)
+{
+	for (int i = 0; i < width; i++, input += 4, output += 3) {
+		copy_v3_v3(output, input);
+	}
+}
+
+void ConvertColorToVectorOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels,
+	                 COM_NUM_CHANNELS_COLOR, COM_NUM_CHANNELS_VECTOR, convert_color_to_vector_row);
+}
+
 
 /* ******** Value to Vector ******** */
 
@@ -136,6 +202,20 @@ void ConvertVectorToColorOperation::executePixelSampled(float output[4], float x
 	output[3] = 1.0f;
 }
 
+static void convert_vector_to_color_row(float *output, const float *input, int width)
+{
+	for (int i = 0; i < width; i++, input += 3, output += 4) {
+		copy_v3_v3(output, input);
+		output[3] = 1.0f;
+	}
+}
+
+void ConvertVectorToColorOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels,
+	                 COM_NUM_CHANNELS_VECTOR, COM_NUM_CHANNELS_COLOR, convert_vector_to_color_row);
+}
+
 
 /* ******** Vector to Value ******** */
 
@@ -327,6 +407,12 @@ void ConvertPremulToStraightOperation::executePixelSampled(float output[4], floa
 	output[3] = alpha;
 }
 
+void ConvertPremulToStraightOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels,
+	                 COM_NUM_CHANNELS_COLOR, COM_NUM_CHANNELS_COLOR, RowKernels::premulToStraight);
+}
+
 
 /* ******** Straight to Premul ******** */
 
@@ -350,6 +436,12 @@ void ConvertStraightToPremulOperation::executePixelSampled(float output[4], floa
 	output[3] = alpha;
 }
 
+void ConvertStraightToPremulOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels,
+	                 COM_NUM_CHANNELS_COLOR, COM_NUM_CHANNELS_COLOR, RowKernels::straightToPremul);
+}
+
 
 /* ******** Separate Channels ******** */
 
@@ -24,12 +24,26 @@
 #define _COM_ConvertOperation_h
 
 #include "COM_NodeOperation.h"
+#include "COM_RowKernels.h"
 
 
 class ConvertBaseOperation : public NodeOperation {
 protected:
 	SocketReader *m_inputOperation;
 	
+	/**
+	 * @brief signature of the kernels converting a span of contiguous pixels
+	 */
+	typedef void (*RowFunc)(float *output, const float *input, int width);
+
+	/**
+	 * @brief calculate a row in spans with a kernel
+	 * @param input_channels the number of channels of the input datatype
+	 * @param output_channels the number of channels of the output datatype
+	 */
+	void executeRowKernel(float *output, int xmin, int xmax, int y, unsigned int num_channels,
+	                      unsigned int input_channels, unsigned int output_channels, RowFunc kernel);
+
 public:
 	ConvertBaseOperation();
 	
@@ -43,6 +57,7 @@ public:
 	ConvertValueToColorOperation();
 	
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 
@@ -51,6 +66,7 @@ public:
 	ConvertColorToValueOperation();
 	
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 
@@ -59,6 +75,7 @@ public:
 	ConvertColorToBWOperation();
 	
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 
@@ -67,6 +84,7 @@ public:
 	ConvertColorToVectorOperation();
 	
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 
@@ -83,6 +101,7 @@ public:
 	ConvertVectorToColorOperation();
 	
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 
@@ -159,6 +178,7 @@ public:
 	ConvertPremulToStraightOperation();
 
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 
@@ -167,6 +187,7 @@ public:
 	ConvertStraightToPremulOperation();
 
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2011, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor:
+ *		Jeroen Bakker
+ *		Monique Dewanchand
+ */
+
+#ifndef _COM_FastConvolution_h
+#define _COM_FastConvolution_h
+
+#include "COM_defines.h"
+
+/**
+ * @brief Convolution of images with large kernels using the 2D Fast Hartley Transform.
+ * The cost doesn't depend on the size of the kernel, used by the fog glow and large bokeh blurs.
+ */
+class FastConvolution {
+public:
+	/**
+	 * @brief convolve the first channels of image with the matching channels of kernel
+	 * The image is processed in blocks with the overlap-add method, pixels outside the image are zero.
+	 * @param dst the result, same size as image, channels that aren't convolved are set to zero
+	 * @param image RGBA pixels of the image
+	 * @param kernel RGBA pixels of the kernel, normalized in place per channel
+	 * @param channels the number of channels to convolve
+	 * @note dst and image can't be the same buffer
+	 */
+	static void convolve(float *dst, const float *image, int imageWidth, int imageHeight,
+	                     float *kernel, int kernelWidth, int kernelHeight, int channels);
+};
+
+#endif
@@ -21,6 +21,7 @@
  */
 
 #include "COM_GammaOperation.h"
+#include "COM_RowKernels.h"
 #include "BLI_math.h"
 
 GammaOperation::GammaOperation() : NodeOperation()
@@ -53,6 +54,36 @@ void GammaOperation::executePixelSampled(float output[4], float x, float y, Pixe
 	output[3] = inputValue[3];
 }
 
+void GammaOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	float inputValue[COM_ROW_SPAN * 4];
+	/* value operations may write up to 4 floats for their last pixel */
+	float inputGamma[COM_ROW_SPAN + 3];
+
+	if (num_channels != COM_NUM_CHANNELS_COLOR) {
+		NodeOperation::executeRow(output, xmin, xmax, y, num_channels);
+		return;
+	}
+
+	for (int x = xmin; x < xmax; x += COM_ROW_SPAN) {
+		const int width = min_ii(COM_ROW_SPAN, xmax - x);
+
+		this->m_inputProgram->readRow(inputValue, x, x + width, y, COM_NUM_CHANNELS_COLOR);
+		this->m_inputGammaProgram->readRow(inputGamma, x, x + width, y, COM_NUM_CHANNELS_VALUE);
+
+		/* there is no SSE power function, keep the scalar powf of executePixelSampled */
+		for (int i = 0; i < width; i++) {
+			const float *color = &inputValue[i * 4];
+			const float gamma = inputGamma[i];
+			output[0] = color[0] > 0.0f ? powf(color[0], gamma) : color[0];
+			output[1] = color[1] > 0.0f ? powf(color[1], gamma) : color[1];
+			output[2] = color[2] > 0.0f ? powf(color[2], gamma) : color[2];
+			output[3] = color[3];
+			output += COM_NUM_CHANNELS_COLOR;
+		}
+	}
+}
+
 void GammaOperation::deinitExecution()
 {
 	this->m_inputProgram = NULL;
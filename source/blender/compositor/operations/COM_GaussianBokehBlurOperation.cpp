@@ -21,6 +21,7 @@
  */
 
 #include "COM_GaussianBokehBlurOperation.h"
+#include "COM_FastConvolution.h"
 #include "BLI_math.h"
 #include "MEM_guardedalloc.h"
 extern "C" {
@@ -199,6 +200,118 @@ bool GaussianBokehBlurOperation::determineDependingAreaOfInterest(rcti *input, R
 	}
 }
 
+/* ******** Gaussian Bokeh Blur FFT Operation ******** */
+
+GaussianBokehBlurFFTOperation::GaussianBokehBlurFFTOperation() : GaussianBokehBlurOperation()
+{
+	this->m_result = NULL;
+}
+
+void *GaussianBokehBlurFFTOperation::initializeTileData(rcti * /*rect*/)
+{
+	lockMutex();
+	if (!this->m_result) {
+		if (!this->m_gausstab) {
+			updateGauss();
+		}
+
+		MemoryBuffer *input = (MemoryBuffer *)getInputOperation(0)->initializeTileData(NULL);
+		MemoryBuffer *result = input->duplicate();
+		const int width = input->getWidth();
+		const int height = input->getHeight();
+		const int kernelWidth = 2 * this->m_radx + 1;
+		const int kernelHeight = 2 * this->m_rady + 1;
+		int x, y, i;
+
+		/* the same kernel for all channels */
+		float *kernel = (float *)MEM_mallocN(sizeof(float) * COM_NUM_CHANNELS_COLOR * kernelWidth * kernelHeight, __func__);
+		for (i = 0; i < kernelWidth * kernelHeight; i++) {
+			copy_v4_fl(&kernel[i * COM_NUM_CHANNELS_COLOR], this->m_gausstab[i]);
+		}
+		FastConvolution::convolve(result->getBuffer(), input->getBuffer(), width, height,
+		                          kernel, kernelWidth, kernelHeight, COM_NUM_CHANNELS_COLOR);
+		MEM_freeN(kernel);
+
+		/* pixels outside the image are zero in the convolution, near the borders divide by the
+		 * weights of the pixels inside the image like executePixel does. Summed area table of the
+		 * kernel to get these weights in constant time. */
+		double *sat = (double *)MEM_callocN(sizeof(double) * (kernelWidth + 1) * (kernelHeight + 1), __func__);
+		for (y = 0; y < kernelHeight; y++) {
+			for (x = 0; x < kernelWidth; x++) {
+				sat[(y + 1) * (kernelWidth + 1) + x + 1] = this->m_gausstab[y * kernelWidth + x] +
+				                                           sat[y * (kernelWidth + 1) + x + 1] +
+				                                           sat[(y + 1) * (kernelWidth + 1) + x] -
+				                                           sat[y * (kernelWidth + 1) + x];
+			}
+		}
+
+		float *buffer = result->getBuffer();
+		for (y = 0; y < height; y++) {
+			const int kymin = max_ii(this->m_rady - y, 0);
+			const int kymax = min_ii(this->m_rady + height - y, kernelHeight);
+			for (x = 0; x < width; x++, buffer += COM_NUM_CHANNELS_COLOR) {
+				const int kxmin = max_ii(this->m_radx - x, 0);
+				const int kxmax = min_ii(this->m_radx + width - x, kernelWidth);
+				if (kxmin == 0 && kymin == 0 && kxmax == kernelWidth && kymax == kernelHeight) {
+					continue;
+				}
+				const double weight = sat[kymax * (kernelWidth + 1) + kxmax] -
+				                      sat[kymin * (kernelWidth + 1) + kxmax] -
+				                      sat[kymax * (kernelWidth + 1) + kxmin] +
+				                      sat[kymin * (kernelWidth + 1) + kxmin];
+				if (weight > 0.0) {
+					mul_v4_fl(buffer, (float)(1.0 / weight));
+				}
+			}
+		}
+		MEM_freeN(sat);
+
+		this->m_result = result;
+	}
+	unlockMutex();
+	return this->m_result;
+}
+
+void GaussianBokehBlurFFTOperation::executePixel(float output[4], int x, int y, void *data)
+{
+	MemoryBuffer *result = (MemoryBuffer *)data;
+	result->read(output, x, y);
+}
+
+void GaussianBokehBlurFFTOperation::deinitExecution()
+{
+	if (this->m_result) {
+		delete this->m_result;
+		this->m_result = NULL;
+	}
+	GaussianBokehBlurOperation::deinitExecution();
+}
+
+bool GaussianBokehBlurFFTOperation::determineDependingAreaOfInterest(rcti * /*input*/, ReadBufferOperation *readOperation, rcti *output)
+{
+	rcti newInput;
+	rcti sizeInput;
+	sizeInput.xmin = 0;
+	sizeInput.ymin = 0;
+	sizeInput.xmax = 5;
+	sizeInput.ymax = 5;
+	NodeOperation *operation = this->getInputOperation(1);
+
+	if (operation->determineDependingAreaOfInterest(&sizeInput, readOperation, output)) {
+		return true;
+	}
+	else {
+		if (this->m_result) {
+			return false;
+		}
+		newInput.xmin = 0;
+		newInput.ymin = 0;
+		newInput.xmax = this->getWidth();
+		newInput.ymax = this->getHeight();
+		return NodeOperation::determineDependingAreaOfInterest(&newInput, readOperation, output);
+	}
+}
+
 // reference image
 GaussianBlurReferenceOperation::GaussianBlurReferenceOperation() : BlurBaseOperation(COM_DT_COLOR)
 {
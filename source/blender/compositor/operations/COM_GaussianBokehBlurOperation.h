@@ -27,7 +27,7 @@
 #include "COM_QualityStepHelper.h"
 
 class GaussianBokehBlurOperation : public BlurBaseOperation {
-private:
+protected:
 	float *m_gausstab;
 	int m_radx, m_rady;
 	void updateGauss();
@@ -49,6 +49,23 @@ public:
 	bool determineDependingAreaOfInterest(rcti *input, ReadBufferOperation *readOperation, rcti *output);
 };
 
+/**
+ * @brief GaussianBokehBlurOperation convolving the whole image with the FastConvolution FFT.
+ * Used by the blur node for large radii, the cost doesn't depend on the radius.
+ */
+class GaussianBokehBlurFFTOperation : public GaussianBokehBlurOperation {
+private:
+	MemoryBuffer *m_result;
+
+public:
+	GaussianBokehBlurFFTOperation();
+	void *initializeTileData(rcti *rect);
+	void executePixel(float output[4], int x, int y, void *data);
+	void deinitExecution();
+
+	bool determineDependingAreaOfInterest(rcti *input, ReadBufferOperation *readOperation, rcti *output);
+};
+
 class GaussianBlurReferenceOperation : public BlurBaseOperation {
 private:
 	float **m_maintabs;
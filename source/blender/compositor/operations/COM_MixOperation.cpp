@@ -69,6 +69,38 @@ void MixBaseOperation::executePixelSampled(float output[4], float x, float y, Pi
 	output[3] = inputColor1[3];
 }
 
+void MixBaseOperation::executeRowKernel(float *output, int xmin, int xmax, int y, unsigned int num_channels,
+                                        RowKernels::MixFunc kernel)
+{
+	/* value operations may write up to 4 floats for their last pixel */
+	float inputValue[COM_ROW_SPAN + 3];
+	float inputColor1[COM_ROW_SPAN * 4];
+	float inputColor2[COM_ROW_SPAN * 4];
+
+	if (num_channels != COM_NUM_CHANNELS_COLOR) {
+		NodeOperation::executeRow(output, xmin, xmax, y, num_channels);
+		return;
+	}
+
+	for (int x = xmin; x < xmax; x += COM_ROW_SPAN) {
+		const int width = min_ii(COM_ROW_SPAN, xmax - x);
+
+		this->m_inputValueOperation->readRow(inputValue, x, x + width, y, COM_NUM_CHANNELS_VALUE);
+		this->m_inputColor1Operation->readRow(inputColor1, x, x + width, y, COM_NUM_CHANNELS_COLOR);
+		this->m_inputColor2Operation->readRow(inputColor2, x, x + width, y, COM_NUM_CHANNELS_COLOR);
+
+		if (this->useValueAlphaMultiply()) {
+			RowKernels::mulAlpha(inputValue, inputColor2, width);
+		}
+		kernel(output, inputValue, inputColor1, inputColor2, width);
+		if (this->m_useClamp) {
+			RowKernels::clamp(output, width);
+		}
+
+		output += width * COM_NUM_CHANNELS_COLOR;
+	}
+}
+
 void MixBaseOperation::determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2])
 {
 	NodeOperationInput *socket;
@@ -129,6 +161,11 @@ void MixAddOperation::executePixelSampled(float output[4], float x, float y, Pix
 	clampIfNeeded(output);
 }
 
+void MixAddOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels, RowKernels::mixAdd);
+}
+
 /* ******** Mix Blend Operation ******** */
 
 MixBlendOperation::MixBlendOperation() : MixBaseOperation()
@@ -160,6 +197,11 @@ void MixBlendOperation::executePixelSampled(float output[4], float x, float y, P
 	clampIfNeeded(output);
 }
 
+void MixBlendOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels, RowKernels::mixBlend);
+}
+
 /* ******** Mix Burn Operation ******** */
 
 MixBurnOperation::MixBurnOperation() : MixBaseOperation()
@@ -300,6 +342,11 @@ void MixDarkenOperation::executePixelSampled(float output[4], float x, float y,
 	clampIfNeeded(output);
 }
 
+void MixDarkenOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels, RowKernels::mixDarken);
+}
+
 /* ******** Mix Difference Operation ******** */
 
 MixDifferenceOperation::MixDifferenceOperation() : MixBaseOperation()
@@ -330,6 +377,11 @@ void MixDifferenceOperation::executePixelSampled(float output[4], float x, float
 	clampIfNeeded(output);
 }
 
+void MixDifferenceOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels, RowKernels::mixDifference);
+}
+
 /* ******** Mix Difference Operation ******** */
 
 MixDivideOperation::MixDivideOperation() : MixBaseOperation()
@@ -554,6 +606,11 @@ void MixLightenOperation::executePixelSampled(float output[4], float x, float y,
 	clampIfNeeded(output);
 }
 
+void MixLightenOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels, RowKernels::mixLighten);
+}
+
 /* ******** Mix Linear Light Operation ******** */
 
 MixLinearLightOperation::MixLinearLightOperation() : MixBaseOperation()
@@ -623,6 +680,11 @@ void MixMultiplyOperation::executePixelSampled(float output[4], float x, float y
 	clampIfNeeded(output);
 }
 
+void MixMultiplyOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels, RowKernels::mixMultiply);
+}
+
 /* ******** Mix Ovelray Operation ******** */
 
 MixOverlayOperation::MixOverlayOperation() : MixBaseOperation()
@@ -740,6 +802,11 @@ void MixScreenOperation::executePixelSampled(float output[4], float x, float y,
 	clampIfNeeded(output);
 }
 
+void MixScreenOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels, RowKernels::mixScreen);
+}
+
 /* ******** Mix Soft Light Operation ******** */
 
 MixSoftLightOperation::MixSoftLightOperation() : MixBaseOperation()
@@ -806,6 +873,11 @@ void MixSubtractOperation::executePixelSampled(float output[4], float x, float y
 	clampIfNeeded(output);
 }
 
+void MixSubtractOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	executeRowKernel(output, xmin, xmax, y, num_channels, RowKernels::mixSubtract);
+}
+
 /* ******** Mix Value Operation ******** */
 
 MixValueOperation::MixValueOperation() : MixBaseOperation()
@@ -23,6 +23,7 @@
 #ifndef _COM_MixBaseOperation_h
 #define _COM_MixBaseOperation_h
 #include "COM_NodeOperation.h"
+#include "COM_RowKernels.h"
 
 
 /**
@@ -50,6 +51,14 @@ protected:
 			CLAMP(color[3], 0.0f, 1.0f);
 		}
 	}
+
+	/**
+	 * @brief calculate a row in spans with a RowKernels mix kernel
+	 * @note only subclasses with a kernel matching their executePixelSampled use this,
+	 * the other ones calculate rows per pixel. m_useClamp is applied like in clampIfNeeded.
+	 */
+	void executeRowKernel(float *output, int xmin, int xmax, int y, unsigned int num_channels,
+	                      RowKernels::MixFunc kernel);
 	
 public:
 	/**
@@ -84,12 +93,14 @@ class MixAddOperation : public MixBaseOperation {
 public:
 	MixAddOperation();
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 class MixBlendOperation : public MixBaseOperation {
 public:
 	MixBlendOperation();
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 class MixBurnOperation : public MixBaseOperation {
@@ -108,12 +119,14 @@ class MixDarkenOperation : public MixBaseOperation {
 public:
 	MixDarkenOperation();
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 class MixDifferenceOperation : public MixBaseOperation {
 public:
 	MixDifferenceOperation();
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 class MixDivideOperation : public MixBaseOperation {
@@ -144,6 +157,7 @@ class MixLightenOperation : public MixBaseOperation {
 public:
 	MixLightenOperation();
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 class MixLinearLightOperation : public MixBaseOperation {
@@ -156,6 +170,7 @@ class MixMultiplyOperation : public MixBaseOperation {
 public:
 	MixMultiplyOperation();
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 class MixOverlayOperation : public MixBaseOperation {
@@ -174,6 +189,7 @@ class MixScreenOperation : public MixBaseOperation {
 public:
 	MixScreenOperation();
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 class MixSoftLightOperation : public MixBaseOperation {
@@ -186,6 +202,7 @@ class MixSubtractOperation : public MixBaseOperation {
 public:
 	MixSubtractOperation();
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 };
 
 class MixValueOperation : public MixBaseOperation {
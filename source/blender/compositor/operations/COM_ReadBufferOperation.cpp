@@ -102,6 +102,37 @@ void ReadBufferOperation::executePixelFiltered(float output[4], float x, float y
 	}
 }
 
+void ReadBufferOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	if (m_single_value || num_channels != m_buffer->get_num_channels()) {
+		NodeOperation::executeRow(output, xmin, xmax, y, num_channels);
+		return;
+	}
+
+	/* copy the part of the row inside the buffer, clip the rest to zero like read() */
+	const rcti *rect = m_buffer->getRect();
+	const int x1 = min_ii(max_ii(xmin, rect->xmin), xmax);
+	const int x2 = max_ii(min_ii(xmax, rect->xmax), x1);
+
+	if (y < rect->ymin || y >= rect->ymax) {
+		memset(output, 0, sizeof(float) * num_channels * (xmax - xmin));
+		return;
+	}
+
+	if (x1 > xmin) {
+		memset(output, 0, sizeof(float) * num_channels * (x1 - xmin));
+	}
+	if (x2 > x1) {
+		/* the buffer starts at the corner of its rect, like in MemoryBuffer::readNoCheck */
+		const int offset = m_buffer->getWidth() * (y - rect->ymin) + (x1 - rect->xmin);
+		const float *buffer = m_buffer->getBuffer() + offset * num_channels;
+		memcpy(output + (x1 - xmin) * num_channels, buffer, sizeof(float) * num_channels * (x2 - x1));
+	}
+	if (xmax > x2) {
+		memset(output + (x2 - xmin) * num_channels, 0, sizeof(float) * num_channels * (xmax - x2));
+	}
+}
+
 bool ReadBufferOperation::determineDependingAreaOfInterest(rcti *input, ReadBufferOperation *readOperation, rcti *output)
 {
 	if (this == readOperation) {
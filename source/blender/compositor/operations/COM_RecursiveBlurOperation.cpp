@@ -0,0 +1,170 @@
+/*
+ * Copyright 2016, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#include "COM_RecursiveBlurOperation.h"
+#include "COM_FastGaussianBlurOperation.h"
+#include "MEM_guardedalloc.h"
+
+extern "C" {
+#  include "BLI_math.h"
+#  include "BLI_utildefines.h"
+}
+
+RecursiveBlurOperation::RecursiveBlurOperation() : BlurBaseOperation(COM_DT_COLOR)
+{
+	this->m_result = NULL;
+}
+
+bool RecursiveBlurOperation::isFilterSupported(int filtertype)
+{
+	return ELEM(filtertype, R_FILTER_BOX, R_FILTER_TENT, R_FILTER_GAUSS);
+}
+
+void RecursiveBlurOperation::executePixel(float output[4], int x, int y, void *data)
+{
+	MemoryBuffer *newData = (MemoryBuffer *)data;
+	newData->read(output, x, y);
+}
+
+bool RecursiveBlurOperation::determineDependingAreaOfInterest(rcti * /*input*/, ReadBufferOperation *readOperation, rcti *output)
+{
+	rcti newInput;
+	rcti sizeInput;
+	sizeInput.xmin = 0;
+	sizeInput.ymin = 0;
+	sizeInput.xmax = 5;
+	sizeInput.ymax = 5;
+
+	NodeOperation *operation = this->getInputOperation(1);
+	if (operation->determineDependingAreaOfInterest(&sizeInput, readOperation, output)) {
+		return true;
+	}
+	else {
+		if (this->m_result) {
+			return false;
+		}
+		else {
+			newInput.xmin = 0;
+			newInput.ymin = 0;
+			newInput.xmax = this->getWidth();
+			newInput.ymax = this->getHeight();
+		}
+		return NodeOperation::determineDependingAreaOfInterest(&newInput, readOperation, output);
+	}
+}
+
+void RecursiveBlurOperation::initExecution()
+{
+	BlurBaseOperation::initExecution();
+	BlurBaseOperation::initMutex();
+}
+
+void RecursiveBlurOperation::deinitExecution()
+{
+	if (this->m_result) {
+		delete this->m_result;
+		this->m_result = NULL;
+	}
+	BlurBaseOperation::deinitMutex();
+}
+
+void RecursiveBlurOperation::boxBlur(MemoryBuffer *buffer, int radius, bool vertical)
+{
+	const int width = buffer->getWidth();
+	const int height = buffer->getHeight();
+	const int num_channels = buffer->get_num_channels();
+	const int length = vertical ? height : width;
+	const int lines = vertical ? width : height;
+	const int pixel_step = (vertical ? width : 1) * num_channels;
+	const int line_step = (vertical ? 1 : width) * num_channels;
+	float *data = buffer->getBuffer();
+	int i, c;
+
+	if (radius < 1 || length < 2) {
+		return;
+	}
+
+	/* running sums as prefix sums, double precision so large images don't accumulate errors */
+	double *sums = (double *)MEM_mallocN(sizeof(double) * (length + 1) * num_channels, __func__);
+
+	for (int line = 0; line < lines; line++) {
+		float *pixels = &data[line * line_step];
+
+		for (c = 0; c < num_channels; c++) {
+			sums[c] = 0.0;
+		}
+		for (i = 0; i < length; i++) {
+			const float *pixel = &pixels[i * pixel_step];
+			for (c = 0; c < num_channels; c++) {
+				sums[(i + 1) * num_channels + c] = sums[i * num_channels + c] + pixel[c];
+			}
+		}
+
+		/* like the direct convolution only the pixels inside the image are averaged */
+		for (i = 0; i < length; i++) {
+			const int first = max_ii(i - radius, 0);
+			const int last = min_ii(i + radius + 1, length);
+			const double fac = 1.0 / (double)(last - first);
+			float *pixel = &pixels[i * pixel_step];
+			for (c = 0; c < num_channels; c++) {
+				pixel[c] = (float)((sums[last * num_channels + c] - sums[first * num_channels + c]) * fac);
+			}
+		}
+	}
+
+	MEM_freeN(sums);
+}
+
+void *RecursiveBlurOperation::initializeTileData(rcti *rect)
+{
+	lockMutex();
+	if (!this->m_result) {
+		MemoryBuffer *newBuf = (MemoryBuffer *)this->m_inputProgram->initializeTileData(rect);
+		MemoryBuffer *copy = newBuf->duplicate();
+		updateSize();
+
+		const float radx = max_ff(this->m_size * this->m_data.sizex, 0.0f);
+		const float rady = max_ff(this->m_size * this->m_data.sizey, 0.0f);
+		int c, pass;
+
+		switch (this->m_data.filtertype) {
+			case R_FILTER_BOX:
+				boxBlur(copy, (int)radx, false);
+				boxBlur(copy, (int)rady, true);
+				break;
+			case R_FILTER_TENT:
+				/* a tent is the convolution of two boxes of half its radius */
+				for (pass = 0; pass < 2; pass++) {
+					boxBlur(copy, (int)(radx * 0.5f + 0.5f), false);
+					boxBlur(copy, (int)(rady * 0.5f + 0.5f), true);
+				}
+				break;
+			case R_FILTER_GAUSS:
+			default:
+				/* the gaussian of RE_filter_value reaches zero at three times its deviation */
+				for (c = 0; c < COM_NUM_CHANNELS_COLOR; c++) {
+					FastGaussianBlurOperation::IIR_gauss(copy, radx / 3.0f, c, 1);
+					FastGaussianBlurOperation::IIR_gauss(copy, rady / 3.0f, c, 2);
+				}
+				break;
+		}
+		this->m_result = copy;
+	}
+	unlockMutex();
+	return this->m_result;
+}
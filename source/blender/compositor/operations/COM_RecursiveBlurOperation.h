@@ -0,0 +1,57 @@
+/*
+ * Copyright 2016, Blender Foundation.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+#ifndef _COM_RecursiveBlurOperation_h
+#define _COM_RecursiveBlurOperation_h
+
+#include "COM_BlurBaseOperation.h"
+
+/**
+ * @brief Separable blur with a cost that doesn't depend on the radius.
+ *
+ * Used by the blur node instead of GaussianXBlurOperation/GaussianYBlurOperation for large
+ * radii. Gaussian filters use the recursive Young/van Vliet filter of FastGaussianBlurOperation,
+ * box and tent filters use cascades of running sums. Like FastGaussianBlurOperation the whole
+ * image is blurred at once.
+ */
+class RecursiveBlurOperation : public BlurBaseOperation {
+private:
+	MemoryBuffer *m_result;
+
+	/**
+	 * @brief box filter of all channels along one axis, normalized by the pixels inside the image
+	 */
+	static void boxBlur(MemoryBuffer *buffer, int radius, bool vertical);
+
+public:
+	RecursiveBlurOperation();
+
+	/**
+	 * @brief can filtertype be calculated by this operation
+	 */
+	static bool isFilterSupported(int filtertype);
+
+	bool determineDependingAreaOfInterest(rcti *input, ReadBufferOperation *readOperation, rcti *output);
+	void executePixel(float output[4], int x, int y, void *data);
+
+	void *initializeTileData(rcti *rect);
+	void initExecution();
+	void deinitExecution();
+};
+
+#endif
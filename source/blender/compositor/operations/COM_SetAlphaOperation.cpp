@@ -21,6 +21,11 @@
  */
 
 #include "COM_SetAlphaOperation.h"
+#include "COM_RowKernels.h"
+
+extern "C" {
+#  include "BLI_math.h"
+}
 
 SetAlphaOperation::SetAlphaOperation() : NodeOperation()
 {
@@ -48,6 +53,28 @@ void SetAlphaOperation::executePixelSampled(float output[4], float x, float y, P
 	output[3] = alphaInput[0];
 }
 
+void SetAlphaOperation::executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels)
+{
+	float inputColor[COM_ROW_SPAN * 4];
+	/* value operations may write up to 4 floats for their last pixel */
+	float inputAlpha[COM_ROW_SPAN + 3];
+
+	if (num_channels != COM_NUM_CHANNELS_COLOR) {
+		NodeOperation::executeRow(output, xmin, xmax, y, num_channels);
+		return;
+	}
+
+	for (int x = xmin; x < xmax; x += COM_ROW_SPAN) {
+		const int width = min_ii(COM_ROW_SPAN, xmax - x);
+
+		this->m_inputColor->readRow(inputColor, x, x + width, y, COM_NUM_CHANNELS_COLOR);
+		this->m_inputAlpha->readRow(inputAlpha, x, x + width, y, COM_NUM_CHANNELS_VALUE);
+		RowKernels::setAlpha(output, inputColor, inputAlpha, width);
+
+		output += width * COM_NUM_CHANNELS_COLOR;
+	}
+}
+
 void SetAlphaOperation::deinitExecution()
 {
 	this->m_inputColor = NULL;
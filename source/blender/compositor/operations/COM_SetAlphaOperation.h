@@ -44,6 +44,7 @@ public:
 	 * the inner loop of this program
 	 */
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
+	void executeRow(float *output, int xmin, int xmax, int y, unsigned int num_channels);
 	
 	void initExecution();
 	void deinitExecution();
@@ -34,6 +34,14 @@ void SetColorOperation::executePixelSampled(float output[4],
 	copy_v4_v4(output, this->m_color);
 }
 
+void SetColorOperation::executeRow(float *output, int xmin, int xmax, int /*y*/, unsigned int num_channels)
+{
+	for (int x = xmin; x < xmax; x++) {
+		copy_v4_v4(output, this->m_color);
+		output += num_channels;
+	}
+}
+
 void SetColorOperation::determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2])
 {
 	resolution[0] = preferredResolution[0];
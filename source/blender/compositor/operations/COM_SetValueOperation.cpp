@@ -34,6 +34,14 @@ void SetValueOperation::executePixelSampled(float output[4],
 	output[0] = this->m_value;
 }
 
+void SetValueOperation::executeRow(float *output, int xmin, int xmax, int /*y*/, unsigned int num_channels)
+{
+	for (int x = xmin; x < xmax; x++) {
+		output[0] = this->m_value;
+		output += num_channels;
+	}
+}
+
 void SetValueOperation::determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2])
 {
 	resolution[0] = preferredResolution[0];
@@ -37,6 +37,16 @@ void SetVectorOperation::executePixelSampled(float output[4],
 	output[2] = this->m_z;
 }
 
+void SetVectorOperation::executeRow(float *output, int xmin, int xmax, int /*y*/, unsigned int num_channels)
+{
+	for (int x = xmin; x < xmax; x++) {
+		output[0] = this->m_x;
+		output[1] = this->m_y;
+		output[2] = this->m_z;
+		output += num_channels;
+	}
+}
+
 void SetVectorOperation::determineResolution(unsigned int resolution[2], unsigned int preferredResolution[2])
 {
 	resolution[0] = preferredResolution[0];
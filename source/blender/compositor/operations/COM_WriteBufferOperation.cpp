@@ -31,6 +31,7 @@ WriteBufferOperation::WriteBufferOperation(DataType datatype) : NodeOperation()
 	this->m_memoryProxy = new MemoryProxy(datatype);
 	this->m_memoryProxy->setWriteBufferOperation(this);
 	this->m_memoryProxy->setExecutor(NULL);
+	this->m_deferAllocation = false;
 }
 WriteBufferOperation::~WriteBufferOperation()
 {
@@ -48,7 +49,9 @@ void WriteBufferOperation::executePixelSampled(float output[4], float x, float y
 void WriteBufferOperation::initExecution()
 {
 	this->m_input = this->getInputOperation(0);
-	this->m_memoryProxy->allocate(this->m_width, this->m_height);
+	if (!this->m_deferAllocation) {
+		this->m_memoryProxy->allocate(this->m_width, this->m_height);
+	}
 }
 
 void WriteBufferOperation::deinitExecution()
@@ -93,15 +96,11 @@ void WriteBufferOperation::executeRegion(rcti *rect, unsigned int /*tileNumber*/
 		int x2 = rect->xmax;
 		int y2 = rect->ymax;
 
-		int x;
 		int y;
 		bool breaked = false;
 		for (y = y1; y < y2 && (!breaked); y++) {
 			int offset4 = (y * memoryBuffer->getWidth() + x1) * num_channels;
-			for (x = x1; x < x2; x++) {
-				this->m_input->readSampled(&(buffer[offset4]), x, y, COM_PS_NEAREST);
-				offset4 += num_channels;
-			}
+			this->m_input->readRow(&(buffer[offset4]), x1, x2, y, num_channels);
 			if (isBreaked()) {
 				breaked = true;
 			}
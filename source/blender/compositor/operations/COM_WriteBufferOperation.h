@@ -34,6 +34,7 @@ class WriteBufferOperation : public NodeOperation {
 	MemoryProxy *m_memoryProxy;
 	bool m_single_value; /* single value stored in buffer */
 	NodeOperation *m_input;
+	bool m_deferAllocation; /* buffer is allocated by the ExecutionSystem right before it is written */
 public:
 	WriteBufferOperation(DataType datatype);
 	~WriteBufferOperation();
@@ -41,6 +42,7 @@ public:
 	void executePixelSampled(float output[4], float x, float y, PixelSampler sampler);
 	const bool isWriteBufferOperation() const { return true; }
 	bool isSingleValue() const { return m_single_value; }
+	void setDeferAllocation(bool defer) { this->m_deferAllocation = defer; }
 	
 	void executeRegion(rcti *rect, unsigned int tileNumber);
 	void initExecution();
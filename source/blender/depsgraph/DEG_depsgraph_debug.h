@@ -90,6 +90,21 @@ void DEG_stats_simple(const struct Depsgraph *graph,
 
 void DEG_debug_graphviz(const struct Depsgraph *graph, FILE *stream, const char *label, bool show_eval);
 
+/* ************************************************ */
+/* Evaluation Trace */
+
+/* Start recording the operations run by all following evaluations. */
+void DEG_debug_trace_begin(void);
+
+/* Stop recording and free the recorded operations. */
+void DEG_debug_trace_end(void);
+
+bool DEG_debug_trace_is_active(void);
+
+/* Write the recorded operations as Chrome trace JSON (chrome://tracing),
+ * one track per thread and one event per evaluated frame. */
+bool DEG_debug_trace_write(FILE *stream);
+
 /* ************************************************ */
 
 /* Compare two dependency graphs. */
@@ -33,15 +33,20 @@
 //#include <stdlib.h>
 #include <string.h>
 
+#include "PIL_time.h"
+
 extern "C" {
 #include "BLI_utildefines.h"
 #include "BLI_listbase.h"
 #include "BLI_ghash.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 
 #include "DNA_scene_types.h"
 #include "DNA_userdef_types.h"
 
+#include "BKE_depsgraph.h"
+
 #include "DEG_depsgraph.h"
 #include "DEG_depsgraph_debug.h"
 #include "DEG_depsgraph_build.h"
@@ -805,15 +810,165 @@ static void times_add(DepsgraphStatsTimes &times, float time)
 	times.duration_last += time;
 }
 
+/* **************** */
+/* Evaluation Trace */
+
+/* Operations recorded between DEG_debug_trace_begin() and DEG_debug_trace_end(),
+ * every evaluation is recorded as well so the frames can be told apart.
+ */
+struct DepsgraphTraceEvent {
+	string name;
+	string category;
+	int thread_id;      /* 0 for whole evaluations, worker threads start at 1 */
+	double start_time;
+	double duration;
+	float frame;
+	float average_time; /* average time of the operation in previous evaluations */
+};
+
+typedef vector<DepsgraphTraceEvent> DepsgraphTraceEvents;
+
+static DepsgraphTraceEvents *deg_trace_events = NULL;
+static double deg_trace_start_time = 0.0;
+static double deg_trace_eval_start_time = 0.0;
+static ThreadMutex deg_trace_mutex = BLI_MUTEX_INITIALIZER;
+
+static void deg_trace_add_event(const string &name,
+                                const string &category,
+                                int thread_id,
+                                double start_time,
+                                double duration,
+                                float frame,
+                                float average_time)
+{
+	DepsgraphTraceEvent event;
+	event.name = name;
+	event.category = category;
+	event.thread_id = thread_id;
+	event.start_time = start_time;
+	event.duration = duration;
+	event.frame = frame;
+	event.average_time = average_time;
+
+	BLI_mutex_lock(&deg_trace_mutex);
+	if (deg_trace_events) {
+		deg_trace_events->push_back(event);
+	}
+	BLI_mutex_unlock(&deg_trace_mutex);
+}
+
+static void deg_trace_write_string(FILE *f, const string &str)
+{
+	fputc('"', f);
+	for (size_t i = 0; i < str.size(); i++) {
+		const char c = str[i];
+		if (c == '"' || c == '\\') {
+			fputc('\\', f);
+			fputc(c, f);
+		}
+		else if ((unsigned char)c < 0x20) {
+			fprintf(f, "\\u%04x", (unsigned int)c);
+		}
+		else {
+			fputc(c, f);
+		}
+	}
+	fputc('"', f);
+}
+
+void DEG_debug_trace_begin(void)
+{
+	BLI_mutex_lock(&deg_trace_mutex);
+	if (deg_trace_events == NULL) {
+		deg_trace_events = new DepsgraphTraceEvents();
+	}
+	deg_trace_events->clear();
+	deg_trace_start_time = PIL_check_seconds_timer();
+	BLI_mutex_unlock(&deg_trace_mutex);
+}
+
+void DEG_debug_trace_end(void)
+{
+	BLI_mutex_lock(&deg_trace_mutex);
+	delete deg_trace_events;
+	deg_trace_events = NULL;
+	BLI_mutex_unlock(&deg_trace_mutex);
+}
+
+bool DEG_debug_trace_is_active(void)
+{
+	return deg_trace_events != NULL;
+}
+
+/**
+ * Write the recorded trace in the Chrome trace event format,
+ * it can be loaded in chrome://tracing or similar viewers.
+ */
+bool DEG_debug_trace_write(FILE *f)
+{
+	BLI_mutex_lock(&deg_trace_mutex);
+
+	if (deg_trace_events == NULL) {
+		BLI_mutex_unlock(&deg_trace_mutex);
+		return false;
+	}
+
+	fprintf(f, "{\"traceEvents\": [\n");
+	fprintf(f, "  {\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, "
+	           "\"args\": {\"name\": \"Evaluation\"}}");
+
+	for (DepsgraphTraceEvents::const_iterator it = deg_trace_events->begin();
+	     it != deg_trace_events->end();
+	     ++it)
+	{
+		const DepsgraphTraceEvent &event = *it;
+
+		fprintf(f, ",\n  {\"name\": ");
+		deg_trace_write_string(f, event.name);
+		fprintf(f, ", \"cat\": ");
+		deg_trace_write_string(f, event.category);
+		fprintf(f, ", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f, "
+		           "\"args\": {\"frame\": %g, \"average_ms\": %.4f}}",
+		        event.thread_id,
+		        (event.start_time - deg_trace_start_time) * 1e6,
+		        event.duration * 1e6,
+		        event.frame,
+		        event.average_time * 1e3f);
+	}
+
+	fprintf(f, "\n],\n\"displayTimeUnit\": \"ms\"}\n");
+
+	BLI_mutex_unlock(&deg_trace_mutex);
+
+	return true;
+}
+
+/* ************* */
+/* Eval Callbacks */
+
 void DepsgraphDebug::eval_begin(const EvaluationContext *UNUSED(eval_ctx))
 {
 	/* TODO(sergey): Stats are currently globally disabled. */
 	/* verify_stats(); */
 	reset_stats();
+
+	if (DEG_debug_trace_is_active()) {
+		deg_trace_eval_start_time = PIL_check_seconds_timer();
+	}
 }
 
-void DepsgraphDebug::eval_end(const EvaluationContext *UNUSED(eval_ctx))
+void DepsgraphDebug::eval_end(const EvaluationContext *eval_ctx)
 {
+	if (DEG_debug_trace_is_active()) {
+		const double end_time = PIL_check_seconds_timer();
+		char name[64];
+
+		BLI_snprintf(name, sizeof(name), "Frame %g", eval_ctx->ctime);
+		deg_trace_add_event(name, "Evaluation", 0,
+		                    deg_trace_eval_start_time, end_time - deg_trace_eval_start_time,
+		                    eval_ctx->ctime, 0.0f);
+	}
+
 	WM_main_add_notifier(NC_SPACE | ND_SPACE_INFO_REPORT, NULL);
 }
 
@@ -853,8 +1008,15 @@ void DepsgraphDebug::task_started(Depsgraph *graph,
 
 void DepsgraphDebug::task_completed(Depsgraph *graph,
                                     const OperationDepsNode *node,
+                                    int thread_id,
+                                    double start_time,
                                     double time)
 {
+	if (DEG_debug_trace_is_active()) {
+		deg_trace_add_event(node->full_identifier(), node->owner->owner->name, thread_id + 1,
+		                    start_time, time, graph->find_time_source()->cfra, node->eval_time);
+	}
+
 	if (stats) {
 		BLI_spin_lock(&graph->lock);
 
@@ -63,6 +63,8 @@ struct DepsgraphDebug {
 	static void task_started(Depsgraph *graph, const OperationDepsNode *node);
 	static void task_completed(Depsgraph *graph,
 	                           const OperationDepsNode *node,
+	                           int thread_id,
+	                           double start_time,
 	                           double time);
 
 	static DepsgraphStatsID *get_id_stats(ID *id, bool create);
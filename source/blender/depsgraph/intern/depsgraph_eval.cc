@@ -30,6 +30,8 @@
  * Evaluation engine entrypoints for Depsgraph Engine.
  */
 
+#include <algorithm>
+
 #include "MEM_guardedalloc.h"
 
 #include "PIL_time.h"
@@ -118,6 +120,13 @@ void DEG_evaluation_context_free(EvaluationContext *eval_ctx)
 /* ********************** */
 /* Evaluation Entrypoints */
 
+/* Cost in seconds assumed for operations which weren't timed yet. */
+#define DEG_EVAL_DEFAULT_COST 1e-5f
+
+/* Weight of the last measured time in the average time of an operation,
+ * low enough so a single slow evaluation doesn't change the schedule. */
+#define DEG_EVAL_TIME_WEIGHT 0.25f
+
 /* Forward declarations. */
 static void schedule_children(TaskPool *pool,
                               Depsgraph *graph,
@@ -132,7 +141,7 @@ struct DepsgraphEvalState {
 
 static void deg_task_run_func(TaskPool *pool,
                               void *taskdata,
-                              int UNUSED(threadid))
+                              int threadid)
 {
 	DepsgraphEvalState *state = (DepsgraphEvalState *)BLI_task_pool_userdata(pool);
 	OperationDepsNode *node = (OperationDepsNode *)taskdata;
@@ -156,9 +165,23 @@ static void deg_task_run_func(TaskPool *pool,
 
 		/* Note how long this took. */
 		double end_time = PIL_check_seconds_timer();
+		const float time = (float)(end_time - start_time);
 		DepsgraphDebug::task_completed(state->graph,
 		                               node,
+		                               threadid,
+		                               start_time,
 		                               end_time - start_time);
+
+		/* Only the thread evaluating the node writes it. It is read when the
+		 * priorities are calculated at the start of the next evaluation, the
+		 * scheduling of this evaluation only uses those priorities.
+		 */
+		if (node->eval_time == 0.0f) {
+			node->eval_time = time;
+		}
+		else {
+			node->eval_time += (time - node->eval_time) * DEG_EVAL_TIME_WEIGHT;
+		}
 	}
 
 	schedule_children(pool, state->graph, node, state->layers);
@@ -201,6 +224,18 @@ static void calculate_pending_parents(Depsgraph *graph, int layers)
 	}
 }
 
+static float operation_eval_cost(const OperationDepsNode *node)
+{
+	/* NOOP nodes have no cost */
+	if (node->is_noop()) {
+		return 0.0f;
+	}
+	return (node->eval_time != 0.0f) ? node->eval_time : DEG_EVAL_DEFAULT_COST;
+}
+
+/* The priority is the time of the longest (critical) path from the node to
+ * the end of the graph, using the times measured in previous evaluations.
+ */
 static void calculate_eval_priority(OperationDepsNode *node)
 {
 	if (node->done) {
@@ -209,10 +244,7 @@ static void calculate_eval_priority(OperationDepsNode *node)
 	node->done = 1;
 
 	if (node->flag & DEPSOP_FLAG_NEEDS_UPDATE) {
-		/* XXX standard cost of a node, could be estimated somewhat later on */
-		const float cost = 1.0f;
-		/* NOOP nodes have no cost */
-		node->eval_priority = node->is_noop() ? cost : 0.0f;
+		float max_child_priority = 0.0f;
 
 		for (OperationDepsNode::Relations::const_iterator it = node->outlinks.begin();
 		     it != node->outlinks.end();
@@ -222,18 +254,27 @@ static void calculate_eval_priority(OperationDepsNode *node)
 			OperationDepsNode *to = (OperationDepsNode *)rel->to;
 			BLI_assert(to->type == DEPSNODE_TYPE_OPERATION);
 			calculate_eval_priority(to);
-			node->eval_priority += to->eval_priority;
+			max_child_priority = std::max(max_child_priority, to->eval_priority);
 		}
+
+		node->eval_priority = operation_eval_cost(node) + max_child_priority;
 	}
 	else {
 		node->eval_priority = 0.0f;
 	}
 }
 
+static bool operation_eval_priority_greater(const OperationDepsNode *a, const OperationDepsNode *b)
+{
+	return a->eval_priority > b->eval_priority;
+}
+
 static void schedule_graph(TaskPool *pool,
                            Depsgraph *graph,
                            const int layers)
 {
+	vector<OperationDepsNode *> ready_nodes;
+
 	BLI_spin_lock(&graph->lock);
 	for (Depsgraph::OperationNodes::const_iterator it = graph->operations.begin();
 	     it != graph->operations.end();
@@ -245,11 +286,20 @@ static void schedule_graph(TaskPool *pool,
 		    node->num_links_pending == 0 &&
 		    (id_node->layers & layers) != 0)
 		{
-			BLI_task_pool_push(pool, deg_task_run_func, node, false, TASK_PRIORITY_LOW);
+			ready_nodes.push_back(node);
 			node->scheduled = true;
 		}
 	}
 	BLI_spin_unlock(&graph->lock);
+
+	/* Start the longest chains first, they determine when the evaluation ends. */
+	std::stable_sort(ready_nodes.begin(), ready_nodes.end(), operation_eval_priority_greater);
+	for (vector<OperationDepsNode *>::const_iterator it = ready_nodes.begin();
+	     it != ready_nodes.end();
+	     ++it)
+	{
+		BLI_task_pool_push(pool, deg_task_run_func, *it, false, TASK_PRIORITY_LOW);
+	}
 }
 
 static void schedule_children(TaskPool *pool,
@@ -257,6 +307,19 @@ static void schedule_children(TaskPool *pool,
                               OperationDepsNode *node,
                               const int layers)
 {
+	/* Priority of the child continuing the critical path through this node.
+	 * Taken from the children rather than derived from the node's own priority,
+	 * the node's evaluation time was just updated and no longer matches it.
+	 */
+	float critical_priority = 0.0f;
+	for (OperationDepsNode::Relations::const_iterator it = node->outlinks.begin();
+	     it != node->outlinks.end();
+	     ++it)
+	{
+		const OperationDepsNode *child = (const OperationDepsNode *)(*it)->to;
+		critical_priority = std::max(critical_priority, child->eval_priority);
+	}
+
 	for (OperationDepsNode::Relations::const_iterator it = node->outlinks.begin();
 	     it != node->outlinks.end();
 	     ++it)
@@ -286,7 +349,13 @@ static void schedule_children(TaskPool *pool,
 				BLI_spin_unlock(&graph->lock);
 
 				if (need_schedule) {
-					BLI_task_pool_push(pool, deg_task_run_func, child, false, TASK_PRIORITY_LOW);
+					/* Continue the critical path before other ready operations, the
+					 * rest is queued behind them.
+					 */
+					const TaskPriority priority =
+					        (child->eval_priority >= critical_priority * 0.999f) ? TASK_PRIORITY_HIGH
+					                                                             : TASK_PRIORITY_LOW;
+					BLI_task_pool_push(pool, deg_task_run_func, child, false, priority);
 				}
 			}
 		}
@@ -74,7 +74,8 @@ struct OperationDepsNode : public DepsNode {
 
 
 	uint32_t num_links_pending; /* how many inlinks are we still waiting on before we can be evaluated... */
-	float eval_priority;
+	float eval_priority;          /* estimated time of the longest chain of operations starting with this one */
+	float eval_time;              /* average time the operation took in previous evaluations, 0 when unknown */
 	bool scheduled;
 
 	short optype;                 /* (eDepsOperation_Type) stage of evaluation */
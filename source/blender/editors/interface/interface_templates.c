@@ -3738,6 +3738,7 @@ void uiTemplateColormanagedViewSettings(uiLayout *layout, bContext *UNUSED(C), P
 	uiItemR(col, &view_transform_ptr, "gamma", 0, NULL, ICON_NONE);
 
 	uiItemR(col, &view_transform_ptr, "look", 0, IFACE_("Look"), ICON_NONE);
+	uiItemR(col, &view_transform_ptr, "use_baked_lut", 0, NULL, ICON_NONE);
 
 	col = uiLayoutColumn(layout, false);
 	uiItemR(col, &view_transform_ptr, "use_curve_mapping", 0, NULL, ICON_NONE);
@@ -2704,6 +2704,10 @@ void init_userdef_do_versions(void)
 		}
 	}
 
+	if (!USER_VERSION_ATLEAST(277, 1)) {
+		U.compositorcachelimit = 256;
+	}
+
 	/**
 	 * Include next version bump.
 	 *
@@ -4954,6 +4954,46 @@ void MESH_OT_sort_elements(wmOperatorType *ot)
 
 /****** end of qsort stuff ****/
 
+static int edbm_compact_exec(bContext *C, wmOperator *op)
+{
+	Object *obedit = CTX_data_edit_object(C);
+	BMEditMesh *em = BKE_editmesh_from_object(obedit);
+	BMeshMemStats stats_prev, stats;
+
+	BM_mesh_memory_stats(em->bm, &stats_prev);
+
+	if (!BM_mesh_compact(em->bm)) {
+		BKE_report(op->reports, RPT_ERROR, "Mesh elements are referenced from Python, cannot compact");
+		return OPERATOR_CANCELLED;
+	}
+
+	BM_mesh_memory_stats(em->bm, &stats);
+
+	EDBM_update_generic(em, true, true);
+
+	BKE_reportf(op->reports, RPT_INFO, "Mesh memory: %.1f MB, was %.1f MB (elements use %.1f MB)",
+	            (double)stats.total / (1024.0 * 1024.0), (double)stats_prev.total / (1024.0 * 1024.0),
+	            (double)stats.used / (1024.0 * 1024.0));
+
+	return OPERATOR_FINISHED;
+}
+
+void MESH_OT_compact(wmOperatorType *ot)
+{
+	/* identifiers */
+	ot->name = "Compact Memory";
+	ot->description = "Reallocate the mesh elements in order, freeing the memory left by deleted elements "
+	                  "(may speed up tools on large meshes after heavy editing)";
+	ot->idname = "MESH_OT_compact";
+
+	/* api callbacks */
+	ot->exec = edbm_compact_exec;
+	ot->poll = ED_operator_editmesh;
+
+	/* flags */
+	ot->flag = OPTYPE_REGISTER | OPTYPE_UNDO;
+}
+
 static int edbm_noise_exec(bContext *C, wmOperator *op)
 {
 	Object *obedit = CTX_data_edit_object(C);
@@ -116,6 +116,7 @@ void ED_operatortypes_mesh(void)
 	WM_operatortype_append(MESH_OT_faces_shade_smooth);
 	WM_operatortype_append(MESH_OT_faces_shade_flat);
 	WM_operatortype_append(MESH_OT_sort_elements);
+	WM_operatortype_append(MESH_OT_compact);
 #ifdef WITH_FREESTYLE
 	WM_operatortype_append(MESH_OT_mark_freestyle_face);
 #endif
@@ -313,6 +313,10 @@ static int screen_render_exec(bContext *C, wmOperator *op)
 	BKE_image_signal(ima, NULL, IMA_SIGNAL_FREE);
 	BKE_image_backup_render(scene, ima, true);
 
+	/* the sequencer prefetch job can't render strips at the same time as the render pipeline,
+	 * screen_render_invoke stops it with the other jobs */
+	WM_jobs_kill_type(CTX_wm_manager(C), NULL, WM_JOB_TYPE_SEQ_PREFETCH);
+
 	/* cleanup sequencer caches before starting user triggered render.
 	 * otherwise, invalidated cache entries can make their way into
 	 * the output rendering. We can't put that into RE_BlenderFrame,
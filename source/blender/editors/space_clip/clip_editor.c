@@ -50,6 +50,8 @@
 #include "BLI_rect.h"
 #include "BLI_task.h"
 
+#include "PIL_time.h"
+
 #include "BKE_global.h"
 #include "BKE_main.h"
 #include "BKE_mask.h"
@@ -793,6 +795,7 @@ static void prefetch_task_func(TaskPool * __restrict pool, void *task_data, int
 		int flag = IB_rect | IB_alphamode_detect;
 		int result;
 		char *colorspace_name = NULL;
+		double start_time;
 		const bool use_proxy = (clip->flag & MCLIP_USE_PROXY) &&
 		                       (queue->render_size != MCLIP_PROXY_RENDER_SIZE_FULL);
 
@@ -805,9 +808,10 @@ static void prefetch_task_func(TaskPool * __restrict pool, void *task_data, int
 			colorspace_name = clip->colorspace_settings.name;
 		}
 
+		start_time = PIL_check_seconds_timer();
 		ibuf = IMB_ibImageFromMemory(mem, size, flag, colorspace_name, "prefetch frame");
 
-		result = BKE_movieclip_put_frame_if_possible(clip, &user, ibuf);
+		result = BKE_movieclip_put_frame_if_possible(clip, &user, ibuf, (float)(PIL_check_seconds_timer() - start_time));
 
 		IMB_freeImBuf(ibuf);
 
@@ -873,12 +877,14 @@ static bool prefetch_movie_frame(MovieClip *clip, int frame, short render_size,
 	user.render_flag = render_flag;
 
 	if (!BKE_movieclip_has_cached_frame(clip, &user)) {
+		const double start_time = PIL_check_seconds_timer();
+
 		ibuf = BKE_movieclip_anim_ibuf_for_frame(clip, &user);
 
 		if (ibuf) {
 			int result;
 
-			result = BKE_movieclip_put_frame_if_possible(clip, &user, ibuf);
+			result = BKE_movieclip_put_frame_if_possible(clip, &user, ibuf, (float)(PIL_check_seconds_timer() - start_time));
 
 			if (!result) {
 				/* no more space in the cache, we could stop prefetching here */
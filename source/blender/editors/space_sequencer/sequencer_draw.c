@@ -900,14 +900,11 @@ void ED_sequencer_special_preview_clear(void)
 	sequencer_special_update_set(NULL);
 }
 
-ImBuf *sequencer_ibuf_get(struct Main *bmain, Scene *scene, SpaceSeq *sseq, int cfra, int frame_ofs, const char *viewname)
+bool sequencer_render_data_get(struct Main *bmain, Scene *scene, SpaceSeq *sseq, const char *viewname, SeqRenderData *r_context)
 {
-	SeqRenderData context;
-	ImBuf *ibuf;
 	int rectx, recty;
 	float render_size;
 	float proxy_size = 100.0;
-	short is_break = G.is_break;
 
 	render_size = sseq->render_size;
 	if (render_size == 0) {
@@ -918,7 +915,7 @@ ImBuf *sequencer_ibuf_get(struct Main *bmain, Scene *scene, SpaceSeq *sseq, int
 	}
 
 	if (render_size < 0) {
-		return NULL;
+		return false;
 	}
 
 	rectx = (render_size * (float)scene->r.xsch) / 100.0f + 0.5f;
@@ -927,20 +924,36 @@ ImBuf *sequencer_ibuf_get(struct Main *bmain, Scene *scene, SpaceSeq *sseq, int
 	BKE_sequencer_new_render_data(
 	        bmain->eval_ctx, bmain, scene,
 	        rectx, recty, proxy_size,
-	        &context);
-	context.view_id = BKE_scene_multiview_view_id_get(&scene->r, viewname);
+	        r_context);
+	r_context->view_id = BKE_scene_multiview_view_id_get(&scene->r, viewname);
+
+	return true;
+}
+
+ImBuf *sequencer_ibuf_get(struct Main *bmain, Scene *scene, SpaceSeq *sseq, int cfra, int frame_ofs, const char *viewname)
+{
+	SeqRenderData context;
+	ImBuf *ibuf;
+	short is_break = G.is_break;
+
+	if (!sequencer_render_data_get(bmain, scene, sseq, viewname, &context)) {
+		return NULL;
+	}
 
 	/* sequencer could start rendering, in this case we need to be sure it wouldn't be canceled
 	 * by Esc pressed somewhere in the past
 	 */
 	G.is_break = false;
 
-	if (special_seq_update)
+	if (special_seq_update) {
+		/* the strip is being changed, frames rendered ahead are outdated */
+		BKE_sequencer_prefetch_stop();
 		ibuf = BKE_sequencer_give_ibuf_direct(&context, cfra + frame_ofs, special_seq_update);
-	else if (!U.prefetchframes) // XXX || (G.f & G_PLAYANIM) == 0) {
-		ibuf = BKE_sequencer_give_ibuf(&context, cfra + frame_ofs, sseq->chanshown);
-	else
+	}
+	else {
+		/* doesn't render at the same time as the prefetch job */
 		ibuf = BKE_sequencer_give_ibuf_threaded(&context, cfra + frame_ofs, sseq->chanshown);
+	}
 
 	/* restore state so real rendering would be canceled (if needed) */
 	G.is_break = is_break;
@@ -1145,6 +1158,11 @@ void draw_image_seq(const bContext *C, Scene *scene, ARegion *ar, SpaceSeq *sseq
 	/* for now we only support Left/Right */
 	ibuf = sequencer_ibuf_get(bmain, scene, sseq, cfra, frame_ofs, names[sseq->multiview_eye]);
 
+	/* render the next frames in the background during playback */
+	if (U.prefetchframes && !draw_overlay && !draw_backdrop && ED_screen_animation_playing(CTX_wm_manager(C))) {
+		sequencer_prefetch_start(C, scene, sseq, cfra, names[sseq->multiview_eye]);
+	}
+
 	if ((ibuf == NULL) ||
 	    (ibuf->rect == NULL && ibuf->rect_float == NULL))
 	{
@@ -0,0 +1,125 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * The Original Code is Copyright (C) 2016 Blender Foundation.
+ * All rights reserved.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file blender/editors/space_sequencer/sequencer_prefetch.c
+ *  \ingroup spseq
+ */
+
+#include "DNA_scene_types.h"
+#include "DNA_space_types.h"
+#include "DNA_userdef_types.h"
+
+#include "BLI_utildefines.h"
+#include "BLI_math_base.h"
+
+#include "BKE_context.h"
+#include "BKE_global.h"
+#include "BKE_sequencer.h"
+
+#include "WM_api.h"
+#include "WM_types.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "sequencer_intern.h"
+
+typedef struct PrefetchJob {
+	SeqRenderData context;
+	int chanshown;
+	int start_frame, end_frame;
+
+	/* see BKE_sequencer_prefetch_begin */
+	int generation;
+} PrefetchJob;
+
+/* only this runs inside thread */
+static void prefetch_startjob(void *pjv, short *stop, short *do_update, float *progress)
+{
+	PrefetchJob *pj = pjv;
+	int frame;
+
+	for (frame = pj->start_frame; frame <= pj->end_frame; frame++) {
+		if (*stop || G.is_break || G.is_rendering) {
+			break;
+		}
+
+		/* strips were changed or the cache is full */
+		if (!BKE_sequencer_prefetch_frame(&pj->context, frame, pj->chanshown, pj->generation)) {
+			break;
+		}
+
+		*do_update = true;
+		*progress = (float)(frame - pj->start_frame + 1) / (pj->end_frame - pj->start_frame + 1);
+	}
+}
+
+static void prefetch_freejob(void *pjv)
+{
+	PrefetchJob *pj = pjv;
+
+	MEM_freeN(pj);
+}
+
+/* start rendering the frames following cfra into the sequencer cache, a new job starts
+ * from the current frame when the previous one is done */
+void sequencer_prefetch_start(const bContext *C, Scene *scene, SpaceSeq *sseq, int cfra, const char *viewname)
+{
+	wmWindowManager *wm = CTX_wm_manager(C);
+	wmJob *wm_job;
+	PrefetchJob *pj;
+
+	/* renders stop the job when they start, don't start it again until they are done */
+	if (G.is_rendering || WM_jobs_test(wm, scene, WM_JOB_TYPE_SEQ_PREFETCH)) {
+		return;
+	}
+
+	if (!BKE_sequencer_prefetch_supported(scene)) {
+		return;
+	}
+
+	pj = MEM_callocN(sizeof(PrefetchJob), "sequencer prefetch job");
+
+	if (!sequencer_render_data_get(CTX_data_main(C), scene, sseq, viewname, &pj->context)) {
+		MEM_freeN(pj);
+		return;
+	}
+
+	pj->chanshown = sseq->chanshown;
+	pj->start_frame = cfra + 1;
+	pj->end_frame = min_ii(cfra + U.prefetchframes, PEFRA);
+	pj->generation = BKE_sequencer_prefetch_begin();
+
+	if (pj->start_frame > pj->end_frame) {
+		MEM_freeN(pj);
+		return;
+	}
+
+	wm_job = WM_jobs_get(wm, CTX_wm_window(C), scene, "Prefetching",
+	                     0, WM_JOB_TYPE_SEQ_PREFETCH);
+
+	WM_jobs_customdata_set(wm_job, pj, prefetch_freejob);
+	WM_jobs_timer(wm_job, 0.1, 0, 0);
+	WM_jobs_callbacks(wm_job, prefetch_startjob, NULL, NULL, NULL);
+
+	WM_jobs_start(wm, wm_job);
+}
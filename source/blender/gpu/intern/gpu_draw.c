@@ -821,13 +821,13 @@ void GPU_create_gl_tex(unsigned int *bind, unsigned int *rect, float *frect, int
 
 		if (use_high_bit_depth) {
 			ibuf = IMB_allocFromBuffer(NULL, frect, tpx, tpy);
-			IMB_scaleImBuf(ibuf, rectw, recth);
+			IMB_scaleImBuf_filter(ibuf, rectw, recth, IMB_SCALE_FILTER_BOX);
 
 			frect = ibuf->rect_float;
 		}
 		else {
 			ibuf = IMB_allocFromBuffer(rect, NULL, tpx, tpy);
-			IMB_scaleImBuf(ibuf, rectw, recth);
+			IMB_scaleImBuf_filter(ibuf, rectw, recth, IMB_SCALE_FILTER_BOX);
 
 			rect = ibuf->rect;
 		}
@@ -1181,10 +1181,10 @@ static bool GPU_check_scaled_image(ImBuf *ibuf, Image *ima, float *frect, int x,
 		if (rectw + x > x_limit) rectw--;
 		if (recth + y > y_limit) recth--;
 
-		/* float rectangles are already continuous in memory so we can use IMB_scaleImBuf */
+		/* float rectangles are already continuous in memory so we can use IMB_scaleImBuf_filter */
 		if (frect) {
 			ImBuf *ibuf_scale = IMB_allocFromBuffer(NULL, frect, w, h);
-			IMB_scaleImBuf(ibuf_scale, rectw, recth);
+			IMB_scaleImBuf_filter(ibuf_scale, rectw, recth, IMB_SCALE_FILTER_BOX);
 
 			glBindTexture(GL_TEXTURE_2D, ima->bindcode[TEXTARGET_TEXTURE_2D]);
 			glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, rectw, recth, GL_RGBA,
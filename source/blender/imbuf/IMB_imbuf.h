@@ -378,6 +378,20 @@ struct ImBuf *IMB_scalefastImBuf(struct ImBuf *ibuf, unsigned int newx, unsigned
  */
 void IMB_scaleImBuf_threaded(struct ImBuf *ibuf, unsigned int newx, unsigned int newy);
 
+typedef enum IMB_ScaleFilter {
+	IMB_SCALE_FILTER_BOX      = 0,  /* area average when downscaling, linear when upscaling */
+	IMB_SCALE_FILTER_MITCHELL = 1,
+	IMB_SCALE_FILTER_LANCZOS  = 2,
+} IMB_ScaleFilter;
+
+/**
+ * Separable, multithreaded resampling of the byte and float buffers.
+ *
+ * \attention Defined in scaling.c
+ */
+struct ImBuf *IMB_scaleImBuf_filter(struct ImBuf *ibuf, unsigned int newx, unsigned int newy,
+                                    IMB_ScaleFilter filter);
+
 /**
  *
  * \attention Defined in writeimage.c
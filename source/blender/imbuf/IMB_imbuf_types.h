@@ -258,6 +258,7 @@ typedef struct ImBuf {
 #define IB_ignore_alpha		(1 << 14)  /* ignore alpha on load and substitude it with 1.0f */
 #define IB_thumbnail		(1 << 15)
 #define IB_multiview		(1 << 16)
+#define IB_animdecoderpool	(1 << 17)  /* keep several movie decoders at different positions for scrubbing */
 
 /**
  * \name Imbuf preset profile tags
@@ -108,9 +108,45 @@
 
 #define MAXNUMSTREAMS       50
 
+#ifdef WITH_FFMPEG
+/* maximum number of decoders opened for an anim with IB_animdecoderpool */
+#  define ANIM_FFMPEG_MAX_DECODERS      4
+/* number of frames kept for reverse playback after seeking backwards */
+#  define ANIM_FFMPEG_REVERSE_FRAMES    8
+#endif
+
 struct _AviMovie;
 struct anim_index;
 
+#ifdef WITH_FFMPEG
+/* State of a decoder of the decoder pool which isn't in use,
+ * the decoder in use keeps its state in the anim itself. */
+struct anim_decoder {
+	AVFormatContext *pFormatCtx;
+	AVCodecContext *pCodecCtx;
+	AVFrame *pFrame;
+	int pFrameComplete;
+	AVFrame *pFrameRGB;
+	AVFrame *pFrameDeinterlaced;
+	struct SwsContext *img_convert_ctx;
+
+	struct ImBuf *last_frame;
+	int64_t last_pts;
+	int64_t next_pts;
+	AVPacket next_packet;
+
+	int curposition;
+	unsigned int last_used;
+};
+
+/* frame decoded on the way to a frame which was reached by seeking backwards */
+struct anim_reverse_frame {
+	struct ImBuf *ibuf;
+	int64_t pts;
+	int64_t next_pts;
+};
+#endif
+
 struct anim {
 	int ib_flags;
 	int curtype;
@@ -168,6 +204,15 @@ struct anim {
 	int64_t last_pts;
 	int64_t next_pts;
 	AVPacket next_packet;
+
+	/* decoder pool, see IB_animdecoderpool */
+	struct anim_decoder decoders[ANIM_FFMPEG_MAX_DECODERS - 1];
+	int num_decoders;
+	unsigned int decoder_last_used;
+	unsigned int decoder_use_counter;
+
+	struct anim_reverse_frame reverse_frames[ANIM_FFMPEG_REVERSE_FRAMES];
+	int reverse_frame_next;
 #endif
 
 	char index_dir[768];
@@ -67,6 +67,7 @@
 #include "BLI_utildefines.h"
 #include "BLI_string.h"
 #include "BLI_path_util.h"
+#include "BLI_threads.h"
 
 #include "MEM_guardedalloc.h"
 
@@ -512,6 +513,14 @@ static int startffmpeg(struct anim *anim)
 
 	pCodecCtx->workaround_bugs = 1;
 
+	/* long GOP footage needs all the decoding speed it can get when seeking,
+	 * the threads are shared by all decoders of a decoder pool */
+	pCodecCtx->thread_count = BLI_system_thread_count();
+	if (anim->ib_flags & IB_animdecoderpool) {
+		pCodecCtx->thread_count = MAX2(1, pCodecCtx->thread_count / ANIM_FFMPEG_MAX_DECODERS);
+	}
+	pCodecCtx->thread_type = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
 	if (avcodec_open2(pCodecCtx, pCodec, NULL) < 0) {
 		avformat_close_input(&pFormatCtx);
 		return -1;
@@ -662,13 +671,12 @@ static int startffmpeg(struct anim *anim)
 /* postprocess the image in anim->pFrame and do color conversion
  * and deinterlacing stuff.
  *
- * Output is anim->last_frame
+ * Output is ibuf, usually anim->last_frame
  */
 
-static void ffmpeg_postprocess(struct anim *anim)
+static void ffmpeg_postprocess(struct anim *anim, ImBuf *ibuf)
 {
 	AVFrame *input = anim->pFrame;
-	ImBuf *ibuf = anim->last_frame;
 	int filter_y = 0;
 
 	if (!anim->pFrameComplete) {
@@ -895,11 +903,59 @@ static int ffmpeg_decode_video_frame(struct anim *anim)
 	return (rval >= 0);
 }
 
+static ImBuf *ffmpeg_frame_ibuf_new(struct anim *anim)
+{
+	ImBuf *ibuf = IMB_allocImBuf(anim->x, anim->y, 32, IB_rect);
+	ibuf->rect_colorspace = colormanage_colorspace_get_named(anim->colorspace);
+	return ibuf;
+}
+
+static void ffmpeg_reverse_frame_add(struct anim *anim, ImBuf *ibuf, int64_t pts, int64_t next_pts)
+{
+	struct anim_reverse_frame *frame = &anim->reverse_frames[anim->reverse_frame_next];
+
+	IMB_freeImBuf(frame->ibuf);
+	frame->ibuf = ibuf;
+	frame->pts = pts;
+	frame->next_pts = next_pts;
+
+	anim->reverse_frame_next = (anim->reverse_frame_next + 1) % ANIM_FFMPEG_REVERSE_FRAMES;
+}
+
+static ImBuf *ffmpeg_reverse_frame_find(struct anim *anim, int64_t pts_to_search)
+{
+	int i;
+
+	for (i = 0; i < ANIM_FFMPEG_REVERSE_FRAMES; i++) {
+		struct anim_reverse_frame *frame = &anim->reverse_frames[i];
+		if (frame->ibuf && frame->pts <= pts_to_search && frame->next_pts > pts_to_search) {
+			return frame->ibuf;
+		}
+	}
+	return NULL;
+}
+
+static void ffmpeg_reverse_frames_free(struct anim *anim)
+{
+	int i;
+
+	for (i = 0; i < ANIM_FFMPEG_REVERSE_FRAMES; i++) {
+		IMB_freeImBuf(anim->reverse_frames[i].ibuf);
+		anim->reverse_frames[i].ibuf = NULL;
+	}
+	anim->reverse_frame_next = 0;
+}
+
+/* decode forward until pts_to_search, the frames from pts_to_keep on
+ * are kept for reverse playback */
+
 static void ffmpeg_decode_video_frame_scan(
-        struct anim *anim, int64_t pts_to_search)
+        struct anim *anim, int64_t pts_to_search, int64_t pts_to_keep)
 {
 	/* there seem to exist *very* silly GOP lengths out in the wild... */
 	int count = 1000;
+	ImBuf *keep_ibuf = NULL;
+	int64_t keep_pts = 0;
 
 	av_log(anim->pFormatCtx,
 	       AV_LOG_DEBUG, 
@@ -911,11 +967,23 @@ static void ffmpeg_decode_video_frame_scan(
 		       AV_LOG_DEBUG, 
 		       "  WHILE: pts=%lld in search of %lld\n", 
 		       (long long int)anim->next_pts, (long long int)pts_to_search);
+		if (anim->pFrameComplete && anim->next_pts >= pts_to_keep) {
+			keep_ibuf = ffmpeg_frame_ibuf_new(anim);
+			ffmpeg_postprocess(anim, keep_ibuf);
+			keep_pts = anim->next_pts;
+		}
 		if (!ffmpeg_decode_video_frame(anim)) {
 			break;
 		}
+		if (keep_ibuf) {
+			ffmpeg_reverse_frame_add(anim, keep_ibuf, keep_pts, anim->next_pts);
+			keep_ibuf = NULL;
+		}
 		count--;
 	}
+	if (keep_ibuf) {
+		IMB_freeImBuf(keep_ibuf);
+	}
 	if (count == 0) {
 		av_log(anim->pFormatCtx,
 		       AV_LOG_ERROR, 
@@ -973,6 +1041,154 @@ static int ffmpeg_seek_by_byte(AVFormatContext *pFormatCtx)
 	return false;
 }
 
+/* ---------------------------------------------------------------------- */
+/* decoder pool
+ *
+ * With IB_animdecoderpool several decoders are opened for the same stream,
+ * a fetch uses the decoder which gets to the requested frame with the least
+ * decoding. Only when no decoder can get there without seeking, another
+ * decoder is opened or the least recently used one seeks. That way jumping
+ * between a few places of a long GOP movie doesn't seek every time.
+ */
+
+static void ffmpeg_decoder_store(struct anim *anim, struct anim_decoder *dec)
+{
+	dec->pFormatCtx = anim->pFormatCtx;
+	dec->pCodecCtx = anim->pCodecCtx;
+	dec->pFrame = anim->pFrame;
+	dec->pFrameComplete = anim->pFrameComplete;
+	dec->pFrameRGB = anim->pFrameRGB;
+	dec->pFrameDeinterlaced = anim->pFrameDeinterlaced;
+	dec->img_convert_ctx = anim->img_convert_ctx;
+	dec->last_frame = anim->last_frame;
+	dec->last_pts = anim->last_pts;
+	dec->next_pts = anim->next_pts;
+	dec->next_packet = anim->next_packet;
+	dec->curposition = anim->curposition;
+	dec->last_used = anim->decoder_last_used;
+}
+
+static void ffmpeg_decoder_restore(struct anim *anim, const struct anim_decoder *dec)
+{
+	anim->pFormatCtx = dec->pFormatCtx;
+	anim->pCodecCtx = dec->pCodecCtx;
+	anim->pFrame = dec->pFrame;
+	anim->pFrameComplete = dec->pFrameComplete;
+	anim->pFrameRGB = dec->pFrameRGB;
+	anim->pFrameDeinterlaced = dec->pFrameDeinterlaced;
+	anim->img_convert_ctx = dec->img_convert_ctx;
+	anim->last_frame = dec->last_frame;
+	anim->last_pts = dec->last_pts;
+	anim->next_pts = dec->next_pts;
+	anim->next_packet = dec->next_packet;
+	anim->curposition = dec->curposition;
+	anim->decoder_last_used = dec->last_used;
+}
+
+static void ffmpeg_decoder_swap(struct anim *anim, struct anim_decoder *dec)
+{
+	struct anim_decoder tmp;
+
+	ffmpeg_decoder_store(anim, &tmp);
+	ffmpeg_decoder_restore(anim, dec);
+	*dec = tmp;
+}
+
+/* open another decoder and make it the one in use */
+static bool ffmpeg_decoder_add(struct anim *anim)
+{
+	struct anim_decoder *dec = &anim->decoders[anim->num_decoders];
+	const int preseek = anim->preseek;
+
+	ffmpeg_decoder_store(anim, dec);
+
+	if (startffmpeg(anim) != 0) {
+		ffmpeg_decoder_restore(anim, dec);
+		return false;
+	}
+
+	/* keep the preseek set by the user of the anim */
+	anim->preseek = preseek;
+	anim->num_decoders++;
+
+	return true;
+}
+
+/* number of frames the decoder has to decode to get to position, -1 when it has to seek */
+static int ffmpeg_decoder_distance(struct anim *anim, const struct anim_decoder *dec,
+                                   struct anim_index *tc_index, int position, int64_t pts_to_search)
+{
+	if (dec->last_frame && dec->last_pts <= pts_to_search && dec->next_pts > pts_to_search) {
+		return 0;
+	}
+
+	if (position == dec->curposition + 1) {
+		return 1;
+	}
+
+	if (tc_index) {
+		const int old_frame_index = IMB_indexer_get_frame_index(tc_index, dec->curposition);
+		const int new_frame_index = IMB_indexer_get_frame_index(tc_index, position);
+
+		if (IMB_indexer_can_scan(tc_index, old_frame_index, new_frame_index)) {
+			return new_frame_index - old_frame_index;
+		}
+	}
+	else if (position > dec->curposition + 1 &&
+	         anim->preseek &&
+	         position - (dec->curposition + 1) < anim->preseek)
+	{
+		return position - dec->curposition;
+	}
+
+	return -1;
+}
+
+/* make the decoder which gets to position fastest the one in use */
+static void ffmpeg_decoder_select(struct anim *anim, struct anim_index *tc_index,
+                                  int position, int64_t pts_to_search)
+{
+	struct anim_decoder active;
+	int best_distance, best = -1;
+	int i;
+
+	ffmpeg_decoder_store(anim, &active);
+	best_distance = ffmpeg_decoder_distance(anim, &active, tc_index, position, pts_to_search);
+
+	for (i = 0; i < anim->num_decoders; i++) {
+		const int distance = ffmpeg_decoder_distance(anim, &anim->decoders[i], tc_index, position, pts_to_search);
+
+		if (distance != -1 && (best_distance == -1 || distance < best_distance)) {
+			best_distance = distance;
+			best = i;
+		}
+	}
+
+	if (best_distance == -1) {
+		/* every decoder has to seek, leave the recently used ones where they are */
+		if (anim->num_decoders < ANIM_FFMPEG_MAX_DECODERS - 1 && ffmpeg_decoder_add(anim)) {
+			av_log(anim->pFormatCtx, AV_LOG_DEBUG,
+			       "FETCH: opened decoder %d\n", anim->num_decoders);
+			best = -1;
+		}
+		else {
+			for (i = 0; i < anim->num_decoders; i++) {
+				if (best == -1 || anim->decoders[i].last_used < anim->decoders[best].last_used) {
+					best = i;
+				}
+			}
+		}
+	}
+
+	if (best != -1) {
+		av_log(anim->pFormatCtx, AV_LOG_DEBUG,
+		       "FETCH: switching to decoder at pos=%d\n", anim->decoders[best].curposition);
+		ffmpeg_decoder_swap(anim, &anim->decoders[best]);
+	}
+
+	anim->decoder_last_used = ++anim->decoder_use_counter;
+}
+
 static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position,
                                IMB_Timecode_Type tc)
 {
@@ -984,6 +1200,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position,
 	AVStream *v_st;
 	int new_frame_index = 0; /* To quiet gcc barking... */
 	int old_frame_index = 0; /* To quiet gcc barking... */
+	int64_t pts_to_keep;
 
 	if (anim == NULL) return (0);
 
@@ -1003,8 +1220,6 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position,
 	if (tc_index) {
 		new_frame_index = IMB_indexer_get_frame_index(
 		        tc_index, position);
-		old_frame_index = IMB_indexer_get_frame_index(
-		        tc_index, anim->curposition);
 		pts_to_search = IMB_indexer_get_pts(
 		        tc_index, new_frame_index);
 	}
@@ -1023,6 +1238,33 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position,
 	       "(pts_timebase=%g, frame_rate=%g, st_time=%lld)\n", 
 	       (long long int)pts_to_search, pts_time_base, frame_rate, st_time);
 
+	/* when seeking backwards, keep the frames before the requested one
+	 * so playing or scrubbing further backwards doesn't seek for every frame */
+	pts_to_keep = pts_to_search;
+
+	if (anim->ib_flags & IB_animdecoderpool) {
+		ImBuf *ibuf = ffmpeg_reverse_frame_find(anim, pts_to_search);
+
+		if (ibuf) {
+			av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: reverse frame\n");
+			IMB_refImBuf(ibuf);
+			return ibuf;
+		}
+
+		if (position < anim->curposition) {
+			pts_to_keep -= (int64_t)(ANIM_FFMPEG_REVERSE_FRAMES / pts_time_base / frame_rate + 0.5);
+			pts_to_keep = MAX2(pts_to_keep, 0);
+		}
+
+		ffmpeg_decoder_select(anim, tc_index, position, pts_to_search);
+		v_st = anim->pFormatCtx->streams[anim->videoStream];
+	}
+
+	if (tc_index) {
+		old_frame_index = IMB_indexer_get_frame_index(
+		        tc_index, anim->curposition);
+	}
+
 	if (anim->last_frame && 
 	    anim->last_pts <= pts_to_search && anim->next_pts > pts_to_search)
 	{
@@ -1043,7 +1285,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position,
 		av_log(anim->pFormatCtx, AV_LOG_DEBUG, 
 		       "FETCH: within preseek interval (no index)\n");
 
-		ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+		ffmpeg_decode_video_frame_scan(anim, pts_to_search, pts_to_search);
 	}
 	else if (tc_index &&
 	         IMB_indexer_can_scan(tc_index, old_frame_index,
@@ -1053,7 +1295,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position,
 		       "FETCH: within preseek interval "
 		       "(index tells us)\n");
 
-		ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+		ffmpeg_decode_video_frame_scan(anim, pts_to_search, pts_to_search);
 	}
 	else if (position != anim->curposition + 1) {
 		long long pos;
@@ -1132,7 +1374,7 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position,
 		/* memset(anim->pFrame, ...) ?? */
 
 		if (ret >= 0) {
-			ffmpeg_decode_video_frame_scan(anim, pts_to_search);
+			ffmpeg_decode_video_frame_scan(anim, pts_to_search, pts_to_keep);
 		}
 	}
 	else if (position == 0 && anim->curposition == -1) {
@@ -1145,10 +1387,9 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position,
 	}
 
 	IMB_freeImBuf(anim->last_frame);
-	anim->last_frame = IMB_allocImBuf(anim->x, anim->y, 32, IB_rect);
-	anim->last_frame->rect_colorspace = colormanage_colorspace_get_named(anim->colorspace);
+	anim->last_frame = ffmpeg_frame_ibuf_new(anim);
 
-	ffmpeg_postprocess(anim);
+	ffmpeg_postprocess(anim, anim->last_frame);
 
 	anim->last_pts = anim->next_pts;
 	
@@ -1161,40 +1402,53 @@ static ImBuf *ffmpeg_fetchibuf(struct anim *anim, int position,
 	return anim->last_frame;
 }
 
+static void free_anim_ffmpeg_decoder(struct anim *anim)
+{
+	avcodec_close(anim->pCodecCtx);
+	avformat_close_input(&anim->pFormatCtx);
+
+	/* Special case here: pFrame could share pointers with codec,
+	 * so in order to avoid double-free we don't use av_frame_free()
+	 * to free the frame.
+	 *
+	 * Could it be a bug in FFmpeg?
+	 */
+	av_free(anim->pFrame);
+
+	if (!need_aligned_ffmpeg_buffer(anim)) {
+		/* If there's no need for own aligned buffer it means that FFmpeg's
+		 * frame shares the same buffer as temporary ImBuf. In this case we
+		 * should not free the buffer when freeing the FFmpeg buffer.
+		 */
+		avpicture_fill((AVPicture *)anim->pFrameRGB,
+		               NULL,
+		               AV_PIX_FMT_RGBA,
+		               anim->x, anim->y);
+	}
+	av_frame_free(&anim->pFrameRGB);
+	av_frame_free(&anim->pFrameDeinterlaced);
+
+	sws_freeContext(anim->img_convert_ctx);
+	IMB_freeImBuf(anim->last_frame);
+	if (anim->next_packet.stream_index != -1) {
+		av_free_packet(&anim->next_packet);
+	}
+}
+
 static void free_anim_ffmpeg(struct anim *anim)
 {
 	if (anim == NULL) return;
 
 	if (anim->pCodecCtx) {
-		avcodec_close(anim->pCodecCtx);
-		avformat_close_input(&anim->pFormatCtx);
-
-		/* Special case here: pFrame could share pointers with codec,
-		 * so in order to avoid double-free we don't use av_frame_free()
-		 * to free the frame.
-		 *
-		 * Could it be a bug in FFmpeg?
-		 */
-		av_free(anim->pFrame);
+		free_anim_ffmpeg_decoder(anim);
 
-		if (!need_aligned_ffmpeg_buffer(anim)) {
-			/* If there's no need for own aligned buffer it means that FFmpeg's
-			 * frame shares the same buffer as temporary ImBuf. In this case we
-			 * should not free the buffer when freeing the FFmpeg buffer.
-			 */
-			avpicture_fill((AVPicture *)anim->pFrameRGB,
-			               NULL,
-			               AV_PIX_FMT_RGBA,
-			               anim->x, anim->y);
+		while (anim->num_decoders > 0) {
+			anim->num_decoders--;
+			ffmpeg_decoder_restore(anim, &anim->decoders[anim->num_decoders]);
+			free_anim_ffmpeg_decoder(anim);
 		}
-		av_frame_free(&anim->pFrameRGB);
-		av_frame_free(&anim->pFrameDeinterlaced);
 
-		sws_freeContext(anim->img_convert_ctx);
-		IMB_freeImBuf(anim->last_frame);
-		if (anim->next_packet.stream_index != -1) {
-			av_free_packet(&anim->next_packet);
-		}
+		ffmpeg_reverse_frames_free(anim);
 	}
 	anim->duration = 0;
 }
@@ -1360,9 +1614,8 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim, int position,
 #endif
 #ifdef WITH_FFMPEG
 		case ANIM_FFMPEG:
+			/* sets curposition of the decoder in use itself */
 			ibuf = ffmpeg_fetchibuf(anim, position, tc);
-			if (ibuf)
-				anim->curposition = position;
 			filter_y = 0; /* done internally */
 			break;
 #endif
@@ -1370,7 +1623,7 @@ struct ImBuf *IMB_anim_absolute(struct anim *anim, int position,
 
 	if (ibuf) {
 		if (filter_y) IMB_filtery(ibuf);
-		BLI_snprintf(ibuf->name, sizeof(ibuf->name), "%s.%04d", anim->name, anim->curposition + 1);
+		BLI_snprintf(ibuf->name, sizeof(ibuf->name), "%s.%04d", anim->name, position + 1);
 		
 	}
 	return(ibuf);
@@ -38,6 +38,10 @@
 #include <string.h>
 #include <math.h>
 
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 #include "DNA_color_types.h"
 #include "DNA_image_types.h"
 #include "DNA_movieclip_types.h"
@@ -105,6 +109,8 @@ static pthread_mutex_t processor_lock = BLI_MUTEX_INITIALIZER;
 typedef struct ColormanageProcessor {
 	OCIO_ConstProcessorRcPtr *processor;
 	CurveMapping *curve_mapping;
+	/* baked display transform, used instead of processor when set */
+	struct ColormanageLUT *lut;
 	bool is_data_result;
 } ColormanageProcessor;
 
@@ -129,6 +135,317 @@ static struct global_glsl_state {
 	struct OCIO_GLSLDrawState *transform_ocio_glsl_state;
 } global_glsl_state;
 
+/*********************** Baked display LUTs *************************/
+
+/* Display transforms baked into a 3D LUT, used for display buffers when
+ * COLORMANAGE_VIEW_USE_LUT is set. Scene linear input is remapped by a
+ * logarithmic shaper first so the lattice covers the HDR range, pixels
+ * outside of the shaper range fall back to the OCIO processor.
+ */
+
+#define DISPLAY_LUT_SIZE 65
+/* log2 of the lowest and highest shaper input */
+#define DISPLAY_LUT_SHAPER_MIN -9
+#define DISPLAY_LUT_SHAPER_MAX 7
+/* added to the input so 0 maps to the start of the shaper range */
+#define DISPLAY_LUT_SHAPER_OFFSET (1.0f / 512.0f)
+/* number of baked LUTs kept around for the combinations used last */
+#define DISPLAY_LUT_MAX_CACHED 4
+
+typedef struct ColormanageLUT {
+	struct ColormanageLUT *next, *prev;
+
+	/* settings of the baked transform */
+	char look[MAX_COLORSPACE_NAME];
+	char view[MAX_COLORSPACE_NAME];
+	char display[MAX_COLORSPACE_NAME];
+	char input[MAX_COLORSPACE_NAME];
+	float exposure, gamma;
+
+	/* DISPLAY_LUT_SIZE^3 RGB triplets, red changing fastest */
+	float *table;
+
+	/* processors using the LUT, plus one while it is in global_display_luts */
+	int users;
+} ColormanageLUT;
+
+static ListBase global_display_luts = {NULL, NULL};
+static ThreadMutex display_lut_lock = BLI_MUTEX_INITIALIZER;
+
+/* Piecewise linear approximation of log2 of x + offset, normalized to 0..1
+ * for the shaper range. Unlike log2f it is cheap and exactly inverted by
+ * display_lut_shaper_inverse. Only valid for display_lut_shaper_in_range input.
+ */
+BLI_INLINE float display_lut_shaper(float x)
+{
+	union { float f; unsigned int i; } value;
+	int exponent;
+	float mantissa;
+
+	value.f = x + DISPLAY_LUT_SHAPER_OFFSET;
+	exponent = (int)(value.i >> 23) - 127;
+	mantissa = (float)(value.i & 0x7fffff) * (1.0f / (float)(1 << 23));
+
+	return ((float)(exponent - DISPLAY_LUT_SHAPER_MIN) + mantissa) *
+	       (1.0f / (float)(DISPLAY_LUT_SHAPER_MAX - DISPLAY_LUT_SHAPER_MIN));
+}
+
+static float display_lut_shaper_inverse(float s)
+{
+	const float t = s * (float)(DISPLAY_LUT_SHAPER_MAX - DISPLAY_LUT_SHAPER_MIN) + (float)DISPLAY_LUT_SHAPER_MIN;
+	const float exponent = floorf(t);
+
+	return ldexpf(1.0f + (t - exponent), (int)exponent) - DISPLAY_LUT_SHAPER_OFFSET;
+}
+
+BLI_INLINE bool display_lut_shaper_in_range(const float rgb[3])
+{
+	/* written so NaN is out of range */
+	const float max = (float)(1 << DISPLAY_LUT_SHAPER_MAX) - 2.0f * DISPLAY_LUT_SHAPER_OFFSET;
+
+	return (rgb[0] >= 0.0f && rgb[0] < max &&
+	        rgb[1] >= 0.0f && rgb[1] < max &&
+	        rgb[2] >= 0.0f && rgb[2] < max);
+}
+
+static float *display_lut_bake(OCIO_ConstProcessorRcPtr *processor)
+{
+	const int size = DISPLAY_LUT_SIZE;
+	const size_t table_len = 3 * (size_t)size * size * size;
+	OCIO_PackedImageDesc *img;
+	float grid[DISPLAY_LUT_SIZE];
+	float *table, *fp;
+	int r, g, b;
+
+	/* one extra float so the SIMD loads of the last entry stay inside the table */
+	table = MEM_mallocN(sizeof(float) * (table_len + 1), "display LUT table");
+	table[table_len] = 0.0f;
+
+	for (r = 0; r < size; r++) {
+		grid[r] = display_lut_shaper_inverse((float)r / (float)(size - 1));
+	}
+
+	fp = table;
+	for (b = 0; b < size; b++) {
+		for (g = 0; g < size; g++) {
+			for (r = 0; r < size; r++, fp += 3) {
+				fp[0] = grid[r];
+				fp[1] = grid[g];
+				fp[2] = grid[b];
+			}
+		}
+	}
+
+	/* the whole lattice as one image, so OCIO can use its optimized path */
+	img = OCIO_createOCIO_PackedImageDesc(
+	        table, (long)size * size, size, 3, sizeof(float),
+	        3 * sizeof(float), 3 * sizeof(float) * size * size);
+	OCIO_processorApply(processor, img);
+	OCIO_PackedImageDescRelease(img);
+
+	return table;
+}
+
+static void display_lut_free(ColormanageLUT *lut)
+{
+	MEM_freeN(lut->table);
+	MEM_freeN(lut);
+}
+
+/* display_lut_lock must be held */
+static void display_lut_remove(ColormanageLUT *lut)
+{
+	BLI_remlink(&global_display_luts, lut);
+
+	if (--lut->users == 0) {
+		display_lut_free(lut);
+	}
+}
+
+static ColormanageLUT *display_lut_acquire(const ColorManagedViewSettings *view_settings,
+                                           const ColorManagedDisplaySettings *display_settings,
+                                           OCIO_ConstProcessorRcPtr *processor)
+{
+	const char *input = global_role_scene_linear;
+	ColormanageLUT *lut;
+
+	BLI_mutex_lock(&display_lut_lock);
+
+	for (lut = global_display_luts.first; lut; lut = lut->next) {
+		if (lut->exposure == view_settings->exposure &&
+		    lut->gamma == view_settings->gamma &&
+		    STREQ(lut->look, view_settings->look) &&
+		    STREQ(lut->view, view_settings->view_transform) &&
+		    STREQ(lut->display, display_settings->display_device) &&
+		    STREQ(lut->input, input))
+		{
+			break;
+		}
+	}
+
+	if (lut) {
+		/* keep the most recently used LUTs first */
+		BLI_remlink(&global_display_luts, lut);
+		BLI_addhead(&global_display_luts, lut);
+	}
+	else {
+		lut = MEM_callocN(sizeof(ColormanageLUT), "display LUT");
+
+		BLI_strncpy(lut->look, view_settings->look, sizeof(lut->look));
+		BLI_strncpy(lut->view, view_settings->view_transform, sizeof(lut->view));
+		BLI_strncpy(lut->display, display_settings->display_device, sizeof(lut->display));
+		BLI_strncpy(lut->input, input, sizeof(lut->input));
+		lut->exposure = view_settings->exposure;
+		lut->gamma = view_settings->gamma;
+
+		/* baked while the lock is held, so the same LUT isn't baked by several threads */
+		lut->table = display_lut_bake(processor);
+		lut->users = 1;
+
+		BLI_addhead(&global_display_luts, lut);
+
+		if (BLI_listbase_count_ex(&global_display_luts, DISPLAY_LUT_MAX_CACHED + 1) > DISPLAY_LUT_MAX_CACHED) {
+			display_lut_remove(global_display_luts.last);
+		}
+	}
+
+	lut->users++;
+
+	BLI_mutex_unlock(&display_lut_lock);
+
+	return lut;
+}
+
+static void display_lut_release(ColormanageLUT *lut)
+{
+	BLI_mutex_lock(&display_lut_lock);
+
+	if (--lut->users == 0) {
+		display_lut_free(lut);
+	}
+
+	BLI_mutex_unlock(&display_lut_lock);
+}
+
+static void display_lut_free_all(void)
+{
+	BLI_mutex_lock(&display_lut_lock);
+
+	while (global_display_luts.first) {
+		display_lut_remove(global_display_luts.first);
+	}
+
+	BLI_mutex_unlock(&display_lut_lock);
+}
+
+/* tetrahedral interpolation of the lattice, rgb must be inside of the shaper range */
+BLI_INLINE void display_lut_interpolate(const ColormanageLUT *lut, float rgb[3])
+{
+	const int size = DISPLAY_LUT_SIZE;
+	const int stride_r = 3, stride_g = 3 * size, stride_b = 3 * size * size;
+	const float *c000, *c111, *ca, *cb;
+	float f[3], w0, wa, wb, w1;
+	int i[3], c;
+
+	for (c = 0; c < 3; c++) {
+		const float s = display_lut_shaper(rgb[c]) * (float)(size - 1);
+
+		i[c] = min_ii((int)s, size - 2);
+		f[c] = s - (float)i[c];
+	}
+
+	c000 = lut->table + i[0] * stride_r + i[1] * stride_g + i[2] * stride_b;
+	c111 = c000 + stride_r + stride_g + stride_b;
+
+	/* pick the tetrahedron containing the point by ordering the fractions */
+	if (f[0] > f[1]) {
+		if (f[1] > f[2]) {
+			ca = c000 + stride_r; cb = ca + stride_g;
+			w0 = 1.0f - f[0]; wa = f[0] - f[1]; wb = f[1] - f[2]; w1 = f[2];
+		}
+		else if (f[0] > f[2]) {
+			ca = c000 + stride_r; cb = ca + stride_b;
+			w0 = 1.0f - f[0]; wa = f[0] - f[2]; wb = f[2] - f[1]; w1 = f[1];
+		}
+		else {
+			ca = c000 + stride_b; cb = ca + stride_r;
+			w0 = 1.0f - f[2]; wa = f[2] - f[0]; wb = f[0] - f[1]; w1 = f[1];
+		}
+	}
+	else {
+		if (f[2] > f[1]) {
+			ca = c000 + stride_b; cb = ca + stride_g;
+			w0 = 1.0f - f[2]; wa = f[2] - f[1]; wb = f[1] - f[0]; w1 = f[0];
+		}
+		else if (f[2] > f[0]) {
+			ca = c000 + stride_g; cb = ca + stride_b;
+			w0 = 1.0f - f[1]; wa = f[1] - f[2]; wb = f[2] - f[0]; w1 = f[0];
+		}
+		else {
+			ca = c000 + stride_g; cb = ca + stride_r;
+			w0 = 1.0f - f[1]; wa = f[1] - f[0]; wb = f[0] - f[2]; w1 = f[2];
+		}
+	}
+
+#ifdef __SSE2__
+	{
+		/* the fourth lane reads the next table entry (or the padding) and is discarded */
+		__m128 result = _mm_mul_ps(_mm_set1_ps(w0), _mm_loadu_ps(c000));
+		float result_v4[4];
+
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(wa), _mm_loadu_ps(ca)));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(wb), _mm_loadu_ps(cb)));
+		result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(w1), _mm_loadu_ps(c111)));
+		_mm_storeu_ps(result_v4, result);
+
+		copy_v3_v3(rgb, result_v4);
+	}
+#else
+	for (c = 0; c < 3; c++) {
+		rgb[c] = w0 * c000[c] + wa * ca[c] + wb * cb[c] + w1 * c111[c];
+	}
+#endif
+}
+
+static void display_lut_apply_rgb(const ColormanageLUT *lut, OCIO_ConstProcessorRcPtr *processor, float rgb[3])
+{
+	if (display_lut_shaper_in_range(rgb))
+		display_lut_interpolate(lut, rgb);
+	else
+		OCIO_processorApplyRGB(processor, rgb);
+}
+
+static void display_lut_apply_rgba_predivide(const ColormanageLUT *lut, OCIO_ConstProcessorRcPtr *processor,
+                                             float pixel[4])
+{
+	if (pixel[3] == 1.0f || pixel[3] == 0.0f) {
+		display_lut_apply_rgb(lut, processor, pixel);
+	}
+	else {
+		const float alpha = pixel[3];
+
+		mul_v3_fl(pixel, 1.0f / alpha);
+		display_lut_apply_rgb(lut, processor, pixel);
+		mul_v3_fl(pixel, alpha);
+	}
+}
+
+static void display_lut_apply(const ColormanageLUT *lut, OCIO_ConstProcessorRcPtr *processor,
+                              float *buffer, size_t num_pixels, int channels, bool predivide)
+{
+	float *pixel = buffer;
+	size_t i;
+
+	if (predivide && channels == 4) {
+		for (i = 0; i < num_pixels; i++, pixel += channels)
+			display_lut_apply_rgba_predivide(lut, processor, pixel);
+	}
+	else {
+		for (i = 0; i < num_pixels; i++, pixel += channels)
+			display_lut_apply_rgb(lut, processor, pixel);
+	}
+}
+
 /*********************** Color managed cache *************************/
 
 /* Cache Implementation Notes
@@ -560,6 +877,9 @@ static void colormanage_free_config(void)
 	ColorSpace *colorspace;
 	ColorManagedDisplay *display;
 
+	/* baked LUTs might not match the new configuration */
+	display_lut_free_all();
+
 	/* free color spaces */
 	colorspace = global_colorspaces.first;
 	while (colorspace) {
@@ -1513,6 +1833,19 @@ static bool is_ibuf_rect_in_display_space(ImBuf *ibuf, const ColorManagedViewSet
 	return false;
 }
 
+/* processor for the display buffers drawn by editors, uses a baked LUT when the view settings ask for it */
+static ColormanageProcessor *display_buffer_processor_new(const ColorManagedViewSettings *view_settings,
+                                                          const ColorManagedDisplaySettings *display_settings)
+{
+	ColormanageProcessor *cm_processor = IMB_colormanagement_display_processor_new(view_settings, display_settings);
+
+	if (view_settings && (view_settings->flag & COLORMANAGE_VIEW_USE_LUT) && cm_processor->processor) {
+		cm_processor->lut = display_lut_acquire(view_settings, display_settings, cm_processor->processor);
+	}
+
+	return cm_processor;
+}
+
 static void colormanage_display_buffer_process_ex(ImBuf *ibuf, float *display_buffer, unsigned char *display_buffer_byte,
                                                   const ColorManagedViewSettings *view_settings,
                                                   const ColorManagedDisplaySettings *display_settings)
@@ -1530,7 +1863,7 @@ static void colormanage_display_buffer_process_ex(ImBuf *ibuf, float *display_bu
 	}
 
 	if (skip_transform == false)
-		cm_processor = IMB_colormanagement_display_processor_new(view_settings, display_settings);
+		cm_processor = display_buffer_processor_new(view_settings, display_settings);
 
 	display_buffer_apply_threaded(ibuf, ibuf->rect_float, (unsigned char *) ibuf->rect,
 	                              display_buffer, display_buffer_byte, cm_processor);
@@ -2793,7 +3126,7 @@ void IMB_partial_display_buffer_update(ImBuf *ibuf, const float *linear_buffer,
 		}
 
 		if (!skip_transform) {
-			cm_processor = IMB_colormanagement_display_processor_new(view_settings, display_settings);
+			cm_processor = display_buffer_processor_new(view_settings, display_settings);
 		}
 
 		partial_buffer_update_rect(ibuf, display_buffer, linear_buffer, byte_buffer, buffer_width, stride,
@@ -2886,7 +3219,9 @@ void IMB_colormanagement_processor_apply_v4(ColormanageProcessor *cm_processor,
 	if (cm_processor->curve_mapping)
 		curvemapping_evaluate_premulRGBF(cm_processor->curve_mapping, pixel, pixel);
 
-	if (cm_processor->processor)
+	if (cm_processor->lut)
+		display_lut_apply_rgb(cm_processor->lut, cm_processor->processor, pixel);
+	else if (cm_processor->processor)
 		OCIO_processorApplyRGBA(cm_processor->processor, pixel);
 }
 
@@ -2895,7 +3230,9 @@ void IMB_colormanagement_processor_apply_v4_predivide(ColormanageProcessor *cm_p
 	if (cm_processor->curve_mapping)
 		curvemapping_evaluate_premulRGBF(cm_processor->curve_mapping, pixel, pixel);
 
-	if (cm_processor->processor)
+	if (cm_processor->lut)
+		display_lut_apply_rgba_predivide(cm_processor->lut, cm_processor->processor, pixel);
+	else if (cm_processor->processor)
 		OCIO_processorApplyRGBA_predivide(cm_processor->processor, pixel);
 }
 
@@ -2904,7 +3241,9 @@ void IMB_colormanagement_processor_apply_v3(ColormanageProcessor *cm_processor,
 	if (cm_processor->curve_mapping)
 		curvemapping_evaluate_premulRGBF(cm_processor->curve_mapping, pixel, pixel);
 
-	if (cm_processor->processor)
+	if (cm_processor->lut)
+		display_lut_apply_rgb(cm_processor->lut, cm_processor->processor, pixel);
+	else if (cm_processor->processor)
 		OCIO_processorApplyRGB(cm_processor->processor, pixel);
 }
 
@@ -2942,7 +3281,11 @@ void IMB_colormanagement_processor_apply(ColormanageProcessor *cm_processor, flo
 		}
 	}
 
-	if (cm_processor->processor && channels >= 3) {
+	if (cm_processor->lut && channels >= 3) {
+		display_lut_apply(cm_processor->lut, cm_processor->processor, buffer,
+		                  ((size_t)width) * height, channels, predivide);
+	}
+	else if (cm_processor->processor && channels >= 3) {
 		OCIO_PackedImageDesc *img;
 
 		/* apply OCIO processor */
@@ -2964,6 +3307,8 @@ void IMB_colormanagement_processor_free(ColormanageProcessor *cm_processor)
 {
 	if (cm_processor->curve_mapping)
 		curvemapping_free(cm_processor->curve_mapping);
+	if (cm_processor->lut)
+		display_lut_release(cm_processor->lut);
 	if (cm_processor->processor)
 		OCIO_processorRelease(cm_processor->processor);
 
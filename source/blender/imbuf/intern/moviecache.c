@@ -32,6 +32,7 @@
 #undef DEBUG_MESSAGES
 
 #include <stdlib.h> /* for qsort */
+#include <limits.h>
 #include <memory.h>
 
 #include "MEM_guardedalloc.h"
@@ -61,6 +62,19 @@
 static MEM_CacheLimiterC *limitor = NULL;
 static pthread_mutex_t limitor_lock = BLI_MUTEX_INITIALIZER;
 
+/* Items are freed using GreedyDual-Size: the value of an item is the time
+ * it took to produce it per megabyte of memory it uses, plus the value of
+ * the last freed item at the time the item was put or used. The item with
+ * the lowest value is freed first, so cheap and big items go before
+ * expensive and small ones, and items which aren't used age out.
+ *
+ * Value of the last freed item, protected by limitor_lock. */
+static double limitor_clock = 0.0;
+
+/* Items put without a cost are assumed to take as long to produce again as reading them
+ * at this speed, so they aren't always freed before the items with a cost. */
+#define MOVIECACHE_DEFAULT_MEGABYTES_PER_SECOND 100.0
+
 typedef struct MovieCache {
 	char name[64];
 
@@ -83,6 +97,8 @@ typedef struct MovieCache {
 
 	int totseg, *points, proxy, render_flags;  /* for visual statistics optimization */
 	int pad;
+
+	MovieCacheStats stats;
 } MovieCache;
 
 typedef struct MovieCacheKey {
@@ -95,6 +111,10 @@ typedef struct MovieCacheItem {
 	ImBuf *ibuf;
 	MEM_CacheLimiterHandleC *c_handle;
 	void *priority_data;
+
+	/* time it took to produce the buffer in seconds, and the GreedyDual-Size value */
+	float cost;
+	double value;
 } MovieCacheItem;
 
 static unsigned int moviecache_hashhash(const void *keyv)
@@ -180,6 +200,10 @@ static void IMB_moviecache_destructor(void *p)
 
 		PRINT("%s: cache '%s' destroy item %p buffer %p\n", __func__, cache->name, item, item->ibuf);
 
+		/* called by the limiter with limitor_lock held */
+		limitor_clock = MAX2(limitor_clock, item->value);
+		cache->stats.evictions++;
+
 		IMB_freeImBuf(item->ibuf);
 
 		item->ibuf = NULL;
@@ -246,23 +270,41 @@ static size_t get_item_size(void *p)
 	return size;
 }
 
-static int get_item_priority(void *item_v, int default_priority)
+/* update the GreedyDual-Size value of an item after it was put or used, needs limitor_lock */
+static void item_value_update(MovieCacheItem *item)
+{
+	const double megabytes = (double)IMB_get_size_in_memory(item->ibuf) / (1024.0 * 1024.0);
+
+	item->value = limitor_clock;
+
+	if (megabytes > 0.0) {
+		/* in microseconds per megabyte, so the priorities have a useful resolution as integers */
+		item->value += (double)item->cost * 1e6 / megabytes;
+	}
+}
+
+static int get_item_priority(void *item_v, int UNUSED(default_priority))
 {
 	MovieCacheItem *item = (MovieCacheItem *) item_v;
 	MovieCache *cache = item->cache_owner;
-	int priority;
+	double value = item->value - limitor_clock;
 
-	if (!cache->getitempriorityfp) {
-		PRINT("%s: cache '%s' item %p use default priority %d\n", __func__, cache-> name, item, default_priority);
+	if (cache->getitempriorityfp) {
+		/* the cache priority is zero for the items most likely to be used again
+		 * and gets lower from there, scale the value down for the unlikely ones */
+		const int priority = cache->getitempriorityfp(cache->last_userkey, item->priority_data);
+		const double scale = 1.0 + abs(priority);
 
-		return default_priority;
+		value = (value > 0.0) ? value / scale : value * scale;
+
+		PRINT("%s: cache '%s' item %p priority %d\n", __func__, cache-> name, item, priority);
 	}
 
-	priority = cache->getitempriorityfp(cache->last_userkey, item->priority_data);
+	PRINT("%s: cache '%s' item %p value %f\n", __func__, cache-> name, item, value);
 
-	PRINT("%s: cache '%s' item %p priority %d\n", __func__, cache-> name, item, priority);
+	CLAMP(value, (double)INT_MIN, (double)INT_MAX);
 
-	return priority;
+	return (int)value;
 }
 
 static bool get_item_destroyable(void *item_v)
@@ -334,7 +376,7 @@ void IMB_moviecache_set_priority_callback(struct MovieCache *cache, MovieCacheGe
 	cache->prioritydeleterfp = prioritydeleterfp;
 }
 
-static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, bool need_lock)
+static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, float cost, bool need_lock)
 {
 	MovieCacheKey *key;
 	MovieCacheItem *item;
@@ -344,6 +386,16 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
 
 	IMB_refImBuf(ibuf);
 
+	/* putting a buffer again doesn't make it cheaper to produce */
+	{
+		MovieCacheKey old_key = {cache, userkey};
+		MovieCacheItem *old_item = BLI_ghash_lookup(cache->hash, &old_key);
+
+		if (old_item && old_item->ibuf == ibuf) {
+			cost = MAX2(cost, old_item->cost);
+		}
+	}
+
 	key = BLI_mempool_alloc(cache->keys_pool);
 	key->cache_owner = cache;
 	key->userkey = BLI_mempool_alloc(cache->userkeys_pool);
@@ -357,6 +409,8 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
 	item->cache_owner = cache;
 	item->c_handle = NULL;
 	item->priority_data = NULL;
+	item->cost = cost;
+	item->value = 0.0;
 
 	if (cache->getprioritydatafp) {
 		item->priority_data = cache->getprioritydatafp(userkey);
@@ -371,6 +425,7 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
 	if (need_lock)
 		BLI_mutex_lock(&limitor_lock);
 
+	item_value_update(item);
 	item->c_handle = MEM_CacheLimiter_insert(limitor, item);
 
 	MEM_CacheLimiter_ref(item->c_handle);
@@ -391,10 +446,19 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
 
 void IMB_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf)
 {
-	do_moviecache_put(cache, userkey, ibuf, true);
+	const double megabytes = (double)IMB_get_size_in_memory(ibuf) / (1024.0 * 1024.0);
+	const float cost = (float)(megabytes / MOVIECACHE_DEFAULT_MEGABYTES_PER_SECOND);
+
+	do_moviecache_put(cache, userkey, ibuf, cost, true);
+}
+
+/* cost is the time in seconds it took to produce ibuf, expensive buffers are kept longer */
+void IMB_moviecache_put_ex(MovieCache *cache, void *userkey, ImBuf *ibuf, float cost)
+{
+	do_moviecache_put(cache, userkey, ibuf, cost, true);
 }
 
-bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibuf)
+bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibuf, float cost)
 {
 	size_t mem_in_use, mem_limit, elem_size;
 	bool result = false;
@@ -406,7 +470,7 @@ bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibu
 	mem_in_use = MEM_CacheLimiter_get_memory_in_use(limitor);
 
 	if (mem_in_use + elem_size <= mem_limit) {
-		do_moviecache_put(cache, userkey, ibuf, false);
+		do_moviecache_put(cache, userkey, ibuf, cost, false);
 		result = true;
 	}
 
@@ -428,6 +492,8 @@ ImBuf *IMB_moviecache_get(MovieCache *cache, void *userkey)
 		if (item->ibuf) {
 			BLI_mutex_lock(&limitor_lock);
 			MEM_CacheLimiter_touch(item->c_handle);
+			item_value_update(item);
+			cache->stats.hits++;
 			BLI_mutex_unlock(&limitor_lock);
 
 			IMB_refImBuf(item->ibuf);
@@ -436,6 +502,11 @@ ImBuf *IMB_moviecache_get(MovieCache *cache, void *userkey)
 		}
 	}
 
+	/* the statistics are protected by limitor_lock, like the evictions counted by the limiter */
+	BLI_mutex_lock(&limitor_lock);
+	cache->stats.misses++;
+	BLI_mutex_unlock(&limitor_lock);
+
 	return NULL;
 }
 
@@ -451,6 +522,13 @@ bool IMB_moviecache_has_frame(MovieCache *cache, void *userkey)
 	return item != NULL;
 }
 
+void IMB_moviecache_get_stats(MovieCache *cache, MovieCacheStats *r_stats)
+{
+	BLI_mutex_lock(&limitor_lock);
+	*r_stats = cache->stats;
+	BLI_mutex_unlock(&limitor_lock);
+}
+
 void IMB_moviecache_free(MovieCache *cache)
 {
 	PRINT("%s: cache '%s' free\n", __func__, cache->name);
@@ -32,9 +32,19 @@
  */
 
 
+#include <math.h>
+#include <string.h>
+
+#ifdef __SSE2__
+#  include <emmintrin.h>
+#endif
+
 #include "BLI_utildefines.h"
+#include "BLI_math_base.h"
 #include "BLI_math_color.h"
 #include "BLI_math_interp.h"
+#include "BLI_math_vector.h"
+#include "BLI_task.h"
 #include "MEM_guardedalloc.h"
 
 #include "imbuf.h"
@@ -1767,3 +1777,362 @@ void IMB_scaleImBuf_threaded(ImBuf *ibuf, unsigned int newx, unsigned int newy)
 		ibuf->rect_float = init_data.float_buffer;
 	}
 }
+
+/* ******** filtered scaling ******** */
+
+/* Separable resampling: the weights of every output column and row are computed
+ * once, then the image is filtered horizontally into a float buffer and that
+ * buffer vertically into the result. Both passes are threaded over rows. */
+
+/* output pixels below which the passes aren't threaded */
+#define SCALE_FILTER_THREADED_MIN (64 * 64)
+
+typedef struct ScaleFilterWeights {
+	/* number of consecutive source pixels contributing to every output pixel */
+	int taps;
+	/* first source pixel for every output pixel */
+	int *start;
+	/* taps normalized weights for every output pixel */
+	float *weights;
+} ScaleFilterWeights;
+
+typedef struct ScaleFilterData {
+	const ScaleFilterWeights *weights_x;
+	const ScaleFilterWeights *weights_y;
+	IMB_ScaleFilter filter;
+
+	int width, height;
+	int newx, newy;
+	int channels;
+
+	const unsigned char *rect;
+	const float *rect_float;
+	unsigned char *newrect;
+	float *newrect_float;
+
+	/* result of the horizontal pass, newx * height pixels */
+	float *buffer;
+	int buffer_channels;
+} ScaleFilterData;
+
+/* Mitchell-Netravali with B = C = 1/3 */
+static float scale_filter_mitchell(float x)
+{
+	x = fabsf(x);
+
+	if (x < 1.0f) {
+		return (7.0f * x * x * x - 12.0f * x * x + 16.0f / 3.0f) * (1.0f / 6.0f);
+	}
+	else if (x < 2.0f) {
+		return (-7.0f / 3.0f * x * x * x + 12.0f * x * x - 20.0f * x + 32.0f / 3.0f) * (1.0f / 6.0f);
+	}
+
+	return 0.0f;
+}
+
+/* Lanczos with three lobes */
+static float scale_filter_lanczos(float x)
+{
+	x = fabsf(x);
+
+	if (x < 1e-6f) {
+		return 1.0f;
+	}
+	else if (x < 3.0f) {
+		const float px = (float)M_PI * x;
+		return 3.0f * sinf(px) * sinf(px / 3.0f) / (px * px);
+	}
+
+	return 0.0f;
+}
+
+static void scale_filter_weights_init(ScaleFilterWeights *fw, IMB_ScaleFilter filter, int size, int newsize)
+{
+	const float scale = (float)size / (float)newsize;
+	/* when downscaling the filter is widened to cover the footprint of the output pixel */
+	const float filter_scale = max_ff(scale, 1.0f);
+	float support;
+	int i, j;
+
+	switch (filter) {
+		case IMB_SCALE_FILTER_MITCHELL:
+			support = 2.0f * filter_scale;
+			break;
+		case IMB_SCALE_FILTER_LANCZOS:
+			support = 3.0f * filter_scale;
+			break;
+		case IMB_SCALE_FILTER_BOX:
+		default:
+			support = 0.5f * filter_scale + 0.5f;
+			break;
+	}
+
+	fw->taps = min_ii((int)ceilf(2.0f * support) + 1, size);
+	fw->start = MEM_mallocN(sizeof(int) * newsize, "scale filter start");
+	fw->weights = MEM_mallocN(sizeof(float) * fw->taps * newsize, "scale filter weights");
+
+	for (i = 0; i < newsize; i++) {
+		const float center = ((float)i + 0.5f) * scale;
+		float *weights = fw->weights + (size_t)i * fw->taps;
+		float total = 0.0f;
+		int start = (int)floorf(center - 0.5f - support) + 1;
+
+		CLAMP(start, 0, size - fw->taps);
+		fw->start[i] = start;
+
+		for (j = 0; j < fw->taps; j++) {
+			/* distance between the source and output pixel centers */
+			const float x = (float)(start + j) + 0.5f - center;
+			float w;
+
+			switch (filter) {
+				case IMB_SCALE_FILTER_MITCHELL:
+					w = scale_filter_mitchell(x / filter_scale);
+					break;
+				case IMB_SCALE_FILTER_LANCZOS:
+					w = scale_filter_lanczos(x / filter_scale);
+					break;
+				case IMB_SCALE_FILTER_BOX:
+				default:
+					/* coverage of the output pixel footprint, averages the area when
+					 * downscaling and interpolates linearly when upscaling */
+					w = max_ff(min_ff(x + 0.5f, 0.5f * filter_scale) - max_ff(x - 0.5f, -0.5f * filter_scale), 0.0f);
+					break;
+			}
+
+			weights[j] = w;
+			total += w;
+		}
+
+		if (total != 0.0f) {
+			for (j = 0; j < fw->taps; j++) {
+				weights[j] /= total;
+			}
+		}
+		else {
+			/* can only happen for degenerate sizes, fall back to the nearest pixel */
+			for (j = 0; j < fw->taps; j++) {
+				weights[j] = (start + j == min_ii((int)center, size - 1)) ? 1.0f : 0.0f;
+			}
+		}
+	}
+}
+
+static void scale_filter_weights_free(ScaleFilterWeights *fw)
+{
+	MEM_freeN(fw->start);
+	MEM_freeN(fw->weights);
+}
+
+/* horizontal pass of a byte row into a four channel float row */
+static void scale_filter_row_x_byte(const ScaleFilterWeights *fw, const unsigned char *src, float *dst, int newx)
+{
+	const int taps = fw->taps;
+	int x, k;
+
+	for (x = 0; x < newx; x++, dst += 4) {
+		const float *weights = fw->weights + (size_t)x * taps;
+		const unsigned char *cp = src + 4 * fw->start[x];
+#ifdef __SSE2__
+		const __m128i zero = _mm_setzero_si128();
+		__m128 sum = _mm_setzero_ps();
+
+		for (k = 0; k < taps; k++, cp += 4) {
+			int value;
+			__m128i pixel;
+
+			memcpy(&value, cp, sizeof(value));
+			pixel = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(value), zero), zero);
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_cvtepi32_ps(pixel)));
+		}
+		_mm_storeu_ps(dst, sum);
+#else
+		zero_v4(dst);
+		for (k = 0; k < taps; k++, cp += 4) {
+			dst[0] += weights[k] * cp[0];
+			dst[1] += weights[k] * cp[1];
+			dst[2] += weights[k] * cp[2];
+			dst[3] += weights[k] * cp[3];
+		}
+#endif
+	}
+}
+
+static void scale_filter_row_x_float(const ScaleFilterWeights *fw, const float *src, float *dst, int newx, int channels)
+{
+	const int taps = fw->taps;
+	int x, k, c;
+
+	for (x = 0; x < newx; x++, dst += channels) {
+		const float *weights = fw->weights + (size_t)x * taps;
+		const float *fp = src + channels * fw->start[x];
+
+#ifdef __SSE2__
+		if (channels == 4) {
+			__m128 sum = _mm_setzero_ps();
+
+			for (k = 0; k < taps; k++, fp += 4) {
+				sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(fp)));
+			}
+			_mm_storeu_ps(dst, sum);
+			continue;
+		}
+#endif
+
+		for (c = 0; c < channels; c++) {
+			dst[c] = 0.0f;
+		}
+		for (k = 0; k < taps; k++, fp += channels) {
+			for (c = 0; c < channels; c++) {
+				dst[c] += weights[k] * fp[c];
+			}
+		}
+	}
+}
+
+/* vertical pass, dst[i] is the weighted sum of column i over the taps rows starting at src */
+BLI_INLINE void scale_filter_column_sum(const float *weights, int taps, const float *src, size_t stride,
+                                        float *dst, int len)
+{
+	int i = 0, k;
+
+#ifdef __SSE2__
+	for (; i + 4 <= len; i += 4) {
+		const float *fp = src + i;
+		__m128 sum = _mm_setzero_ps();
+
+		for (k = 0; k < taps; k++, fp += stride) {
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_set1_ps(weights[k]), _mm_loadu_ps(fp)));
+		}
+		_mm_storeu_ps(dst + i, sum);
+	}
+#endif
+
+	for (; i < len; i++) {
+		const float *fp = src + i;
+		float sum = 0.0f;
+
+		for (k = 0; k < taps; k++, fp += stride) {
+			sum += weights[k] * fp[0];
+		}
+		dst[i] = sum;
+	}
+}
+
+static void scale_filter_x_func(void *userdata, const int y)
+{
+	ScaleFilterData *data = userdata;
+	float *dst = data->buffer + (size_t)y * data->newx * data->buffer_channels;
+
+	if (data->rect_float) {
+		scale_filter_row_x_float(data->weights_x, data->rect_float + (size_t)y * data->width * data->channels,
+		                         dst, data->newx, data->channels);
+	}
+	else {
+		scale_filter_row_x_byte(data->weights_x, data->rect + (size_t)y * data->width * 4, dst, data->newx);
+	}
+}
+
+static void scale_filter_y_func(void *userdata, const int y)
+{
+	ScaleFilterData *data = userdata;
+	const ScaleFilterWeights *fw = data->weights_y;
+	const size_t stride = (size_t)data->newx * data->buffer_channels;
+	const float *src = data->buffer + fw->start[y] * stride;
+	const float *weights = fw->weights + (size_t)y * fw->taps;
+
+	if (data->newrect_float) {
+		scale_filter_column_sum(weights, fw->taps, src, stride,
+		                        data->newrect_float + y * stride, (int)stride);
+	}
+	else {
+		/* filtered in chunks so the row fits on the stack */
+		unsigned char *cp = data->newrect + y * stride;
+		float row[256];
+		int i, j;
+
+		for (i = 0; i < (int)stride; i += (int)ARRAY_SIZE(row)) {
+			const int len = min_ii((int)ARRAY_SIZE(row), (int)stride - i);
+
+			scale_filter_column_sum(weights, fw->taps, src + i, stride, row, len);
+
+			/* negative lobes of the filters can overshoot */
+			for (j = 0; j < len; j++) {
+				cp[i + j] = (row[j] <= 0.0f) ? 0 : (row[j] >= 255.0f) ? 255 : (unsigned char)(row[j] + 0.5f);
+			}
+		}
+	}
+}
+
+static void scale_filter_buffer(ScaleFilterData *data)
+{
+	ScaleFilterWeights weights_x, weights_y;
+	const bool use_threading = (data->newx * data->newy >= SCALE_FILTER_THREADED_MIN);
+
+	scale_filter_weights_init(&weights_x, data->filter, data->width, data->newx);
+	scale_filter_weights_init(&weights_y, data->filter, data->height, data->newy);
+	data->weights_x = &weights_x;
+	data->weights_y = &weights_y;
+
+	data->buffer = MEM_mallocN(sizeof(float) * data->buffer_channels * data->newx * data->height,
+	                           "scale filter buffer");
+
+	BLI_task_parallel_range(0, data->height, data, scale_filter_x_func, use_threading);
+	BLI_task_parallel_range(0, data->newy, data, scale_filter_y_func, use_threading);
+
+	MEM_freeN(data->buffer);
+	scale_filter_weights_free(&weights_x);
+	scale_filter_weights_free(&weights_y);
+}
+
+struct ImBuf *IMB_scaleImBuf_filter(struct ImBuf *ibuf, unsigned int newx, unsigned int newy,
+                                    IMB_ScaleFilter filter)
+{
+	ScaleFilterData data = {NULL};
+
+	if (ibuf == NULL) return (NULL);
+	if (ibuf->rect == NULL && ibuf->rect_float == NULL) return (ibuf);
+	if (newx == 0 || newy == 0) return (ibuf);
+
+	if (newx == ibuf->x && newy == ibuf->y) { return ibuf; }
+
+	data.filter = filter;
+	data.width = ibuf->x;
+	data.height = ibuf->y;
+	data.newx = newx;
+	data.newy = newy;
+	data.channels = ibuf->channels;
+
+	if (ibuf->rect_float) {
+		data.rect_float = ibuf->rect_float;
+		data.newrect_float = MEM_mallocN(sizeof(float) * ibuf->channels * newx * newy, "scale filter float");
+		data.buffer_channels = ibuf->channels;
+
+		scale_filter_buffer(&data);
+
+		imb_freerectfloatImBuf(ibuf);
+		ibuf->mall |= IB_rectfloat;
+		ibuf->rect_float = data.newrect_float;
+		data.rect_float = NULL;
+		data.newrect_float = NULL;
+	}
+
+	if (ibuf->rect) {
+		data.rect = (unsigned char *)ibuf->rect;
+		data.newrect = MEM_mallocN(sizeof(unsigned char) * 4 * newx * newy, "scale filter byte");
+		data.buffer_channels = 4;
+
+		scale_filter_buffer(&data);
+
+		imb_freerectImBuf(ibuf);
+		ibuf->mall |= IB_rect;
+		ibuf->rect = (unsigned int *)data.newrect;
+	}
+
+	scalefast_Z_ImBuf(ibuf, newx, newy);
+
+	ibuf->x = newx;
+	ibuf->y = newy;
+
+	return ibuf;
+}
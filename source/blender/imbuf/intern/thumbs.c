@@ -425,7 +425,7 @@ static ImBuf *thumb_create_ex(
 				imb_freerectfloatImBuf(img);
 			}
 
-			IMB_scaleImBuf(img, ex, ey);
+			IMB_scaleImBuf_filter(img, ex, ey, IMB_SCALE_FILTER_MITCHELL);
 		}
 		BLI_snprintf(desc, sizeof(desc), "Thumbnail for %s", uri);
 		IMB_metadata_change_field(img, "Description", desc);
@@ -42,6 +42,7 @@
 #include "BLI_path_util.h"
 #include "BLI_fileops.h"
 #include "BLI_string.h"
+#include "BLI_threads.h"
 
 #include "BKE_global.h"
 
@@ -288,10 +289,33 @@ static void ffmpeg_log_callback(void *ptr, int level, const char *format, va_lis
 #  pragma GCC diagnostic pop
 #endif
 
+/* codecs are opened from the threads rendering sequencer strips in parallel */
+static int ffmpeg_lockmgr(void **mutex, enum AVLockOp op)
+{
+	switch (op) {
+		case AV_LOCK_CREATE:
+			*mutex = BLI_mutex_alloc();
+			break;
+		case AV_LOCK_OBTAIN:
+			BLI_mutex_lock(*mutex);
+			break;
+		case AV_LOCK_RELEASE:
+			BLI_mutex_unlock(*mutex);
+			break;
+		case AV_LOCK_DESTROY:
+			BLI_mutex_free(*mutex);
+			*mutex = NULL;
+			break;
+	}
+
+	return 0;
+}
+
 void IMB_ffmpeg_init(void)
 {
 	av_register_all();
 	avdevice_register_all();
+	av_lockmgr_register(ffmpeg_lockmgr);
 
 	ffmpeg_last_error[0] = '\0';
 
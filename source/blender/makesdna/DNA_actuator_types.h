@@ -98,7 +98,7 @@ typedef struct bEditObjectActuator {
 	short localflag; /* flag for the lin & ang. vel: apply locally   */
 	short dyn_operation;
 	short upflag, trackflag; /* flag for up axis and track axis */
-	int pad;
+	int pool_size; /* number of removed objects kept to be recycled */
 } bEditObjectActuator;
 
 typedef struct bSceneActuator {
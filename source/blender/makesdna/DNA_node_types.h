@@ -214,7 +214,7 @@ typedef struct bNode {
 	 * and replacing all uses with per-instance data.
 	 */
 	short preview_xsize, preview_ysize;	/* reserved size of the preview rect */
-	int pad2;
+	int update_stamp;		/* incremented on every update, identifies the content of node->id for caches */
 	struct uiBlock *block;	/* runtime during drawing */
 } bNode;
 
@@ -410,6 +410,7 @@ typedef struct bNodeTree {
 #define NTREE_COM_GROUPNODE_BUFFER	8	/* use groupnode buffers */
 #define NTREE_VIEWER_BORDER			16	/* use a border for viewer nodes */
 #define NTREE_IS_LOCALIZED			32	/* tree is localized copy, free when deleting node groups */
+#define NTREE_COM_FULL_FRAME		64	/* execute whole buffers per operation instead of tiles */
 
 /* XXX not nice, but needed as a temporary flags
  * for group updates after library linking.
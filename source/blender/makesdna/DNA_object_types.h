@@ -280,6 +280,9 @@ typedef struct Object {
 	struct CurveCache *curve_cache;
 
 	struct DerivedMesh *derivedDeform, *derivedFinal;
+	/* Runtime copy of an intermediate result of the modifier stack, see DerivedMesh.c */
+	struct ModifierStackCache *modifier_stack_cache;
+	void *pad3;  /* keeps lastDataMask 8 byte aligned on 32 bit */
 	uint64_t lastDataMask;   /* the custom data layer mask that was last used to calculate derivedDeform and derivedFinal */
 	uint64_t customdata_mask; /* (extra) custom data layer mask to use for creating derivedmesh, set by depsgraph */
 	unsigned int state;			/* bit masks of game controllers that are active */
@@ -1430,6 +1430,14 @@ static void rna_def_edit_object_actuator(BlenderRNA *brna)
 	RNA_def_property_ui_text(prop, "Time", "Duration the new Object lives or the track takes");
 	RNA_def_property_update(prop, NC_LOGIC, NULL);
 
+	prop = RNA_def_property(srna, "pool_size", PROP_INT, PROP_NONE);
+	RNA_def_property_range(prop, 0, 10000);
+	RNA_def_property_ui_range(prop, 0, 1000, 1, 1);
+	RNA_def_property_ui_text(prop, "Pool Size",
+	                         "Number of removed objects kept to be recycled by the next additions, "
+	                         "0 to always create new objects");
+	RNA_def_property_update(prop, NC_LOGIC, NULL);
+
 	prop = RNA_def_property(srna, "mass", PROP_FLOAT, PROP_NONE);
 	RNA_def_property_ui_range(prop, 0, 10000, 1, 2);
 	RNA_def_property_ui_text(prop, "Mass", "The mass of the object");
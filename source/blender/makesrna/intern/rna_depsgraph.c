@@ -55,6 +55,27 @@ static void rna_Depsgraph_debug_graphviz(Depsgraph *graph, const char *filename)
 	fclose(f);
 }
 
+static void rna_Depsgraph_debug_trace_begin(Depsgraph *UNUSED(graph))
+{
+	DEG_debug_trace_begin();
+}
+
+static void rna_Depsgraph_debug_trace_end(Depsgraph *UNUSED(graph), ReportList *reports, const char *filename)
+{
+	FILE *f = fopen(filename, "w");
+	if (f == NULL) {
+		BKE_reportf(reports, RPT_ERROR, "Could not open \"%s\" for writing", filename);
+	}
+	else {
+		if (!DEG_debug_trace_write(f)) {
+			BKE_report(reports, RPT_ERROR, "Evaluation trace was not started");
+		}
+		fclose(f);
+	}
+
+	DEG_debug_trace_end();
+}
+
 static void rna_Depsgraph_debug_rebuild(Depsgraph *UNUSED(graph), Main *bmain)
 {
 	Scene *sce;
@@ -99,6 +120,16 @@ static void rna_def_depsgraph(BlenderRNA *brna)
 	RNA_def_function_flag(func, FUNC_USE_MAIN);
 	RNA_def_property_flag(parm, PROP_REQUIRED);
 	
+	func = RNA_def_function(srna, "debug_trace_begin", "rna_Depsgraph_debug_trace_begin");
+	RNA_def_function_ui_description(func, "Start recording the time taken by every evaluated operation");
+
+	func = RNA_def_function(srna, "debug_trace_end", "rna_Depsgraph_debug_trace_end");
+	RNA_def_function_ui_description(func, "Stop recording and write the evaluation trace as Chrome trace JSON");
+	RNA_def_function_flag(func, FUNC_USE_REPORTS);
+	parm = RNA_def_string_file_path(func, "filename", NULL, FILE_MAX, "File Name",
+	                                "File in which to store the trace");
+	RNA_def_property_flag(parm, PROP_REQUIRED);
+
 	func = RNA_def_function(srna, "debug_stats", "rna_Depsgraph_debug_stats");
 	RNA_def_function_ui_description(func, "Report the number of elements in the Dependency Graph");
 	RNA_def_function_flag(func, FUNC_USE_REPORTS);
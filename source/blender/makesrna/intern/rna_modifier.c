@@ -441,6 +441,11 @@ static char *rna_Modifier_path(PointerRNA *ptr)
 
 static void rna_Modifier_update(Main *UNUSED(bmain), Scene *UNUSED(scene), PointerRNA *ptr)
 {
+	/* settings stored outside of the modifier, like curve mappings, don't change its hash */
+	if (RNA_struct_is_a(ptr->type, &RNA_Modifier)) {
+		mesh_modifier_stack_cache_tag(ptr->id.data, ptr->data);
+	}
+
 	DAG_id_tag_update(ptr->id.data, OB_RECALC_DATA);
 	WM_main_add_notifier(NC_OBJECT | ND_MODIFIER, ptr->id.data);
 }
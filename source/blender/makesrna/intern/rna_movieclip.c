@@ -48,9 +48,12 @@
 #ifdef RNA_RUNTIME
 
 #include "BKE_depsgraph.h"
+#include "BKE_sequencer.h"
 
 #include "ED_clip.h"
 
+#include "IMB_moviecache.h"
+
 #include "DNA_screen_types.h"
 #include "DNA_space_types.h"
 
@@ -70,6 +73,45 @@ static void rna_MovieClip_size_get(PointerRNA *ptr, int *values)
 	values[1] = clip->lastsize[1];
 }
 
+static PointerRNA rna_MovieClip_cache_statistics_get(PointerRNA *ptr)
+{
+	return rna_pointer_inherit_refine(ptr, &RNA_MovieCacheStatistics, ptr->data);
+}
+
+/* the statistics are shared by movie clips and the sequencer, which uses one cache for all scenes */
+static void rna_MovieCacheStatistics_stats_get(PointerRNA *ptr, MovieCacheStats *r_stats)
+{
+	ID *id = (ID *) ptr->id.data;
+
+	if (GS(id->name) == ID_MC) {
+		BKE_movieclip_cache_get_stats((MovieClip *) id, r_stats);
+	}
+	else {
+		BKE_sequencer_cache_get_stats(r_stats);
+	}
+}
+
+static int rna_MovieCacheStatistics_hits_get(PointerRNA *ptr)
+{
+	MovieCacheStats stats;
+	rna_MovieCacheStatistics_stats_get(ptr, &stats);
+	return stats.hits;
+}
+
+static int rna_MovieCacheStatistics_misses_get(PointerRNA *ptr)
+{
+	MovieCacheStats stats;
+	rna_MovieCacheStatistics_stats_get(ptr, &stats);
+	return stats.misses;
+}
+
+static int rna_MovieCacheStatistics_evictions_get(PointerRNA *ptr)
+{
+	MovieCacheStats stats;
+	rna_MovieCacheStatistics_stats_get(ptr, &stats);
+	return stats.evictions;
+}
+
 static void rna_MovieClipUser_proxy_render_settings_update(Main *UNUSED(bmain), Scene *UNUSED(scene), PointerRNA *ptr)
 {
 	ID *id = (ID *) ptr->id.data;
@@ -105,6 +147,30 @@ static void rna_MovieClipUser_proxy_render_settings_update(Main *UNUSED(bmain),
 
 #else
 
+static void rna_def_movie_cache_statistics(BlenderRNA *brna)
+{
+	StructRNA *srna;
+	PropertyRNA *prop;
+
+	srna = RNA_def_struct(brna, "MovieCacheStatistics", NULL);
+	RNA_def_struct_ui_text(srna, "Movie Cache Statistics", "Usage statistics of a frame cache");
+
+	prop = RNA_def_property(srna, "hits", PROP_INT, PROP_NONE);
+	RNA_def_property_int_funcs(prop, "rna_MovieCacheStatistics_hits_get", NULL, NULL);
+	RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+	RNA_def_property_ui_text(prop, "Hits", "Number of frames found in the cache");
+
+	prop = RNA_def_property(srna, "misses", PROP_INT, PROP_NONE);
+	RNA_def_property_int_funcs(prop, "rna_MovieCacheStatistics_misses_get", NULL, NULL);
+	RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+	RNA_def_property_ui_text(prop, "Misses", "Number of frames not found in the cache");
+
+	prop = RNA_def_property(srna, "evictions", PROP_INT, PROP_NONE);
+	RNA_def_property_int_funcs(prop, "rna_MovieCacheStatistics_evictions_get", NULL, NULL);
+	RNA_def_property_clear_flag(prop, PROP_EDITABLE);
+	RNA_def_property_ui_text(prop, "Evictions", "Number of frames freed to stay below the memory cache limit");
+}
+
 static void rna_def_movieclip_proxy(BlenderRNA *brna)
 {
 	StructRNA *srna;
@@ -347,10 +413,16 @@ static void rna_def_movieclip(BlenderRNA *brna)
 	RNA_def_property_pointer_sdna(prop, NULL, "colorspace_settings");
 	RNA_def_property_struct_type(prop, "ColorManagedInputColorspaceSettings");
 	RNA_def_property_ui_text(prop, "Color Space Settings", "Input color space settings");
+
+	prop = RNA_def_property(srna, "cache_statistics", PROP_POINTER, PROP_NONE);
+	RNA_def_property_struct_type(prop, "MovieCacheStatistics");
+	RNA_def_property_pointer_funcs(prop, "rna_MovieClip_cache_statistics_get", NULL, NULL, NULL);
+	RNA_def_property_ui_text(prop, "Cache Statistics", "Usage statistics of the frame cache of this clip");
 }
 
 void RNA_def_movieclip(BlenderRNA *brna)
 {
+	rna_def_movie_cache_statistics(brna);
 	rna_def_movieclip(brna);
 	rna_def_movieclip_proxy(brna);
 	rna_def_moviecliUser(brna);
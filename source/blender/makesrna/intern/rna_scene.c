@@ -4142,6 +4142,13 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
 	                         "threshold will deactivate (0.0 means no deactivation)");
 	RNA_def_property_update(prop, NC_SCENE, NULL);
 
+	prop = RNA_def_property(srna, "use_physics_multithreading", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_PHYSICS_MULTITHREADING);
+	RNA_def_property_ui_text(prop, "Multithreading",
+	                         "Run the physics collision detection and the collision callbacks gathering "
+	                         "on all the processor cores");
+	RNA_def_property_update(prop, NC_SCENE, NULL);
+
 	/* mode */
 	/* not used  *//* deprecated !!!!!!!!!!!!! */
 	prop = RNA_def_property(srna, "use_occlusion_culling", PROP_BOOLEAN, PROP_NONE);
@@ -4209,6 +4216,13 @@ static void rna_def_scene_game_data(BlenderRNA *brna)
 	                         "Restrict the number of animation updates to the animation FPS (this is "
 	                         "better for performance, but can cause issues with smooth playback)");
 
+	prop = RNA_def_property(srna, "use_event_driven_logic", PROP_BOOLEAN, PROP_NONE);
+	RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_LOGIC_EVENT_DRIVEN);
+	RNA_def_property_ui_text(prop, "Event Driven Logic",
+	                         "Only evaluate the always, property, keyboard and collision sensors when a property "
+	                         "write, an input event or a collision can change them (sensor settings modified from "
+	                         "Python are applied on the next event)");
+
 	prop = RNA_def_property(srna, "show_bounding_box", PROP_BOOLEAN, PROP_NONE);
 	RNA_def_property_boolean_sdna(prop, NULL, "flag", GAME_SHOW_BOUNDING_BOX);
 	RNA_def_property_ui_text(prop, "Show Bounding Box", "Show a visualization of bounding volume box");
@@ -593,6 +593,11 @@ static PointerRNA rna_SequenceEditor_meta_stack_get(CollectionPropertyIterator *
 	return rna_pointer_inherit_refine(&iter->parent, &RNA_Sequence, ms->parseq);
 }
 
+static PointerRNA rna_SequenceEditor_cache_statistics_get(PointerRNA *ptr)
+{
+	return rna_pointer_inherit_refine(ptr, &RNA_MovieCacheStatistics, ptr->data);
+}
+
 /* TODO, expose seq path setting as a higher level sequencer BKE function */
 static void rna_Sequence_filepath_set(PointerRNA *ptr, const char *value)
 {
@@ -1659,6 +1664,12 @@ static void rna_def_editor(BlenderRNA *brna)
 	RNA_def_property_string_sdna(prop, NULL, "proxy_dir");
 	RNA_def_property_ui_text(prop, "Proxy Directory", "");
 	RNA_def_property_update(prop, NC_SPACE | ND_SPACE_SEQUENCER, "rna_SequenceEditor_update_cache");
+
+	prop = RNA_def_property(srna, "cache_statistics", PROP_POINTER, PROP_NONE);
+	RNA_def_property_struct_type(prop, "MovieCacheStatistics");
+	RNA_def_property_pointer_funcs(prop, "rna_SequenceEditor_cache_statistics_get", NULL, NULL, NULL);
+	RNA_def_property_ui_text(prop, "Cache Statistics",
+	                         "Usage statistics of the frame cache, which is shared by all sequence editors");
 }
 
 static void rna_def_filter_video(StructRNA *srna)
@@ -39,6 +39,7 @@
 
 #include "BLI_math.h"
 #include "BLI_utildefines.h"
+#include "BLI_task.h"
 
 #include "DNA_curve_types.h"
 #include "DNA_meshdata_types.h"
@@ -61,6 +62,9 @@
  */
 #define CYCLIC_DEPENDENCY_WORKAROUND
 
+/* Minimum number of created vertices and loops to use threads. */
+#define ARRAY_THREADED_MIN 10000
+
 static void initData(ModifierData *md)
 {
 	ArrayModifierData *amd = (ArrayModifierData *) md;
@@ -176,37 +180,76 @@ static float vertarray_size(const MVert *mvert, int numVerts, int axis)
 	return max_co - min_co;
 }
 
-BLI_INLINE float sum_v3(const float v[3])
+/* Spatial hash of the target vertices used when searching for doubles,
+ * its cells are at least as large as the merge distance so only the neighbor cells have to be checked. */
+typedef struct MergeVertsHash {
+	int *buckets;       /* first vertex of each bucket (index in target), -1 for empty buckets */
+	int *next;          /* next vertex in the same bucket, -1 at the end of the list */
+	unsigned int mask;
+	float min[3];
+	float cell_size_inv;
+	int cell_max[3];    /* coordinates of the last cell on each axis */
+} MergeVertsHash;
+
+/* Cells are limited to this number per axis, so cell coordinates can't overflow. */
+#define MERGE_HASH_CELLS_MAX (1 << 20)
+
+BLI_INLINE unsigned int merge_hash_cell_key(const int cell[3])
 {
-	return v[0] + v[1] + v[2];
+	return ((unsigned int)cell[0] * 73856093u) ^
+	       ((unsigned int)cell[1] * 19349663u) ^
+	       ((unsigned int)cell[2] * 83492791u);
 }
 
-/* Structure used for sorting vertices, when processing doubles */
-typedef struct SortVertsElem {
-	int vertex_num;     /* The original index of the vertex, prior to sorting */
-	float co[3];        /* Its coordinates */
-	float sum_co;       /* sum_v3(co), just so we don't do the sum many times.  */
-} SortVertsElem;
-
+static void merge_hash_cell_from_co(const MergeVertsHash *hash, const float co[3], int r_cell[3])
+{
+	int j;
+	for (j = 0; j < 3; j++) {
+		/* clamp before converting, vertices far away from the target would overflow */
+		float cell = floorf((co[j] - hash->min[j]) * hash->cell_size_inv);
+		CLAMP(cell, -2.0f, (float)(MERGE_HASH_CELLS_MAX + 2));
+		r_cell[j] = (int)cell;
+	}
+}
 
-static int svert_sum_cmp(const void *e1, const void *e2)
+static void merge_hash_init(MergeVertsHash *hash, const MVert *mverts, const int num_verts, const float dist)
 {
-	const SortVertsElem *sv1 = e1;
-	const SortVertsElem *sv2 = e2;
+	float max[3], cell_size;
+	int i, j;
+
+	INIT_MINMAX(hash->min, max);
+	for (i = 0; i < num_verts; i++) {
+		minmax_v3v3_v3(hash->min, max, mverts[i].co);
+	}
+
+	cell_size = max_ff(dist, max_fff(max[0] - hash->min[0], max[1] - hash->min[1], max[2] - hash->min[2]) /
+	                         (float)MERGE_HASH_CELLS_MAX);
+	hash->cell_size_inv = (cell_size > 0.0f) ? 1.0f / cell_size : 1.0f;
+	merge_hash_cell_from_co(hash, max, hash->cell_max);
 
-	if      (sv1->sum_co > sv2->sum_co) return  1;
-	else if (sv1->sum_co < sv2->sum_co) return -1;
-	else                                return  0;
+	hash->mask = power_of_2_max_u((unsigned int)max_ii(num_verts, 1)) - 1;
+	hash->buckets = MEM_mallocN(sizeof(int) * (hash->mask + 1), __func__);
+	hash->next = MEM_mallocN(sizeof(int) * (size_t)max_ii(num_verts, 1), __func__);
+	copy_vn_i(hash->buckets, (int)hash->mask + 1, -1);
+
+	for (i = 0; i < num_verts; i++) {
+		int cell[3];
+		unsigned int key;
+
+		merge_hash_cell_from_co(hash, mverts[i].co, cell);
+		for (j = 0; j < 3; j++) {
+			CLAMP(cell[j], 0, hash->cell_max[j]);
+		}
+		key = merge_hash_cell_key(cell) & hash->mask;
+		hash->next[i] = hash->buckets[key];
+		hash->buckets[key] = i;
+	}
 }
 
-static void svert_from_mvert(SortVertsElem *sv, const MVert *mv, const int i_begin, const int i_end)
+static void merge_hash_free(MergeVertsHash *hash)
 {
-	int i;
-	for (i = i_begin; i < i_end; i++, sv++, mv++) {
-		sv->vertex_num = i;
-		copy_v3_v3(sv->co, mv->co);
-		sv->sum_co = sum_v3(mv->co);
-	}
+	MEM_freeN(hash->buckets);
+	MEM_freeN(hash->next);
 }
 
 /**
@@ -224,112 +267,87 @@ static void dm_mvert_map_doubles(
         const int source_num_verts,
         const float dist)
 {
-	const float dist3 = ((float)M_SQRT3 + 0.00005f) * dist;   /* Just above sqrt(3) */
-	int i_source, i_target, i_target_low_bound, target_end, source_end;
-	SortVertsElem *sorted_verts_target, *sorted_verts_source;
-	SortVertsElem *sve_source, *sve_target, *sve_target_low_bound;
-	bool target_scan_completed;
-
-	target_end = target_start + target_num_verts;
-	source_end = source_start + source_num_verts;
-
-	/* build array of MVerts to be tested for merging */
-	sorted_verts_target = MEM_mallocN(sizeof(SortVertsElem) * target_num_verts, __func__);
-	sorted_verts_source = MEM_mallocN(sizeof(SortVertsElem) * source_num_verts, __func__);
-
-	/* Copy target vertices index and cos into SortVertsElem array */
-	svert_from_mvert(sorted_verts_target, mverts + target_start, target_start, target_end);
-
-	/* Copy source vertices index and cos into SortVertsElem array */
-	svert_from_mvert(sorted_verts_source, mverts + source_start, source_start, source_end);
-
-	/* sort arrays according to sum of vertex coordinates (sumco) */
-	qsort(sorted_verts_target, target_num_verts, sizeof(SortVertsElem), svert_sum_cmp);
-	qsort(sorted_verts_source, source_num_verts, sizeof(SortVertsElem), svert_sum_cmp);
-
-	sve_target_low_bound = sorted_verts_target;
-	i_target_low_bound = 0;
-	target_scan_completed = false;
-
-	/* Scan source vertices, in SortVertsElem sorted array, */
-	/* all the while maintaining the lower bound of possible doubles in target vertices */
-	for (i_source = 0, sve_source = sorted_verts_source;
-	     i_source < source_num_verts;
-	     i_source++, sve_source++)
-	{
+	const float dist_sq = dist * dist;
+	const MVert *target_mverts = mverts + target_start;
+	MergeVertsHash hash;
+	int i_source, i_target;
+
+	if (target_num_verts == 0) {
+		return;
+	}
+
+	/* build spatial hash of MVerts to be tested for merging */
+	merge_hash_init(&hash, target_mverts, target_num_verts, dist);
+
+	for (i_source = source_start; i_source < source_start + source_num_verts; i_source++) {
+		const float *co = mverts[i_source].co;
 		int best_target_vertex = -1;
-		float best_dist_sq = dist * dist;
-		float sve_source_sumco;
+		float best_dist_sq = dist_sq;
+		int cell[3], x, y, z;
 
 		/* If source has already been assigned to a target (in an earlier call, with other chunks) */
-		if (doubles_map[sve_source->vertex_num] != -1) {
-			continue;
-		}
-
-		/* If target fully scanned already, then all remaining source vertices cannot have a double */
-		if (target_scan_completed) {
-			doubles_map[sve_source->vertex_num] = -1;
+		if (doubles_map[i_source] != -1) {
 			continue;
 		}
 
-		sve_source_sumco = sum_v3(sve_source->co);
+		merge_hash_cell_from_co(&hash, co, cell);
 
-		/* Skip all target vertices that are more than dist3 lower in terms of sumco */
-		/* and advance the overall lower bound, applicable to all remaining vertices as well. */
-		while ((i_target_low_bound < target_num_verts) &&
-		       (sve_target_low_bound->sum_co < sve_source_sumco - dist3))
+		/* Source vertices out of the target bounds cannot have a double */
+		if (cell[0] < -1 || cell[0] > hash.cell_max[0] + 1 ||
+		    cell[1] < -1 || cell[1] > hash.cell_max[1] + 1 ||
+		    cell[2] < -1 || cell[2] > hash.cell_max[2] + 1)
 		{
-			i_target_low_bound++;
-			sve_target_low_bound++;
-		}
-		/* If end of target list reached, then no more possible doubles */
-		if (i_target_low_bound >= target_num_verts) {
-			doubles_map[sve_source->vertex_num] = -1;
-			target_scan_completed = true;
 			continue;
 		}
-		/* Test target candidates starting at the low bound of possible doubles, ordered in terms of sumco */
-		i_target = i_target_low_bound;
-		sve_target = sve_target_low_bound;
 
-		/* i_target will scan vertices in the [v_source_sumco - dist3;  v_source_sumco + dist3] range */
+		/* Test target candidates in the neighbor cells */
+		for (x = cell[0] - 1; x <= cell[0] + 1; x++) {
+			for (y = cell[1] - 1; y <= cell[1] + 1; y++) {
+				for (z = cell[2] - 1; z <= cell[2] + 1; z++) {
+					const int cell_test[3] = {x, y, z};
 
-		while ((i_target < target_num_verts) &&
-		       (sve_target->sum_co <= sve_source_sumco + dist3))
-		{
-			/* Testing distance for candidate double in target */
-			/* v_target is within dist3 of v_source in terms of sumco;  check real distance */
-			float dist_sq;
-			if ((dist_sq = len_squared_v3v3(sve_source->co, sve_target->co)) <= best_dist_sq) {
-				/* Potential double found */
-				best_dist_sq = dist_sq;
-				best_target_vertex = sve_target->vertex_num;
-
-				/* If target is already mapped, we only follow that mapping if final target remains
-				 * close enough from current vert (otherwise no mapping at all).
-				 * Note that if we later find another target closer than this one, then we check it. But if other
-				 * potential targets are farther, then there will be no mapping at all for this source. */
-				while (best_target_vertex != -1 && !ELEM(doubles_map[best_target_vertex], -1, best_target_vertex)) {
-					if (compare_len_v3v3(mverts[sve_source->vertex_num].co,
-					                     mverts[doubles_map[best_target_vertex]].co,
-					                     dist))
+					if (x < 0 || y < 0 || z < 0 ||
+					    x > hash.cell_max[0] || y > hash.cell_max[1] || z > hash.cell_max[2])
 					{
-						best_target_vertex = doubles_map[best_target_vertex];
+						continue;
 					}
-					else {
-						best_target_vertex = -1;
+
+					for (i_target = hash.buckets[merge_hash_cell_key(cell_test) & hash.mask];
+					     i_target != -1;
+					     i_target = hash.next[i_target])
+					{
+						/* Testing distance for candidate double in target (buckets may contain other cells) */
+						float dist_test_sq;
+						if ((dist_test_sq = len_squared_v3v3(co, target_mverts[i_target].co)) <= best_dist_sq) {
+							/* Potential double found */
+							best_dist_sq = dist_test_sq;
+							best_target_vertex = target_start + i_target;
+
+							/* If target is already mapped, we only follow that mapping if final target remains
+							 * close enough from current vert (otherwise no mapping at all).
+							 * Note that if we later find another target closer than this one, then we check it.
+							 * But if other potential targets are farther, then there will be no mapping at all
+							 * for this source. */
+							while (best_target_vertex != -1 &&
+							       !ELEM(doubles_map[best_target_vertex], -1, best_target_vertex))
+							{
+								if (compare_len_v3v3(co, mverts[doubles_map[best_target_vertex]].co, dist)) {
+									best_target_vertex = doubles_map[best_target_vertex];
+								}
+								else {
+									best_target_vertex = -1;
+								}
+							}
+						}
 					}
 				}
 			}
-			i_target++;
-			sve_target++;
 		}
 		/* End of candidate scan: if none found then no doubles */
-		doubles_map[sve_source->vertex_num] = best_target_vertex;
+		doubles_map[i_source] = best_target_vertex;
 	}
 
-	MEM_freeN(sorted_verts_source);
-	MEM_freeN(sorted_verts_target);
+	merge_hash_free(&hash);
 }
 
 
@@ -406,6 +424,70 @@ static void dm_merge_transform(
 	}
 }
 
+typedef struct ArrayChunkData {
+	DerivedMesh *result;
+	float (*chunk_offsets)[4][4];
+	int chunk_nverts, chunk_nedges, chunk_nloops, chunk_npolys;
+	bool use_recalc_normals;
+} ArrayChunkData;
+
+/* Create copy \a c of the first chunk, copies are independent from each other. */
+static void array_chunk_copy_cb(void *userdata, const int c)
+{
+	ArrayChunkData *data = userdata;
+	DerivedMesh *result = data->result;
+	float (*current_offset)[4] = data->chunk_offsets[c];
+	const int chunk_nverts = data->chunk_nverts;
+	const int chunk_nedges = data->chunk_nedges;
+	const int chunk_nloops = data->chunk_nloops;
+	const int chunk_npolys = data->chunk_npolys;
+	MVert *mv;
+	MEdge *me;
+	MLoop *ml;
+	MPoly *mp;
+	int i;
+
+	/* copy customdata to new geometry, each layer is copied as a whole block */
+	DM_copy_vert_data(result, result, 0, c * chunk_nverts, chunk_nverts);
+	DM_copy_edge_data(result, result, 0, c * chunk_nedges, chunk_nedges);
+	DM_copy_loop_data(result, result, 0, c * chunk_nloops, chunk_nloops);
+	DM_copy_poly_data(result, result, 0, c * chunk_npolys, chunk_npolys);
+
+	/* apply offset to all new verts */
+	mv = CDDM_get_verts(result) + c * chunk_nverts;
+	for (i = 0; i < chunk_nverts; i++, mv++) {
+		mul_m4_v3(current_offset, mv->co);
+
+		/* We have to correct normals too, if we do not tag them as dirty! */
+		if (!data->use_recalc_normals) {
+			float no[3];
+			normal_short_to_float_v3(no, mv->no);
+			mul_mat3_m4_v3(current_offset, no);
+			normalize_v3(no);
+			normal_float_to_short_v3(mv->no, no);
+		}
+	}
+
+	/* adjust edge vertex indices */
+	me = CDDM_get_edges(result) + c * chunk_nedges;
+	for (i = 0; i < chunk_nedges; i++, me++) {
+		me->v1 += c * chunk_nverts;
+		me->v2 += c * chunk_nverts;
+	}
+
+	mp = CDDM_get_polys(result) + c * chunk_npolys;
+	for (i = 0; i < chunk_npolys; i++, mp++) {
+		mp->loopstart += c * chunk_nloops;
+	}
+
+	/* adjust loop vertex and edge indices */
+	ml = CDDM_get_loops(result) + c * chunk_nloops;
+	for (i = 0; i < chunk_nloops; i++, ml++) {
+		ml->v += c * chunk_nverts;
+		ml->e += c * chunk_nedges;
+	}
+}
+
 static DerivedMesh *arrayModifier_doArray(
         ArrayModifierData *amd,
         Scene *scene, Object *ob, DerivedMesh *dm,
@@ -413,11 +495,8 @@ static DerivedMesh *arrayModifier_doArray(
 {
 	const float eps = 1e-6f;
 	const MVert *src_mvert;
-	MVert *mv, *mv_prev, *result_dm_verts;
+	MVert *result_dm_verts;
 
-	MEdge *me;
-	MLoop *ml;
-	MPoly *mp;
 	int i, j, c, count;
 	float length = amd->length;
 	/* offset matrix */
@@ -425,7 +504,7 @@ static DerivedMesh *arrayModifier_doArray(
 	float scale[3];
 	bool offset_has_scale;
 	float current_offset[4][4];
-	float final_offset[4][4];
+	float (*chunk_offsets)[4][4];
 	int *full_doubles_map = NULL;
 	int tot_doubles;
 
@@ -573,53 +652,33 @@ static DerivedMesh *arrayModifier_doArray(
 	first_chunk_start = 0;
 	first_chunk_nverts = chunk_nverts;
 
-	unit_m4(current_offset);
+	/* cumulative offsets of all copies, so they can be created in any order */
+	chunk_offsets = MEM_mallocN(sizeof(*chunk_offsets) * (size_t)count, __func__);
+	unit_m4(chunk_offsets[0]);
 	for (c = 1; c < count; c++) {
-		/* copy customdata to new geometry */
-		DM_copy_vert_data(result, result, 0, c * chunk_nverts, chunk_nverts);
-		DM_copy_edge_data(result, result, 0, c * chunk_nedges, chunk_nedges);
-		DM_copy_loop_data(result, result, 0, c * chunk_nloops, chunk_nloops);
-		DM_copy_poly_data(result, result, 0, c * chunk_npolys, chunk_npolys);
-
-		mv_prev = result_dm_verts;
-		mv = mv_prev + c * chunk_nverts;
-
-		/* recalculate cumulative offset here */
-		mul_m4_m4m4(current_offset, current_offset, offset);
-
-		/* apply offset to all new verts */
-		for (i = 0; i < chunk_nverts; i++, mv++, mv_prev++) {
-			mul_m4_v3(current_offset, mv->co);
-
-			/* We have to correct normals too, if we do not tag them as dirty! */
-			if (!use_recalc_normals) {
-				float no[3];
-				normal_short_to_float_v3(no, mv->no);
-				mul_mat3_m4_v3(current_offset, no);
-				normalize_v3(no);
-				normal_float_to_short_v3(mv->no, no);
-			}
-		}
+		mul_m4_m4m4(chunk_offsets[c], chunk_offsets[c - 1], offset);
+	}
+	copy_m4_m4(current_offset, chunk_offsets[count - 1]);
 
-		/* adjust edge vertex indices */
-		me = CDDM_get_edges(result) + c * chunk_nedges;
-		for (i = 0; i < chunk_nedges; i++, me++) {
-			me->v1 += c * chunk_nverts;
-			me->v2 += c * chunk_nverts;
-		}
+	{
+		ArrayChunkData data = {
+			.result = result,
+			.chunk_offsets = chunk_offsets,
+			.chunk_nverts = chunk_nverts,
+			.chunk_nedges = chunk_nedges,
+			.chunk_nloops = chunk_nloops,
+			.chunk_npolys = chunk_npolys,
+			.use_recalc_normals = use_recalc_normals,
+		};
+		const bool use_threading = (count - 1) * (chunk_nverts + chunk_nloops) > ARRAY_THREADED_MIN;
 
-		mp = CDDM_get_polys(result) + c * chunk_npolys;
-		for (i = 0; i < chunk_npolys; i++, mp++) {
-			mp->loopstart += c * chunk_nloops;
-		}
+		BLI_task_parallel_range(1, count, &data, array_chunk_copy_cb, use_threading);
+	}
 
-		/* adjust loop vertex and edge indices */
-		ml = CDDM_get_loops(result) + c * chunk_nloops;
-		for (i = 0; i < chunk_nloops; i++, ml++) {
-			ml->v += c * chunk_nverts;
-			ml->e += c * chunk_nedges;
-		}
+	MEM_freeN(chunk_offsets);
 
+	/* Merging has to be done in order, each chunk follows the mapping of the previous one */
+	for (c = 1; c < count; c++) {
 		/* Handle merge between chunk n and n-1 */
 		if (use_merge && (c >= 1)) {
 			if (!offset_has_scale && (c >= 2)) {
@@ -665,8 +724,6 @@ static DerivedMesh *arrayModifier_doArray(
 	last_chunk_start = (count - 1) * chunk_nverts;
 	last_chunk_nverts = chunk_nverts;
 
-	copy_m4_m4(final_offset, current_offset);
-
 	if (use_merge && (amd->flags & MOD_ARR_MERGEFINAL) && (count > 1)) {
 		/* Merge first and last copies */
 		dm_mvert_map_doubles(
@@ -267,6 +267,8 @@ static DerivedMesh *applyModifier(ModifierData *md, Object *UNUSED(ob),
 	/* mloop_dst = */ ml_dst = CDDM_get_loops(result);
 	
 	/* copy the faces across, remapping indices */
+	CustomData_copy_data_indices(&dm->polyData, &result->polyData, faceMap, 0, numFaces_dst);
+
 	k = 0;
 	for (i = 0; i < numFaces_dst; i++) {
 		MPoly *source;
@@ -274,7 +276,6 @@ static DerivedMesh *applyModifier(ModifierData *md, Object *UNUSED(ob),
 		
 		source = mpoly_src + faceMap[i];
 		dest = mpoly_dst + i;
-		DM_copy_poly_data(dm, result, faceMap[i], i, 1);
 		
 		*dest = *source;
 		dest->loopstart = k;
@@ -81,6 +81,7 @@
 #include "BKE_packedFile.h"
 #include "BKE_report.h"
 #include "BKE_sound.h"
+#include "BKE_subsurf.h"
 #include "BKE_scene.h"
 #include "BKE_screen.h"
 
@@ -107,6 +108,8 @@
 
 #include "GPU_draw.h"
 
+#include "COM_compositor.h"
+
 /* only to report a missing engine */
 #include "RE_engine.h"
 
@@ -459,6 +462,11 @@ static void wm_file_read_post(bContext *C, bool is_startup_file)
 
 	CTX_wm_window_set(C, wm->windows.first);
 
+#ifdef WITH_OPENSUBDIV
+	/* the evaluators of the meshes of the previous file aren't used again */
+	BKE_subsurf_osd_free_cached_evaluators();
+#endif
+
 	ED_editors_init(C);
 	DAG_on_visible_update(CTX_data_main(C), true);
 
@@ -531,6 +539,9 @@ bool WM_file_read(bContext *C, const char *filepath, ReportList *reports)
 	BLI_callback_exec(CTX_data_main(C), NULL, BLI_CB_EVT_LOAD_PRE);
 
 	UI_view2d_zoom_cache_reset();
+#ifdef WITH_COMPOSITOR
+	COM_clearCaches();
+#endif
 
 	/* first try to append data from exotic file formats... */
 	/* it throws error box when file doesn't exist and returns -1 */
@@ -657,6 +668,9 @@ int wm_homefile_read(bContext *C, ReportList *reports, bool from_memory, const c
 	BLI_callback_exec(CTX_data_main(C), NULL, BLI_CB_EVT_LOAD_PRE);
 
 	UI_view2d_zoom_cache_reset();
+#ifdef WITH_COMPOSITOR
+	COM_clearCaches();
+#endif
 
 	G.relbase_valid = 0;
 	if (!from_memory) {
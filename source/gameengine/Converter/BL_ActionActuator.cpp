@@ -244,8 +244,10 @@ bool BL_ActionActuator::Update(double curtime, bool frame)
 	{
 		CValue* oldprop = obj->GetProperty(m_framepropname);
 		CValue* newval = new CFloatValue(obj->GetActionFrame(m_layer));
-		if (oldprop)
+		if (oldprop) {
 			oldprop->SetValue(newval);
+			obj->SetSensorsDirty();
+		}
 		else
 			obj->SetProperty(m_framepropname, newval);
 
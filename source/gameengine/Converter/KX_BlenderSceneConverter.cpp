@@ -33,6 +33,8 @@
 #  pragma warning (disable:4786)  /* suppress stl-MSVC debug info warning */
 #endif
 
+#include <float.h>
+
 #include "KX_Scene.h"
 #include "KX_GameObject.h"
 #include "KX_IpoConvert.h"
@@ -121,7 +123,8 @@ typedef struct ThreadInfo {
 KX_BlenderSceneConverter::KX_BlenderSceneConverter(
 							Main *maggie,
 							KX_KetsjiEngine *engine)
-							:m_maggie(maggie),
+							:m_mergesceneindex(0),
+							m_maggie(maggie),
 							m_ketsjiEngine(engine),
 							m_alwaysUseExpandFraming(false)
 {
@@ -308,6 +311,22 @@ void KX_BlenderSceneConverter::ConvertScene(KX_Scene *destinationscene, RAS_IRas
 void KX_BlenderSceneConverter::RemoveScene(KX_Scene *scene)
 {
 	int i, size;
+
+	// The libloads being merged in this scene are finished, their objects are owned by the merge until then.
+	bool merging = false;
+	m_threadinfo->m_mutex.Lock();
+	for (vector<KX_LibLoadStatus *>::iterator it = m_mergequeue.begin(); it != m_mergequeue.end(); ++it) {
+		if ((*it)->GetMergeScene() == scene) {
+			merging = true;
+			break;
+		}
+	}
+	m_threadinfo->m_mutex.Unlock();
+
+	if (merging) {
+		MergeQueuedScenes(DBL_MAX);
+	}
+
 	// delete the scene first as it will stop the use of entities
 	scene->Release();
 	// delete the entities of this scene
@@ -521,32 +540,49 @@ Main *KX_BlenderSceneConverter::GetMainDynamicPath(const char *path)
 	return NULL;
 }
 
-void KX_BlenderSceneConverter::MergeAsyncLoads()
+void KX_BlenderSceneConverter::MergeQueuedScenes(double endtime)
 {
-	vector<KX_Scene *> *merge_scenes;
+	while (true) {
+		m_threadinfo->m_mutex.Lock();
+		KX_LibLoadStatus *status = (m_mergequeue.empty()) ? NULL : m_mergequeue.front();
+		m_threadinfo->m_mutex.Unlock();
+
+		if (!status) {
+			break;
+		}
 
-	vector<KX_LibLoadStatus *>::iterator mit;
-	vector<KX_Scene *>::iterator sit;
+		vector<KX_Scene *> *merge_scenes = (vector<KX_Scene *> *)status->GetData();
 
-	m_threadinfo->m_mutex.Lock();
+		for (; m_mergesceneindex < merge_scenes->size(); ++m_mergesceneindex) {
+			KX_Scene *other = (*merge_scenes)[m_mergesceneindex];
 
-	for (mit = m_mergequeue.begin(); mit != m_mergequeue.end(); ++mit) {
-		merge_scenes = (vector<KX_Scene *> *)(*mit)->GetData();
+			if (!status->GetMergeScene()->MergeSceneStep(other, m_mergestate, endtime)) {
+				// Out of time, the conversion made 90% of the progress and the merge the last 10%.
+				status->SetProgress(0.9f + 0.1f * (m_mergesceneindex + m_mergestate.GetProgress()) / merge_scenes->size());
+				status->RunProgressCallback();
+				return;
+			}
 
-		for (sit=merge_scenes->begin(); sit!=merge_scenes->end(); ++sit) {
-			(*mit)->GetMergeScene()->MergeScene(*sit);
-			delete (*sit);
+			delete other;
+			m_mergestate = KX_Scene::MergeState();
 		}
 
 		delete merge_scenes;
-		(*mit)->SetData(NULL);
+		status->SetData(NULL);
+		m_mergesceneindex = 0;
 
-		(*mit)->Finish();
-	}
+		m_threadinfo->m_mutex.Lock();
+		m_mergequeue.erase(m_mergequeue.begin());
+		m_threadinfo->m_mutex.Unlock();
 
-	m_mergequeue.clear();
+		status->Finish();
+	}
+}
 
-	m_threadinfo->m_mutex.Unlock();
+void KX_BlenderSceneConverter::MergeAsyncLoads()
+{
+	const double mergetime = KX_KetsjiEngine::GetLibLoadMergeTime();
+	MergeQueuedScenes((mergetime > 0.0) ? PIL_check_seconds_timer() + mergetime : DBL_MAX);
 }
 
 void KX_BlenderSceneConverter::FinalizeAsyncLoads()
@@ -556,7 +592,7 @@ void KX_BlenderSceneConverter::FinalizeAsyncLoads()
 		BLI_task_pool_work_and_wait(m_threadinfo->m_pool);
 	}
 	// Merge all libraries data in the current scene, to avoid memory leak of unmerged scenes.
-	MergeAsyncLoads();
+	MergeQueuedScenes(DBL_MAX);
 }
 
 void KX_BlenderSceneConverter::AddScenesToMergeQueue(KX_LibLoadStatus *status)
@@ -571,7 +607,7 @@ static void async_convert(TaskPool *pool, void *ptr, int UNUSED(threadid))
 	KX_Scene *new_scene = NULL;
 	KX_LibLoadStatus *status = (KX_LibLoadStatus *)ptr;
 	vector<Scene *> *scenes = (vector<Scene *> *)status->GetData();
-	vector<KX_Scene *> *merge_scenes = new vector<KX_Scene *>(); // Deleted in MergeAsyncLoads
+	vector<KX_Scene *> *merge_scenes = new vector<KX_Scene *>(); // Deleted in MergeQueuedScenes
 
 	for (unsigned int i = 0; i < scenes->size(); ++i) {
 		new_scene = status->GetEngine()->CreateScene((*scenes)[i], true);
@@ -853,6 +889,9 @@ bool KX_BlenderSceneConverter::FreeBlendFile(Main *maggie)
 				}
 			}
 			
+			/* the pooled objects could use the freed meshes */
+			scene->ClearObjectPools();
+
 			//scene->FreeTagged(); /* removed tagged objects and meshes*/
 			CListValue *obj_lists[] = {scene->GetObjectList(), scene->GetInactiveList(), NULL};
 
@@ -37,6 +37,7 @@
 
 #include "KX_ISceneConverter.h"
 #include "KX_IpoConvert.h"
+#include "KX_Scene.h" // For KX_Scene::MergeState
 
 #include <map>
 
@@ -72,6 +73,10 @@ class KX_BlenderSceneConverter : public KX_ISceneConverter
 	vector<class KX_LibLoadStatus*> m_mergequeue;
 	ThreadInfo	*m_threadinfo;
 
+	// Merge progress of the first libload of the merge queue, only used by the main thread.
+	KX_Scene::MergeState m_mergestate;
+	unsigned int m_mergesceneindex;
+
 	// Cached material conversions
 	MaterialCache m_mat_cache;
 	PolyMaterialCache m_polymat_cache;
@@ -166,6 +171,8 @@ public:
 	virtual void MergeAsyncLoads();
 	virtual void FinalizeAsyncLoads();
 	void AddScenesToMergeQueue(class KX_LibLoadStatus *status);
+	/// Merge the libloads of the merge queue until the end time is reached.
+	void MergeQueuedScenes(double endtime);
  
 	void PrintStats() {
 		printf("BGE STATS!\n");
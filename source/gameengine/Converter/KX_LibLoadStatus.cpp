@@ -75,11 +75,9 @@ void KX_LibLoadStatus::RunFinishCallback()
 
 void KX_LibLoadStatus::RunProgressCallback()
 {
-// Progess callbacks are causing threading problems with Python, so they're disabled for now
-#if 0
+	// Only called from the main thread, the conversion thread doesn't run the callback.
 #ifdef WITH_PYTHON
 	if (m_progress_cb) {
-		//PyGILState_STATE gstate = PyGILState_Ensure();
 		PyObject* args = Py_BuildValue("(O)", GetProxy());
 
 		if (!PyObject_Call(m_progress_cb, args, NULL)) {
@@ -88,10 +86,8 @@ void KX_LibLoadStatus::RunProgressCallback()
 		}
 
 		Py_DECREF(args);
-		//PyGILState_Release(gstate);
 	}
 #endif
-#endif
 }
 
 class KX_BlenderSceneConverter *KX_LibLoadStatus::GetConverter()
@@ -132,7 +128,6 @@ void *KX_LibLoadStatus::GetData()
 void KX_LibLoadStatus::SetProgress(float progress)
 {
 	m_progress = progress;
-	RunProgressCallback();
 }
 
 float KX_LibLoadStatus::GetProgress()
@@ -143,7 +138,6 @@ float KX_LibLoadStatus::GetProgress()
 void KX_LibLoadStatus::AddProgress(float progress)
 {
 	m_progress += progress;
-	RunProgressCallback();
 }
 
 #ifdef WITH_PYTHON
@@ -155,7 +149,7 @@ PyMethodDef KX_LibLoadStatus::Methods[] =
 
 PyAttributeDef KX_LibLoadStatus::Attributes[] = {
 	KX_PYATTRIBUTE_RW_FUNCTION("onFinish", KX_LibLoadStatus, pyattr_get_onfinish, pyattr_set_onfinish),
-	// KX_PYATTRIBUTE_RW_FUNCTION("onProgress", KX_LibLoadStatus, pyattr_get_onprogress, pyattr_set_onprogress),
+	KX_PYATTRIBUTE_RW_FUNCTION("onProgress", KX_LibLoadStatus, pyattr_get_onprogress, pyattr_set_onprogress),
 	KX_PYATTRIBUTE_FLOAT_RO("progress", KX_LibLoadStatus, m_progress),
 	KX_PYATTRIBUTE_STRING_RO("libraryName", KX_LibLoadStatus, m_libname),
 	KX_PYATTRIBUTE_RO_FUNCTION("timeTaken", KX_LibLoadStatus, pyattr_get_timetaken),
@@ -59,6 +59,12 @@ void SCA_AlwaysSensor::Init()
 	m_alwaysresult = true;
 }
 
+bool SCA_AlwaysSensor::IsEventDriven()
+{
+	// only the first evaluation after Init() triggers
+	return true;
+}
+
 SCA_AlwaysSensor::~SCA_AlwaysSensor()
 {
 	/* intentionally empty */
@@ -33,6 +33,7 @@
 #include <assert.h>
 #include "SCA_EventManager.h"
 #include "SCA_ISensor.h"
+#include "SCA_LogicManager.h"
 
 
 SCA_EventManager::SCA_EventManager(SCA_LogicManager* logicmgr, EVENT_MANAGER_TYPE mgrtype)
@@ -47,6 +48,7 @@ SCA_EventManager::~SCA_EventManager()
 {
 	// all sensors should be removed
 	assert(m_sensors.Empty());
+	assert(m_idleSensors.Empty());
 }
 
 void SCA_EventManager::RegisterSensor(class SCA_ISensor* sensor)
@@ -59,6 +61,42 @@ void SCA_EventManager::RemoveSensor(class SCA_ISensor* sensor)
 	sensor->Delink();
 }
 
+void SCA_EventManager::WakeSensor(class SCA_ISensor* sensor)
+{
+	sensor->Delink();
+	m_sensors.AddBack(sensor);
+}
+
+void SCA_EventManager::WakeAllSensors()
+{
+	for (SCA_ISensor *sensor = (SCA_ISensor *)m_idleSensors.Remove();
+	     sensor != NULL;
+	     sensor = (SCA_ISensor *)m_idleSensors.Remove())
+	{
+		sensor->SetIdle(false);
+		m_sensors.AddBack(sensor);
+	}
+}
+
+void SCA_EventManager::ActivateSensors()
+{
+	const bool eventdriven = m_logicmgr->IsEventDriven();
+
+	SG_DList::iterator<SCA_ISensor> it(m_sensors);
+	for (it.begin(); !it.end();)
+	{
+		SCA_ISensor *sensor = *it;
+		// increment first to allow moving the sensor to the idle list
+		++it;
+		sensor->Activate(m_logicmgr);
+		if (eventdriven && sensor->CanSleep()) {
+			sensor->Delink();
+			sensor->SetIdle(true);
+			m_idleSensors.AddBack(sensor);
+		}
+	}
+}
+
 void SCA_EventManager::NextFrame(double curtime, double fixedtime)
 {
 	NextFrame();
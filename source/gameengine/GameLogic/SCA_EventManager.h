@@ -46,6 +46,13 @@ protected:
 	// use a set to speed-up insertion/removal
 	//std::set <class SCA_ISensor*>				m_sensors;
 	SG_DList		m_sensors;
+	// event driven sensors waiting for an event, they are not activated each frame
+	// and are moved back to m_sensors by WakeSensor()
+	SG_DList		m_idleSensors;
+
+	/** Activate all the sensors, in event driven mode the sensors which can't
+	 * trigger until their next event are moved to the idle sensors list. */
+	void			ActivateSensors();
 
 public:
 	enum EVENT_MANAGER_TYPE {
@@ -72,7 +79,12 @@ public:
 	virtual void    UpdateFrame();
 	virtual void	EndFrame();
 	virtual void	RegisterSensor(class SCA_ISensor* sensor);
+	/** Move an idle sensor back to the activated sensors, see SCA_ISensor::SetDirty(). */
+	void			WakeSensor(class SCA_ISensor* sensor);
+	/** Move back all the idle sensors, used when the event driven mode is disabled. */
+	void			WakeAllSensors();
 	int		GetType();
+	SCA_LogicManager*	GetLogicManager() { return m_logicmgr; }
 	//SG_DList &GetSensors() { return m_sensors; }
 
 
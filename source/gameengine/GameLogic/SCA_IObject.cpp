@@ -52,6 +52,16 @@ SCA_IObject::SCA_IObject():
 }
 
 SCA_IObject::~SCA_IObject()
+{
+	ClearLogic();
+
+	//T_InterpolatorList::iterator i;
+	//for (i = m_interpolators.begin(); !(i == m_interpolators.end()); ++i) {
+	//	delete *i;
+	//}
+}
+
+void SCA_IObject::ClearLogic()
 {
 	SCA_SensorList::iterator its;
 	for (its = m_sensors.begin(); !(its == m_sensors.end()); ++its)
@@ -83,10 +93,52 @@ SCA_IObject::~SCA_IObject()
 		(*ito)->UnlinkObject(this);
 	}
 
-	//T_InterpolatorList::iterator i;
-	//for (i = m_interpolators.begin(); !(i == m_interpolators.end()); ++i) {
-	//	delete *i;
-	//}
+	m_sensors.clear();
+	m_controllers.clear();
+	m_actuators.clear();
+	m_registeredActuators.clear();
+	m_registeredObjects.clear();
+	// no controller is active anymore
+	m_state = 0;
+}
+
+void SCA_IObject::ReplaceLogic(SCA_IObject *original)
+{
+	ClearLogic();
+
+	// same as the copy constructor, the bricks are replicated in ReParentLogic
+	m_sensors = original->m_sensors;
+	m_controllers = original->m_controllers;
+	m_actuators = original->m_actuators;
+	ReParentLogic();
+}
+
+void SCA_IObject::SetSensorsDirty()
+{
+	for (SCA_SensorList::iterator it = m_sensors.begin(); it != m_sensors.end(); ++it) {
+		(*it)->SetDirty();
+	}
+}
+
+void SCA_IObject::SetProperty(const STR_String& name, CValue* ioProperty)
+{
+	CValue::SetProperty(name, ioProperty);
+	SetSensorsDirty();
+}
+
+void SCA_IObject::SetProperty(const char* name, CValue* ioProperty)
+{
+	CValue::SetProperty(name, ioProperty);
+	SetSensorsDirty();
+}
+
+bool SCA_IObject::RemoveProperty(const char* inName)
+{
+	if (CValue::RemoveProperty(inName)) {
+		SetSensorsDirty();
+		return true;
+	}
+	return false;
 }
 
 void SCA_IObject::AddSensor(SCA_ISensor* act)
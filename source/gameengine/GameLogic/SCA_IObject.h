@@ -131,6 +131,16 @@ public:
 		return m_activeActuators;
 	}
 
+	/**
+	 * Notify the event driven sensors that a property changed,
+	 * must be called after modifying a property value in place.
+	 */
+	void SetSensorsDirty();
+
+	virtual void SetProperty(const STR_String& name, CValue* ioProperty);
+	virtual void SetProperty(const char* name, CValue* ioProperty);
+	virtual bool RemoveProperty(const char* inName);
+
 	void AddSensor(SCA_ISensor* act);
 	void ReserveSensor(int num)
 	{
@@ -165,6 +175,18 @@ public:
 	void SetCurrentTime(float currentTime) {}
 
 	virtual void ReParentLogic();
+
+	/**
+	 * Delete all the logic bricks of the object and unlink the actuators and
+	 * objects using it, the bricks must be removed from the logic manager before.
+	 */
+	void ClearLogic();
+
+	/**
+	 * Replace the logic bricks of the object by replicas of the ones of
+	 * \a original, as for a new replica the bricks are not linked yet.
+	 */
+	void ReplaceLogic(SCA_IObject *original);
 	
 	/**
 	 * Set whether or not to ignore activity culling requests
@@ -70,6 +70,7 @@ SCA_ISensor::SCA_ISensor(SCA_IObject* gameobj,
 	m_skipped_ticks = 0;
 	m_state = false;
 	m_prev_state = false;
+	m_idle = false;
 	
 	m_eventmgr = eventmgr;
 }
@@ -84,6 +85,7 @@ void SCA_ISensor::ProcessReplica()
 {
 	SCA_ILogicBrick::ProcessReplica();
 	m_linkedcontrollers.clear();
+	m_idle = false;
 }
 
 bool SCA_ISensor::IsPositiveTrigger()
@@ -150,6 +152,28 @@ void SCA_ISensor::Init()
 	printf("Sensor %s has no init function, please report this bug to Blender.org\n", m_name.Ptr());
 }
 
+bool SCA_ISensor::IsEventDriven()
+{
+	return false;
+}
+
+bool SCA_ISensor::CanSleep()
+{
+	/* Pulses, level and tap modes generate events without any change of the sensor
+	 * inputs. The state must be stable too, as the previous state is only updated
+	 * when the sensor is activated. */
+	return (m_links && !m_suspended && !m_pos_pulsemode && !m_neg_pulsemode && !m_level && !m_tap &&
+	        m_state == m_prev_state && IsEventDriven());
+}
+
+void SCA_ISensor::SetDirty()
+{
+	if (m_idle) {
+		m_idle = false;
+		m_eventmgr->WakeSensor(this);
+	}
+}
+
 void SCA_ISensor::DecLink()
 {
 	m_links--;
@@ -180,6 +204,7 @@ void SCA_ISensor::Replace_EventManager(class SCA_LogicManager* logicmgr)
 		m_eventmgr->RemoveSensor(this);
 		m_eventmgr= logicmgr->FindEventManager(m_eventmgr->GetType());
 		m_eventmgr->RegisterSensor(this);
+		m_idle = false;
 	}
 	else {
 		m_eventmgr= logicmgr->FindEventManager(m_eventmgr->GetType());
@@ -222,6 +247,7 @@ void SCA_ISensor::UnregisterToManager()
 {
 	m_eventmgr->RemoveSensor(this);
 	m_links = 0;
+	m_idle = false;
 }
 
 void SCA_ISensor::ActivateControllers(class SCA_LogicManager* logicmgr)
@@ -330,6 +356,7 @@ KX_PYMETHODDEF_DOC_NOARGS(SCA_ISensor, reset,
 {
 	Init();
 	m_prev_state = false;
+	SetDirty();
 	Py_RETURN_NONE;
 }
 
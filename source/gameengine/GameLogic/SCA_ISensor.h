@@ -90,6 +90,9 @@ protected:
 	/** previous state (for tap option) */
 	bool m_prev_state;
 
+	/** sensor is in the idle list of its event manager (event driven mode) */
+	bool m_idle;
+
 	std::vector<class SCA_IController*>		m_linkedcontrollers;
 
 public:
@@ -116,6 +119,25 @@ public:
 	virtual bool IsPositiveTrigger();
 	virtual void Init();
 
+	/** Return true if Evaluate() can't trigger until SetDirty() is called,
+	 * i.e the sensor only depends on events notified to it (property writes,
+	 * input events, collisions). Such sensors are not activated every frame
+	 * when the logic manager runs in event driven mode.
+	 */
+	virtual bool IsEventDriven();
+	/** Return true if the sensor doesn't need to be activated until its next event. */
+	bool CanSleep();
+	/** Notify the sensor that its input changed, it will be activated on next logic frame. */
+	void SetDirty();
+	void SetIdle(bool idle)
+	{
+		m_idle = idle;
+	}
+	bool IsIdle() const
+	{
+		return m_idle;
+	}
+
 	virtual CValue* GetReplica()=0;
 
 	/** Set parameters for the pulsing behavior.
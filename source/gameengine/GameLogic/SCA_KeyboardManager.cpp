@@ -36,6 +36,7 @@
 #include "EXP_BoolValue.h"
 #include "SCA_KeyboardManager.h"
 #include "SCA_KeyboardSensor.h"
+#include "SCA_LogicManager.h"
 #include "EXP_IntValue.h"
 #include <vector>
 
@@ -65,11 +66,12 @@ void SCA_KeyboardManager::NextFrame()
 {
 	//const SCA_InputEvent& event =	GetEventValue(SCA_IInputDevice::KX_EnumInputs inputcode)=0;
 //	cerr << "SCA_KeyboardManager::NextFrame"<< endl;
-	SG_DList::iterator<SCA_ISensor> it(m_sensors);
-	for (it.begin();!it.end();++it)
-	{
-		(*it)->Activate(m_logicmgr);
+	if (m_logicmgr->IsEventDriven() && m_inputDevice->GetNumJustEvents() > 0) {
+		// a key was pressed or released, all the keyboard sensors can trigger
+		WakeAllSensors();
 	}
+
+	ActivateSensors();
 }
 
 bool SCA_KeyboardManager::IsPressed(SCA_IInputDevice::KX_EnumInputs inputcode)
@@ -117,6 +117,14 @@ bool SCA_KeyboardSensor::IsPositiveTrigger()
 
 
 
+bool SCA_KeyboardSensor::IsEventDriven()
+{
+	// keep checking pressed keys, their release can be missed after a scene suspend
+	return (m_val == 0);
+}
+
+
+
 bool SCA_KeyboardSensor::TriggerOnAllKeys()
 { 
 	return m_bAllKeys;
@@ -104,6 +104,7 @@ public:
 	short int GetHotkey();
 	virtual bool Evaluate();
 	virtual bool IsPositiveTrigger();
+	virtual bool IsEventDriven();
 	bool	TriggerOnAllKeys();
 
 #ifdef WITH_PYTHON
@@ -41,6 +41,7 @@
 
 
 SCA_LogicManager::SCA_LogicManager()
+	:m_eventDriven(false)
 {
 }
 
@@ -182,6 +183,16 @@ void SCA_LogicManager::RegisterToActuator(SCA_IController* controller,SCA_IActua
 
 
 
+void SCA_LogicManager::SetEventDriven(bool eventDriven)
+{
+	if (m_eventDriven && !eventDriven) {
+		// all the sensors must be activated every frame again
+		for (vector<SCA_EventManager*>::const_iterator ie=m_eventmanagers.begin(); !(ie==m_eventmanagers.end()); ie++)
+			(*ie)->WakeAllSensors();
+	}
+	m_eventDriven = eventDriven;
+}
+
 void SCA_LogicManager::BeginFrame(double curtime, double fixedtime)
 {
 	for (vector<SCA_EventManager*>::const_iterator ie=m_eventmanagers.begin(); !(ie==m_eventmanagers.end()); ie++)
@@ -85,6 +85,9 @@ class SCA_LogicManager
 
 	std::map<STR_HashedString, void *>		m_map_gamemeshname_to_blendobj;
 	std::map<void *, CValue *>			m_map_blendobj_to_gameobj;
+
+	// only activate the sensors notified of a change, see SCA_ISensor::IsEventDriven()
+	bool								m_eventDriven;
 public:
 	SCA_LogicManager();
 	virtual ~SCA_LogicManager();
@@ -96,6 +99,16 @@ public:
 	void	RegisterToActuator(SCA_IController* controller,
 							   class SCA_IActuator* actuator);
 	
+	/**
+	 * In event driven mode the sensors depending only on property writes, input
+	 * events or collisions are not activated until they are notified of a change.
+	 */
+	void	SetEventDriven(bool eventDriven);
+	bool	IsEventDriven() const
+	{
+		return m_eventDriven;
+	}
+
 	void	BeginFrame(double curtime, double fixedtime);
 	void	UpdateFrame(double curtime, bool frame);
 	void	EndFrame();
@@ -69,7 +69,9 @@ bool SCA_PropertyActuator::Update()
 
 	bool bNegativeEvent = IsNegativeEvent();
 	RemoveAllEvents();
-	CValue* propowner = GetParent();
+	SCA_IObject* propowner = GetParent();
+	// the property is modified in place below, wake up the property sensors
+	propowner->SetSensorsDirty();
 
 	if (bNegativeEvent)
 	{
@@ -43,6 +43,7 @@
 #include "EXP_StringValue.h"
 #include "SCA_EventManager.h"
 #include "SCA_LogicManager.h"
+#include "SCA_TimeEventManager.h"
 #include "EXP_BoolValue.h"
 #include "EXP_FloatValue.h"
 #include <stdio.h>
@@ -103,6 +104,27 @@ bool SCA_PropertySensor::IsPositiveTrigger()
 
 
 
+bool SCA_PropertySensor::IsEventDriven()
+{
+	// the timer properties are updated every frame without notifying their owner
+	SCA_TimeEventManager *timemgr = (SCA_TimeEventManager *)m_eventmgr->GetLogicManager()->FindEventManager(
+		SCA_EventManager::TIME_EVENTMGR);
+	if (!timemgr) {
+		return true;
+	}
+
+	const STR_String *propnames[3] = {&m_checkpropname, &m_checkpropval, &m_checkpropmaxval};
+	for (unsigned short i = 0; i < 3; ++i) {
+		CValue *prop = GetParent()->GetProperty(*propnames[i]);
+		if (prop && timemgr->IsTimeProperty(prop)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+
+
 SCA_PropertySensor::~SCA_PropertySensor()
 {
 }
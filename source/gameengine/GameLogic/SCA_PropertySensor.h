@@ -78,6 +78,7 @@ public:
 
 	virtual bool Evaluate();
 	virtual bool	IsPositiveTrigger();
+	virtual bool	IsEventDriven();
 	virtual CValue*		FindIdentifier(const STR_String& identifiername);
 
 #ifdef WITH_PYTHON
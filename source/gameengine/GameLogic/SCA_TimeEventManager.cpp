@@ -95,6 +95,7 @@ void SCA_TimeEventManager::AddTimeProperty(CValue* timeval)
 {
 	timeval->AddRef();
 	m_timevalues.push_back(timeval);
+	m_timevalueset.insert(timeval);
 }
 
 
@@ -107,12 +108,18 @@ void SCA_TimeEventManager::RemoveTimeProperty(CValue* timeval)
 		if ((*it) == timeval)
 		{
 			this->m_timevalues.erase(it);
+			m_timevalueset.erase(timeval);
 			timeval->Release();
 			break;
 		}
 	}
 }
 
+bool SCA_TimeEventManager::IsTimeProperty(CValue* value) const
+{
+	return (m_timevalueset.find(value) != m_timevalueset.end());
+}
+
 vector<CValue*> SCA_TimeEventManager::GetTimeValues()
 {
 	return m_timevalues;
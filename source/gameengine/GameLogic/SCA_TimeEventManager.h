@@ -35,12 +35,14 @@
 #include "SCA_EventManager.h"
 #include "EXP_Value.h"
 #include <vector>
+#include <set>
 
 using namespace std;
 
 class SCA_TimeEventManager : public SCA_EventManager
 {
 	vector<CValue*>		m_timevalues; // values that need their time updated regularly
+	set<CValue*>		m_timevalueset; // same values, for fast lookup
 	
 public:
 	SCA_TimeEventManager(class SCA_LogicManager* logicmgr);
@@ -51,6 +53,7 @@ public:
 	virtual void	RemoveSensor(class SCA_ISensor* sensor);
 	void			AddTimeProperty(CValue* timeval);
 	void			RemoveTimeProperty(CValue* timeval);
+	bool			IsTimeProperty(CValue* value) const;
 
 	vector<CValue*>	GetTimeValues();
 
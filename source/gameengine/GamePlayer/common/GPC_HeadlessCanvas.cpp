@@ -0,0 +1,97 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/GamePlayer/common/GPC_HeadlessCanvas.cpp
+ *  \ingroup player
+ */
+
+#include "GPC_HeadlessCanvas.h"
+
+#include <iostream>
+
+GPC_HeadlessCanvas::GPC_HeadlessCanvas(int width, int height)
+{
+	m_mousestate = MOUSE_INVISIBLE;
+	m_frame = 1;
+	Resize(width, height);
+	SetViewPort(0, 0, width - 1, height - 1);
+}
+
+GPC_HeadlessCanvas::~GPC_HeadlessCanvas()
+{
+}
+
+void GPC_HeadlessCanvas::Resize(int width, int height)
+{
+	m_width = width;
+	m_height = height;
+
+	m_displayarea.m_x1 = 0;
+	m_displayarea.m_y1 = 0;
+	m_displayarea.m_x2 = width;
+	m_displayarea.m_y2 = height;
+}
+
+float GPC_HeadlessCanvas::GetMouseNormalizedX(int x)
+{
+	return float(x) / GetWidth();
+}
+
+float GPC_HeadlessCanvas::GetMouseNormalizedY(int y)
+{
+	return float(y) / GetHeight();
+}
+
+void GPC_HeadlessCanvas::SetViewPort(int x1, int y1, int x2, int y2)
+{
+	m_viewport[0] = x1;
+	m_viewport[1] = y1;
+	m_viewport[2] = x2 - x1 + 1;
+	m_viewport[3] = y2 - y1 + 1;
+}
+
+void GPC_HeadlessCanvas::UpdateViewPort(int x1, int y1, int x2, int y2)
+{
+	m_viewport[0] = x1;
+	m_viewport[1] = y1;
+	m_viewport[2] = x2;
+	m_viewport[3] = y2;
+}
+
+const int *GPC_HeadlessCanvas::GetViewPort()
+{
+	return m_viewport;
+}
+
+void GPC_HeadlessCanvas::MakeScreenShot(const char *filename)
+{
+	std::cout << "Warning: screenshot \"" << filename << "\" skipped, no graphic context in headless mode." << std::endl;
+}
+
+void GPC_HeadlessCanvas::GetDisplayDimensions(int &width, int &height)
+{
+	width = m_width;
+	height = m_height;
+}
+
+void GPC_HeadlessCanvas::ResizeWindow(int width, int height)
+{
+	Resize(width, height);
+}
@@ -0,0 +1,129 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file GPC_HeadlessCanvas.h
+ *  \ingroup player
+ */
+
+#ifndef __GPC_HEADLESSCANVAS_H__
+#define __GPC_HEADLESSCANVAS_H__
+
+#include "RAS_ICanvas.h"
+#include "RAS_Rect.h"
+
+/**
+ * Canvas without any window nor OpenGL context, used with the null rasterizer
+ * when the player runs headless. It only keeps a virtual size so that the
+ * game logic querying the canvas (mouse coordinates, viewport) keeps working.
+ */
+class GPC_HeadlessCanvas : public RAS_ICanvas
+{
+protected:
+	int m_width;
+	int m_height;
+	RAS_Rect m_displayarea;
+	int m_viewport[4];
+
+public:
+	GPC_HeadlessCanvas(int width, int height);
+	virtual ~GPC_HeadlessCanvas();
+
+	void Resize(int width, int height);
+
+	virtual void Init() {}
+	virtual void BeginFrame() {}
+	virtual void EndFrame() {}
+
+	/// Nothing can be drawn, the engine must not render into this canvas.
+	virtual bool BeginDraw()
+	{
+		return false;
+	}
+	virtual void EndDraw() {}
+
+	virtual void SwapBuffers() {}
+	virtual void SetSwapInterval(int interval) {}
+	virtual bool GetSwapInterval(int& intervalOut)
+	{
+		return false;
+	}
+
+	virtual void ClearBuffer(int type) {}
+	virtual void ClearColor(float r, float g, float b, float a) {}
+
+	virtual int GetWidth() const
+	{
+		return m_width;
+	}
+	virtual int GetHeight() const
+	{
+		return m_height;
+	}
+
+	virtual int GetMouseX(int x)
+	{
+		return x;
+	}
+	virtual int GetMouseY(int y)
+	{
+		return y;
+	}
+	virtual float GetMouseNormalizedX(int x);
+	virtual float GetMouseNormalizedY(int y);
+
+	virtual const RAS_Rect &GetDisplayArea() const
+	{
+		return m_displayarea;
+	}
+	virtual void SetDisplayArea(RAS_Rect *rect)
+	{
+		m_displayarea = *rect;
+	}
+	virtual RAS_Rect &GetWindowArea()
+	{
+		return m_displayarea;
+	}
+
+	virtual void SetViewPort(int x1, int y1, int x2, int y2);
+	virtual void UpdateViewPort(int x1, int y1, int x2, int y2);
+	virtual const int *GetViewPort();
+
+	virtual void SetMouseState(RAS_MouseState mousestate)
+	{
+		m_mousestate = mousestate;
+	}
+	virtual void SetMousePosition(int x, int y) {}
+
+	virtual void MakeScreenShot(const char *filename);
+
+	virtual void GetDisplayDimensions(int &width, int &height);
+	virtual void ResizeWindow(int width, int height);
+	virtual void SetFullScreen(bool enable) {}
+	virtual bool GetFullScreen()
+	{
+		return false;
+	}
+
+#ifdef WITH_CXX_GUARDEDALLOC
+	MEM_CXX_CLASS_ALLOC_FUNCS("GE:GPC_HeadlessCanvas")
+#endif
+};
+
+#endif  /* __GPC_HEADLESSCANVAS_H__ */
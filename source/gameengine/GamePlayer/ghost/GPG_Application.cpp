@@ -44,8 +44,11 @@
 #include "BL_BlenderDataConversion.h"
 
 #include <iostream>
+#include <algorithm>
+#include <numeric>
 #include <BLI_utildefines.h>
 #include <stdlib.h>
+#include <math.h>
 
 /**********************************
  * Begin Blender include block
@@ -76,6 +79,7 @@ extern "C"
 #include "SCA_IActuator.h"
 #include "RAS_MeshObject.h"
 #include "RAS_OpenGLRasterizer.h"
+#include "RAS_NullRasterizer.h"
 #include "KX_Globals.h"
 #include "KX_PythonInit.h"
 #include "KX_PyConstraintBinding.h"
@@ -86,6 +90,7 @@ extern "C"
 
 #include "GPC_MouseDevice.h"
 #include "GPG_Canvas.h" 
+#include "GPC_HeadlessCanvas.h"
 #include "GPG_KeyboardDevice.h"
 #include "GPG_System.h"
 
@@ -119,6 +124,10 @@ GPG_Application::GPG_Application(GHOST_ISystem* system)
 	  m_engineInitialized(0), 
 	  m_engineRunning(0), 
 	  m_isEmbedded(false),
+	  m_isHeadless(false),
+	  m_headlessWidth(0),
+	  m_headlessHeight(0),
+	  m_headlessFrames(0),
 	  m_ketsjiengine(0),
 	  m_kxsystem(0), 
 	  m_keyboard(0), 
@@ -143,7 +152,9 @@ GPG_Application::~GPG_Application(void)
 	}
 
 	exitEngine();
-	fSystem->disposeWindow(m_mainWindow);
+	if (m_mainWindow) {
+		fSystem->disposeWindow(m_mainWindow);
+	}
 }
 
 
@@ -384,6 +395,21 @@ bool GPG_Application::startEmbeddedWindow(
 }
 
 
+bool GPG_Application::startHeadless(int width, int height, int frames)
+{
+	m_isHeadless = true;
+	m_headlessWidth = width;
+	m_headlessHeight = height;
+	m_headlessFrames = frames;
+
+	bool success = initEngine(NULL, RAS_IRasterizer::RAS_STEREO_NOSTEREO);
+	if (success) {
+		success = startEngine();
+	}
+	return success;
+}
+
+
 bool GPG_Application::startFullScreen(
         int width,
         int height,
@@ -518,7 +544,7 @@ bool GPG_Application::processEvent(GHOST_IEvent* event)
 			if (m_canvas) {
 				GHOST_Rect bnds;
 				window->getClientBounds(bnds);
-				m_canvas->Resize(bnds.getWidth(), bnds.getHeight());
+				static_cast<GPG_Canvas *>(m_canvas)->Resize(bnds.getWidth(), bnds.getHeight());
 				m_ketsjiengine->Resize();
 			}
 			}
@@ -557,7 +583,9 @@ bool GPG_Application::initEngine(GHOST_IWindow* window, const int stereoMode)
 {
 	if (!m_engineInitialized)
 	{
-		GPU_init();
+		if (!m_isHeadless) {
+			GPU_init();
+		}
 
 		// get and set the preferences
 		SYS_SystemHandle syshandle = SYS_GetSystem();
@@ -581,8 +609,19 @@ bool GPG_Application::initEngine(GHOST_IWindow* window, const int stereoMode)
 		bool nodepwarnings = (SYS_GetCommandLineInt(syshandle, "ignore_deprecation_warnings", 1) != 0);
 		bool restrictAnimFPS = (gm->flag & GAME_RESTRICT_ANIM_UPDATES) != 0;
 
+		if (m_isHeadless) {
+			// Nothing is rendered, so advance the clock of exactly one logic tick per frame
+			// and compute the frames as fast as possible.
+			fixed_framerate = true;
+		}
+
 		// create the canvas, rasterizer and rendertools
-		m_canvas = new GPG_Canvas(window);
+		if (m_isHeadless) {
+			m_canvas = new GPC_HeadlessCanvas(m_headlessWidth, m_headlessHeight);
+		}
+		else {
+			m_canvas = new GPG_Canvas(window);
+		}
 		if (!m_canvas)
 			return false;
 
@@ -595,21 +634,26 @@ bool GPG_Application::initEngine(GHOST_IWindow* window, const int stereoMode)
 		if (gm->flag & GAME_SHOW_MOUSE)
 			m_canvas->SetMouseState(RAS_ICanvas::MOUSE_NORMAL);
 		
-		RAS_STORAGE_TYPE raster_storage = RAS_AUTO_STORAGE;
-		int storageInfo = RAS_STORAGE_INFO_NONE;
-
-		if (gm->raster_storage == RAS_STORE_VBO) {
-			raster_storage = RAS_VBO;
-		}
-		else if (gm->raster_storage == RAS_STORE_VA) {
-			raster_storage = RAS_VA;
+		if (m_isHeadless) {
+			m_rasterizer = new RAS_NullRasterizer(m_canvas);
 		}
+		else {
+			RAS_STORAGE_TYPE raster_storage = RAS_AUTO_STORAGE;
+			int storageInfo = RAS_STORAGE_INFO_NONE;
 
-		if (useLists) {
-			storageInfo |= RAS_STORAGE_USE_DISPLAY_LIST;
-		}
+			if (gm->raster_storage == RAS_STORE_VBO) {
+				raster_storage = RAS_VBO;
+			}
+			else if (gm->raster_storage == RAS_STORE_VA) {
+				raster_storage = RAS_VA;
+			}
 
-		m_rasterizer = new RAS_OpenGLRasterizer(m_canvas, raster_storage, storageInfo);
+			if (useLists) {
+				storageInfo |= RAS_STORAGE_USE_DISPLAY_LIST;
+			}
+
+			m_rasterizer = new RAS_OpenGLRasterizer(m_canvas, raster_storage, storageInfo);
+		}
 
 		/* Stereo parameters - Eye Separation from the UI - stereomode from the command-line/UI */
 		m_rasterizer->SetStereoMode((RAS_IRasterizer::StereoMode) stereoMode);
@@ -729,7 +773,7 @@ bool GPG_Application::startEngine(void)
 #endif // WITH_PYTHON
 
 		//initialize Dome Settings
-		if (m_startScene->gm.stereoflag == STEREO_DOME)
+		if (m_startScene->gm.stereoflag == STEREO_DOME && !m_isHeadless)
 			m_ketsjiengine->InitDome(m_startScene->gm.dome.res, m_startScene->gm.dome.mode, m_startScene->gm.dome.angle, m_startScene->gm.dome.resbuf, m_startScene->gm.dome.tilt, m_startScene->gm.dome.warptext);
 
 		// initialize 3D Audio Settings
@@ -751,7 +795,7 @@ bool GPG_Application::startEngine(void)
 		m_kxStartScene->Release();
 		
 		// Create a timer that is used to kick the engine
-		if (!m_frameTimer) {
+		if (!m_frameTimer && m_system) {
 			m_frameTimer = m_system->installTimer(0, kTimerFreq, frameTimerProc, m_mainWindow);
 		}
 		m_rasterizer->Init();
@@ -790,6 +834,11 @@ void GPG_Application::stopEngine()
 	
 	m_ketsjiengine->StopEngine();
 
+	if (m_isHeadless) {
+		printFrameTimeStatistics();
+		m_frameTimes.clear();
+	}
+
 	if (m_sceneconverter) {
 		delete m_sceneconverter;
 		m_sceneconverter = 0;
@@ -810,6 +859,18 @@ void GPG_Application::EngineNextFrame()
 		// first check if we want to exit
 		m_exitRequested = m_ketsjiengine->GetExitCode();
 		
+		if (m_isHeadless) {
+			const double starttime = m_kxsystem->GetTimeInSeconds();
+			m_ketsjiengine->NextFrame();
+			m_frameTimes.push_back(m_kxsystem->GetTimeInSeconds() - starttime);
+
+			if (!m_exitRequested && m_headlessFrames > 0 && m_frameTimes.size() >= (size_t)m_headlessFrames) {
+				m_exitRequested = KX_EXIT_REQUEST_OUTSIDE;
+			}
+			m_exitString = m_ketsjiengine->GetExitString();
+			return;
+		}
+
 		// kick the engine
 		bool renderFrame = m_ketsjiengine->NextFrame();
 		if (renderFrame && m_mainWindow) {
@@ -865,7 +926,9 @@ void GPG_Application::exitEngine()
 		m_networkMessageManager = NULL;
 	}
 
-	GPU_exit();
+	if (!m_isHeadless) {
+		GPU_exit();
+	}
 
 #ifdef WITH_PYTHON
 	// Call this after we're sure nothing needs Python anymore (e.g., destructors)
@@ -876,6 +939,39 @@ void GPG_Application::exitEngine()
 	m_engineInitialized = false;
 }
 
+void GPG_Application::printFrameTimeStatistics(void)
+{
+	const size_t numframes = m_frameTimes.size();
+	if (numframes == 0) {
+		return;
+	}
+
+	std::vector<double> times(m_frameTimes);
+	std::sort(times.begin(), times.end());
+
+	const double total = std::accumulate(times.begin(), times.end(), 0.0);
+	const double mean = total / numframes;
+	double variance = 0.0;
+	for (std::vector<double>::const_iterator it = times.begin(); it != times.end(); ++it) {
+		variance += (*it - mean) * (*it - mean);
+	}
+	variance /= numframes;
+
+#define PERCENTILE(p) (times[std::min(numframes - 1, (size_t)((p) * numframes))] * 1000.0)
+	printf("Headless frame time statistics:\n");
+	printf("  frames:     %u\n", (unsigned int)numframes);
+	printf("  total:      %.3f s\n", total);
+	printf("  frames/s:   %.1f\n", (total > 0.0) ? numframes / total : 0.0);
+	printf("  mean:       %.3f ms\n", mean * 1000.0);
+	printf("  deviation:  %.3f ms\n", sqrt(variance) * 1000.0);
+	printf("  min:        %.3f ms\n", times.front() * 1000.0);
+	printf("  median:     %.3f ms\n", PERCENTILE(0.5));
+	printf("  95%%:        %.3f ms\n", PERCENTILE(0.95));
+	printf("  99%%:        %.3f ms\n", PERCENTILE(0.99));
+	printf("  max:        %.3f ms\n", times.back() * 1000.0);
+#undef PERCENTILE
+}
+
 bool GPG_Application::handleWheel(GHOST_IEvent* event)
 {
 	bool handled = false;
@@ -39,17 +39,19 @@
 
 #include "KX_KetsjiEngine.h"
 
+#include <vector>
+
 class KX_KetsjiEngine;
 class KX_Scene;
 class KX_ISceneConverter;
 class KX_NetworkMessageManager;
+class RAS_ICanvas;
 class RAS_IRasterizer;
 class GHOST_IEvent;
 class GHOST_ISystem;
 class GHOST_ITimerTask;
 class GHOST_IWindow;
 class GPC_MouseDevice;
-class GPG_Canvas;
 class GPG_KeyboardDevice;
 class GPG_System;
 struct Main;
@@ -72,6 +74,15 @@ public:
 	                     const GHOST_TUns16 samples=0, bool useDesktop=false);
 	bool startEmbeddedWindow(STR_String& title, const GHOST_TEmbedderWindowID parent_window,
 	                         const bool stereoVisual, const int stereoMode, const GHOST_TUns16 samples=0);
+	/**
+	 * Starts the engine without window nor OpenGL context, using a null rasterizer.
+	 * Logic frames are computed as fast as possible and frame time statistics
+	 * are printed when the engine stops.
+	 * \param width The virtual canvas width.
+	 * \param height The virtual canvas height.
+	 * \param frames The number of frames to run before exiting, 0 to run until the game ends.
+	 */
+	bool startHeadless(int width, int height, int frames);
 #ifdef WIN32
 	bool startScreenSaverFullScreen(int width, int height,
 	                                int bpp, int frequency,
@@ -119,6 +130,11 @@ protected:
 	 * Shuts the game engine down.
 	 */
 	void exitEngine(void);
+
+	/**
+	 * Prints the statistics of the frame times recorded in headless mode.
+	 */
+	void printFrameTimeStatistics(void);
 	short					m_exitkey;
 
 	/* The game data */
@@ -147,6 +163,15 @@ protected:
 	bool m_engineRunning;
 	/** Running on embedded window */
 	bool m_isEmbedded;
+	/** Running without window nor OpenGL context. */
+	bool m_isHeadless;
+	/** Virtual canvas size used in headless mode. */
+	int m_headlessWidth;
+	int m_headlessHeight;
+	/** Number of frames to run in headless mode, 0 for no limit. */
+	int m_headlessFrames;
+	/** Duration in seconds of every frame computed in headless mode. */
+	std::vector<double> m_frameTimes;
 
 	/** the gameengine itself */
 	KX_KetsjiEngine* m_ketsjiengine;
@@ -157,7 +182,7 @@ protected:
 	/** The game engine's mouse abstraction. */
 	GPC_MouseDevice* m_mouse;
 	/** The game engine's canvas abstraction. */
-	GPG_Canvas* m_canvas;
+	RAS_ICanvas* m_canvas;
 	/** the rasterizer */
 	RAS_IRasterizer* m_rasterizer;
 	/** Converts Blender data files. */
@@ -46,6 +46,10 @@ class GPG_System : public KX_ISystem
 	GHOST_ISystem* m_system;
 
 public:
+	/**
+	 * \param system The GHOST system used for timing, can be NULL when
+	 * the player runs headless, the timer from blenlib is used instead.
+	 */
 	GPG_System(GHOST_ISystem* system);
 
 	virtual double GetTimeInSeconds();
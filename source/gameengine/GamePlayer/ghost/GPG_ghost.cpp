@@ -270,6 +270,11 @@ static void usage(const char* program, bool isBlenderPlayer)
 	printf("  -c: keep console window open\n\n");
 #endif
 	printf("  -d: turn debugging on\n\n");
+	printf("  --headless: run without window nor OpenGL context, as fast as possible (logic, physics and animations only)\n");
+	printf("       --Optional parameters--\n");
+	printf("       frames = number of frames to run before exiting (default: run until the game ends)\n");
+	printf("       Frame time statistics are printed when the game ends.\n");
+	printf("       Example: --headless  or  --headless 10000\n\n");
 	printf("  -g: game engine options:\n\n");
 	printf("       Name                       Default      Description\n");
 	printf("       ------------------------------------------------------------------------\n");
@@ -285,7 +290,8 @@ static void usage(const char* program, bool isBlenderPlayer)
 	printf("\n");
 	printf("example: %s -w 320 200 10 10 -g noaudio %s%s\n", program, example_pathname, example_filename);
 	printf("example: %s -g show_framerate = 0 %s%s\n", program, example_pathname, example_filename);
-	printf("example: %s -i 232421 -m 16 %s%s\n\n", program, example_pathname, example_filename);
+	printf("example: %s -i 232421 -m 16 %s%s\n", program, example_pathname, example_filename);
+	printf("example: %s --headless 1000 %s%s\n\n", program, example_pathname, example_filename);
 }
 
 static void get_filename(int argc, char **argv, char *filename)
@@ -369,8 +375,11 @@ static BlendFileData *load_game_data(const char *progname, char *filename = NULL
 static bool GPG_NextFrame(GHOST_ISystem* system, GPG_Application *app, int &exitcode, STR_String &exitstring, GlobalSettings *gs)
 {
 	bool run = true;
-	system->processEvents(false);
-	system->dispatchEvents();
+	/* No system in headless mode, there are no events to process. */
+	if (system) {
+		system->processEvents(false);
+		system->dispatchEvents();
+	}
 	app->EngineNextFrame();
 	if ((exitcode = app->getExitRequested())) {
 		run = false;
@@ -438,6 +447,8 @@ int main(int argc, char** argv)
 	int validArguments=0;
 	bool samplesParFound = false;
 	GHOST_TUns16 aasamples = 0;
+	bool headless = false;
+	int headlessFrames = 0;
 	
 #ifdef __linux__
 #ifdef __alpha__
@@ -567,6 +578,19 @@ int main(int argc, char** argv)
 			
 			switch (argv[i][1])
 			{
+			case '-': //long options
+			{
+				if (!strcmp(argv[i], "--headless")) {
+					i++;
+					headless = true;
+					if ((i + 1) <= validArguments && argv[i][0] != '-')
+						headlessFrames = atoi(argv[i++]);
+				}
+				else {
+					printf("Unknown argument: %s\n", argv[i++]);
+				}
+				break;
+			}
 			case 'g': //game engine options (show_framerate, fixedtime, etc)
 			{
 				i++;
@@ -835,18 +859,22 @@ int main(int argc, char** argv)
 	if (scr_saver_mode != SCREEN_SAVER_MODE_CONFIGURATION)
 #endif
 	{
-		// Create the system
-		if (GHOST_ISystem::createSystem() == GHOST_kSuccess) {
-			GHOST_ISystem* system = GHOST_ISystem::getSystem();
-			assertd(system);
-			
-			if (!fullScreenWidth || !fullScreenHeight)
-				system->getMainDisplayDimensions(fullScreenWidth, fullScreenHeight);
-			// process first batch of events. If the user
-			// drops a file on top off the blenderplayer icon, we
-			// receive an event with the filename
-			
-			system->processEvents(0);
+		// Create the system, the headless player runs without any GHOST system
+		if (headless || GHOST_ISystem::createSystem() == GHOST_kSuccess) {
+			GHOST_ISystem* system = NULL;
+
+			if (!headless) {
+				system = GHOST_ISystem::getSystem();
+				assertd(system);
+
+				if (!fullScreenWidth || !fullScreenHeight)
+					system->getMainDisplayDimensions(fullScreenWidth, fullScreenHeight);
+				// process first batch of events. If the user
+				// drops a file on top off the blenderplayer icon, we
+				// receive an event with the filename
+
+				system->processEvents(0);
+			}
 			
 			// this bracket is needed for app (see below) to get out
 			// of scope before GHOST_ISystem::disposeSystem() is called.
@@ -909,7 +937,7 @@ int main(int argc, char** argv)
 						/* Setting options according to the blend file if not overriden in the command line */
 #ifdef WIN32
 #if !defined(DEBUG)
-						if (closeConsole) {
+						if (closeConsole && system) {
 							system->toggleConsole(0); // Close a console window
 						}
 #endif // !defined(DEBUG)
@@ -997,7 +1025,10 @@ int main(int argc, char** argv)
 						if (firstTimeRunning) {
 							firstTimeRunning = false;
 
-							if (fullScreen) {
+							if (headless) {
+								app.startHeadless(windowWidth, windowHeight, headlessFrames);
+							}
+							else if (fullScreen) {
 #ifdef WIN32
 								if (scr_saver_mode == SCREEN_SAVER_MODE_SAVER)
 								{
@@ -1072,7 +1103,8 @@ int main(int argc, char** argv)
 						}
 						
 						// Add the application as event consumer
-						system->addEventConsumer(&app);
+						if (system)
+							system->addEventConsumer(&app);
 						
 						// Enter main loop
 						bool run = true;
@@ -1116,7 +1148,8 @@ int main(int argc, char** argv)
 
 						/* 'app' is freed automatic when out of scope.
 						 * removal is needed else the system will free an already freed value */
-						system->removeEventConsumer(&app);
+						if (system)
+							system->removeEventConsumer(&app);
 
 						BLO_blendfiledata_free(bfd);
 						/* G.main == bfd->main, it gets referenced in free_nodesystem so we can't have a dangling pointer */
@@ -1134,7 +1167,8 @@ int main(int argc, char** argv)
 			BKE_icons_free();
 
 			// Dispose the system
-			GHOST_ISystem::disposeSystem();
+			if (system)
+				GHOST_ISystem::disposeSystem();
 		}
 		else {
 			error = true;
@@ -29,6 +29,8 @@
 #include "BL_Shader.h"
 #include "BL_BlenderShader.h"
 #include "KX_Scene.h"
+#include "KX_Globals.h"
+#include "KX_KetsjiEngine.h"
 #include "KX_Light.h"
 #include "KX_GameObject.h"
 #include "KX_MeshProxy.h"
@@ -222,9 +224,13 @@ void KX_BlenderMaterial::OnConstruction()
 		return;
 	}
 
-	SetBlenderGLSLShader();
+	KX_KetsjiEngine *engine = KX_GetActiveEngine();
+	// shaders and textures can't be created without a graphic context (headless player)
+	if (!engine || engine->GetRasterizer()->HasGraphicContext()) {
+		SetBlenderGLSLShader();
 
-	InitTextures();
+		InitTextures();
+	}
 
 	m_blendFunc[0] = 0;
 	m_blendFunc[1] = 0;
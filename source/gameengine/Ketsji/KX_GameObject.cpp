@@ -575,6 +575,64 @@ void KX_GameObject::ActivateGraphicController(bool recurse)
 	}
 }
 
+void KX_GameObject::Deactivate()
+{
+#ifdef WITH_PYTHON
+	if (m_attr_dict) {
+		PyDict_Clear(m_attr_dict);
+		Py_CLEAR(m_attr_dict);
+	}
+	if (m_collisionCallbacks) {
+		UnregisterCollisionCallbacks();
+		Py_CLEAR(m_collisionCallbacks);
+	}
+#endif  // WITH_PYTHON
+
+	if (m_actionManager) {
+		delete m_actionManager;
+		m_actionManager = NULL;
+	}
+
+	if (m_pGraphicController) {
+		m_pGraphicController->Activate(false);
+	}
+	if (m_pPhysicsController) {
+		m_pPhysicsController->SetActive(false);
+	}
+}
+
+void KX_GameObject::Reactivate(KX_GameObject *original)
+{
+#ifdef WITH_PYTHON
+	if (original->m_attr_dict) {
+		m_attr_dict = PyDict_Copy(original->m_attr_dict);
+	}
+#endif  // WITH_PYTHON
+
+	m_bVisible = original->m_bVisible;
+	m_bOccluder = original->m_bOccluder;
+	m_objectColor = original->m_objectColor;
+	m_userCollisionGroup = original->m_userCollisionGroup;
+	m_userCollisionMask = original->m_userCollisionMask;
+
+	PHY_IPhysicsController *orgctrl = original->GetPhysicsController();
+	if (m_pPhysicsController && orgctrl) {
+		m_pPhysicsController->SetTransform();
+		m_pPhysicsController->SetActive(true);
+		if (m_pPhysicsController->IsSuspended() && !orgctrl->IsSuspended()) {
+			m_pPhysicsController->RestoreDynamics();
+		}
+		if (m_pPhysicsController->IsDynamic()) {
+			m_pPhysicsController->SetMass(orgctrl->GetMass());
+			m_pPhysicsController->SetLinearVelocity(MT_Vector3(0.0f, 0.0f, 0.0f), false);
+			m_pPhysicsController->SetAngularVelocity(MT_Vector3(0.0f, 0.0f, 0.0f), false);
+		}
+		m_pPhysicsController->SetDamping(orgctrl->GetLinearDamping(), orgctrl->GetAngularDamping());
+	}
+
+	ActivateGraphicController(false);
+}
+
 void KX_GameObject::SetUserCollisionGroup(unsigned short group)
 {
 	m_userCollisionGroup = group;
@@ -2129,8 +2187,10 @@ static int Map_SetItem(PyObject *self_v, PyObject *key, PyObject *val)
 			if (vallie) {
 				CValue* oldprop = self->GetProperty(attr_str);
 				
-				if (oldprop)
+				if (oldprop) {
 					oldprop->SetValue(vallie);
+					self->SetSensorsDirty();
+				}
 				else
 					self->SetProperty(attr_str, vallie);
 				
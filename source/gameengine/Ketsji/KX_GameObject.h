@@ -533,6 +533,20 @@ public:
 	 */
 	void ActivateGraphicController(bool recurse);
 
+	/**
+	 * Release the per instance data (actions, python attributes and collision
+	 * callbacks) and remove the object from the physics and culling trees.
+	 * Used to keep an added object in an object pool, see KX_ObjectPool.
+	 */
+	void Deactivate();
+
+	/**
+	 * Put back a deactivated object in the physics and culling trees and reset
+	 * its display and physics settings to the ones of \a original.
+	 * The node transform must be set before.
+	 */
+	void Reactivate(KX_GameObject *original);
+
 	/** Set the object's collison group
 	 * \param filter The group bitfield
 	 */
@@ -98,6 +98,7 @@ const char KX_KetsjiEngine::m_profileLabels[tc_numCategories][15] = {
 double KX_KetsjiEngine::m_ticrate = DEFAULT_LOGIC_TIC_RATE;
 int KX_KetsjiEngine::m_maxLogicFrame = 5;
 int KX_KetsjiEngine::m_maxPhysicsFrame = 5;
+double KX_KetsjiEngine::m_libLoadMergeTime = 0.002;
 double KX_KetsjiEngine::m_anim_framerate = 25.0;
 double KX_KetsjiEngine::m_suspendedtime = 0.0;
 double KX_KetsjiEngine::m_suspendeddelta = 0.0;
@@ -1366,6 +1367,35 @@ void KX_KetsjiEngine::RenderDebugProperties()
 			m_rasterizer->RenderBox2D(xcoord + (int)(2.2 * profile_indent), ycoord, m_canvas->GetWidth(), m_canvas->GetHeight(), time/tottime);
 			ycoord += const_ysize;
 		}
+
+		// Object pools hit rate, only when pools are used
+		int poolhits = 0;
+		int poolmisses = 0;
+		for (CListValue::iterator sceit = m_scenes->GetBegin(); sceit != m_scenes->GetEnd(); ++sceit) {
+			KX_Scene *scene = (KX_Scene *)*sceit;
+			poolhits += scene->GetObjectPoolHits();
+			poolmisses += scene->GetObjectPoolMisses();
+		}
+
+		if (poolhits + poolmisses > 0) {
+			m_rasterizer->RenderText2D(RAS_IRasterizer::RAS_TEXT_PADDED,
+			                           "Object Pool:",
+			                           xcoord + const_xindent,
+			                           ycoord,
+			                           m_canvas->GetWidth(),
+			                           m_canvas->GetHeight());
+
+			const float hitrate = (float)poolhits / (float)(poolhits + poolmisses);
+			debugtxt.Format("%d/%d | %d%%", poolhits, poolhits + poolmisses, (int)(hitrate * 100.f));
+			m_rasterizer->RenderText2D(RAS_IRasterizer::RAS_TEXT_PADDED,
+			                           debugtxt.ReadPtr(),
+			                           xcoord + const_xindent + profile_indent, ycoord,
+			                           m_canvas->GetWidth(),
+			                           m_canvas->GetHeight());
+
+			m_rasterizer->RenderBox2D(xcoord + (int)(2.2 * profile_indent), ycoord, m_canvas->GetWidth(), m_canvas->GetHeight(), hitrate);
+			ycoord += const_ysize;
+		}
 	}
 	// Add the ymargin for titles below the other section of debug info
 	ycoord += title_y_top_margin;
@@ -1700,6 +1730,16 @@ void KX_KetsjiEngine::SetMaxPhysicsFrame(int frame)
 	m_maxPhysicsFrame = frame;
 }
 
+double KX_KetsjiEngine::GetLibLoadMergeTime()
+{
+	return m_libLoadMergeTime;
+}
+
+void KX_KetsjiEngine::SetLibLoadMergeTime(double time)
+{
+	m_libLoadMergeTime = time;
+}
+
 bool KX_KetsjiEngine::GetRestrictAnimationFPS()
 {
 	return m_restrict_anim_fps;
@@ -135,6 +135,8 @@ private:
 	static int m_maxLogicFrame;
 	/// maximum number of consecutive physics frame
 	static int m_maxPhysicsFrame;
+	/// maximum time in seconds spent merging asynchronous libloads per logic frame
+	static double m_libLoadMergeTime;
 	static double m_ticrate;
 	/// for animation playback only - ipo and action
 	static double m_anim_framerate;
@@ -414,6 +416,15 @@ public:
 	 * Sets the maximum number of physics frame before render frame
 	 */
 	static void SetMaxPhysicsFrame(int frame);
+	/**
+	 * Gets the maximum time in seconds spent merging asynchronous libloads per logic frame
+	 */
+	static double GetLibLoadMergeTime();
+	/**
+	 * Sets the maximum time in seconds spent merging asynchronous libloads per logic frame,
+	 * zero or less merges a libload at once
+	 */
+	static void SetLibLoadMergeTime(double time);
 
 	/**
 	 * Gets whether or not to lock animation updates to the animframerate
@@ -78,6 +78,8 @@ public:
 	virtual bool	BroadPhaseFilterCollision(void*obj1,void*obj2);
 	virtual bool	BroadPhaseSensorFilterCollision(void* obj1,void* obj2) { return false; }
 	virtual sensortype GetSensorType() { return ST_NEAR; }
+	/// The sensor object must follow its owner every frame.
+	virtual bool IsEventDriven() { return false; }
 
 #ifdef WITH_PYTHON
 
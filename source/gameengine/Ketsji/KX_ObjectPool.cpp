@@ -0,0 +1,141 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Ketsji/KX_ObjectPool.cpp
+ *  \ingroup ketsji
+ */
+
+#include "KX_ObjectPool.h"
+#include "KX_GameObject.h"
+
+#include "DNA_object_types.h"
+
+#include "BLI_utildefines.h"
+
+KX_ObjectPool::KX_ObjectPool(KX_GameObject *original, unsigned int size)
+	:m_original(original),
+	m_size(size)
+{
+}
+
+KX_ObjectPool::~KX_ObjectPool()
+{
+	/* The scene must destroy the deactivated replicas before. */
+	BLI_assert(m_objects.empty());
+}
+
+bool KX_ObjectPool::IsPoolable(KX_GameObject *original)
+{
+	/* Cameras, lights and texts are registered in other lists of the scene
+	 * and armatures always have a hierarchy. */
+	if (ELEM(original->GetGameObjectType(), SCA_IObject::OBJ_ARMATURE, SCA_IObject::OBJ_CAMERA,
+	         SCA_IObject::OBJ_LIGHT, SCA_IObject::OBJ_TEXT))
+	{
+		return false;
+	}
+
+	/* The whole hierarchy would have to be deactivated. */
+	if (!original->GetSGNode() || !original->GetSGNode()->GetSGChildren().empty() || original->IsDupliGroup()) {
+		return false;
+	}
+
+	/* The rigid body constraints are replicated with the object and bound to this instance,
+	 * a recycled object would keep the constraints of its previous use. */
+	if (!original->GetConstraints().empty()) {
+		return false;
+	}
+
+	/* The deformers and soft bodies keep a state which can't be reset. */
+	if (original->GetDeformer()) {
+		return false;
+	}
+
+	Object *blenderobj = original->GetBlenderObject();
+	if (blenderobj && ELEM(blenderobj->body_type, OB_BODY_TYPE_SOFT, OB_BODY_TYPE_NAVMESH)) {
+		return false;
+	}
+
+	return true;
+}
+
+bool KX_ObjectPool::CanRecycle(KX_GameObject *gameobj) const
+{
+	SG_Node *node = gameobj->GetSGNode();
+	/* The object was parented or got children. */
+	if (!node || node->GetSGParent() || !node->GetSGChildren().empty()) {
+		return false;
+	}
+
+	/* The mesh was replaced. */
+	if (gameobj->GetMeshCount() != m_original->GetMeshCount()) {
+		return false;
+	}
+	for (int i = 0, count = gameobj->GetMeshCount(); i < count; ++i) {
+		if (gameobj->GetMesh(i) != m_original->GetMesh(i)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+KX_GameObject *KX_ObjectPool::GetOriginal() const
+{
+	return m_original;
+}
+
+unsigned int KX_ObjectPool::GetSize() const
+{
+	return m_size;
+}
+
+void KX_ObjectPool::SetSize(unsigned int size)
+{
+	m_size = size;
+}
+
+unsigned int KX_ObjectPool::GetObjectCount() const
+{
+	return m_objects.size();
+}
+
+bool KX_ObjectPool::IsFull() const
+{
+	return (m_objects.size() >= m_size);
+}
+
+void KX_ObjectPool::PushObject(KX_GameObject *gameobj)
+{
+	BLI_assert(!IsFull());
+	m_objects.push_back(gameobj);
+}
+
+KX_GameObject *KX_ObjectPool::PopObject()
+{
+	if (m_objects.empty()) {
+		return NULL;
+	}
+
+	KX_GameObject *gameobj = m_objects.back();
+	m_objects.pop_back();
+	return gameobj;
+}
@@ -0,0 +1,85 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * Contributor(s): none yet.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file KX_ObjectPool.h
+ *  \ingroup ketsji
+ */
+
+#ifndef __KX_OBJECTPOOL_H__
+#define __KX_OBJECTPOOL_H__
+
+#include <vector>
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#include "MEM_guardedalloc.h"
+#endif
+
+class KX_GameObject;
+
+/**
+ * Pool of the removed replicas of an object added in a scene.
+ * Instead of being destroyed the replicas are deactivated and kept
+ * here, the next additions of the original object recycle them and
+ * only reset their logic, properties and transform.
+ *
+ * Only the objects without hierarchy, group instance, deformer and
+ * soft body can be pooled, see IsPoolable.
+ */
+class KX_ObjectPool
+{
+private:
+	/// Original object of the replicas, not owned.
+	KX_GameObject *m_original;
+	/// Maximum number of deactivated replicas kept.
+	unsigned int m_size;
+	/// The deactivated replicas, the scene owns their reference.
+	std::vector<KX_GameObject *> m_objects;
+
+public:
+	KX_ObjectPool(KX_GameObject *original, unsigned int size);
+	~KX_ObjectPool();
+
+	/// Return true if the replicas of this object can be recycled.
+	static bool IsPoolable(KX_GameObject *original);
+
+	/// Return true if the replica is still identical to a new one apart from its logic and properties.
+	bool CanRecycle(KX_GameObject *gameobj) const;
+
+	KX_GameObject *GetOriginal() const;
+	unsigned int GetSize() const;
+	void SetSize(unsigned int size);
+
+	/// Return the number of deactivated replicas.
+	unsigned int GetObjectCount() const;
+	bool IsFull() const;
+
+	/// Add a deactivated replica, the pool must not be full.
+	void PushObject(KX_GameObject *gameobj);
+	/// Remove and return the last deactivated replica, NULL if the pool is empty.
+	KX_GameObject *PopObject();
+
+#ifdef WITH_CXX_GUARDEDALLOC
+	MEM_CXX_CLASS_ALLOC_FUNCS("GE:KX_ObjectPool")
+#endif
+};
+
+#endif  /* __KX_OBJECTPOOL_H__ */
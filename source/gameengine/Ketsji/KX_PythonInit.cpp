@@ -469,6 +469,21 @@ static PyObject *gPyGetMaxPhysicsFrame(PyObject *)
 	return PyLong_FromLong(KX_KetsjiEngine::GetMaxPhysicsFrame());
 }
 
+static PyObject *gPySetLibLoadMergeTime(PyObject *, PyObject *args)
+{
+	double time;
+	if (!PyArg_ParseTuple(args, "d:setLibLoadMergeTime", &time))
+		return NULL;
+
+	KX_KetsjiEngine::SetLibLoadMergeTime(time);
+	Py_RETURN_NONE;
+}
+
+static PyObject *gPyGetLibLoadMergeTime(PyObject *)
+{
+	return PyFloat_FromDouble(KX_KetsjiEngine::GetLibLoadMergeTime());
+}
+
 static PyObject *gPySetPhysicsTicRate(PyObject *, PyObject *args)
 {
 	float ticrate;
@@ -851,6 +866,8 @@ static struct PyMethodDef game_methods[] = {
 	{"setMaxLogicFrame", (PyCFunction) gPySetMaxLogicFrame, METH_VARARGS, (const char *)"Sets the max number of logic frame per render frame"},
 	{"getMaxPhysicsFrame", (PyCFunction) gPyGetMaxPhysicsFrame, METH_NOARGS, (const char *)"Gets the max number of physics frame per render frame"},
 	{"setMaxPhysicsFrame", (PyCFunction) gPySetMaxPhysicsFrame, METH_VARARGS, (const char *)"Sets the max number of physics farme per render frame"},
+	{"getLibLoadMergeTime", (PyCFunction) gPyGetLibLoadMergeTime, METH_NOARGS, (const char *)"Gets the max time in seconds spent merging asynchronous libloads per logic frame"},
+	{"setLibLoadMergeTime", (PyCFunction) gPySetLibLoadMergeTime, METH_VARARGS, (const char *)"Sets the max time in seconds spent merging asynchronous libloads per logic frame"},
 	{"getLogicTicRate", (PyCFunction) gPyGetLogicTicRate, METH_NOARGS, (const char *)"Gets the logic tic rate"},
 	{"setLogicTicRate", (PyCFunction) gPySetLogicTicRate, METH_VARARGS, (const char *)"Sets the logic tic rate"},
 	{"getPhysicsTicRate", (PyCFunction) gPyGetPhysicsTicRate, METH_NOARGS, (const char *)"Gets the physics tic rate"},
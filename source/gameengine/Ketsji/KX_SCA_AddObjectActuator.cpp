@@ -51,14 +51,16 @@ KX_SCA_AddObjectActuator::KX_SCA_AddObjectActuator(SCA_IObject *gameobj,
 												   const float *linvel,
 												   bool linv_local,
 												   const float *angvel,
-												   bool angv_local)
+												   bool angv_local,
+												   int poolsize)
 	: 
 	SCA_IActuator(gameobj, KX_ACT_ADD_OBJECT),
 	m_OriginalObject(original),
 	m_scene(scene),
 	
 	m_localLinvFlag(linv_local),
-	m_localAngvFlag(angv_local)
+	m_localAngvFlag(angv_local),
+	m_poolSize(poolsize)
 {
 	m_linear_velocity[0] = linvel[0];
 	m_linear_velocity[1] = linvel[1];
@@ -197,6 +199,7 @@ PyAttributeDef KX_SCA_AddObjectActuator::Attributes[] = {
 	KX_PYATTRIBUTE_RW_FUNCTION("object",KX_SCA_AddObjectActuator,pyattr_get_object,pyattr_set_object),
 	KX_PYATTRIBUTE_RO_FUNCTION("objectLastCreated",KX_SCA_AddObjectActuator,pyattr_get_objectLastCreated),
 	KX_PYATTRIBUTE_INT_RW("time",0,2000,true,KX_SCA_AddObjectActuator,m_timeProp),
+	KX_PYATTRIBUTE_INT_RW("poolSize",0,10000,true,KX_SCA_AddObjectActuator,m_poolSize),
 	KX_PYATTRIBUTE_FLOAT_ARRAY_RW("linearVelocity",-FLT_MAX,FLT_MAX,KX_SCA_AddObjectActuator,m_linear_velocity,3),
 	KX_PYATTRIBUTE_FLOAT_ARRAY_RW("angularVelocity",-FLT_MAX,FLT_MAX,KX_SCA_AddObjectActuator,m_angular_velocity,3),
 	{ NULL }	//Sentinel
@@ -252,6 +255,10 @@ void	KX_SCA_AddObjectActuator::InstantAddObject()
 {
 	if (m_OriginalObject)
 	{
+		// Removed objects are kept to be recycled by the next additions.
+		if (m_poolSize > 0)
+			m_scene->ReserveObjectPool(m_OriginalObject, m_poolSize);
+
 		// Add an identical object, with properties inherited from the original object
 		// Now it needs to be added to the current scene.
 		SCA_IObject* replica = m_scene->AddReplicaObject(m_OriginalObject,GetParent(),m_timeProp );
@@ -65,6 +65,9 @@ class KX_SCA_AddObjectActuator : public SCA_IActuator
 	float  m_angular_velocity[3];
 	/// Apply the velocity locally 
 	bool m_localAngvFlag; 
+
+	/// Number of removed objects kept to be recycled, 0 to disable pooling.
+	int m_poolSize;
 	
 	
 	
@@ -86,7 +89,8 @@ public:
 		const float *linvel,
 		bool linv_local,
 		const float *angvel,
-		bool angv_local
+		bool angv_local,
+		int poolsize
 	);
 
 	~KX_SCA_AddObjectActuator(void);
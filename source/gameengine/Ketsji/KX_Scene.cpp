@@ -36,6 +36,8 @@
 #endif
 
 #include <stdio.h>
+#include <float.h>
+#include <string>
 
 #include "KX_Scene.h"
 #include "KX_Globals.h"
@@ -65,6 +67,7 @@
 #include "RAS_2DFilterData.h"
 #include "RAS_2DFilterManager.h"
 #include "RAS_BucketManager.h"
+#include "RAS_MaterialBucket.h"
 
 #include "EXP_FloatValue.h"
 #include "SCA_IController.h"
@@ -76,6 +79,7 @@
 #include "DNA_group_types.h"
 #include "DNA_scene_types.h"
 #include "DNA_property_types.h"
+#include "DNA_constraint_types.h"
 
 #include "KX_SG_NodeRelationships.h"
 
@@ -90,6 +94,7 @@
 #include "BL_ShapeDeformer.h"
 #include "BL_DeformableGameObject.h"
 #include "KX_ObstacleSimulation.h"
+#include "KX_ObjectPool.h"
 
 #ifdef WITH_BULLET
 #  include "KX_SoftBodyDeformer.h"
@@ -103,6 +108,8 @@
 
 #include "BLI_task.h"
 
+#include "PIL_time.h"
+
 static void *KX_SceneReplicationFunc(SG_IObject* node,void* gameobj,void* scene)
 {
 	KX_GameObject* replica = ((KX_Scene*)scene)->AddNodeReplicaObject(node,(KX_GameObject*)gameobj);
@@ -170,6 +177,9 @@ KX_Scene::KX_Scene(class SCA_IInputDevice* keyboarddevice,
 	m_inactivelist = new CListValue();
 	m_euthanasyobjects = new CListValue();
 	m_animatedlist = new CListValue();
+	m_pooledlist = new CListValue();
+	m_objectPoolHits = 0;
+	m_objectPoolMisses = 0;
 
 	m_filterManager = new RAS_2DFilterManager(canvas);
 	m_logicmgr = new SCA_LogicManager();
@@ -186,6 +196,7 @@ KX_Scene::KX_Scene(class SCA_IInputDevice* keyboarddevice,
 	m_logicmgr->RegisterEventManager(m_mousemgr);
 	m_logicmgr->RegisterEventManager(m_timemgr);
 	m_logicmgr->RegisterEventManager(basicmgr);
+	m_logicmgr->SetEventDriven((scene->gm.flag & GAME_LOGIC_EVENT_DRIVEN) != 0);
 
 
 	SYS_SystemHandle hSystem = SYS_GetSystem();
@@ -232,6 +243,15 @@ KX_Scene::~KX_Scene()
 	// reference might be hanging and causing late release of objects
 	RemoveAllDebugProperties();
 
+	for (std::map<KX_GameObject *, KX_ObjectPool *>::iterator it = m_objectPools.begin(), end = m_objectPools.end();
+	     it != end; ++it)
+	{
+		KX_ObjectPool *pool = it->second;
+		DestroyPooledObjects(pool, pool->GetObjectCount());
+		delete pool;
+	}
+	m_objectPools.clear();
+
 	while (GetRootParentList()->GetCount() > 0) 
 	{
 		KX_GameObject* parentobj = (KX_GameObject*) GetRootParentList()->GetValue(0);
@@ -262,6 +282,9 @@ KX_Scene::~KX_Scene()
 	if (m_animatedlist)
 		m_animatedlist->Release();
 
+	if (m_pooledlist)
+		m_pooledlist->Release();
+
 	if (m_filterManager) {
 		delete m_filterManager;
 	}
@@ -892,6 +915,21 @@ SCA_IObject* KX_Scene::AddReplicaObject(class CValue* originalobject,
 	KX_GameObject* originalobj = (KX_GameObject*) originalobject;
 	KX_GameObject* referenceobj = (KX_GameObject*) referenceobject;
 
+	// try to recycle a removed replica first
+	std::map<KX_GameObject *, KX_ObjectPool *>::iterator poolit = m_objectPools.find(originalobj);
+	const bool pooled = (poolit != m_objectPools.end());
+	if (pooled) {
+		KX_GameObject *pooledobj = poolit->second->PopObject();
+		if (pooledobj) {
+			m_objectPoolHits++;
+			RecyclePooledObject(pooledobj, originalobj, referenceobj, lifespan);
+			m_pooledObjectOriginals[pooledobj] = originalobj;
+			// the reference of the pooled list is returned
+			return pooledobj;
+		}
+		m_objectPoolMisses++;
+	}
+
 	m_ueberExecutionPriority++;
 
 	// lets create a replica
@@ -988,6 +1026,11 @@ SCA_IObject* KX_Scene::AddReplicaObject(class CValue* originalobject,
 	{
 		DupliGroupRecurse(*git, 0);
 	}
+
+	if (pooled) {
+		m_pooledObjectOriginals[replica] = originalobj;
+	}
+
 	//	don't release replica here because we are returning it, not done with it...
 	return replica;
 }
@@ -1034,6 +1077,229 @@ void KX_Scene::DelayedRemoveObject(class CValue* gameobj)
 	}
 }
 
+bool KX_Scene::SetObjectPoolSize(CValue *gameobj, int size)
+{
+	KX_GameObject *original = (KX_GameObject *)gameobj;
+	std::map<KX_GameObject *, KX_ObjectPool *>::iterator it = m_objectPools.find(original);
+
+	if (size <= 0) {
+		if (it != m_objectPools.end()) {
+			DestroyObjectPool(original);
+		}
+		return true;
+	}
+
+	if (!KX_ObjectPool::IsPoolable(original)) {
+		return false;
+	}
+
+	if (it == m_objectPools.end()) {
+		m_objectPools[original] = new KX_ObjectPool(original, size);
+	}
+	else {
+		KX_ObjectPool *pool = it->second;
+		pool->SetSize(size);
+		if (pool->GetObjectCount() > pool->GetSize()) {
+			DestroyPooledObjects(pool, pool->GetObjectCount() - pool->GetSize());
+		}
+	}
+	return true;
+}
+
+int KX_Scene::GetObjectPoolSize(CValue *gameobj)
+{
+	std::map<KX_GameObject *, KX_ObjectPool *>::iterator it = m_objectPools.find((KX_GameObject *)gameobj);
+	if (it == m_objectPools.end()) {
+		return 0;
+	}
+	return it->second->GetSize();
+}
+
+void KX_Scene::ReserveObjectPool(CValue *gameobj, int size)
+{
+	if (GetObjectPoolSize(gameobj) < size) {
+		SetObjectPoolSize(gameobj, size);
+	}
+}
+
+void KX_Scene::ClearObjectPools()
+{
+	for (std::map<KX_GameObject *, KX_ObjectPool *>::iterator it = m_objectPools.begin(), end = m_objectPools.end();
+	     it != end; ++it)
+	{
+		KX_ObjectPool *pool = it->second;
+		DestroyPooledObjects(pool, pool->GetObjectCount());
+	}
+}
+
+int KX_Scene::GetObjectPoolHits() const
+{
+	return m_objectPoolHits;
+}
+
+int KX_Scene::GetObjectPoolMisses() const
+{
+	return m_objectPoolMisses;
+}
+
+void KX_Scene::DestroyPooledObjects(KX_ObjectPool *pool, unsigned int count)
+{
+	for (unsigned int i = 0; i < count; ++i) {
+		KX_GameObject *gameobj = pool->PopObject();
+		// the reference is owned by m_pooledlist and released in NewRemoveObject
+		RemoveObject(gameobj);
+	}
+}
+
+void KX_Scene::DestroyObjectPool(KX_GameObject *original)
+{
+	std::map<KX_GameObject *, KX_ObjectPool *>::iterator poolit = m_objectPools.find(original);
+	KX_ObjectPool *pool = poolit->second;
+	m_objectPools.erase(poolit);
+
+	DestroyPooledObjects(pool, pool->GetObjectCount());
+	delete pool;
+
+	// the active replicas will be destroyed normally
+	for (std::map<KX_GameObject *, KX_GameObject *>::iterator it = m_pooledObjectOriginals.begin();
+	     it != m_pooledObjectOriginals.end();)
+	{
+		if (it->second == original) {
+			m_pooledObjectOriginals.erase(it++);
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+bool KX_Scene::ReleasePooledObject(KX_GameObject *gameobj)
+{
+	std::map<KX_GameObject *, KX_GameObject *>::iterator origit = m_pooledObjectOriginals.find(gameobj);
+	if (origit == m_pooledObjectOriginals.end()) {
+		return false;
+	}
+
+	std::map<KX_GameObject *, KX_ObjectPool *>::iterator poolit = m_objectPools.find(origit->second);
+	m_pooledObjectOriginals.erase(origit);
+	if (poolit == m_objectPools.end()) {
+		return false;
+	}
+
+	KX_ObjectPool *pool = poolit->second;
+	if (pool->IsFull() || !pool->CanRecycle(gameobj)) {
+		return false;
+	}
+
+	RemoveObjectDebugProperties(gameobj);
+	// as for a destroyed object, the python references become invalid
+	gameobj->InvalidateProxy();
+
+	// remove the logic bricks as in NewRemoveObject, new ones are replicated when the object is recycled
+	SCA_SensorList& sensors = gameobj->GetSensors();
+	for (SCA_SensorList::iterator its = sensors.begin(); its != sensors.end(); ++its) {
+		m_logicmgr->RemoveSensor(*its);
+	}
+	SCA_ControllerList& controllers = gameobj->GetControllers();
+	for (SCA_ControllerList::iterator itc = controllers.begin(); itc != controllers.end(); ++itc) {
+		m_logicmgr->RemoveController(*itc);
+		(*itc)->ReParent(NULL);
+	}
+	SCA_ActuatorList& actuators = gameobj->GetActuators();
+	for (SCA_ActuatorList::iterator ita = actuators.begin(); ita != actuators.end(); ++ita) {
+		m_logicmgr->RemoveActuator(*ita);
+	}
+	gameobj->ClearLogic();
+
+	for (int i = 0, numprops = gameobj->GetPropertyCount(); i < numprops; ++i) {
+		CValue *propval = gameobj->GetProperty(i);
+		if (propval->GetProperty("timer")) {
+			m_timemgr->RemoveTimeProperty(propval);
+		}
+	}
+	gameobj->ClearProperties();
+
+	if (m_obstacleSimulation) {
+		m_obstacleSimulation->DestroyObstacleForObj(gameobj);
+	}
+
+	gameobj->Deactivate();
+
+	// move the object out of the scene lists, the pooled list keeps it alive
+	m_pooledlist->Add(gameobj->AddRef());
+	if (m_objectlist->RemoveValue(gameobj))
+		gameobj->Release();
+	if (m_tempObjectList->RemoveValue(gameobj))
+		gameobj->Release();
+	if (m_parentlist->RemoveValue(gameobj))
+		gameobj->Release();
+	if (m_animatedlist->RemoveValue(gameobj))
+		gameobj->Release();
+
+	pool->PushObject(gameobj);
+
+	return true;
+}
+
+void KX_Scene::RecyclePooledObject(KX_GameObject *gameobj, KX_GameObject *original,
+                                   KX_GameObject *referenceobj, int lifespan)
+{
+	m_ueberExecutionPriority++;
+
+	// copy the properties and register the timers, as done by GetReplica in AddNodeReplicaObject
+	std::vector<STR_String> propnames = original->GetPropertyNames();
+	for (std::vector<STR_String>::iterator it = propnames.begin(), end = propnames.end(); it != end; ++it) {
+		CValue *prop = original->GetProperty(*it)->GetReplica();
+		gameobj->SetProperty(*it, prop);
+		if (prop->GetProperty("timer")) {
+			m_timemgr->AddTimeProperty(prop);
+		}
+		prop->Release();
+	}
+
+	if (lifespan > 0) {
+		m_tempObjectList->Add(gameobj->AddRef());
+		// see AddReplicaObject
+		CValue *fval = new CFloatValue(lifespan * 0.02f);
+		gameobj->SetProperty("::timebomb", fval);
+		fval->Release();
+	}
+
+	// the reference of the pooled list is kept by the caller
+	m_pooledlist->RemoveValue(gameobj);
+	m_objectlist->Add(gameobj->AddRef());
+	m_parentlist->Add(gameobj->AddRef());
+
+	if (m_obstacleSimulation && original->GetBlenderObject()->gameflag & OB_HASOBSTACLE) {
+		m_obstacleSimulation->AddObstacleForObj(gameobj);
+	}
+
+	// same transform as a new replica
+	SG_Node *orgnode = original->GetSGNode();
+	gameobj->NodeSetLocalScale(orgnode->GetLocalScale());
+	gameobj->NodeSetLocalPosition(orgnode->GetLocalPosition());
+	gameobj->NodeSetLocalOrientation(orgnode->GetLocalOrientation());
+	if (referenceobj) {
+		gameobj->NodeSetLocalPosition(referenceobj->NodeGetWorldPosition());
+		gameobj->NodeSetLocalOrientation(referenceobj->NodeGetWorldOrientation());
+		gameobj->NodeSetRelativeScale(referenceobj->GetSGNode()->GetRootSGParent()->GetLocalScale());
+	}
+	gameobj->GetSGNode()->UpdateWorldData(0);
+	gameobj->GetSGNode()->SetBBox(orgnode->BBox());
+
+	gameobj->Reactivate(original);
+
+	// replicate the logic of the original, see AddReplicaObject
+	gameobj->ReplaceLogic(original);
+
+	m_map_gameobject_to_replica.clear();
+	m_map_gameobject_to_replica[original] = gameobj;
+	gameobj->Relink(m_map_gameobject_to_replica);
+	gameobj->SetLayer(referenceobj ? referenceobj->GetLayer() : m_blenderScene->lay);
+
+	ReplicateLogic(gameobj);
+}
+
 int KX_Scene::NewRemoveObject(class CValue* gameobj)
 {
 	int ret;
@@ -1042,6 +1308,12 @@ int KX_Scene::NewRemoveObject(class CValue* gameobj)
 	/* remove property from debug list */
 	RemoveObjectDebugProperties(newobj);
 
+	m_pooledObjectOriginals.erase(newobj);
+	// the pooled objects can't be recycled without their original
+	if (m_objectPools.find(newobj) != m_objectPools.end()) {
+		DestroyObjectPool(newobj);
+	}
+
 	/* Invalidate the python reference, since the object may exist in script lists
 	 * its possible that it wont be automatically invalidated, so do it manually here,
 	 * 
@@ -1142,6 +1414,8 @@ int KX_Scene::NewRemoveObject(class CValue* gameobj)
 		ret = newobj->Release();
 	if (m_animatedlist->RemoveValue(newobj))
 		ret = newobj->Release();
+	if (m_pooledlist->RemoveValue(newobj))
+		ret = newobj->Release();
 
 	/* Warning 'newobj' maye be freed now, only compare, don't access */
 
@@ -1687,7 +1961,9 @@ void KX_Scene::LogicEndFrame()
 		obj = (KX_GameObject*)m_euthanasyobjects->GetValue(numobj-1);
 		m_euthanasyobjects->Remove(numobj-1);
 		obj->Release();
-		RemoveObject(obj);
+		if (!ReleasePooledObject(obj)) {
+			RemoveObject(obj);
+		}
 	}
 
 	//prepare obstacle simulation for new frame
@@ -1907,17 +2183,23 @@ static void MergeScene_LogicBrick(SCA_ILogicBrick* brick, KX_Scene *from, KX_Sce
 	if (filter_actuator) {
 		filter_actuator->SetScene(to);
 	}
+}
 
+static void MergeScene_CompileLogic(KX_GameObject *gameobj)
+{
 #ifdef WITH_PYTHON
 	// Python must be called from the main thread unless we want to deal
 	// with GIL issues. So, this is delayed until here in case of async
 	// libload (originally in KX_ConvertControllers)
-	SCA_PythonController *pyctrl = dynamic_cast<SCA_PythonController*>(brick);
-	if (pyctrl) {
-		pyctrl->SetNamespace(KX_GetActiveEngine()->GetPyNamespace());
-
-		if (pyctrl->m_mode==SCA_PythonController::SCA_PYEXEC_SCRIPT)
-			pyctrl->Compile();
+	SCA_ControllerList& controllers = gameobj->GetControllers();
+	for (SCA_ControllerList::iterator itc = controllers.begin(); itc != controllers.end(); ++itc) {
+		SCA_PythonController *pyctrl = dynamic_cast<SCA_PythonController *>(*itc);
+		if (pyctrl) {
+			pyctrl->SetNamespace(KX_GetActiveEngine()->GetPyNamespace());
+
+			if (pyctrl->m_mode==SCA_PythonController::SCA_PYEXEC_SCRIPT)
+				pyctrl->Compile();
+		}
 	}
 #endif
 }
@@ -1980,9 +2262,6 @@ static void MergeScene_GameObject(KX_GameObject* gameobj, KX_Scene *to, KX_Scene
 					children[i]->SetSGClientInfo(to);
 		}
 	}
-	/* If the object is a light, update it's scene */
-	if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_LIGHT)
-		((KX_LightObject*)gameobj)->UpdateScene(to);
 
 	if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_CAMERA)
 		to->AddCamera((KX_Camera*)gameobj);
@@ -2003,7 +2282,50 @@ static void MergeScene_GameObject(KX_GameObject* gameobj, KX_Scene *to, KX_Scene
 	}
 }
 
-bool KX_Scene::MergeScene(KX_Scene *other)
+static KX_GameObject *MergeScene_GetRootParent(KX_GameObject *gameobj)
+{
+	SG_Node *node = gameobj->GetSGNode();
+	if (!node) {
+		return gameobj;
+	}
+
+	while (node->GetSGParent()) {
+		node = node->GetSGParent();
+	}
+
+	KX_GameObject *parent = (KX_GameObject *)node->GetSGClientObject();
+	return parent ? parent : gameobj;
+}
+
+/// Count a merged element and return true if the merge step must stop.
+static bool MergeScene_StepDone(KX_Scene::MergeState& state, double endtime)
+{
+	++state.m_index;
+	++state.m_numMerged;
+	return (PIL_check_seconds_timer() >= endtime);
+}
+
+KX_Scene::MergeState::MergeState()
+	:m_stage(MERGE_BEGIN),
+	m_index(0),
+	m_success(true),
+	m_numMerged(0),
+	m_numTotal(0)
+{
+}
+
+float KX_Scene::MergeState::GetProgress() const
+{
+	if (m_stage == MERGE_FINISHED) {
+		return 1.0f;
+	}
+	if (m_numTotal == 0) {
+		return 0.0f;
+	}
+	return (float)m_numMerged / (float)m_numTotal;
+}
+
+bool KX_Scene::MergeSceneBegin(KX_Scene *other, MergeState& state)
 {
 	PHY_IPhysicsEnvironment *env = this->GetPhysicsEnvironment();
 	PHY_IPhysicsEnvironment *env_other = other->GetPhysicsEnvironment();
@@ -2020,36 +2342,129 @@ bool KX_Scene::MergeScene(KX_Scene *other)
 		return false;
 	}
 
+	CListValue *objects = other->GetObjectList();
+	CListValue *inactiveObjects = other->GetInactiveList();
+	CListValue *rootParents = other->GetRootParentList();
 
-	GetBucketManager()->MergeBucketManager(other->GetBucketManager(), this);
+	for (int i = 0; i < objects->GetCount(); ++i) {
+		state.m_logicObjects.push_back((KX_GameObject *)objects->GetValue(i));
+	}
+	for (int i = 0; i < inactiveObjects->GetCount(); ++i) {
+		state.m_logicObjects.push_back((KX_GameObject *)inactiveObjects->GetValue(i));
+	}
+
+	/* The lights are added to the blender scene before the materials construction
+	 * so that the shaders use them. */
+	for (std::vector<KX_GameObject *>::iterator it = state.m_logicObjects.begin(); it != state.m_logicObjects.end(); ++it) {
+		if ((*it)->GetGameObjectType() == SCA_IObject::OBJ_LIGHT) {
+			((KX_LightObject *)*it)->UpdateScene(this);
+		}
+	}
 
+	RAS_BucketManager::BucketList& buckets = other->GetBucketManager()->GetBuckets();
+	for (RAS_BucketManager::BucketList::iterator bit = buckets.begin(); bit != buckets.end(); ++bit) {
+		RAS_MaterialBucket *bucket = *bit;
+		state.m_materials.push_back(bucket->GetPolyMaterial());
 
-	/* active + inactive == all ??? - lets hope so */
-	for (int i = 0; i < other->GetObjectList()->GetCount(); i++)
-	{
-		KX_GameObject* gameobj = (KX_GameObject*)other->GetObjectList()->GetValue(i);
+		RAS_DisplayArrayBucketList& arrayBuckets = bucket->GetDisplayArrayBucketList();
+		state.m_arrayBuckets.insert(state.m_arrayBuckets.end(), arrayBuckets.begin(), arrayBuckets.end());
+	}
+
+	/* Split the active objects by hierarchy, an object becomes active with its whole hierarchy. */
+	std::vector<MergeState::Group> groups;
+	std::map<KX_GameObject *, unsigned int> parentGroups;
+	for (int i = 0; i < rootParents->GetCount(); ++i) {
+		KX_GameObject *parent = (KX_GameObject *)rootParents->GetValue(i);
+		parentGroups[parent] = groups.size();
+		groups.push_back(MergeState::Group());
+		groups.back().m_rootParents.push_back(parent);
+	}
+
+	std::set<std::string> constraintTargets;
+	for (int i = 0; i < objects->GetCount(); ++i) {
+		KX_GameObject *gameobj = (KX_GameObject *)objects->GetValue(i);
+		std::map<KX_GameObject *, unsigned int>::iterator pit = parentGroups.find(MergeScene_GetRootParent(gameobj));
+		if (pit != parentGroups.end()) {
+			groups[pit->second].m_objects.push_back(gameobj);
+		}
+		else {
+			groups.push_back(MergeState::Group());
+			groups.back().m_objects.push_back(gameobj);
+		}
+
+		std::vector<bRigidBodyJointConstraint *> constraints = gameobj->GetConstraints();
+		for (std::vector<bRigidBodyJointConstraint *>::iterator cit = constraints.begin(); cit != constraints.end(); ++cit) {
+			constraintTargets.insert((*cit)->tar->id.name + 2);
+		}
+	}
+
+	/* The constraints are replicated between objects merged at the same time,
+	 * all the hierarchies using or targeted by a constraint are merged last and together. */
+	MergeState::Group constraintGroup;
+	constraintGroup.m_constraints = true;
+	for (std::vector<MergeState::Group>::iterator git = groups.begin(); git != groups.end(); ++git) {
+		MergeState::Group& group = *git;
+		group.m_constraints = false;
+		for (std::vector<KX_GameObject *>::iterator it = group.m_objects.begin(); it != group.m_objects.end(); ++it) {
+			KX_GameObject *gameobj = *it;
+			if (!gameobj->GetConstraints().empty() || constraintTargets.count(gameobj->GetName().ReadPtr())) {
+				group.m_constraints = true;
+				break;
+			}
+		}
+
+		if (group.m_constraints) {
+			constraintGroup.m_rootParents.insert(constraintGroup.m_rootParents.end(),
+			                                     group.m_rootParents.begin(), group.m_rootParents.end());
+			constraintGroup.m_objects.insert(constraintGroup.m_objects.end(),
+			                                 group.m_objects.begin(), group.m_objects.end());
+		}
+		else {
+			state.m_groups.push_back(group);
+		}
+	}
+	if (!constraintGroup.m_objects.empty()) {
+		state.m_groups.push_back(constraintGroup);
+	}
+
+	/* The list references of the active objects are now owned by the state,
+	 * they are given to the lists of this scene once the objects are merged. */
+	objects->Resize(0);
+	rootParents->Resize(0);
+
+	state.m_numTotal = state.m_logicObjects.size() + state.m_materials.size() + state.m_arrayBuckets.size() +
+	                   inactiveObjects->GetCount() + state.m_groups.size();
+
+	return true;
+}
+
+void KX_Scene::MergeSceneGroup(KX_Scene *other, MergeState::Group& group)
+{
+	for (std::vector<KX_GameObject *>::iterator it = group.m_objects.begin(); it != group.m_objects.end(); ++it) {
+		KX_GameObject *gameobj = *it;
 		MergeScene_GameObject(gameobj, this, other);
 
 		/* add properties to debug list for LibLoad objects */
 		if (KX_GetActiveEngine()->GetAutoAddDebugProperties()) {
 			AddObjectDebugProperties(gameobj);
 		}
-	}
 
-	for (int i = 0; i < other->GetInactiveList()->GetCount(); i++)
-	{
-		KX_GameObject* gameobj = (KX_GameObject*)other->GetInactiveList()->GetValue(i);
-		MergeScene_GameObject(gameobj, this, other);
+		m_objectlist->Add(gameobj);
+
+		if (gameobj->GetGameObjectType() == SCA_IObject::OBJ_LIGHT && other->GetLightList()->RemoveValue(gameobj)) {
+			m_lightlist->Add(gameobj);
+		}
 	}
 
-	if (env) {
-		env->MergeEnvironment(env_other);
-		CListValue *otherObjects = other->GetObjectList();
+	for (std::vector<KX_GameObject *>::iterator it = group.m_rootParents.begin(); it != group.m_rootParents.end(); ++it) {
+		m_parentlist->Add(*it);
+	}
 
+	if (group.m_constraints && GetPhysicsEnvironment()) {
 		// List of all physics objects to merge (needed by ReplicateConstraints).
 		std::vector<KX_GameObject *> physicsObjects;
-		for (unsigned int i = 0; i < otherObjects->GetCount(); ++i) {
-			KX_GameObject *gameobj = (KX_GameObject *)otherObjects->GetValue(i);
+		for (std::vector<KX_GameObject *>::iterator it = group.m_objects.begin(); it != group.m_objects.end(); ++it) {
+			KX_GameObject *gameobj = *it;
 			if (gameobj->GetPhysicsController()) {
 				physicsObjects.push_back(gameobj);
 			}
@@ -2062,25 +2477,23 @@ bool KX_Scene::MergeScene(KX_Scene *other)
 			gameobj->ClearConstraints();
 		}
 	}
+}
 
+void KX_Scene::MergeSceneEnd(KX_Scene *other)
+{
+	PHY_IPhysicsEnvironment *env = this->GetPhysicsEnvironment();
+	if (env) {
+		env->MergeEnvironment(other->GetPhysicsEnvironment());
+	}
 
 	GetTempObjectList()->MergeList(other->GetTempObjectList());
 	other->GetTempObjectList()->ReleaseAndRemoveAll();
 
-	GetObjectList()->MergeList(other->GetObjectList());
-	other->GetObjectList()->ReleaseAndRemoveAll();
-
-	GetInactiveList()->MergeList(other->GetInactiveList());
-	other->GetInactiveList()->ReleaseAndRemoveAll();
-
-	GetRootParentList()->MergeList(other->GetRootParentList());
-	other->GetRootParentList()->ReleaseAndRemoveAll();
-
 	GetLightList()->MergeList(other->GetLightList());
 	other->GetLightList()->ReleaseAndRemoveAll();
 
 	/* move materials across, assume they both use the same scene-converters
-	 * Do this after lights are merged so materials can use the lights in shaders
+	 * The materials are already constructed with the lights of this scene.
 	 */
 	GetSceneConverter()->MergeScene(this, other);
 
@@ -2114,9 +2527,102 @@ bool KX_Scene::MergeScene(KX_Scene *other)
 		}
 		
 	}
+}
+
+bool KX_Scene::MergeSceneStep(KX_Scene *other, MergeState& state, double endtime)
+{
+	if (state.m_stage == MergeState::MERGE_BEGIN) {
+		if (!MergeSceneBegin(other, state)) {
+			state.m_success = false;
+			state.m_stage = MergeState::MERGE_FINISHED;
+			return true;
+		}
+		state.m_stage = MergeState::MERGE_LOGIC;
+		state.m_index = 0;
+	}
+
+	if (state.m_stage == MergeState::MERGE_LOGIC) {
+		while (state.m_index < state.m_logicObjects.size()) {
+			MergeScene_CompileLogic(state.m_logicObjects[state.m_index]);
+			if (MergeScene_StepDone(state, endtime)) {
+				return false;
+			}
+		}
+		state.m_stage = MergeState::MERGE_MATERIALS;
+		state.m_index = 0;
+	}
+
+	if (state.m_stage == MergeState::MERGE_MATERIALS) {
+		while (state.m_index < state.m_materials.size()) {
+			// Compile the shaders and load the textures.
+			state.m_materials[state.m_index]->Replace_IScene(this);
+			if (MergeScene_StepDone(state, endtime)) {
+				return false;
+			}
+		}
+		state.m_stage = MergeState::MERGE_STORAGE;
+		state.m_index = 0;
+	}
+
+	if (state.m_stage == MergeState::MERGE_STORAGE) {
+		RAS_IRasterizer *rasty = KX_GetActiveEngine()->GetRasterizer();
+		while (state.m_index < state.m_arrayBuckets.size()) {
+			// Create the GPU buffers now instead of at the first render.
+			rasty->PrepareStorage(state.m_arrayBuckets[state.m_index]);
+			if (MergeScene_StepDone(state, endtime)) {
+				return false;
+			}
+		}
+
+		// The buckets are not rendered until their objects are merged.
+		GetBucketManager()->MergeBucketManager(other->GetBucketManager(), this);
+
+		state.m_stage = MergeState::MERGE_INACTIVE_OBJECTS;
+		state.m_index = 0;
+	}
+
+	if (state.m_stage == MergeState::MERGE_INACTIVE_OBJECTS) {
+		/* The inactive objects are merged before the active ones which can add them. */
+		CListValue *inactiveObjects = other->GetInactiveList();
+		while (state.m_index < (unsigned int)inactiveObjects->GetCount()) {
+			MergeScene_GameObject((KX_GameObject *)inactiveObjects->GetValue(state.m_index), this, other);
+			if (MergeScene_StepDone(state, endtime)) {
+				return false;
+			}
+		}
+
+		GetInactiveList()->MergeList(inactiveObjects);
+		inactiveObjects->ReleaseAndRemoveAll();
+
+		state.m_stage = MergeState::MERGE_OBJECTS;
+		state.m_index = 0;
+	}
+
+	if (state.m_stage == MergeState::MERGE_OBJECTS) {
+		while (state.m_index < state.m_groups.size()) {
+			MergeSceneGroup(other, state.m_groups[state.m_index]);
+			if (MergeScene_StepDone(state, endtime)) {
+				return false;
+			}
+		}
+		state.m_stage = MergeState::MERGE_END;
+		state.m_index = 0;
+	}
+
+	MergeSceneEnd(other);
+	state.m_stage = MergeState::MERGE_FINISHED;
+
 	return true;
 }
 
+bool KX_Scene::MergeScene(KX_Scene *other)
+{
+	MergeState state;
+	MergeSceneStep(other, state, DBL_MAX);
+
+	return state.m_success;
+}
+
 RAS_2DFilterManager *KX_Scene::Get2DFilterManager() const
 {
 	return m_filterManager;
@@ -2173,6 +2679,8 @@ PyMethodDef KX_Scene::Methods[] = {
 	KX_PYMETHODTABLE(KX_Scene, suspend),
 	KX_PYMETHODTABLE(KX_Scene, resume),
 	KX_PYMETHODTABLE(KX_Scene, drawObstacleSimulation),
+	KX_PYMETHODTABLE(KX_Scene, setObjectPoolSize),
+	KX_PYMETHODTABLE(KX_Scene, getObjectPoolSize),
 
 	
 	/* dict style access */
@@ -2493,6 +3001,8 @@ PyAttributeDef KX_Scene::Attributes[] = {
 	KX_PYATTRIBUTE_BOOL_RO("activity_culling",		KX_Scene, m_activity_culling),
 	KX_PYATTRIBUTE_FLOAT_RW("activity_culling_radius", 0.5f, FLT_MAX, KX_Scene, m_activity_box_radius),
 	KX_PYATTRIBUTE_BOOL_RO("dbvt_culling",			KX_Scene, m_dbvt_culling),
+	KX_PYATTRIBUTE_INT_RO("objectPoolHits",			KX_Scene, m_objectPoolHits),
+	KX_PYATTRIBUTE_INT_RO("objectPoolMisses",		KX_Scene, m_objectPoolMisses),
 	{ NULL }	//Sentinel
 };
 
@@ -2587,6 +3097,51 @@ KX_PYMETHODDEF_DOC(KX_Scene, drawObstacleSimulation,
 	Py_RETURN_NONE;
 }
 
+KX_PYMETHODDEF_DOC(KX_Scene, setObjectPoolSize,
+				   "setObjectPoolSize(object, size)\n"
+				   "Set the number of removed replicas of object kept to be recycled by the next additions.\n")
+{
+	PyObject *pyob;
+	KX_GameObject *ob;
+	int size;
+
+	if (!PyArg_ParseTuple(args, "Oi:setObjectPoolSize", &pyob, &size))
+		return NULL;
+
+	if (!ConvertPythonToGameObject(pyob, &ob, false, "scene.setObjectPoolSize(object, size): KX_Scene"))
+		return NULL;
+
+	if (size < 0) {
+		PyErr_SetString(PyExc_ValueError, "scene.setObjectPoolSize(object, size): KX_Scene, size must be positive or zero");
+		return NULL;
+	}
+
+	if (!SetObjectPoolSize(ob, size)) {
+		PyErr_Format(PyExc_ValueError, "scene.setObjectPoolSize(object, size): KX_Scene, "
+		             "object \"%s\" can't be pooled, it must be a mesh or an empty without hierarchy, "
+		             "group instance, deformer and soft body", ob->GetName().ReadPtr());
+		return NULL;
+	}
+
+	Py_RETURN_NONE;
+}
+
+KX_PYMETHODDEF_DOC(KX_Scene, getObjectPoolSize,
+				   "getObjectPoolSize(object)\n"
+				   "Return the number of removed replicas of object kept to be recycled.\n")
+{
+	PyObject *pyob;
+	KX_GameObject *ob;
+
+	if (!PyArg_ParseTuple(args, "O:getObjectPoolSize", &pyob))
+		return NULL;
+
+	if (!ConvertPythonToGameObject(pyob, &ob, false, "scene.getObjectPoolSize(object): KX_Scene"))
+		return NULL;
+
+	return PyLong_FromLong(GetObjectPoolSize(ob));
+}
+
 /* Matches python dict.get(key, [default]) */
 KX_PYMETHODDEF_DOC(KX_Scene, get, "")
 {
@@ -75,6 +75,7 @@ class KX_GameObject;
 class KX_LightObject;
 class RAS_BucketManager;
 class RAS_MaterialBucket;
+class RAS_DisplayArrayBucket;
 class RAS_IPolyMaterial;
 class RAS_IRasterizer;
 class RAS_IRenderTools;
@@ -223,6 +224,29 @@ protected:
 	 * means don't care.
 	 */
 	std::set<CValue*>	m_groupGameObjects;
+
+	/**
+	 * The object pools, indexed by the original object.
+	 */
+	std::map<KX_GameObject *, class KX_ObjectPool *> m_objectPools;
+
+	/**
+	 * The original object of the added objects which have a pool,
+	 * used to release them in their pool when they are removed.
+	 */
+	std::map<KX_GameObject *, KX_GameObject *> m_pooledObjectOriginals;
+
+	/**
+	 * The deactivated objects kept in the object pools.
+	 */
+	CListValue *m_pooledlist;
+
+	/**
+	 * Number of additions of objects with a pool which recycled
+	 * a deactivated object (hits) or created a new replica (misses).
+	 */
+	int m_objectPoolHits;
+	int m_objectPoolMisses;
 	
 	/** 
 	 * Pointer to system variable passed in in constructor
@@ -337,6 +361,43 @@ public:
 	void DelayedRemoveObject(CValue* gameobj);
 	
 	int NewRemoveObject(CValue* gameobj);
+
+	/**
+	 * Set the maximum number of removed replicas of \a gameobj kept to be
+	 * recycled by the next additions, 0 disables the pool.
+	 * Return false if the object can't be pooled.
+	 */
+	bool SetObjectPoolSize(CValue *gameobj, int size);
+	int GetObjectPoolSize(CValue *gameobj);
+	/**
+	 * Make sure the pool of \a gameobj can keep at least \a size objects.
+	 */
+	void ReserveObjectPool(CValue *gameobj, int size);
+	/**
+	 * Destroy all the deactivated objects of the pools, the pool sizes are kept.
+	 */
+	void ClearObjectPools();
+	int GetObjectPoolHits() const;
+	int GetObjectPoolMisses() const;
+
+protected:
+	/**
+	 * Deactivate a removed object and keep it in its pool,
+	 * return false if the object must be destroyed instead.
+	 */
+	bool ReleasePooledObject(KX_GameObject *gameobj);
+	/**
+	 * Reset a deactivated object like a new replica of \a original and add it in the scene.
+	 */
+	void RecyclePooledObject(KX_GameObject *gameobj, KX_GameObject *original,
+	                         KX_GameObject *referenceobj, int lifespan);
+	/**
+	 * Destroy the deactivated objects of a pool.
+	 */
+	void DestroyPooledObjects(KX_ObjectPool *pool, unsigned int count);
+	void DestroyObjectPool(KX_GameObject *original);
+
+public:
 	void ReplaceMesh(CValue* gameobj,
 	                 void* meshob, bool use_gfx, bool use_phys);
 
@@ -626,6 +687,8 @@ public:
 	KX_PYMETHOD_DOC(KX_Scene, resume);
 	KX_PYMETHOD_DOC(KX_Scene, get);
 	KX_PYMETHOD_DOC(KX_Scene, drawObstacleSimulation);
+	KX_PYMETHOD_DOC(KX_Scene, setObjectPoolSize);
+	KX_PYMETHOD_DOC(KX_Scene, getObjectPoolSize);
 
 
 	/* attributes */
@@ -685,7 +748,74 @@ public:
 	 */
 	struct Scene *GetBlenderScene() { return m_blenderScene; }
 
+	/// Progress of an incremental merge of a scene into another one, see MergeSceneStep.
+	struct MergeState
+	{
+		enum Stage {
+			MERGE_BEGIN = 0,
+			/// Compile the python controllers.
+			MERGE_LOGIC,
+			/// Construct the materials, it compiles the shaders and loads the textures.
+			MERGE_MATERIALS,
+			/// Create the GPU buffers of the display arrays.
+			MERGE_STORAGE,
+			/// Merge the inactive objects.
+			MERGE_INACTIVE_OBJECTS,
+			/// Merge the active objects, one group at a time.
+			MERGE_OBJECTS,
+			MERGE_END,
+			MERGE_FINISHED
+		};
+
+		/** Active objects merged at once: an object hierarchy or all the hierarchies
+		 * using rigid body constraints, their list references are owned by the state.
+		 */
+		struct Group
+		{
+			std::vector<KX_GameObject *> m_rootParents;
+			std::vector<KX_GameObject *> m_objects;
+			bool m_constraints;
+		};
+
+		Stage m_stage;
+		/// Index of the next element to merge in the current stage.
+		unsigned int m_index;
+		/// False if the scenes can't be merged.
+		bool m_success;
+
+		std::vector<KX_GameObject *> m_logicObjects;
+		std::vector<RAS_IPolyMaterial *> m_materials;
+		std::vector<RAS_DisplayArrayBucket *> m_arrayBuckets;
+		std::vector<Group> m_groups;
+
+		/// Number of merged and total elements of all the stages.
+		unsigned int m_numMerged;
+		unsigned int m_numTotal;
+
+		MergeState();
+
+		/// Return the merge progress from 0 to 1.
+		float GetProgress() const;
+	};
+
+	/// Merge all the other scene at once.
 	bool MergeScene(KX_Scene *other);
+	/** Merge the other scene until the end time is reached, the scene can be used between two steps.
+	 * \param state The merge progress, default constructed before the first step.
+	 * \param endtime The time from PIL_check_seconds_timer() at which the step returns.
+	 * \return True when the merge is finished, the state then tells if it succeeded.
+	 */
+	bool MergeSceneStep(KX_Scene *other, MergeState& state, double endtime);
+
+protected:
+	/// Check that the scenes can be merged and gather the elements to merge.
+	bool MergeSceneBegin(KX_Scene *other, MergeState& state);
+	/// Merge a group of active objects and give their list references to this scene.
+	void MergeSceneGroup(KX_Scene *other, MergeState::Group& group);
+	/// Merge the remaining lists, the materials and the event managers.
+	void MergeSceneEnd(KX_Scene *other);
+
+public:
 
 
 	//void PrintStats(int verbose_level) {
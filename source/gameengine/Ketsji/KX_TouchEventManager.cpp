@@ -208,6 +208,7 @@ void KX_TouchEventManager::NextFrame()
 			// Invoke sensor response for each object
 			if (client_info) {
 				for ( sit = client_info->m_sensors.begin(); sit != client_info->m_sensors.end(); ++sit) {
+					(*sit)->SetDirty();
 					static_cast<KX_TouchSensor*>(*sit)->NewHandleCollision(ctrl1, ctrl2, NULL);
 				}
 			}
@@ -218,6 +219,7 @@ void KX_TouchEventManager::NextFrame()
 			KX_GameObject *kxObj2 = KX_GameObject::GetClientObject(client_info);
 			if (client_info) {
 				for ( sit = client_info->m_sensors.begin(); sit != client_info->m_sensors.end(); ++sit) {
+					(*sit)->SetDirty();
 					static_cast<KX_TouchSensor*>(*sit)->NewHandleCollision(ctrl2, ctrl1, NULL);
 				}
 			}
@@ -229,8 +231,7 @@ void KX_TouchEventManager::NextFrame()
 			kxObj2->RunCollisionCallbacks(kxObj1, contactPointList1);
 		}
 
-		for (it.begin();!it.end();++it)
-			(*it)->Activate(m_logicmgr);
+		ActivateSensors();
 
 	RemoveNewCollisions();
 }
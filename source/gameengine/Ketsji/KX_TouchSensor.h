@@ -116,6 +116,11 @@ public:
 	}
 	
 	virtual void EndFrame();
+	virtual bool IsEventDriven()
+	{
+		// triggers only on collisions, and once more when they stop
+		return !m_bTriggered && !m_bLastTriggered;
+	}
 
 	class PHY_IPhysicsController* GetPhysicsController() { return m_physCtrl; }
 
@@ -0,0 +1,227 @@
+/** \file gameengine/Physics/Bullet/CcdCollisionDispatcher.cpp
+ *  \ingroup physbullet
+ */
+/*
+   Bullet Continuous Collision Detection and Physics Library
+   Copyright (c) 2003-2006 Erwin Coumans  http://continuousphysics.com/Bullet/
+
+   This software is provided 'as-is', without any express or implied warranty.
+   In no event will the authors be held liable for any damages arising from the use of this software.
+   Permission is granted to anyone to use this software for any purpose,
+   including commercial applications, and to alter it and redistribute it freely,
+   subject to the following restrictions:
+
+   1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+   2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+   3. This notice may not be removed or altered from any source distribution.
+ */
+
+#include "CcdCollisionDispatcher.h"
+
+#include "BulletCollision/BroadphaseCollision/btOverlappingPairCache.h"
+#include "BulletCollision/CollisionDispatch/btCollisionConfiguration.h"
+#include "BulletCollision/CollisionDispatch/btCollisionObject.h"
+#include "BulletCollision/CollisionDispatch/btConvexConvexAlgorithm.h"
+#include "BulletCollision/CollisionShapes/btCollisionShape.h"
+#include "BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h"
+#include "LinearMath/btPoolAllocator.h"
+
+#include "BLI_task.h"
+
+/* Under this number of pairs the narrowphase is cheaper than the task creation. */
+#define CCD_PARALLEL_PAIRS_MIN 64
+
+/**
+ * Convex-convex algorithm owning its simplex solver, the solver of the
+ * collision configuration is shared by all the algorithms and can't be
+ * used by several threads.
+ */
+class CcdConvexConvexAlgorithm : public btConvexConvexAlgorithm
+{
+private:
+	btVoronoiSimplexSolver m_ownSimplexSolver;
+
+public:
+	CcdConvexConvexAlgorithm(btPersistentManifold *mf, const btCollisionAlgorithmConstructionInfo& ci,
+	                         const btCollisionObjectWrapper *body0Wrap, const btCollisionObjectWrapper *body1Wrap,
+	                         btConvexPenetrationDepthSolver *pdSolver, int numPerturbationIterations,
+	                         int minimumPointsPerturbationThreshold)
+		/* The base class only stores the simplex solver pointer. */
+		:btConvexConvexAlgorithm(mf, ci, body0Wrap, body1Wrap, &m_ownSimplexSolver, pdSolver,
+		                         numPerturbationIterations, minimumPointsPerturbationThreshold)
+	{
+	}
+
+	struct CreateFunc : public btConvexConvexAlgorithm::CreateFunc
+	{
+		CreateFunc(const btConvexConvexAlgorithm::CreateFunc *other)
+			:btConvexConvexAlgorithm::CreateFunc(NULL, other->m_pdSolver)
+		{
+			m_numPerturbationIterations = other->m_numPerturbationIterations;
+			m_minimumPointsPerturbationThreshold = other->m_minimumPointsPerturbationThreshold;
+		}
+
+		virtual btCollisionAlgorithm *CreateCollisionAlgorithm(btCollisionAlgorithmConstructionInfo& ci,
+		                                                       const btCollisionObjectWrapper *body0Wrap,
+		                                                       const btCollisionObjectWrapper *body1Wrap)
+		{
+			void *mem = ci.m_dispatcher1->allocateCollisionAlgorithm(sizeof(CcdConvexConvexAlgorithm));
+			return new(mem) CcdConvexConvexAlgorithm(ci.m_manifold, ci, body0Wrap, body1Wrap, m_pdSolver,
+			                                         m_numPerturbationIterations, m_minimumPointsPerturbationThreshold);
+		}
+	};
+};
+
+/// Return true if the pair can be processed at the same time as other pairs.
+static bool ccd_pair_is_thread_safe(const btBroadphasePair& pair)
+{
+	for (unsigned short i = 0; i < 2; ++i) {
+		const btCollisionObject *colObj = (btCollisionObject *)(i == 0 ? pair.m_pProxy0 : pair.m_pProxy1)->m_clientObject;
+		const int shapeType = colObj->getCollisionShape()->getShapeType();
+		/* Soft bodies append their contacts in the body and GImpact shapes lock their
+		 * triangle data, both are shared between all the pairs of the object. */
+		if (btBroadphaseProxy::isSoftBody(shapeType) || shapeType == GIMPACT_SHAPE_PROXYTYPE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+struct CcdDispatchData
+{
+	CcdCollisionDispatcher *dispatcher;
+	btBroadphasePair **pairs;
+	const btDispatcherInfo *dispatchInfo;
+};
+
+CcdCollisionDispatcher::CcdCollisionDispatcher(btCollisionConfiguration *collisionConfiguration)
+	:btCollisionDispatcher(collisionConfiguration),
+	m_useThreading(false)
+{
+	BLI_spin_init(&m_lock);
+
+	for (int i = 0; i < MAX_BROADPHASE_COLLISION_TYPES; ++i) {
+		for (int j = 0; j < MAX_BROADPHASE_COLLISION_TYPES; ++j) {
+			btConvexConvexAlgorithm::CreateFunc *func =
+				dynamic_cast<btConvexConvexAlgorithm::CreateFunc *>(m_doubleDispatch[i][j]);
+			if (!func) {
+				continue;
+			}
+
+			/* The configuration uses the same function for all the convex shape types. */
+			int index = m_replacedCreateFuncs.findLinearSearch(func);
+			if (index == m_replacedCreateFuncs.size()) {
+				m_replacedCreateFuncs.push_back(func);
+				m_createFuncs.push_back(new CcdConvexConvexAlgorithm::CreateFunc(func));
+			}
+			registerCollisionCreateFunc(i, j, m_createFuncs[index]);
+		}
+	}
+}
+
+CcdCollisionDispatcher::~CcdCollisionDispatcher()
+{
+	for (int i = 0; i < m_createFuncs.size(); ++i) {
+		delete m_createFuncs[i];
+	}
+
+	BLI_spin_end(&m_lock);
+}
+
+void CcdCollisionDispatcher::SetUseThreading(bool useThreading)
+{
+	m_useThreading = useThreading;
+}
+
+bool CcdCollisionDispatcher::GetUseThreading() const
+{
+	return m_useThreading;
+}
+
+btPersistentManifold *CcdCollisionDispatcher::getNewManifold(const btCollisionObject *b0, const btCollisionObject *b1)
+{
+	BLI_spin_lock(&m_lock);
+	btPersistentManifold *manifold = btCollisionDispatcher::getNewManifold(b0, b1);
+	BLI_spin_unlock(&m_lock);
+
+	return manifold;
+}
+
+void CcdCollisionDispatcher::releaseManifold(btPersistentManifold *manifold)
+{
+	BLI_spin_lock(&m_lock);
+	btCollisionDispatcher::releaseManifold(manifold);
+	BLI_spin_unlock(&m_lock);
+}
+
+void *CcdCollisionDispatcher::allocateCollisionAlgorithm(int size)
+{
+	void *mem;
+
+	BLI_spin_lock(&m_lock);
+	/* The pool elements are sized for the Bullet algorithms only. */
+	if (size <= m_collisionAlgorithmPoolAllocator->getElementSize()) {
+		mem = btCollisionDispatcher::allocateCollisionAlgorithm(size);
+	}
+	else {
+		mem = btAlignedAlloc(static_cast<size_t>(size), 16);
+	}
+	BLI_spin_unlock(&m_lock);
+
+	return mem;
+}
+
+void CcdCollisionDispatcher::freeCollisionAlgorithm(void *ptr)
+{
+	BLI_spin_lock(&m_lock);
+	btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+	BLI_spin_unlock(&m_lock);
+}
+
+void CcdCollisionDispatcher::ProcessPairTask(void *userdata, const int index)
+{
+	CcdDispatchData *data = (CcdDispatchData *)userdata;
+	(*data->dispatcher->getNearCallback())(*data->pairs[index], *data->dispatcher, *data->dispatchInfo);
+}
+
+void CcdCollisionDispatcher::dispatchAllCollisionPairs(btOverlappingPairCache *pairCache,
+                                                       const btDispatcherInfo& dispatchInfo, btDispatcher *dispatcher)
+{
+	const int numPairs = pairCache->getNumOverlappingPairs();
+
+	/* Continuous collision detection reduces the time of impact over all the pairs. */
+	if (!m_useThreading || numPairs < CCD_PARALLEL_PAIRS_MIN ||
+	    dispatchInfo.m_dispatchFunc != btDispatcherInfo::DISPATCH_DISCRETE)
+	{
+		btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+		return;
+	}
+
+	btBroadphasePair *pairs = pairCache->getOverlappingPairArrayPtr();
+
+	m_parallelPairs.resize(0);
+	m_serialPairs.resize(0);
+	for (int i = 0; i < numPairs; ++i) {
+		btBroadphasePair *pair = &pairs[i];
+		if (ccd_pair_is_thread_safe(*pair)) {
+			m_parallelPairs.push_back(pair);
+		}
+		else {
+			m_serialPairs.push_back(pair);
+		}
+	}
+
+	if (m_parallelPairs.size() > 0) {
+		CcdDispatchData data;
+		data.dispatcher = this;
+		data.pairs = &m_parallelPairs[0];
+		data.dispatchInfo = &dispatchInfo;
+
+		BLI_task_parallel_range(0, m_parallelPairs.size(), &data, ProcessPairTask,
+		                        m_parallelPairs.size() >= CCD_PARALLEL_PAIRS_MIN);
+	}
+
+	for (int i = 0; i < m_serialPairs.size(); ++i) {
+		(*getNearCallback())(*m_serialPairs[i], *this, dispatchInfo);
+	}
+}
@@ -0,0 +1,85 @@
+/*
+   Bullet Continuous Collision Detection and Physics Library
+   Copyright (c) 2003-2006 Erwin Coumans  http://continuousphysics.com/Bullet/
+
+   This software is provided 'as-is', without any express or implied warranty.
+   In no event will the authors be held liable for any damages arising from the use of this software.
+   Permission is granted to anyone to use this software for any purpose,
+   including commercial applications, and to alter it and redistribute it freely,
+   subject to the following restrictions:
+
+   1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+   2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+   3. This notice may not be removed or altered from any source distribution.
+ */
+
+/** \file CcdCollisionDispatcher.h
+ *  \ingroup physbullet
+ */
+
+#ifndef __CCDCOLLISIONDISPATCHER_H__
+#define __CCDCOLLISIONDISPATCHER_H__
+
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcher.h"
+#include "LinearMath/btAlignedObjectArray.h"
+
+#include "BLI_threads.h"
+
+#ifdef WITH_CXX_GUARDEDALLOC
+#include "MEM_guardedalloc.h"
+#endif
+
+struct btBroadphasePair;
+
+/**
+ * Collision dispatcher able to run the narrowphase of the overlapping pairs on
+ * the blender task scheduler.
+ *
+ * The Bullet version we use only has a single threaded dispatcher, so the shared
+ * states of the narrowphase are made thread safe here:
+ * - The manifolds and collision algorithms allocations are done under a lock.
+ * - The convex-convex algorithms own their simplex solver instead of sharing the
+ *   one of the collision configuration.
+ * - The pairs using soft bodies or GImpact shapes, which modify their shapes while
+ *   colliding, are always processed serially after the parallel ones.
+ */
+class CcdCollisionDispatcher : public btCollisionDispatcher
+{
+private:
+	/// Use the task scheduler to process the pairs.
+	bool m_useThreading;
+	/// Protects the manifold and collision algorithm pools.
+	SpinLock m_lock;
+
+	/// Pairs processed in parallel and pairs processed after, reused every step.
+	btAlignedObjectArray<btBroadphasePair *> m_parallelPairs;
+	btAlignedObjectArray<btBroadphasePair *> m_serialPairs;
+
+	/// Convex-convex algorithm creation functions replacing the ones of the configuration.
+	btAlignedObjectArray<btCollisionAlgorithmCreateFunc *> m_createFuncs;
+	btAlignedObjectArray<btCollisionAlgorithmCreateFunc *> m_replacedCreateFuncs;
+
+	static void ProcessPairTask(void *userdata, const int index);
+
+public:
+	CcdCollisionDispatcher(btCollisionConfiguration *collisionConfiguration);
+	virtual ~CcdCollisionDispatcher();
+
+	void SetUseThreading(bool useThreading);
+	bool GetUseThreading() const;
+
+	virtual btPersistentManifold *getNewManifold(const btCollisionObject *b0, const btCollisionObject *b1);
+	virtual void releaseManifold(btPersistentManifold *manifold);
+
+	virtual void *allocateCollisionAlgorithm(int size);
+	virtual void freeCollisionAlgorithm(void *ptr);
+
+	virtual void dispatchAllCollisionPairs(btOverlappingPairCache *pairCache, const btDispatcherInfo& dispatchInfo,
+	                                       btDispatcher *dispatcher);
+
+#ifdef WITH_CXX_GUARDEDALLOC
+	MEM_CXX_CLASS_ALLOC_FUNCS("GE:CcdCollisionDispatcher")
+#endif
+};
+
+#endif  /* __CCDCOLLISIONDISPATCHER_H__ */
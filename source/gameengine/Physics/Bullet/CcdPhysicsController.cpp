@@ -1290,6 +1290,19 @@ void CcdPhysicsController::Jump()
 
 void CcdPhysicsController::SetActive(bool active)
 {
+	// sensor objects are added by their logic sensor when needed
+	if (m_cci.m_bSensor)
+		return;
+
+	if (active) {
+		m_cci.m_physicsEnv->AddCcdPhysicsController(this);
+		// the body may have been sleeping when it was removed
+		if (!m_object->isStaticOrKinematicObject())
+			m_object->activate(true);
+	}
+	else {
+		m_cci.m_physicsEnv->RemoveCcdPhysicsController(this);
+	}
 }
 
 float CcdPhysicsController::GetLinearDamping() const
@@ -19,6 +19,7 @@
 #include "CcdPhysicsEnvironment.h"
 #include "CcdPhysicsController.h"
 #include "CcdGraphicController.h"
+#include "CcdCollisionDispatcher.h"
 
 #include <algorithm>
 #include "btBulletDynamicsCommon.h"
@@ -53,6 +54,8 @@ extern "C" {
 	#include "BKE_object.h"
 }
 
+#include "BLI_task.h"
+
 #define CCD_CONSTRAINT_DISABLE_LINKED_COLLISION 0x80
 
 #ifdef NEW_BULLET_VEHICLE_SUPPORT
@@ -384,6 +387,7 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling, btDispatcher *
 	m_filterCallback(NULL),
 	m_ghostPairCallback(NULL),
 	m_ownDispatcher(NULL),
+	m_useMultiThreading(false),
 	m_scalingPropagated(false)
 {
 	for (int i = 0; i < PHY_NUM_RESPONSE; i++) {
@@ -395,7 +399,7 @@ CcdPhysicsEnvironment::CcdPhysicsEnvironment(bool useDbvtCulling, btDispatcher *
 	//m_collisionConfiguration->setConvexConvexMultipointIterations();
 
 	if (!dispatcher) {
-		btCollisionDispatcher *disp = new btCollisionDispatcher(m_collisionConfiguration);
+		CcdCollisionDispatcher *disp = new CcdCollisionDispatcher(m_collisionConfiguration);
 		dispatcher = disp;
 		btGImpactCollisionAlgorithm::registerAlgorithm(disp);
 		m_ownDispatcher = dispatcher;
@@ -868,6 +872,17 @@ void CcdPhysicsEnvironment::SetDeactivationTime(float dTime)
 {
 	m_deactivationTime = dTime;
 }
+
+void CcdPhysicsEnvironment::SetUseMultiThreading(bool useMultiThreading)
+{
+	m_useMultiThreading = useMultiThreading;
+
+	// Only our own dispatcher can run the narrowphase in parallel.
+	if (m_ownDispatcher) {
+		static_cast<CcdCollisionDispatcher *>(m_ownDispatcher)->SetUseThreading(useMultiThreading);
+	}
+}
+
 void CcdPhysicsEnvironment::SetDeactivationLinearTreshold(float linTresh)
 {
 	m_linearDeactivationThreshold = linTresh;
@@ -2185,6 +2200,54 @@ bool CcdPhysicsEnvironment::RequestCollisionCallback(PHY_IPhysicsController *ctr
 	return ccdCtrl->Register();
 }
 
+/* Manifold states computed by CallbackTriggers before firing the callbacks. */
+enum {
+	CCD_MANIFOLD_CONTACTS = (1 << 0),
+	CCD_MANIFOLD_CALLBACK = (1 << 1),
+	/* The callback is done from the second object. */
+	CCD_MANIFOLD_CALLBACK_CTRL1 = (1 << 2),
+	CCD_MANIFOLD_NO_RESPONSE = (1 << 3)
+};
+
+struct CcdManifoldStatesData
+{
+	btDispatcher *dispatcher;
+	btPersistentManifold **manifolds;
+	unsigned char *states;
+};
+
+void CcdPhysicsEnvironment::ManifoldStateTask(void *userdata, const int index)
+{
+	CcdManifoldStatesData *data = (CcdManifoldStatesData *)userdata;
+	btPersistentManifold *manifold = data->manifolds[index];
+	unsigned char state = 0;
+
+	if (manifold->getNumContacts()) {
+		state |= CCD_MANIFOLD_CONTACTS;
+
+		const btCollisionObject *ob0 = manifold->getBody0();
+		const btCollisionObject *ob1 = manifold->getBody1();
+
+		//m_internalOwner is set in 'addPhysicsController'
+		CcdPhysicsController *ctrl0 = static_cast<CcdPhysicsController *>(ob0->getUserPointer());
+		CcdPhysicsController *ctrl1 = static_cast<CcdPhysicsController *>(ob1->getUserPointer());
+
+		// Test if one of the controller is registered and use collision callback.
+		if (ctrl0->Registered()) {
+			state |= CCD_MANIFOLD_CALLBACK;
+		}
+		else if (ctrl1->Registered()) {
+			state |= CCD_MANIFOLD_CALLBACK | CCD_MANIFOLD_CALLBACK_CTRL1;
+		}
+
+		if (!data->dispatcher->needsResponse(ob0, ob1)) {
+			state |= CCD_MANIFOLD_NO_RESPONSE;
+		}
+	}
+
+	data->states[index] = state;
+}
+
 void CcdPhysicsEnvironment::CallbackTriggers()
 {
 	bool draw_contact_points = m_debugDrawer && (m_debugDrawer->getDebugMode() & btIDebugDraw::DBG_DrawContactPoints);
@@ -2195,17 +2258,30 @@ void CcdPhysicsEnvironment::CallbackTriggers()
 	//walk over all overlapping pairs, and if one of the involved bodies is registered for trigger callback, perform callback
 	btDispatcher *dispatcher = m_dynamicsWorld->getDispatcher();
 	int numManifolds = dispatcher->getNumManifolds();
+	if (!numManifolds) {
+		return;
+	}
+
+	/* The manifolds needing a callback are gathered first, possibly in parallel,
+	 * the callbacks are then fired in the manifolds order from this thread. */
+	m_manifoldStates.resize(numManifolds);
+
+	CcdManifoldStatesData data;
+	data.dispatcher = dispatcher;
+	data.manifolds = dispatcher->getInternalManifoldPointer();
+	data.states = &m_manifoldStates[0];
+	BLI_task_parallel_range(0, numManifolds, &data, ManifoldStateTask,
+	                        m_useMultiThreading && numManifolds > 256);
+
 	for (int i = 0; i < numManifolds; i++) {
-		bool colliding_ctrl0 = true;
-		btPersistentManifold *manifold = dispatcher->getManifoldByIndexInternal(i);
-		int numContacts = manifold->getNumContacts();
-		if (!numContacts) {
+		const unsigned char state = m_manifoldStates[i];
+		if (!(state & CCD_MANIFOLD_CONTACTS)) {
 			continue;
 		}
 
-		const btRigidBody *rb0 = static_cast<const btRigidBody *>(manifold->getBody0());
-		const btRigidBody *rb1 = static_cast<const btRigidBody *>(manifold->getBody1());
+		btPersistentManifold *manifold = dispatcher->getManifoldByIndexInternal(i);
 		if (draw_contact_points) {
+			int numContacts = manifold->getNumContacts();
 			for (int j = 0; j < numContacts; j++) {
 				btVector3 color(1.0f, 1.0f, 0.0f);
 				const btManifoldPoint& cp = manifold->getContactPoint(j);
@@ -2217,20 +2293,10 @@ void CcdPhysicsEnvironment::CallbackTriggers()
 			}
 		}
 
-		//m_internalOwner is set in 'addPhysicsController'
-		CcdPhysicsController *ctrl0 = static_cast<CcdPhysicsController *>(rb0->getUserPointer());
-		CcdPhysicsController *ctrl1 = static_cast<CcdPhysicsController *>(rb1->getUserPointer());
-		bool usecallback = false;
-
-		// Test if one of the controller is registered and use collision callback.
-		if (ctrl0->Registered())
-			usecallback = true;
-		else if (ctrl1->Registered()) {
-			colliding_ctrl0 = false;
-			usecallback = true;
-		}
-
-		if (usecallback) {
+		if (state & CCD_MANIFOLD_CALLBACK) {
+			CcdPhysicsController *ctrl0 = static_cast<CcdPhysicsController *>(manifold->getBody0()->getUserPointer());
+			CcdPhysicsController *ctrl1 = static_cast<CcdPhysicsController *>(manifold->getBody1()->getUserPointer());
+			bool colliding_ctrl0 = !(state & CCD_MANIFOLD_CALLBACK_CTRL1);
 			const CcdCollData *coll_data = new CcdCollData(manifold);
 
 			m_triggerCallbacks[PHY_OBJECT_RESPONSE](m_triggerCallbacksUserPtrs[PHY_OBJECT_RESPONSE],
@@ -2238,7 +2304,7 @@ void CcdPhysicsEnvironment::CallbackTriggers()
 		}
 		// Bullet does not refresh the manifold contact point for object without contact response
 		// may need to remove this when a newer Bullet version is integrated
-		if (!dispatcher->needsResponse(rb0, rb1)) {
+		if (state & CCD_MANIFOLD_NO_RESPONSE) {
 			// Refresh algorithm fails sometimes when there is penetration
 			// (usuall the case with ghost and sensor objects)
 			// Let's just clear the manifold, in any case, it is recomputed on each frame.
@@ -2839,6 +2905,7 @@ CcdPhysicsEnvironment *CcdPhysicsEnvironment::Create(Scene *blenderscene, bool v
 	ccdPhysEnv->SetDeactivationLinearTreshold(blenderscene->gm.lineardeactthreshold);
 	ccdPhysEnv->SetDeactivationAngularTreshold(blenderscene->gm.angulardeactthreshold);
 	ccdPhysEnv->SetDeactivationTime(blenderscene->gm.deactivationtime);
+	ccdPhysEnv->SetUseMultiThreading((blenderscene->gm.flag & GAME_PHYSICS_MULTITHREADING) != 0);
 
 	if (visualizePhysics)
 		ccdPhysEnv->SetDebugMode(btIDebugDraw::DBG_DrawWireframe | btIDebugDraw::DBG_DrawAabb | btIDebugDraw::DBG_DrawContactPoints | btIDebugDraw::DBG_DrawText | btIDebugDraw::DBG_DrawConstraintLimits | btIDebugDraw::DBG_DrawConstraints);
@@ -94,6 +94,10 @@ protected:
 	float m_angularDeactivationThreshold;
 	float m_contactBreakingThreshold;
 
+	/// Per manifold states used to batch the collision callbacks, see CallbackTriggers.
+	std::vector<unsigned char> m_manifoldStates;
+	static void ManifoldStateTask(void *userdata, const int index);
+
 	void ProcessFhSprings(double curTime, float timeStep);
 
 public:
@@ -115,6 +119,12 @@ public:
 		m_numTimeSubSteps = numTimeSubSteps;
 	}
 	virtual void SetDeactivationTime(float dTime);
+	/// Run the collision detection and the collision callbacks gathering on the task scheduler.
+	void SetUseMultiThreading(bool useMultiThreading);
+	bool GetUseMultiThreading() const
+	{
+		return m_useMultiThreading;
+	}
 	virtual void SetDeactivationLinearTreshold(float linTresh);
 	virtual void SetDeactivationAngularTreshold(float angTresh);
 	virtual void SetContactBreakingTreshold(float contactBreakingTreshold);
@@ -325,6 +335,8 @@ protected:
 
 	class btDispatcher *m_ownDispatcher;
 
+	bool m_useMultiThreading;
+
 	bool m_scalingPropagated;
 
 	virtual void ExportFile(const char *filename);
@@ -101,6 +101,7 @@ public:
 	virtual void SuspendDynamics(bool ghost = false) = 0;
 	virtual void RestoreDynamics() = 0;
 
+	/// Add or remove the controller from the physics world while keeping it alive.
 	virtual void SetActive(bool active) = 0;
 
 	// reading out information from physics
@@ -172,6 +172,12 @@ public:
 	 */
 	virtual void SetDepthMask(DepthMask depthmask) = 0;
 
+	/**
+	 * Returns false when the rasterizer runs without any OpenGL context
+	 * (e.g. headless player), in this case no GPU resources must be created.
+	 */
+	virtual bool HasGraphicContext() const = 0;
+
 	/**
 	 * Init initializes the renderer.
 	 */
@@ -266,6 +272,9 @@ public:
 	 */
 	virtual void IndexPrimitivesInstancing(RAS_DisplayArrayBucket *arrayBucket) = 0;
 
+	/// Create the storage of the display array bucket ahead of its first render, e.g the VBO.
+	virtual void PrepareStorage(RAS_DisplayArrayBucket *arrayBucket) = 0;
+
 	/**
 	 * IndexPrimitives_3DText will render text into the polygons.
 	 */
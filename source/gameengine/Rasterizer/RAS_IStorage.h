@@ -75,6 +75,10 @@ public:
 	{
 	}
 
+	virtual void PrepareStorage(RAS_DisplayArrayBucket *arrayBucket)
+	{
+	}
+
 	virtual void SetDrawingMode(RAS_IRasterizer::DrawType drawingmode) = 0;
 
 #ifdef WITH_CXX_GUARDEDALLOC
@@ -0,0 +1,294 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file gameengine/Rasterizer/RAS_NullRasterizer.cpp
+ *  \ingroup bgerast
+ */
+
+#include "RAS_NullRasterizer.h"
+
+#include <string.h>
+#include <iostream>
+
+RAS_NullRasterizer::RAS_NullRasterizer(RAS_ICanvas *canvas)
+	:RAS_IRasterizer(canvas),
+	m_time(0.0),
+	m_campos(0.0f, 0.0f, 0.0f),
+	m_camortho(false),
+	m_stereomode(RAS_STEREO_NOSTEREO),
+	m_curreye(RAS_STEREO_LEFTEYE),
+	m_eyeseparation(0.0f),
+	m_focallength(0.0f),
+	m_drawingmode(RAS_TEXTURED),
+	m_shadowmode(RAS_SHADOW_NONE),
+	m_overrideShader(RAS_OVERRIDE_SHADER_NONE),
+	m_mipmap(RAS_MIPMAP_NONE),
+	m_anisotropic(1),
+	m_motionblur(0),
+	m_motionblurvalue(-1.0f)
+{
+	m_viewmatrix.setIdentity();
+	m_viewinvmatrix.setIdentity();
+}
+
+RAS_NullRasterizer::~RAS_NullRasterizer()
+{
+}
+
+bool RAS_NullRasterizer::BeginFrame(double time)
+{
+	m_time = time;
+	return true;
+}
+
+void RAS_NullRasterizer::SetStereoMode(const StereoMode stereomode)
+{
+	m_stereomode = stereomode;
+}
+
+bool RAS_NullRasterizer::Stereo()
+{
+	/* Nothing is rendered, eyes never need to be separated. */
+	return false;
+}
+
+RAS_IRasterizer::StereoMode RAS_NullRasterizer::GetStereoMode()
+{
+	return m_stereomode;
+}
+
+bool RAS_NullRasterizer::InterlacedStereo()
+{
+	return false;
+}
+
+void RAS_NullRasterizer::SetEye(const StereoEye eye)
+{
+	m_curreye = eye;
+}
+
+RAS_IRasterizer::StereoEye RAS_NullRasterizer::GetEye()
+{
+	return m_curreye;
+}
+
+void RAS_NullRasterizer::SetEyeSeparation(const float eyeseparation)
+{
+	m_eyeseparation = eyeseparation;
+}
+
+float RAS_NullRasterizer::GetEyeSeparation()
+{
+	return m_eyeseparation;
+}
+
+void RAS_NullRasterizer::SetFocalLength(const float focallength)
+{
+	m_focallength = focallength;
+}
+
+float RAS_NullRasterizer::GetFocalLength()
+{
+	return m_focallength;
+}
+
+void RAS_NullRasterizer::SetProjectionMatrix(MT_CmMatrix4x4 &mat)
+{
+	m_camortho = (mat(3, 3) != 0.0f);
+}
+
+void RAS_NullRasterizer::SetProjectionMatrix(const MT_Matrix4x4 &mat)
+{
+	m_camortho = (mat[3][3] != 0.0f);
+}
+
+void RAS_NullRasterizer::SetViewMatrix(const MT_Matrix4x4 &mat, const MT_Matrix3x3 &ori,
+                                       const MT_Vector3 &pos, bool perspective)
+{
+	m_viewmatrix = mat;
+	m_viewinvmatrix = m_viewmatrix;
+	m_viewinvmatrix.invert();
+	m_campos = pos;
+}
+
+const MT_Vector3& RAS_NullRasterizer::GetCameraPosition()
+{
+	return m_campos;
+}
+
+bool RAS_NullRasterizer::GetCameraOrtho()
+{
+	return m_camortho;
+}
+
+void RAS_NullRasterizer::SetDrawingMode(DrawType drawingmode)
+{
+	m_drawingmode = drawingmode;
+}
+
+RAS_IRasterizer::DrawType RAS_NullRasterizer::GetDrawingMode()
+{
+	return m_drawingmode;
+}
+
+void RAS_NullRasterizer::SetShadowMode(ShadowType shadowmode)
+{
+	m_shadowmode = shadowmode;
+}
+
+RAS_IRasterizer::ShadowType RAS_NullRasterizer::GetShadowMode()
+{
+	return m_shadowmode;
+}
+
+double RAS_NullRasterizer::GetTime()
+{
+	return m_time;
+}
+
+/* Same matrices as glFrustum and glOrtho, computed without OpenGL. */
+MT_Matrix4x4 RAS_NullRasterizer::GetFrustumMatrix(
+    float left,
+    float right,
+    float bottom,
+    float top,
+    float frustnear,
+    float frustfar,
+    float focallength,
+    bool perspective)
+{
+	MT_Matrix4x4 result;
+	result.setIdentity();
+
+	result[0][0] = 2.0f * frustnear / (right - left);
+	result[0][2] = (right + left) / (right - left);
+	result[1][1] = 2.0f * frustnear / (top - bottom);
+	result[1][2] = (top + bottom) / (top - bottom);
+	result[2][2] = -(frustfar + frustnear) / (frustfar - frustnear);
+	result[2][3] = -2.0f * frustfar * frustnear / (frustfar - frustnear);
+	result[3][2] = -1.0f;
+	result[3][3] = 0.0f;
+
+	return result;
+}
+
+MT_Matrix4x4 RAS_NullRasterizer::GetOrthoMatrix(
+    float left,
+    float right,
+    float bottom,
+    float top,
+    float frustnear,
+    float frustfar)
+{
+	MT_Matrix4x4 result;
+	result.setIdentity();
+
+	result[0][0] = 2.0f / (right - left);
+	result[0][3] = -(right + left) / (right - left);
+	result[1][1] = 2.0f / (top - bottom);
+	result[1][3] = -(top + bottom) / (top - bottom);
+	result[2][2] = -2.0f / (frustfar - frustnear);
+	result[2][3] = -(frustfar + frustnear) / (frustfar - frustnear);
+
+	return result;
+}
+
+const MT_Matrix4x4 &RAS_NullRasterizer::GetViewMatrix() const
+{
+	return m_viewmatrix;
+}
+
+const MT_Matrix4x4 &RAS_NullRasterizer::GetViewInvMatrix() const
+{
+	return m_viewinvmatrix;
+}
+
+void RAS_NullRasterizer::EnableMotionBlur(float motionblurvalue)
+{
+	m_motionblur = 1;
+	m_motionblurvalue = motionblurvalue;
+}
+
+void RAS_NullRasterizer::DisableMotionBlur()
+{
+	m_motionblur = 0;
+	m_motionblurvalue = -1.0f;
+}
+
+float RAS_NullRasterizer::GetMotionBlurValue()
+{
+	return m_motionblurvalue;
+}
+
+int RAS_NullRasterizer::GetMotionBlurState()
+{
+	return m_motionblur;
+}
+
+void RAS_NullRasterizer::SetMotionBlurState(int newstate)
+{
+	m_motionblur = newstate;
+}
+
+void RAS_NullRasterizer::SetAnisotropicFiltering(short level)
+{
+	m_anisotropic = level;
+}
+
+short RAS_NullRasterizer::GetAnisotropicFiltering()
+{
+	return m_anisotropic;
+}
+
+void RAS_NullRasterizer::SetMipmapping(MipmapOption val)
+{
+	m_mipmap = val;
+}
+
+RAS_IRasterizer::MipmapOption RAS_NullRasterizer::GetMipmapping()
+{
+	return m_mipmap;
+}
+
+void RAS_NullRasterizer::SetOverrideShader(OverrideShaderType type)
+{
+	m_overrideShader = type;
+}
+
+RAS_IRasterizer::OverrideShaderType RAS_NullRasterizer::GetOverrideShader()
+{
+	return m_overrideShader;
+}
+
+void RAS_NullRasterizer::GetTransform(float *origmat, int objectdrawmode, float mat[16])
+{
+	/* Billboards and shadow objects are only drawing features, keep the object matrix. */
+	memcpy(mat, origmat, sizeof(float) * 16);
+}
+
+RAS_ILightObject *RAS_NullRasterizer::CreateLight()
+{
+	return new RAS_NullLight();
+}
+
+void RAS_NullRasterizer::PrintHardwareInfo()
+{
+	std::cout << "Null rasterizer: no graphic context, nothing is rendered." << std::endl;
+}
@@ -0,0 +1,259 @@
+/*
+ * ***** BEGIN GPL LICENSE BLOCK *****
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ *
+ * ***** END GPL LICENSE BLOCK *****
+ */
+
+/** \file RAS_NullRasterizer.h
+ *  \ingroup bgerast
+ */
+
+#ifndef __RAS_NULLRASTERIZER_H__
+#define __RAS_NULLRASTERIZER_H__
+
+#include "RAS_IRasterizer.h"
+#include "RAS_ILightObject.h"
+
+#include "MT_Matrix4x4.h"
+#include "MT_Vector3.h"
+
+/**
+ * Light object without any GPU resources, used by the null rasterizer.
+ */
+class RAS_NullLight : public RAS_ILightObject
+{
+public:
+	virtual RAS_ILightObject *Clone()
+	{
+		return new RAS_NullLight(*this);
+	}
+
+	virtual bool HasShadowBuffer()
+	{
+		return false;
+	}
+	virtual bool NeedShadowUpdate()
+	{
+		return false;
+	}
+	virtual int GetShadowBindCode()
+	{
+		return -1;
+	}
+	virtual MT_Matrix4x4 GetShadowMatrix()
+	{
+		MT_Matrix4x4 mat;
+		mat.setIdentity();
+		return mat;
+	}
+	virtual int GetShadowLayer()
+	{
+		return 0;
+	}
+	virtual void BindShadowBuffer(RAS_ICanvas *canvas, KX_Camera *cam, MT_Transform& camtrans) {}
+	virtual void UnbindShadowBuffer() {}
+	virtual Image *GetTextureImage(short texslot)
+	{
+		return NULL;
+	}
+	virtual void Update() {}
+
+#ifdef WITH_CXX_GUARDEDALLOC
+	MEM_CXX_CLASS_ALLOC_FUNCS("GE:RAS_NullLight")
+#endif
+};
+
+/**
+ * Rasterizer doing no drawing at all and never touching OpenGL.
+ * It is used to run the game logic, physics and animations without
+ * any graphic context, e.g for headless simulations and benchmarks.
+ * Only the state queried by the game logic (matrices, camera, stereo
+ * and texture settings) is kept.
+ */
+class RAS_NullRasterizer : public RAS_IRasterizer
+{
+private:
+	double m_time;
+	MT_Matrix4x4 m_viewmatrix;
+	MT_Matrix4x4 m_viewinvmatrix;
+	MT_Vector3 m_campos;
+	bool m_camortho;
+
+	StereoMode m_stereomode;
+	StereoEye m_curreye;
+	float m_eyeseparation;
+	float m_focallength;
+
+	DrawType m_drawingmode;
+	ShadowType m_shadowmode;
+	OverrideShaderType m_overrideShader;
+	MipmapOption m_mipmap;
+	short m_anisotropic;
+	int m_motionblur;
+	float m_motionblurvalue;
+
+public:
+	RAS_NullRasterizer(RAS_ICanvas *canvas);
+	virtual ~RAS_NullRasterizer();
+
+	virtual bool HasGraphicContext() const
+	{
+		return false;
+	}
+
+	virtual void SetDepthMask(DepthMask depthmask) {}
+	virtual bool Init()
+	{
+		return true;
+	}
+	virtual void Exit() {}
+	virtual void RenderBackground() {}
+	virtual bool BeginFrame(double time);
+	virtual void ClearColorBuffer() {}
+	virtual void ClearDepthBuffer() {}
+	virtual void EndFrame() {}
+	virtual void SetRenderArea() {}
+
+	virtual void SetStereoMode(const StereoMode stereomode);
+	virtual bool Stereo();
+	virtual StereoMode GetStereoMode();
+	virtual bool InterlacedStereo();
+	virtual void SetEye(const StereoEye eye);
+	virtual StereoEye GetEye();
+	virtual void SetEyeSeparation(const float eyeseparation);
+	virtual float GetEyeSeparation();
+	virtual void SetFocalLength(const float focallength);
+	virtual float GetFocalLength();
+
+	virtual void SwapBuffers() {}
+
+	virtual void BindPrimitives(RAS_DisplayArrayBucket *arrayBucket) {}
+	virtual void UnbindPrimitives(RAS_DisplayArrayBucket *arrayBucket) {}
+	virtual void IndexPrimitives(RAS_MeshSlot *ms) {}
+	virtual void IndexPrimitivesInstancing(RAS_DisplayArrayBucket *arrayBucket) {}
+	virtual void PrepareStorage(RAS_DisplayArrayBucket *arrayBucket) {}
+	virtual void IndexPrimitives_3DText(RAS_MeshSlot *ms, RAS_IPolyMaterial *polymat) {}
+
+	virtual void SetProjectionMatrix(MT_CmMatrix4x4 &mat);
+	virtual void SetProjectionMatrix(const MT_Matrix4x4 &mat);
+	virtual void SetViewMatrix(const MT_Matrix4x4 &mat, const MT_Matrix3x3 &ori,
+	                           const MT_Vector3 &pos, bool perspective);
+	virtual const MT_Vector3& GetCameraPosition();
+	virtual bool GetCameraOrtho();
+
+	virtual void SetFog(short type, float start, float dist, float intensity, float color[3]) {}
+	virtual void DisplayFog() {}
+	virtual void EnableFog(bool enable) {}
+
+	virtual void SetDrawingMode(DrawType drawingmode);
+	virtual DrawType GetDrawingMode();
+	virtual void SetShadowMode(ShadowType shadowmode);
+	virtual ShadowType GetShadowMode();
+
+	virtual void SetCullFace(bool enable) {}
+	virtual void SetLines(bool enable) {}
+
+	virtual double GetTime();
+
+	virtual MT_Matrix4x4 GetFrustumMatrix(
+	        float left, float right, float bottom, float top,
+	        float frustnear, float frustfar,
+	        float focallength = 0.0f, bool perspective = true);
+	virtual MT_Matrix4x4 GetOrthoMatrix(
+	        float left, float right, float bottom, float top,
+	        float frustnear, float frustfar);
+
+	virtual void SetSpecularity(float specX, float specY, float specZ, float specval) {}
+	virtual void SetShinyness(float shiny) {}
+	virtual void SetDiffuse(float difX, float difY, float difZ, float diffuse) {}
+	virtual void SetEmissive(float eX, float eY, float eZ, float e) {}
+	virtual void SetAmbientColor(float color[3]) {}
+	virtual void SetAmbient(float factor) {}
+	virtual void SetPolygonOffset(float mult, float add) {}
+
+	virtual void DrawDebugLine(SCA_IScene *scene, const MT_Vector3 &from, const MT_Vector3 &to, const MT_Vector3& color) {}
+	virtual void DrawDebugCircle(SCA_IScene *scene, const MT_Vector3 &center, const MT_Scalar radius,
+	                             const MT_Vector3 &color, const MT_Vector3 &normal, int nsector) {}
+	virtual void DrawDebugBox(SCA_IScene *scene, const MT_Vector3& pos, const MT_Matrix3x3& rot,
+	                          const MT_Vector3& min, const MT_Vector3& max, const MT_Vector3& color) {}
+	virtual void FlushDebugShapes(SCA_IScene *scene) {}
+
+	virtual void SetTexCoordNum(int num) {}
+	virtual void SetAttribNum(int num) {}
+	virtual void SetTexCoord(TexCoGen coords, int unit) {}
+	virtual void SetAttrib(TexCoGen coords, int unit, int layer = 0) {}
+
+	virtual const MT_Matrix4x4 &GetViewMatrix() const;
+	virtual const MT_Matrix4x4 &GetViewInvMatrix() const;
+
+	virtual bool UseDisplayLists() const
+	{
+		return false;
+	}
+
+	virtual void EnableMotionBlur(float motionblurvalue);
+	virtual void DisableMotionBlur();
+	virtual float GetMotionBlurValue();
+	virtual int GetMotionBlurState();
+	virtual void SetMotionBlurState(int newstate);
+
+	virtual void SetAlphaBlend(int alphablend) {}
+	virtual void SetFrontFace(bool ccw) {}
+
+	virtual void SetAnisotropicFiltering(short level);
+	virtual short GetAnisotropicFiltering();
+	virtual void SetMipmapping(MipmapOption val);
+	virtual MipmapOption GetMipmapping();
+
+	virtual void SetOverrideShader(OverrideShaderType type);
+	virtual OverrideShaderType GetOverrideShader();
+	virtual void ActivateOverrideShaderInstancing(void *matrixoffset, void *positionoffset, unsigned int stride) {}
+	virtual void DesactivateOverrideShaderInstancing() {}
+
+	virtual void GetTransform(float *origmat, int objectdrawmode, float mat[16]);
+	virtual void ApplyTransform(const float mat[16]) {}
+
+	virtual void RenderBox2D(int xco, int yco, int width, int height, float percentage) {}
+	virtual void RenderText3D(
+	        int fontid, const char *text, int size, int dpi,
+	        const float color[4], const float mat[16], float aspect) {}
+	virtual void RenderText2D(
+	        RAS_TEXT_RENDER_MODE mode, const char *text,
+	        int xco, int yco, int width, int height) {}
+
+	virtual void ProcessLighting(bool uselights, const MT_Transform &trans) {}
+
+	virtual void PushMatrix() {}
+	virtual void PopMatrix() {}
+
+	virtual RAS_ILightObject *CreateLight();
+	virtual void AddLight(RAS_ILightObject *lightobject) {}
+	virtual void RemoveLight(RAS_ILightObject *lightobject) {}
+
+	virtual void MotionBlur() {}
+
+	virtual void SetClientObject(void *obj) {}
+	virtual void SetAuxilaryClientInfo(void *inf) {}
+
+	virtual void PrintHardwareInfo();
+
+#ifdef WITH_CXX_GUARDEDALLOC
+	MEM_CXX_CLASS_ALLOC_FUNCS("GE:RAS_NullRasterizer")
+#endif
+};
+
+#endif  /* __RAS_NULLRASTERIZER_H__ */
@@ -791,6 +791,14 @@ void RAS_OpenGLRasterizer::IndexPrimitivesInstancing(RAS_DisplayArrayBucket *arr
 	m_storage->IndexPrimitivesInstancing(arrayBucket);
 }
 
+void RAS_OpenGLRasterizer::PrepareStorage(RAS_DisplayArrayBucket *arrayBucket)
+{
+	// No display array means the mesh is drawn from a derived mesh.
+	if (arrayBucket && arrayBucket->GetDisplayArray()) {
+		m_storage->PrepareStorage(arrayBucket);
+	}
+}
+
 
 // Code for hooking into Blender's mesh drawing for derived meshes.
 // If/when we use more of Blender's drawing code, we may be able to
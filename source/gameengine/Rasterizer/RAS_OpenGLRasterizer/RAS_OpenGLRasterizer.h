@@ -160,6 +160,11 @@ public:
 
 	virtual void SetDepthMask(DepthMask depthmask);
 
+	virtual bool HasGraphicContext() const
+	{
+		return true;
+	}
+
 	virtual bool Init();
 	virtual void Exit();
 	virtual void RenderBackground();
@@ -186,6 +191,7 @@ public:
 	virtual void UnbindPrimitives(RAS_DisplayArrayBucket *arrayBucket);
 	virtual void IndexPrimitives(class RAS_MeshSlot *ms);
 	virtual void IndexPrimitivesInstancing(RAS_DisplayArrayBucket *arrayBucket);
+	virtual void PrepareStorage(RAS_DisplayArrayBucket *arrayBucket);
 	virtual void IndexPrimitives_3DText(class RAS_MeshSlot *ms, class RAS_IPolyMaterial *polymat);
 	virtual void DrawDerivedMesh(class RAS_MeshSlot *ms);
 
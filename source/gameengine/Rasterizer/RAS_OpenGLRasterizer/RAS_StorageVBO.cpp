@@ -239,6 +239,15 @@ VBO *RAS_StorageVBO::GetVBO(RAS_DisplayArrayBucket *arrayBucket)
 	return vbo;
 }
 
+void RAS_StorageVBO::PrepareStorage(RAS_DisplayArrayBucket *arrayBucket)
+{
+	GetVBO(arrayBucket);
+
+	// The buffers are left bound by their creation.
+	glBindBufferARB(GL_ARRAY_BUFFER_ARB, 0);
+	glBindBufferARB(GL_ELEMENT_ARRAY_BUFFER_ARB, 0);
+}
+
 void RAS_StorageVBO::BindPrimitives(RAS_DisplayArrayBucket *arrayBucket)
 {
 	VBO *vbo = GetVBO(arrayBucket);
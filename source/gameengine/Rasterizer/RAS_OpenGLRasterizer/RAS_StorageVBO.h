@@ -79,6 +79,7 @@ public:
 	virtual void UnbindPrimitives(RAS_DisplayArrayBucket *arrayBucket);
 	virtual void IndexPrimitives(RAS_MeshSlot *ms);
 	virtual void IndexPrimitivesInstancing(RAS_DisplayArrayBucket *arrayBucket);
+	virtual void PrepareStorage(RAS_DisplayArrayBucket *arrayBucket);
 
 	virtual void SetDrawingMode(RAS_IRasterizer::DrawType drawingmode)
 	{
@@ -0,0 +1,172 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "BLI_rand.h"
+#include "BLI_mempool.h"
+#include "DNA_customdata_types.h"
+#include "DNA_meshdata_types.h"
+#include "BKE_customdata.h"
+#include "bmesh_class.h"
+}
+
+#define SOURCE_NUM 16
+#define DEST_NUM 64
+#define INTERP_NUM 4
+
+static void customdata_init(CustomData *data, int totelem, RNG *rng)
+{
+	memset(data, 0, sizeof(*data));
+	CustomData_add_layer(data, CD_BWEIGHT, CD_CALLOC, NULL, totelem);
+	CustomData_add_layer(data, CD_SHAPEKEY, CD_CALLOC, NULL, totelem);
+	CustomData_add_layer(data, CD_MLOOPUV, CD_CALLOC, NULL, totelem);
+	CustomData_add_layer(data, CD_MLOOPCOL, CD_CALLOC, NULL, totelem);
+
+	if (rng) {
+		float *bweight = (float *)CustomData_get_layer(data, CD_BWEIGHT);
+		float (*shapekey)[3] = (float (*)[3])CustomData_get_layer(data, CD_SHAPEKEY);
+		MLoopUV *mloopuv = (MLoopUV *)CustomData_get_layer(data, CD_MLOOPUV);
+		MLoopCol *mloopcol = (MLoopCol *)CustomData_get_layer(data, CD_MLOOPCOL);
+
+		for (int i = 0; i < totelem; i++) {
+			bweight[i] = BLI_rng_get_float(rng);
+			for (int j = 0; j < 3; j++) {
+				shapekey[i][j] = BLI_rng_get_float(rng);
+			}
+			mloopuv[i].uv[0] = BLI_rng_get_float(rng);
+			mloopuv[i].uv[1] = BLI_rng_get_float(rng);
+			mloopuv[i].flag = BLI_rng_get_int(rng) & MLOOPUV_VERTSEL;
+			mloopcol[i].r = (unsigned char)BLI_rng_get_int(rng);
+			mloopcol[i].g = (unsigned char)BLI_rng_get_int(rng);
+			mloopcol[i].b = (unsigned char)BLI_rng_get_int(rng);
+			mloopcol[i].a = (unsigned char)BLI_rng_get_int(rng);
+		}
+	}
+}
+
+static void customdata_expect_eq(CustomData *a, CustomData *b, int totelem)
+{
+	const float *bweight_a = (float *)CustomData_get_layer(a, CD_BWEIGHT);
+	const float *bweight_b = (float *)CustomData_get_layer(b, CD_BWEIGHT);
+	const float (*shapekey_a)[3] = (float (*)[3])CustomData_get_layer(a, CD_SHAPEKEY);
+	const float (*shapekey_b)[3] = (float (*)[3])CustomData_get_layer(b, CD_SHAPEKEY);
+	const MLoopUV *mloopuv_a = (MLoopUV *)CustomData_get_layer(a, CD_MLOOPUV);
+	const MLoopUV *mloopuv_b = (MLoopUV *)CustomData_get_layer(b, CD_MLOOPUV);
+	const MLoopCol *mloopcol_a = (MLoopCol *)CustomData_get_layer(a, CD_MLOOPCOL);
+	const MLoopCol *mloopcol_b = (MLoopCol *)CustomData_get_layer(b, CD_MLOOPCOL);
+
+	for (int i = 0; i < totelem; i++) {
+		EXPECT_EQ(bweight_a[i], bweight_b[i]);
+		for (int j = 0; j < 3; j++) {
+			EXPECT_EQ(shapekey_a[i][j], shapekey_b[i][j]);
+		}
+		EXPECT_EQ(mloopuv_a[i].uv[0], mloopuv_b[i].uv[0]);
+		EXPECT_EQ(mloopuv_a[i].uv[1], mloopuv_b[i].uv[1]);
+		EXPECT_EQ(mloopuv_a[i].flag, mloopuv_b[i].flag);
+		EXPECT_EQ(0, memcmp(&mloopcol_a[i], &mloopcol_b[i], sizeof(MLoopCol)));
+	}
+}
+
+/* The range version must give the same results as interpolating each element. */
+TEST(customdata, InterpRange)
+{
+	CustomData source, dest, dest_ref;
+	RNG *rng = BLI_rng_new(0);
+	int src_indices[INTERP_NUM] = {3, 7, 0, 12};
+	float weights[DEST_NUM][INTERP_NUM];
+
+	customdata_init(&source, SOURCE_NUM, rng);
+	customdata_init(&dest, DEST_NUM, NULL);
+	customdata_init(&dest_ref, DEST_NUM, NULL);
+
+	for (int i = 0; i < DEST_NUM; i++) {
+		for (int j = 0; j < INTERP_NUM; j++) {
+			/* include some zero weights, they don't contribute to the UV flag */
+			weights[i][j] = (i + j) % 3 ? BLI_rng_get_float(rng) : 0.0f;
+		}
+		CustomData_interp(&source, &dest_ref, src_indices, weights[i], NULL, INTERP_NUM, i);
+	}
+
+	CustomData_interp_range(&source, &dest, src_indices, &weights[0][0], INTERP_NUM, 0, DEST_NUM);
+
+	customdata_expect_eq(&dest, &dest_ref, DEST_NUM);
+
+	CustomData_free(&source, SOURCE_NUM);
+	CustomData_free(&dest, DEST_NUM);
+	CustomData_free(&dest_ref, DEST_NUM);
+	BLI_rng_free(rng);
+}
+
+TEST(customdata, CopyDataIndices)
+{
+	CustomData source, dest, dest_ref;
+	RNG *rng = BLI_rng_new(0);
+	int src_indices[DEST_NUM];
+
+	customdata_init(&source, SOURCE_NUM, rng);
+	customdata_init(&dest, DEST_NUM, NULL);
+	customdata_init(&dest_ref, DEST_NUM, NULL);
+
+	for (int i = 0; i < DEST_NUM; i++) {
+		src_indices[i] = BLI_rng_get_int(rng) % SOURCE_NUM;
+		CustomData_copy_data(&source, &dest_ref, src_indices[i], i, 1);
+	}
+
+	CustomData_copy_data_indices(&source, &dest, src_indices, 0, DEST_NUM);
+
+	customdata_expect_eq(&dest, &dest_ref, DEST_NUM);
+
+	CustomData_free(&source, SOURCE_NUM);
+	CustomData_free(&dest, DEST_NUM);
+	CustomData_free(&dest_ref, DEST_NUM);
+	BLI_rng_free(rng);
+}
+
+/* The range versions must give the same blocks and elements as converting each element. */
+TEST(customdata, BMeshBlockRange)
+{
+	CustomData source, bdata, dest, dest_ref;
+	RNG *rng = BLI_rng_new(0);
+	void *blocks[SOURCE_NUM] = {NULL}, *blocks_ref[SOURCE_NUM] = {NULL};
+
+	customdata_init(&source, SOURCE_NUM, rng);
+	customdata_init(&dest, DEST_NUM, NULL);
+	customdata_init(&dest_ref, DEST_NUM, NULL);
+
+	memset(&bdata, 0, sizeof(bdata));
+	CustomData_copy(&source, &bdata, CD_MASK_BMESH, CD_CALLOC, 0);
+	/* without source layer, set to its default value */
+	CustomData_add_layer(&bdata, CD_MLOOPCOL, CD_CALLOC, NULL, 0);
+	CustomData_bmesh_init_pool(&bdata, SOURCE_NUM * 2, BM_LOOP);
+
+	for (int i = 0; i < SOURCE_NUM; i++) {
+		CustomData_to_bmesh_block(&source, &bdata, i, &blocks_ref[i], true);
+		CustomData_bmesh_alloc_block(&bdata, &blocks[i]);
+	}
+	CustomData_to_bmesh_block_range(&source, &bdata, 0, blocks, SOURCE_NUM, true);
+
+	for (int i = 0; i < SOURCE_NUM; i++) {
+		EXPECT_EQ(0, memcmp(blocks[i], blocks_ref[i], bdata.totsize));
+	}
+
+	for (int i = 0; i < SOURCE_NUM; i++) {
+		CustomData_from_bmesh_block(&bdata, &dest_ref, blocks_ref[i], i + 3);
+	}
+	CustomData_from_bmesh_block_range(&bdata, &dest, blocks, 3, SOURCE_NUM);
+
+	customdata_expect_eq(&dest, &dest_ref, DEST_NUM);
+
+	for (int i = 0; i < SOURCE_NUM; i++) {
+		CustomData_bmesh_free_block(&bdata, &blocks[i]);
+		CustomData_bmesh_free_block(&bdata, &blocks_ref[i]);
+	}
+	BLI_mempool_destroy(bdata.pool);
+	CustomData_free(&bdata, 0);
+	CustomData_free(&source, SOURCE_NUM);
+	CustomData_free(&dest, DEST_NUM);
+	CustomData_free(&dest_ref, DEST_NUM);
+	BLI_rng_free(rng);
+}
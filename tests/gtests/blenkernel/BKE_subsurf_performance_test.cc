@@ -0,0 +1,90 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+#include "testing/testing_common.h"
+
+#include <string.h>
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "BLI_rand.h"
+#include "DNA_modifier_types.h"
+#include "BKE_cdderivedmesh.h"
+#include "BKE_DerivedMesh.h"
+#include "BKE_subsurf.h"
+#include "PIL_time.h"
+}
+
+/* Grid of 317 x 317 quads, a bit more than 100k faces. */
+#define GRID_SIZE 317
+
+static DerivedMesh *grid_new(void)
+{
+	const int totvert = (GRID_SIZE + 1) * (GRID_SIZE + 1);
+	const int totpoly = GRID_SIZE * GRID_SIZE;
+	DerivedMesh *dm = CDDM_new(totvert, 0, 0, totpoly * 4, totpoly);
+	MVert *mvert = dm->getVertArray(dm);
+	RNG *rng = BLI_rng_new(0);
+
+	testing_grid_fill(mvert, dm->getLoopArray(dm), dm->getPolyArray(dm), GRID_SIZE, 0);
+
+	/* some noise on the height, so the normals are not all the same */
+	for (int i = 0; i < totvert; i++) {
+		mvert[i].co[2] = BLI_rng_get_float(rng);
+	}
+
+	BLI_rng_free(rng);
+
+	CDDM_calc_edges(dm);
+
+	return dm;
+}
+
+/* Time and output rate of a single subdivision, the grid is large enough for all levels
+ * to use the threaded loops. */
+static void subsurf_benchmark(int levels)
+{
+	DerivedMesh *dm = grid_new();
+	SubsurfModifierData smd;
+
+	memset(&smd, 0, sizeof(smd));
+	smd.levels = levels;
+	smd.subdivType = ME_CC_SUBSURF;
+
+	const double start = PIL_check_seconds_timer();
+	DerivedMesh *result = subsurf_make_derived_from_derived(dm, &smd, NULL, (SubsurfFlags)0);
+	const double time = PIL_check_seconds_timer() - start;
+
+	/* every quad is split in (2 ^ levels) x (2 ^ levels) quads */
+	const int size = GRID_SIZE * (1 << levels);
+	EXPECT_EQ((size + 1) * (size + 1), result->getNumVerts(result));
+
+	printf("level %d, %d faces: %.2f ms, %.1f Mfaces/s\n",
+	       levels, size * size, time * 1000.0, (double)size * size / time * 1e-6);
+
+	result->release(result);
+	dm->release(dm);
+}
+
+class subsurf : public ThreadapiTest {};
+
+TEST_F(subsurf, level1)
+{
+	subsurf_benchmark(1);
+}
+
+TEST_F(subsurf, level2)
+{
+	subsurf_benchmark(2);
+}
+
+TEST_F(subsurf, level3)
+{
+	subsurf_benchmark(3);
+}
+
+TEST_F(subsurf, level4)
+{
+	subsurf_benchmark(4);
+}
@@ -0,0 +1,127 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+#include "testing/testing_common.h"
+
+#include <map>
+#include <math.h>
+#include <string.h>
+#include <utility>
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "DNA_modifier_types.h"
+#include "BKE_cdderivedmesh.h"
+#include "BKE_DerivedMesh.h"
+#include "BKE_subsurf.h"
+#include "intern/CCGSubSurf.h"
+}
+
+#define LEVELS 3
+
+/* Grid with the heights given by its position, so a window of a larger grid has the same
+ * control vertices as the larger grid over that window. */
+static DerivedMesh *grid_new(int offset, int size)
+{
+	const int totvert = (size + 1) * (size + 1);
+	const int totpoly = size * size;
+	DerivedMesh *dm = CDDM_new(totvert, 0, 0, totpoly * 4, totpoly);
+	MVert *mvert = dm->getVertArray(dm);
+
+	testing_grid_fill(mvert, dm->getLoopArray(dm), dm->getPolyArray(dm), size, offset);
+
+	for (int i = 0; i < totvert; i++) {
+		mvert[i].co[2] = sinf(mvert[i].co[0] * 0.7f) * cosf(mvert[i].co[1] * 1.3f);
+	}
+
+	CDDM_calc_edges(dm);
+
+	return dm;
+}
+
+static DerivedMesh *grid_subdivide(DerivedMesh *dm)
+{
+	SubsurfModifierData smd;
+
+	memset(&smd, 0, sizeof(smd));
+	smd.levels = LEVELS;
+	smd.subdivType = ME_CC_SUBSURF;
+
+	return subsurf_make_derived_from_derived(dm, &smd, NULL, (SubsurfFlags)0);
+}
+
+/* The subdivided vertices of a planar grid stay on the finer grid,
+ * their position on it identifies them in both results. */
+typedef std::pair<int, int> GridKey;
+
+static GridKey grid_key(const float co[3])
+{
+	const float scale = (float)(1 << LEVELS);
+	return GridKey((int)floorf(co[0] * scale + 0.5f), (int)floorf(co[1] * scale + 0.5f));
+}
+
+class subsurf : public ThreadapiTest {};
+
+/* The large grid is subdivided by the threaded loops and the window by the serial ones,
+ * away from the window border they must give the same vertices. */
+TEST_F(subsurf, ThreadedMatchesSerial)
+{
+	const int large_size = 64, window_offset = 24, window_size = 8;
+	/* the subdivision of a vertex depends on the control vertices up to two faces away */
+	const int border = 2;
+	const int edge_size = (1 << LEVELS) + 1;
+
+	ASSERT_GE(large_size * large_size * edge_size * edge_size * 4, CCG_TASK_LIMIT);
+	ASSERT_LT(window_size * window_size * edge_size * edge_size * 4, CCG_TASK_LIMIT);
+
+	DerivedMesh *large = grid_new(0, large_size);
+	DerivedMesh *window = grid_new(window_offset, window_size);
+	DerivedMesh *large_result = grid_subdivide(large);
+	DerivedMesh *window_result = grid_subdivide(window);
+
+	const int large_totvert = large_result->getNumVerts(large_result);
+	const int window_totvert = window_result->getNumVerts(window_result);
+	float (*large_cos)[3] = (float (*)[3])MEM_mallocN(sizeof(float[3]) * large_totvert, __func__);
+	float (*window_cos)[3] = (float (*)[3])MEM_mallocN(sizeof(float[3]) * window_totvert, __func__);
+	std::map<GridKey, int> large_verts;
+	int num_compared = 0;
+
+	large_result->getVertCos(large_result, large_cos);
+	window_result->getVertCos(window_result, window_cos);
+
+	for (int i = 0; i < large_totvert; i++) {
+		large_verts[grid_key(large_cos[i])] = i;
+	}
+
+	const float min = (float)(window_offset + border);
+	const float max = (float)(window_offset + window_size - border);
+
+	for (int i = 0; i < window_totvert; i++) {
+		const float *co = window_cos[i];
+
+		if (co[0] < min || co[0] > max || co[1] < min || co[1] > max) {
+			continue;
+		}
+
+		std::map<GridKey, int>::const_iterator it = large_verts.find(grid_key(co));
+		ASSERT_TRUE(it != large_verts.end()) << "vertex " << i;
+
+		const float *co_large = large_cos[it->second];
+		for (int j = 0; j < 3; j++) {
+			EXPECT_NEAR(co_large[j], co[j], 1e-5f) << "vertex " << i << ", axis " << j;
+		}
+		num_compared++;
+	}
+
+	/* every subdivided vertex of the window interior, borders included */
+	const int interior_size = (window_size - 2 * border) * (1 << LEVELS) + 1;
+	EXPECT_EQ(interior_size * interior_size, num_compared);
+
+	MEM_freeN(large_cos);
+	MEM_freeN(window_cos);
+	large_result->release(large_result);
+	window_result->release(window_result);
+	large->release(large);
+	window->release(window);
+}
@@ -0,0 +1,132 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+#include "testing/testing_common.h"
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "BLI_kdopbvh.h"
+#include "BLI_rand.h"
+#include "BLI_math_vector.h"
+}
+
+/* -------------------------------------------------------------------- */
+/* Helper Functions */
+
+static void rng_v3_round(
+        float *coords, int coords_len,
+        struct RNG *rng, int round, float scale)
+{
+	for (int i = 0; i < coords_len; i++) {
+		float f = BLI_rng_get_float(rng) * 2.0f - 1.0f;
+		coords[i] = ((float)((int)(f * round)) / (float)round) * scale;
+	}
+}
+
+static BVHTree *tree_from_points(float (*points)[3], int points_len)
+{
+	BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 8, 8);
+	for (int i = 0; i < points_len; i++) {
+		BLI_bvhtree_insert(tree, i, points[i], 1);
+	}
+	BLI_bvhtree_balance(tree);
+	return tree;
+}
+
+/* -------------------------------------------------------------------- */
+/* Tests */
+
+/* The batch search must find the same points as the single point search. */
+static void find_nearest_batch_test(int points_len, int queries_len)
+{
+	RNG *rng = BLI_rng_new(points_len);
+	float (*points)[3] = (float (*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+	float (*queries)[3] = (float (*)[3])MEM_mallocN(sizeof(float[3]) * queries_len, __func__);
+	BVHTreeNearest *nearest = (BVHTreeNearest *)MEM_mallocN(sizeof(*nearest) * queries_len, __func__);
+
+	rng_v3_round(&points[0][0], points_len * 3, rng, 1 << 16, 1.0f);
+	/* sorted along an axis, so the queries are close to each other like mesh vertices */
+	for (int i = 0; i < queries_len; i++) {
+		rng_v3_round(queries[i], 3, rng, 1 << 16, 0.1f);
+		queries[i][0] += (float)i / (float)queries_len * 2.0f - 1.0f;
+		nearest[i].index = -1;
+		nearest[i].dist_sq = FLT_MAX;
+	}
+
+	BVHTree *tree = tree_from_points(points, points_len);
+
+	BLI_bvhtree_find_nearest_batch(tree, queries, queries_len, nearest, NULL, NULL);
+
+	for (int i = 0; i < queries_len; i++) {
+		BVHTreeNearest ref;
+		ref.index = -1;
+		ref.dist_sq = FLT_MAX;
+		BLI_bvhtree_find_nearest(tree, queries[i], &ref, NULL, NULL);
+
+		EXPECT_NEAR(ref.dist_sq, nearest[i].dist_sq, 1e-6f);
+		EXPECT_NEAR(ref.dist_sq, len_squared_v3v3(queries[i], points[nearest[i].index]), 1e-6f);
+	}
+
+	BLI_bvhtree_free(tree);
+	BLI_rng_free(rng);
+	MEM_freeN(points);
+	MEM_freeN(queries);
+	MEM_freeN(nearest);
+}
+
+/* The batch ray cast must hit the same nodes as the single ray cast. */
+static void ray_cast_batch_test(int points_len, int rays_len)
+{
+	RNG *rng = BLI_rng_new(points_len);
+	float (*points)[3] = (float (*)[3])MEM_mallocN(sizeof(float[3]) * points_len, __func__);
+	float (*co)[3] = (float (*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+	float (*dir)[3] = (float (*)[3])MEM_mallocN(sizeof(float[3]) * rays_len, __func__);
+	BVHTreeRayHit *hit = (BVHTreeRayHit *)MEM_mallocN(sizeof(*hit) * rays_len, __func__);
+
+	rng_v3_round(&points[0][0], points_len * 3, rng, 1 << 16, 1.0f);
+	/* aim at the points, so most of the rays hit something */
+	for (int i = 0; i < rays_len; i++) {
+		rng_v3_round(co[i], 3, rng, 1 << 16, 2.0f);
+		sub_v3_v3v3(dir[i], points[i % points_len], co[i]);
+		normalize_v3(dir[i]);
+		hit[i].index = -1;
+		hit[i].dist = BVH_RAYCAST_DIST_MAX;
+	}
+
+	/* points have no size, give the nodes some room so the rays can hit them */
+	BVHTree *tree = BLI_bvhtree_new(points_len, 0.01f, 8, 8);
+	for (int i = 0; i < points_len; i++) {
+		BLI_bvhtree_insert(tree, i, points[i], 1);
+	}
+	BLI_bvhtree_balance(tree);
+
+	BLI_bvhtree_ray_cast_batch(tree, co, dir, rays_len, 0.0f, hit, NULL, NULL, BVH_RAYCAST_DEFAULT);
+
+	for (int i = 0; i < rays_len; i++) {
+		BVHTreeRayHit ref;
+		ref.index = -1;
+		ref.dist = BVH_RAYCAST_DIST_MAX;
+		BLI_bvhtree_ray_cast(tree, co[i], dir[i], 0.0f, &ref, NULL, NULL);
+
+		EXPECT_NE(-1, hit[i].index);
+		EXPECT_EQ(ref.index, hit[i].index);
+		EXPECT_NEAR(ref.dist, hit[i].dist, 1e-6f);
+	}
+
+	BLI_bvhtree_free(tree);
+	BLI_rng_free(rng);
+	MEM_freeN(points);
+	MEM_freeN(co);
+	MEM_freeN(dir);
+	MEM_freeN(hit);
+}
+
+class kdopbvh : public ThreadapiTest {};
+
+TEST_F(kdopbvh, FindNearestBatch_Small) { find_nearest_batch_test(100, 100); }
+TEST_F(kdopbvh, FindNearestBatch_Threaded) { find_nearest_batch_test(10000, 10000); }
+TEST_F(kdopbvh, FindNearestBatch_Empty) { find_nearest_batch_test(100, 0); }
+TEST_F(kdopbvh, RayCastBatch_Small) { ray_cast_batch_test(100, 100); }
+TEST_F(kdopbvh, RayCastBatch_Threaded) { ray_cast_batch_test(10000, 10000); }
+TEST_F(kdopbvh, RayCastBatch_Empty) { ray_cast_batch_test(100, 0); }
@@ -35,3 +35,135 @@ TEST(bmesh_core, BMVertCreate) {
 	EXPECT_EQ(3, BM_mesh_elem_count(bm, BM_VERT));
 	BM_mesh_free(bm);
 }
+
+/* big enough for the pools to use several chunks */
+#define COMPACT_GRID_SIZE 48
+
+/* Sum over the face loops, reading the loops, vertices and custom-data of every face.
+ * All values are integers, so the sum doesn't depend on the order of the elements. */
+static double bm_loops_sum(BMesh *bm)
+{
+	BMIter iter, liter;
+	BMFace *f;
+	BMLoop *l;
+	double sum = 0.0;
+
+	BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+		BM_ITER_ELEM (l, &liter, f, BM_LOOPS_OF_FACE) {
+			sum += (double)(l->v->co[0] * l->v->co[1] + BM_elem_float_data_get(&bm->ldata, l, CD_PROP_FLT));
+		}
+	}
+
+	return sum;
+}
+
+/* Check all pointers between elements are consistent (BM_mesh_validate is debug only). */
+static bool bm_topology_check(BMesh *bm)
+{
+	BMIter iter, liter;
+	BMVert *v;
+	BMFace *f;
+	BMLoop *l;
+
+	BM_ITER_MESH (v, &iter, bm, BM_VERTS_OF_MESH) {
+		if (v->e && !BM_vert_in_edge(v->e, v)) {
+			return false;
+		}
+	}
+
+	BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+		int len = 0;
+		BM_ITER_ELEM (l, &liter, f, BM_LOOPS_OF_FACE) {
+			if ((l->f != f) ||
+			    (l->next->prev != l) ||
+			    (l->radial_next->radial_prev != l) ||
+			    (l->radial_next->e != l->e) ||
+			    (BM_edge_exists(l->v, l->next->v) != l->e))
+			{
+				return false;
+			}
+			len++;
+		}
+		if (len != f->len) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+TEST(bmesh_core, BMeshCompact) {
+	BMesh *bm;
+	BMVert *verts[COMPACT_GRID_SIZE + 1][COMPACT_GRID_SIZE + 1];
+	BMeshMemStats stats_before, stats_after;
+	BMIter iter, liter;
+	BMFace *f, *f_act = NULL;
+	BMLoop *l;
+	int i;
+
+	bm = BM_mesh_create(&bm_mesh_allocsize_default);
+	BM_data_layer_add(bm, &bm->ldata, CD_PROP_FLT);
+
+	for (int y = 0; y <= COMPACT_GRID_SIZE; y++) {
+		for (int x = 0; x <= COMPACT_GRID_SIZE; x++) {
+			const float co[3] = {(float)x, (float)y, 0.0f};
+			verts[y][x] = BM_vert_create(bm, co, NULL, BM_CREATE_NOP);
+		}
+	}
+	for (int y = 0; y < COMPACT_GRID_SIZE; y++) {
+		for (int x = 0; x < COMPACT_GRID_SIZE; x++) {
+			BMVert *quad[4] = {verts[y][x], verts[y][x + 1], verts[y + 1][x + 1], verts[y + 1][x]};
+			f = BM_face_create_verts(bm, quad, 4, NULL, BM_CREATE_NOP, true);
+			i = 0;
+			BM_ITER_ELEM (l, &liter, f, BM_LOOPS_OF_FACE) {
+				BM_elem_float_data_set(&bm->ldata, l, CD_PROP_FLT, (float)(y * COMPACT_GRID_SIZE + x + i++));
+			}
+		}
+	}
+
+	/* leave holes in the pools, like after deleting a part of the mesh */
+	i = 0;
+	BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+		if ((i++ % 3) != 0) {
+			BM_face_kill(bm, f);
+		}
+		else {
+			f_act = f;
+		}
+	}
+	bm->act_face = f_act;
+	BM_select_history_store(bm, f_act);
+
+	const int totvert = bm->totvert, totedge = bm->totedge, totloop = bm->totloop, totface = bm->totface;
+	const double sum = bm_loops_sum(bm);
+	const float act_co[3] = {f_act->l_first->v->co[0], f_act->l_first->v->co[1], f_act->l_first->v->co[2]};
+	BM_mesh_memory_stats(bm, &stats_before);
+
+	EXPECT_TRUE(BM_mesh_compact(bm));
+
+	EXPECT_EQ(totvert, bm->totvert);
+	EXPECT_EQ(totedge, bm->totedge);
+	EXPECT_EQ(totloop, bm->totloop);
+	EXPECT_EQ(totface, bm->totface);
+	EXPECT_EQ(sum, bm_loops_sum(bm));
+	EXPECT_TRUE(bm_topology_check(bm));
+
+	/* the freed elements aren't allocated anymore */
+	BM_mesh_memory_stats(bm, &stats_after);
+	EXPECT_EQ(stats_before.used, stats_after.used);
+	EXPECT_LT(stats_after.total, stats_before.total);
+
+	/* references to the elements are updated */
+	ASSERT_TRUE(bm->act_face != NULL);
+	EXPECT_TRUE(equals_v3v3(act_co, bm->act_face->l_first->v->co));
+	EXPECT_EQ((BMElem *)bm->act_face, ((BMEditSelection *)bm->selected.first)->ele);
+
+	/* indices follow the new order */
+	EXPECT_EQ(0, bm->elem_index_dirty);
+	i = 0;
+	BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+		EXPECT_EQ(i++, BM_elem_index_get(f));
+	}
+
+	BM_mesh_free(bm);
+}
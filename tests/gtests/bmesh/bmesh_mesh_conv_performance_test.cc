@@ -0,0 +1,142 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+#include "testing/testing_common.h"
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "BLI_rand.h"
+#include "BKE_customdata.h"
+#include "PIL_time.h"
+}
+
+#include "bmesh.h"
+
+/* Grid of 700 x 700 quads, about half a million faces. */
+#define GRID_SIZE 700
+
+static void grid_init(Mesh *me)
+{
+	RNG *rng = BLI_rng_new(0);
+
+	/* custom-data is the most expensive part of the conversion */
+	testing_mesh_grid_init(me, GRID_SIZE, true);
+
+	for (int i = 0; i < me->totvert; i++) {
+		me->mvert[i].co[2] = BLI_rng_get_float(rng);
+	}
+
+	for (int i = 0; i < me->totloop; i++) {
+		me->mloopuv[i].uv[0] = BLI_rng_get_float(rng);
+		me->mloopuv[i].uv[1] = BLI_rng_get_float(rng);
+	}
+
+	BLI_rng_free(rng);
+}
+
+class bmesh_mesh_conv : public ThreadapiTest {};
+
+/* Conversion rate in each direction, the element order and custom-data are checked by
+ * the round trip in bmesh_mesh_conv_test. */
+TEST_F(bmesh_mesh_conv, RoundTrip)
+{
+	Mesh me_src, me_dst;
+
+	grid_init(&me_src);
+
+	const struct BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_ME(&me_src);
+	BMesh *bm = BM_mesh_create(&allocsize);
+
+	double start = PIL_check_seconds_timer();
+	BM_mesh_bm_from_me(bm, &me_src, true, false, 0);
+	const double time_from_me = PIL_check_seconds_timer() - start;
+
+	EXPECT_EQ(me_src.totpoly, bm->totface);
+
+	testing_mesh_init(&me_dst);
+	start = PIL_check_seconds_timer();
+	BM_mesh_bm_to_me(bm, &me_dst, false);
+	const double time_to_me = PIL_check_seconds_timer() - start;
+
+	EXPECT_EQ(me_src.totpoly, me_dst.totpoly);
+
+	printf("%d faces, BM_mesh_bm_from_me: %.2f ms, %.1f Mfaces/s\n",
+	       me_src.totpoly, time_from_me * 1000.0, me_src.totpoly / time_from_me * 1e-6);
+	printf("%d faces, BM_mesh_bm_to_me: %.2f ms, %.1f Mfaces/s\n",
+	       me_src.totpoly, time_to_me * 1000.0, me_src.totpoly / time_to_me * 1e-6);
+
+	BM_mesh_free(bm);
+	BKE_mesh_free(&me_dst, false);
+	BKE_mesh_free(&me_src, false);
+}
+
+/* Sum over the face loops, this reads the loops, vertices and custom-data of every face. */
+static double bm_loops_sum(BMesh *bm, const int cd_loop_uv_offset)
+{
+	BMIter iter, liter;
+	BMFace *f;
+	BMLoop *l;
+	double sum = 0.0;
+
+	BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+		BM_ITER_ELEM (l, &liter, f, BM_LOOPS_OF_FACE) {
+			const MLoopUV *luv = (const MLoopUV *)BM_ELEM_CD_GET_VOID_P(l, cd_loop_uv_offset);
+			sum += (double)(l->v->co[2] + luv->uv[0]);
+		}
+	}
+
+	return sum;
+}
+
+TEST_F(bmesh_mesh_conv, Compact)
+{
+	Mesh me_src;
+	BMeshMemStats stats_before, stats_after;
+	BMIter iter;
+	BMFace *f;
+	int i;
+
+	grid_init(&me_src);
+
+	const struct BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_ME(&me_src);
+	BMesh *bm = BM_mesh_create(&allocsize);
+	BM_mesh_bm_from_me(bm, &me_src, true, false, 0);
+	BKE_mesh_free(&me_src, false);
+
+	/* leave holes in the pools, like after deleting a part of the mesh */
+	i = 0;
+	BM_ITER_MESH (f, &iter, bm, BM_FACES_OF_MESH) {
+		if ((i++ % 3) != 0) {
+			BM_face_kill(bm, f);
+		}
+	}
+
+	const int cd_loop_uv_offset = CustomData_get_offset(&bm->ldata, CD_MLOOPUV);
+	/* keeps the iterations from being optimized out */
+	volatile double sum;
+
+	BM_mesh_memory_stats(bm, &stats_before);
+
+	double start = PIL_check_seconds_timer();
+	sum = bm_loops_sum(bm, cd_loop_uv_offset);
+	printf("loops iteration before compact: %.2f ms\n", (PIL_check_seconds_timer() - start) * 1000.0);
+
+	start = PIL_check_seconds_timer();
+	ASSERT_TRUE(BM_mesh_compact(bm));
+	printf("BM_mesh_compact: %.2f ms\n", (PIL_check_seconds_timer() - start) * 1000.0);
+
+	start = PIL_check_seconds_timer();
+	sum = bm_loops_sum(bm, cd_loop_uv_offset);
+	printf("loops iteration after compact: %.2f ms\n", (PIL_check_seconds_timer() - start) * 1000.0);
+
+	BM_mesh_memory_stats(bm, &stats_after);
+	printf("memory before compact: %.2f MB (used %.2f MB)\n",
+	       stats_before.total / (1024.0 * 1024.0), stats_before.used / (1024.0 * 1024.0));
+	printf("memory after compact: %.2f MB (used %.2f MB)\n",
+	       stats_after.total / (1024.0 * 1024.0), stats_after.used / (1024.0 * 1024.0));
+
+	UNUSED_VARS(sum);
+
+	BM_mesh_free(bm);
+}
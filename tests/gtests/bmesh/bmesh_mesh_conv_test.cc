@@ -0,0 +1,105 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+#include "testing/testing_common.h"
+
+#include <string.h>
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "DNA_object_types.h"
+}
+
+#include "bmesh.h"
+
+/* Small enough to compare every element, the performance test converts a large grid. */
+#define GRID_SIZE 12
+
+/* Grid with a value in every custom-data layer that depends on the element index. */
+static void grid_init(Mesh *me)
+{
+	testing_mesh_grid_init(me, GRID_SIZE, true);
+	CustomData_add_layer(&me->vdata, CD_PROP_FLT, CD_CALLOC, NULL, me->totvert);
+
+	float *vert_values = (float *)CustomData_get_layer(&me->vdata, CD_PROP_FLT);
+
+	for (int y = 0; y <= GRID_SIZE; y++) {
+		for (int x = 0; x <= GRID_SIZE; x++) {
+			const int i = y * (GRID_SIZE + 1) + x;
+			MVert *mv = &me->mvert[i];
+			mv->co[2] = (float)((x * 7 + y * 3) % 5);
+			mv->flag = (i % 3) ? 0 : SELECT;
+			vert_values[i] = (float)i * 0.5f;
+		}
+	}
+
+	for (int y = 0; y < GRID_SIZE; y++) {
+		for (int x = 0; x < GRID_SIZE; x++) {
+			const int i = y * GRID_SIZE + x;
+			MLoopUV *mluv = &me->mloopuv[i * 4];
+
+			me->mpoly[i].mat_nr = (short)(i % 4);
+
+			for (int j = 0; j < 4; j++) {
+				mluv[j].uv[0] = (float)(i * 4 + j);
+				mluv[j].uv[1] = (float)-(i * 4 + j);
+			}
+		}
+	}
+}
+
+/* Converting to a BMesh and back keeps the elements, their order and their custom-data. */
+TEST(bmesh_mesh_conv, RoundTrip)
+{
+	Mesh me_src, me_dst;
+
+	grid_init(&me_src);
+
+	const struct BMAllocTemplate allocsize = BMALLOC_TEMPLATE_FROM_ME(&me_src);
+	BMesh *bm = BM_mesh_create(&allocsize);
+	BM_mesh_bm_from_me(bm, &me_src, true, false, 0);
+
+	EXPECT_EQ(me_src.totvert, bm->totvert);
+	EXPECT_EQ(me_src.totedge, bm->totedge);
+	EXPECT_EQ(me_src.totloop, bm->totloop);
+	EXPECT_EQ(me_src.totpoly, bm->totface);
+
+	testing_mesh_init(&me_dst);
+	BM_mesh_bm_to_me(bm, &me_dst, false);
+	BM_mesh_free(bm);
+
+	ASSERT_EQ(me_src.totvert, me_dst.totvert);
+	ASSERT_EQ(me_src.totedge, me_dst.totedge);
+	ASSERT_EQ(me_src.totloop, me_dst.totloop);
+	ASSERT_EQ(me_src.totpoly, me_dst.totpoly);
+	ASSERT_TRUE(me_dst.mloopuv != NULL);
+	ASSERT_TRUE(me_dst.mtpoly != NULL);
+
+	const float *vert_values_src = (const float *)CustomData_get_layer(&me_src.vdata, CD_PROP_FLT);
+	const float *vert_values_dst = (const float *)CustomData_get_layer(&me_dst.vdata, CD_PROP_FLT);
+	ASSERT_TRUE(vert_values_dst != NULL);
+
+	for (int i = 0; i < me_src.totvert; i++) {
+		EXPECT_EQ(0, memcmp(me_src.mvert[i].co, me_dst.mvert[i].co, sizeof(float[3]))) << "vertex " << i;
+		EXPECT_EQ(me_src.mvert[i].flag & SELECT, me_dst.mvert[i].flag & SELECT) << "vertex " << i;
+		EXPECT_EQ(vert_values_src[i], vert_values_dst[i]) << "vertex " << i;
+	}
+	for (int i = 0; i < me_src.totedge; i++) {
+		EXPECT_EQ(me_src.medge[i].v1, me_dst.medge[i].v1) << "edge " << i;
+		EXPECT_EQ(me_src.medge[i].v2, me_dst.medge[i].v2) << "edge " << i;
+	}
+	for (int i = 0; i < me_src.totloop; i++) {
+		EXPECT_EQ(me_src.mloop[i].v, me_dst.mloop[i].v) << "loop " << i;
+		EXPECT_EQ(me_src.mloop[i].e, me_dst.mloop[i].e) << "loop " << i;
+		EXPECT_EQ(0, memcmp(me_src.mloopuv[i].uv, me_dst.mloopuv[i].uv, sizeof(float[2]))) << "loop " << i;
+	}
+	for (int i = 0; i < me_src.totpoly; i++) {
+		EXPECT_EQ(me_src.mpoly[i].loopstart, me_dst.mpoly[i].loopstart) << "face " << i;
+		EXPECT_EQ(me_src.mpoly[i].totloop, me_dst.mpoly[i].totloop) << "face " << i;
+		EXPECT_EQ(me_src.mpoly[i].mat_nr, me_dst.mpoly[i].mat_nr) << "face " << i;
+	}
+
+	BKE_mesh_free(&me_dst, false);
+	BKE_mesh_free(&me_src, false);
+}
@@ -0,0 +1,131 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "COM_MixOperation.h"
+#include "COM_AlphaOverKeyOperation.h"
+#include "COM_AlphaOverMixedOperation.h"
+#include "COM_AlphaOverPremultiplyOperation.h"
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "BLI_rand.h"
+}
+
+/* More than one span, with a partial span at the end. */
+#define IMAGE_WIDTH (COM_ROW_SPAN * 2 + 37)
+#define IMAGE_HEIGHT 4
+
+/* Random pixels, including out of range colors and the alpha and factor values
+ * the operations handle separately (0 and 1). */
+class RandomInputOperation : public SocketReader {
+private:
+	float *m_pixels;
+
+public:
+	RandomInputOperation(unsigned int seed)
+	{
+		const int num_values = IMAGE_WIDTH * IMAGE_HEIGHT * 4;
+		RNG *rng = BLI_rng_new(seed);
+
+		m_pixels = (float *)MEM_mallocN(sizeof(float) * num_values, __func__);
+		for (int i = 0; i < num_values; i++) {
+			const float r = BLI_rng_get_float(rng);
+			m_pixels[i] = (r < 0.1f) ? 0.0f : (r > 0.9f) ? 1.0f : r * 1.2f - 0.1f;
+		}
+
+		BLI_rng_free(rng);
+	}
+
+	~RandomInputOperation()
+	{
+		MEM_freeN(m_pixels);
+	}
+
+protected:
+	void executePixelSampled(float output[4], float x, float y, PixelSampler /*sampler*/)
+	{
+		copy_v4_v4(output, &m_pixels[((int)y * IMAGE_WIDTH + (int)x) * 4]);
+	}
+};
+
+/* Gives access to the inputs, without building a whole execution system. */
+template<typename T> class MixTestOperation : public T {
+public:
+	void setInputs(SocketReader *value, SocketReader *color1, SocketReader *color2)
+	{
+		this->m_inputValueOperation = value;
+		this->m_inputColor1Operation = color1;
+		this->m_inputColor2Operation = color2;
+	}
+};
+
+/* Rows must give the same result as the pixels, for every combination of the mix options. */
+template<typename T> static void mix_operation_test(MixTestOperation<T> *operation)
+{
+	RandomInputOperation value(0), color1(1), color2(2);
+	float *row = (float *)MEM_mallocN(sizeof(float) * IMAGE_WIDTH * 4, __func__);
+
+	operation->setInputs(&value, &color1, &color2);
+
+	for (int options = 0; options < 4; options++) {
+		operation->setUseValueAlphaMultiply((options & 1) != 0);
+		operation->setUseClamp((options & 2) != 0);
+
+		for (int y = 0; y < IMAGE_HEIGHT; y++) {
+			/* start inside the image as well, rows are not always calculated from x = 0 */
+			const int xmin = (y % 2) ? 13 : 0;
+
+			operation->readRow(row, xmin, IMAGE_WIDTH, y, COM_NUM_CHANNELS_COLOR);
+
+			for (int x = xmin; x < IMAGE_WIDTH; x++) {
+				float pixel[4];
+				operation->readSampled(pixel, x, y, COM_PS_NEAREST);
+				for (int c = 0; c < 4; c++) {
+					EXPECT_NEAR(pixel[c], row[(x - xmin) * 4 + c], 1e-5f) <<
+					        "options " << options << ", pixel " << x << ", " << y << ", channel " << c;
+				}
+			}
+		}
+	}
+
+	MEM_freeN(row);
+	delete operation;
+}
+
+#define MIX_OPERATION_TEST(name) \
+TEST(mix_operation, name) \
+{ \
+	mix_operation_test(new MixTestOperation<name>()); \
+}
+
+MIX_OPERATION_TEST(MixBaseOperation)
+MIX_OPERATION_TEST(MixAddOperation)
+MIX_OPERATION_TEST(MixBlendOperation)
+MIX_OPERATION_TEST(MixBurnOperation)
+MIX_OPERATION_TEST(MixColorOperation)
+MIX_OPERATION_TEST(MixDarkenOperation)
+MIX_OPERATION_TEST(MixDifferenceOperation)
+MIX_OPERATION_TEST(MixDivideOperation)
+MIX_OPERATION_TEST(MixDodgeOperation)
+MIX_OPERATION_TEST(MixGlareOperation)
+MIX_OPERATION_TEST(MixHueOperation)
+MIX_OPERATION_TEST(MixLightenOperation)
+MIX_OPERATION_TEST(MixLinearLightOperation)
+MIX_OPERATION_TEST(MixMultiplyOperation)
+MIX_OPERATION_TEST(MixOverlayOperation)
+MIX_OPERATION_TEST(MixSaturationOperation)
+MIX_OPERATION_TEST(MixScreenOperation)
+MIX_OPERATION_TEST(MixSoftLightOperation)
+MIX_OPERATION_TEST(MixSubtractOperation)
+MIX_OPERATION_TEST(MixValueOperation)
+MIX_OPERATION_TEST(AlphaOverKeyOperation)
+MIX_OPERATION_TEST(AlphaOverPremultiplyOperation)
+
+TEST(mix_operation, AlphaOverMixedOperation)
+{
+	MixTestOperation<AlphaOverMixedOperation> *operation = new MixTestOperation<AlphaOverMixedOperation>();
+	operation->setX(0.5f);
+	mix_operation_test(operation);
+}
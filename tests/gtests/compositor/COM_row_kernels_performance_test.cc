@@ -0,0 +1,183 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+
+#include "COM_RowKernels.h"
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "BLI_math_base.h"
+#include "BLI_rand.h"
+#include "PIL_time.h"
+}
+
+/* Full HD frame, processed in spans like SocketReader::executeRow does. */
+#define IMAGE_WIDTH 1920
+#define IMAGE_HEIGHT 1080
+#define ITERATIONS 20
+
+struct RowKernelsImage {
+	float *value;
+	float *color1;
+	float *color2;
+	float *output;
+};
+
+static void image_init(RowKernelsImage *image)
+{
+	const size_t num_pixels = IMAGE_WIDTH;
+	RNG *rng = BLI_rng_new(0);
+
+	image->value = (float *)MEM_mallocN(sizeof(float) * num_pixels, __func__);
+	image->color1 = (float *)MEM_mallocN(sizeof(float) * num_pixels * 4, __func__);
+	image->color2 = (float *)MEM_mallocN(sizeof(float) * num_pixels * 4, __func__);
+	image->output = (float *)MEM_mallocN(sizeof(float) * num_pixels * 4, __func__);
+
+	for (size_t i = 0; i < num_pixels; i++) {
+		image->value[i] = BLI_rng_get_float(rng);
+	}
+	for (size_t i = 0; i < num_pixels * 4; i++) {
+		/* include some out of range and zero alpha values */
+		image->color1[i] = BLI_rng_get_float(rng) * 1.2f - 0.1f;
+		image->color2[i] = BLI_rng_get_float(rng) * 1.2f - 0.1f;
+	}
+
+	BLI_rng_free(rng);
+}
+
+static void image_free(RowKernelsImage *image)
+{
+	MEM_freeN(image->value);
+	MEM_freeN(image->color1);
+	MEM_freeN(image->color2);
+	MEM_freeN(image->output);
+}
+
+/* The same row is processed for every line of the image, the inputs stay in the cache
+ * so the numbers show the cost of the kernels and not of the memory bandwidth. */
+static void print_megapixels_per_second(const char *id, double time)
+{
+	const double megapixels = (double)IMAGE_WIDTH * IMAGE_HEIGHT * ITERATIONS / 1e6;
+	printf("%s: %.1f MP/s\n", id, megapixels / time);
+}
+
+static void mix_kernel_test(const char *id, RowKernels::MixFunc kernel)
+{
+	RowKernelsImage image;
+	image_init(&image);
+
+	const double start = PIL_check_seconds_timer();
+	for (int iter = 0; iter < ITERATIONS; iter++) {
+		for (int y = 0; y < IMAGE_HEIGHT; y++) {
+			for (int x = 0; x < IMAGE_WIDTH; x += COM_ROW_SPAN) {
+				const int width = min_ii(COM_ROW_SPAN, IMAGE_WIDTH - x);
+				kernel(&image.output[x * 4], &image.value[x], &image.color1[x * 4], &image.color2[x * 4], width);
+				RowKernels::clamp(&image.output[x * 4], width);
+			}
+		}
+	}
+	print_megapixels_per_second(id, PIL_check_seconds_timer() - start);
+
+	image_free(&image);
+}
+
+#define MIX_KERNEL_TEST(name) \
+TEST(row_kernels, name) \
+{ \
+	mix_kernel_test(STRINGIFY(name), RowKernels::name); \
+}
+
+MIX_KERNEL_TEST(mixBlend)
+MIX_KERNEL_TEST(mixAdd)
+MIX_KERNEL_TEST(mixSubtract)
+MIX_KERNEL_TEST(mixMultiply)
+MIX_KERNEL_TEST(mixScreen)
+MIX_KERNEL_TEST(mixDifference)
+MIX_KERNEL_TEST(mixDarken)
+MIX_KERNEL_TEST(mixLighten)
+
+TEST(row_kernels, setAlpha)
+{
+	RowKernelsImage image;
+	image_init(&image);
+
+	const double start = PIL_check_seconds_timer();
+	for (int iter = 0; iter < ITERATIONS; iter++) {
+		for (int y = 0; y < IMAGE_HEIGHT; y++) {
+			for (int x = 0; x < IMAGE_WIDTH; x += COM_ROW_SPAN) {
+				const int width = min_ii(COM_ROW_SPAN, IMAGE_WIDTH - x);
+				RowKernels::setAlpha(&image.output[x * 4], &image.color1[x * 4], &image.value[x], width);
+			}
+		}
+	}
+	print_megapixels_per_second("setAlpha", PIL_check_seconds_timer() - start);
+
+	for (int i = 0; i < IMAGE_WIDTH; i++) {
+		EXPECT_NEAR(image.color1[i * 4], image.output[i * 4], 1e-6f);
+		EXPECT_NEAR(image.value[i], image.output[i * 4 + 3], 1e-6f);
+	}
+
+	image_free(&image);
+}
+
+TEST(row_kernels, premultiply)
+{
+	RowKernelsImage image;
+	image_init(&image);
+
+	const double start = PIL_check_seconds_timer();
+	for (int iter = 0; iter < ITERATIONS; iter++) {
+		for (int y = 0; y < IMAGE_HEIGHT; y++) {
+			for (int x = 0; x < IMAGE_WIDTH; x += COM_ROW_SPAN) {
+				const int width = min_ii(COM_ROW_SPAN, IMAGE_WIDTH - x);
+				RowKernels::straightToPremul(&image.output[x * 4], &image.color1[x * 4], width);
+				RowKernels::premulToStraight(&image.output[x * 4], &image.output[x * 4], width);
+			}
+		}
+	}
+	print_megapixels_per_second("straightToPremul + premulToStraight", PIL_check_seconds_timer() - start);
+
+	for (int i = 0; i < IMAGE_WIDTH; i++) {
+		if (fabsf(image.color1[i * 4 + 3]) > 0.1f) {
+			EXPECT_NEAR(image.color1[i * 4], image.output[i * 4], 1e-5f);
+		}
+	}
+
+	image_free(&image);
+}
+
+/* The kernels must give the same results as the executePixelSampled methods. */
+TEST(row_kernels, mixBlendResult)
+{
+	RowKernelsImage image;
+	image_init(&image);
+
+	RowKernels::mixBlend(image.output, image.value, image.color1, image.color2, IMAGE_WIDTH);
+
+	for (int i = 0; i < IMAGE_WIDTH; i++) {
+		const float *c1 = &image.color1[i * 4], *c2 = &image.color2[i * 4];
+		const float fac = image.value[i];
+		for (int c = 0; c < 3; c++) {
+			EXPECT_NEAR((1.0f - fac) * c1[c] + fac * c2[c], image.output[i * 4 + c], 1e-6f);
+		}
+		EXPECT_NEAR(c1[3], image.output[i * 4 + 3], 1e-6f);
+	}
+
+	image_free(&image);
+}
+
+TEST(row_kernels, clampResult)
+{
+	RowKernelsImage image;
+	image_init(&image);
+
+	RowKernels::clamp(image.color1, IMAGE_WIDTH);
+
+	for (int i = 0; i < IMAGE_WIDTH * 4; i++) {
+		EXPECT_GE(image.color1[i], 0.0f);
+		EXPECT_LE(image.color1[i], 1.0f);
+	}
+
+	image_free(&image);
+}
@@ -0,0 +1,137 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+#include "testing/testing_common.h"
+
+#include <algorithm>
+#include <float.h>
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "BLI_rand.h"
+#include "PIL_time.h"
+#include "IMB_imbuf.h"
+#include "IMB_imbuf_types.h"
+}
+
+/* Throughput of the scaling functions on a full HD frame, in source megapixels per second,
+ * for the sizes used by thumbnails and texture uploads. */
+#define SOURCE_WIDTH 1920
+#define SOURCE_HEIGHT 1080
+
+/* Best of a few runs, the first one also pays for the page faults of new buffers. */
+#define RUNS 5
+
+static ImBuf *source_new(bool use_float)
+{
+	ImBuf *ibuf = IMB_allocImBuf(SOURCE_WIDTH, SOURCE_HEIGHT, 32, use_float ? IB_rectfloat : IB_rect);
+	const size_t num_values = (size_t)SOURCE_WIDTH * SOURCE_HEIGHT * 4;
+	RNG *rng = BLI_rng_new(0);
+
+	if (use_float) {
+		for (size_t i = 0; i < num_values; i++) {
+			ibuf->rect_float[i] = BLI_rng_get_float(rng);
+		}
+	}
+	else {
+		unsigned char *cp = (unsigned char *)ibuf->rect;
+		for (size_t i = 0; i < num_values; i++) {
+			cp[i] = (unsigned char)BLI_rng_get_int(rng);
+		}
+	}
+
+	BLI_rng_free(rng);
+
+	return ibuf;
+}
+
+static void scale_default(ImBuf *ibuf, unsigned int newx, unsigned int newy)
+{
+	IMB_scaleImBuf(ibuf, newx, newy);
+}
+
+static void scale_fast(ImBuf *ibuf, unsigned int newx, unsigned int newy)
+{
+	IMB_scalefastImBuf(ibuf, newx, newy);
+}
+
+static void scale_threaded(ImBuf *ibuf, unsigned int newx, unsigned int newy)
+{
+	IMB_scaleImBuf_threaded(ibuf, newx, newy);
+}
+
+static void scale_box(ImBuf *ibuf, unsigned int newx, unsigned int newy)
+{
+	IMB_scaleImBuf_filter(ibuf, newx, newy, IMB_SCALE_FILTER_BOX);
+}
+
+static void scale_mitchell(ImBuf *ibuf, unsigned int newx, unsigned int newy)
+{
+	IMB_scaleImBuf_filter(ibuf, newx, newy, IMB_SCALE_FILTER_MITCHELL);
+}
+
+static void scale_lanczos(ImBuf *ibuf, unsigned int newx, unsigned int newy)
+{
+	IMB_scaleImBuf_filter(ibuf, newx, newy, IMB_SCALE_FILTER_LANCZOS);
+}
+
+static const struct {
+	const char *name;
+	void (*func)(ImBuf *ibuf, unsigned int newx, unsigned int newy);
+} scale_methods[] = {
+	{"IMB_scaleImBuf", scale_default},
+	{"IMB_scalefastImBuf", scale_fast},
+	{"IMB_scaleImBuf_threaded", scale_threaded},
+	{"IMB_scaleImBuf_filter box", scale_box},
+	{"IMB_scaleImBuf_filter mitchell", scale_mitchell},
+	{"IMB_scaleImBuf_filter lanczos", scale_lanczos},
+};
+
+/* Each method scales its own copy of the same source. */
+static void scale_benchmark(const char *use_case, bool use_float, unsigned int newx, unsigned int newy)
+{
+	ImBuf *source = source_new(use_float);
+
+	printf("%s, %s %dx%d to %ux%u:\n", use_case, use_float ? "float" : "byte",
+	       SOURCE_WIDTH, SOURCE_HEIGHT, newx, newy);
+
+	for (int i = 0; i < ARRAY_SIZE(scale_methods); i++) {
+		double best = DBL_MAX;
+
+		for (int run = 0; run < RUNS; run++) {
+			ImBuf *ibuf = IMB_dupImBuf(source);
+			const double start = PIL_check_seconds_timer();
+			scale_methods[i].func(ibuf, newx, newy);
+			best = std::min(best, PIL_check_seconds_timer() - start);
+			IMB_freeImBuf(ibuf);
+		}
+
+		printf("  %-32s %8.2f ms %8.1f Mpixels/s\n", scale_methods[i].name, best * 1000.0,
+		       (double)(SOURCE_WIDTH * SOURCE_HEIGHT) / best * 1e-6);
+	}
+
+	IMB_freeImBuf(source);
+}
+
+class imbuf_scaling : public ThreadapiTest {
+protected:
+	static void SetUpTestCase()
+	{
+		ThreadapiTest::SetUpTestCase();
+		IMB_init();
+	}
+
+	static void TearDownTestCase()
+	{
+		IMB_exit();
+		ThreadapiTest::TearDownTestCase();
+	}
+};
+
+/* File browser thumbnails and preview icons. */
+TEST_F(imbuf_scaling, Thumbnail) { scale_benchmark("thumbnail", false, 128, 72); }
+/* Textures larger than the GPU limit, or non power of two sizes. */
+TEST_F(imbuf_scaling, TextureByte) { scale_benchmark("texture", false, 1024, 512); }
+TEST_F(imbuf_scaling, TextureFloat) { scale_benchmark("texture", true, 1024, 512); }
+TEST_F(imbuf_scaling, TextureUpscale) { scale_benchmark("texture", false, 2048, 1024); }
@@ -0,0 +1,154 @@
+/* Apache License, Version 2.0 */
+
+#include "testing/testing.h"
+#include "testing/testing_common.h"
+
+#include <string.h>
+
+extern "C" {
+#include "MEM_guardedalloc.h"
+#include "BLI_utildefines.h"
+#include "BLI_rand.h"
+#include "IMB_imbuf.h"
+#include "IMB_imbuf_types.h"
+}
+
+/* Odd sizes, so the scaling ratios aren't whole numbers. */
+#define IMAGE_WIDTH 94
+#define IMAGE_HEIGHT 52
+
+static ImBuf *image_new(bool use_float)
+{
+	ImBuf *ibuf = IMB_allocImBuf(IMAGE_WIDTH, IMAGE_HEIGHT, 32, use_float ? IB_rectfloat : IB_rect);
+	const int num_values = IMAGE_WIDTH * IMAGE_HEIGHT * 4;
+	RNG *rng = BLI_rng_new(0);
+
+	if (use_float) {
+		for (int i = 0; i < num_values; i++) {
+			ibuf->rect_float[i] = BLI_rng_get_float(rng);
+		}
+	}
+	else {
+		unsigned char *cp = (unsigned char *)ibuf->rect;
+		for (int i = 0; i < num_values; i++) {
+			cp[i] = (unsigned char)BLI_rng_get_int(rng);
+		}
+	}
+
+	BLI_rng_free(rng);
+
+	return ibuf;
+}
+
+class imbuf_scaling : public ThreadapiTest {
+protected:
+	static void SetUpTestCase()
+	{
+		ThreadapiTest::SetUpTestCase();
+		IMB_init();
+	}
+
+	static void TearDownTestCase()
+	{
+		IMB_exit();
+		ThreadapiTest::TearDownTestCase();
+	}
+};
+
+/* Halving with the box filter must average each 2x2 block. */
+TEST_F(imbuf_scaling, BoxHalf)
+{
+	ImBuf *ibuf = image_new(true);
+	ImBuf *ref = image_new(true);
+	const int newx = IMAGE_WIDTH / 2, newy = IMAGE_HEIGHT / 2;
+
+	IMB_scaleImBuf_filter(ibuf, newx, newy, IMB_SCALE_FILTER_BOX);
+
+	ASSERT_EQ(newx, ibuf->x);
+	ASSERT_EQ(newy, ibuf->y);
+
+	for (int y = 0; y < newy; y++) {
+		for (int x = 0; x < newx; x++) {
+			for (int c = 0; c < 4; c++) {
+				const float *fp = ref->rect_float + ((2 * y) * IMAGE_WIDTH + 2 * x) * 4 + c;
+				const float average = (fp[0] + fp[4] + fp[IMAGE_WIDTH * 4] + fp[IMAGE_WIDTH * 4 + 4]) * 0.25f;
+				EXPECT_NEAR(average, ibuf->rect_float[(y * newx + x) * 4 + c], 1e-5f);
+			}
+		}
+	}
+
+	IMB_freeImBuf(ibuf);
+	IMB_freeImBuf(ref);
+}
+
+/* The box filter replaces IMB_scaleImBuf for texture uploads, when downscaling it must give the same result. */
+static void box_downscale_test(unsigned int newx, unsigned int newy)
+{
+	ImBuf *ibuf = image_new(false);
+	ImBuf *ref = image_new(false);
+
+	IMB_scaleImBuf_filter(ibuf, newx, newy, IMB_SCALE_FILTER_BOX);
+	IMB_scaleImBuf(ref, newx, newy);
+
+	ASSERT_EQ(ref->x, ibuf->x);
+	ASSERT_EQ(ref->y, ibuf->y);
+
+	const unsigned char *cp = (const unsigned char *)ibuf->rect;
+	const unsigned char *cp_ref = (const unsigned char *)ref->rect;
+	for (unsigned int i = 0; i < newx * newy * 4; i++) {
+		EXPECT_NEAR(cp_ref[i], cp[i], 1) << "pixel " << i / 4 << ", channel " << i % 4;
+	}
+
+	IMB_freeImBuf(ibuf);
+	IMB_freeImBuf(ref);
+}
+
+TEST_F(imbuf_scaling, BoxDownscale) { box_downscale_test(IMAGE_WIDTH / 3, IMAGE_HEIGHT / 3); }
+
+/* When upscaling the box filter interpolates linearly between the pixel centers,
+ * so doubling a ramp gives a ramp with half the slope away from the borders. */
+TEST_F(imbuf_scaling, BoxUpscale)
+{
+	ImBuf *ibuf = IMB_allocImBuf(IMAGE_WIDTH, IMAGE_HEIGHT, 32, IB_rectfloat);
+	const int newx = IMAGE_WIDTH * 2, newy = IMAGE_HEIGHT * 2;
+
+	for (int y = 0; y < IMAGE_HEIGHT; y++) {
+		for (int x = 0; x < IMAGE_WIDTH; x++) {
+			float *fp = ibuf->rect_float + (y * IMAGE_WIDTH + x) * 4;
+			fp[0] = fp[1] = fp[2] = (float)x;
+			fp[3] = (float)y;
+		}
+	}
+
+	IMB_scaleImBuf_filter(ibuf, newx, newy, IMB_SCALE_FILTER_BOX);
+
+	for (int y = 1; y < newy - 1; y++) {
+		for (int x = 1; x < newx - 1; x++) {
+			const float *fp = ibuf->rect_float + (y * newx + x) * 4;
+			EXPECT_NEAR(x * 0.5f - 0.25f, fp[0], 1e-4f) << "pixel " << x << ", " << y;
+			EXPECT_NEAR(y * 0.5f - 0.25f, fp[3], 1e-4f) << "pixel " << x << ", " << y;
+		}
+	}
+
+	IMB_freeImBuf(ibuf);
+}
+
+/* The filter weights are normalized, so a constant image stays constant. */
+static void constant_test(IMB_ScaleFilter filter, unsigned int newx, unsigned int newy)
+{
+	ImBuf *ibuf = IMB_allocImBuf(IMAGE_WIDTH, IMAGE_HEIGHT, 32, IB_rect);
+
+	memset(ibuf->rect, 200, sizeof(unsigned int) * IMAGE_WIDTH * IMAGE_HEIGHT);
+
+	IMB_scaleImBuf_filter(ibuf, newx, newy, filter);
+
+	const unsigned char *cp = (const unsigned char *)ibuf->rect;
+	for (unsigned int i = 0; i < newx * newy * 4; i++) {
+		EXPECT_EQ(200, cp[i]);
+	}
+
+	IMB_freeImBuf(ibuf);
+}
+
+TEST_F(imbuf_scaling, MitchellConstant) { constant_test(IMB_SCALE_FILTER_MITCHELL, 33, 17); }
+TEST_F(imbuf_scaling, LanczosConstant) { constant_test(IMB_SCALE_FILTER_LANCZOS, 33, 17); }
@@ -0,0 +1,96 @@
+/* Apache License, Version 2.0 */
+
+#ifndef __TESTING_COMMON_H__
+#define __TESTING_COMMON_H__
+
+/* Helpers shared by the tests of Blender's own modules,
+ * include after "testing/testing.h". */
+
+#include <string.h>
+
+extern "C" {
+#include "BLI_threads.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "BKE_customdata.h"
+#include "BKE_mesh.h"
+}
+
+/* Fixture for tests of code which uses task pools or other threading API. */
+class ThreadapiTest : public testing::Test {
+protected:
+	static void SetUpTestCase()
+	{
+		BLI_threadapi_init();
+	}
+
+	static void TearDownTestCase()
+	{
+		BLI_threadapi_exit();
+	}
+};
+
+/* Quads of a grid of size x size faces starting at (offset, offset), the vertices are left at z = 0.
+ * The arrays hold (size + 1) ^ 2 vertices, size ^ 2 faces and four loops per face. */
+inline void testing_grid_fill(MVert *mvert, MLoop *mloop, MPoly *mpoly, int size, int offset)
+{
+	for (int y = 0; y <= size; y++) {
+		for (int x = 0; x <= size; x++) {
+			MVert *mv = &mvert[y * (size + 1) + x];
+			mv->co[0] = (float)(offset + x);
+			mv->co[1] = (float)(offset + y);
+			mv->co[2] = 0.0f;
+		}
+	}
+
+	for (int y = 0; y < size; y++) {
+		for (int x = 0; x < size; x++) {
+			const int i = y * size + x;
+			const int v = y * (size + 1) + x;
+			MLoop *ml = &mloop[i * 4];
+
+			mpoly[i].loopstart = i * 4;
+			mpoly[i].totloop = 4;
+			ml[0].v = v;
+			ml[1].v = v + 1;
+			ml[2].v = v + size + 2;
+			ml[3].v = v + size + 1;
+		}
+	}
+}
+
+/* Empty mesh outside of Main, free with BKE_mesh_free(me, false). */
+inline void testing_mesh_init(Mesh *me)
+{
+	memset(me, 0, sizeof(*me));
+	CustomData_reset(&me->vdata);
+	CustomData_reset(&me->edata);
+	CustomData_reset(&me->fdata);
+	CustomData_reset(&me->ldata);
+	CustomData_reset(&me->pdata);
+}
+
+/* Mesh of testing_grid_fill() with its edges, uv_layers adds zeroed UV and texture face layers. */
+inline void testing_mesh_grid_init(Mesh *me, int size, bool uv_layers)
+{
+	const int totpoly = size * size;
+
+	testing_mesh_init(me);
+	me->totvert = (size + 1) * (size + 1);
+	me->totloop = totpoly * 4;
+	me->totpoly = totpoly;
+	CustomData_add_layer(&me->vdata, CD_MVERT, CD_CALLOC, NULL, me->totvert);
+	CustomData_add_layer(&me->ldata, CD_MLOOP, CD_CALLOC, NULL, me->totloop);
+	CustomData_add_layer(&me->pdata, CD_MPOLY, CD_CALLOC, NULL, me->totpoly);
+	if (uv_layers) {
+		CustomData_add_layer(&me->ldata, CD_MLOOPUV, CD_CALLOC, NULL, me->totloop);
+		CustomData_add_layer(&me->pdata, CD_MTEXPOLY, CD_CALLOC, NULL, me->totpoly);
+	}
+	BKE_mesh_update_customdata_pointers(me, false);
+
+	testing_grid_fill(me->mvert, me->mloop, me->mpoly, size, 0);
+
+	BKE_mesh_calc_edges(me, false, false);
+}
+
+#endif  /* __TESTING_COMMON_H__ */